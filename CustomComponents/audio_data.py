@@ -11,7 +11,7 @@ The host fills this from the C++ side before each render call.
 from __future__ import annotations
 
 from dataclasses import dataclass, field
-from typing import List, Optional
+from typing import Dict, List, Optional, Tuple
 
 
 @dataclass(slots=True)
@@ -61,6 +61,25 @@ class AudioData:
         duration_seconds:  Total file duration in seconds.
         bpm:               Estimated BPM (0 if unavailable).
         beat_phase:        Beat phase 0.0–1.0 within current beat (for beat-sync visuals).
+        spectral_centroid: Magnitude-weighted mean frequency (Hz).
+        spectral_flux:     Sum of positive magnitude changes since the previous FFT frame.
+        spectral_rolloff:  Frequency below which 85 % of the spectral power lies (Hz).
+        spectral_flatness: Geometric / arithmetic mean power, 0 (tonal) … 1 (noise).
+        chroma:            12 pitch-class energies (C, C#, … B), loudest = 1.0.
+        mfcc:              13 mel-frequency cepstral coefficients.
+        pitch_hz:          YIN fundamental estimate (0 when unvoiced or silent).
+        pitch_confidence:  0.0–1.0 confidence of *pitch_hz*.
+        history:           The host's metric history over the last
+                           *history_window* seconds: metric name →
+                           (min, max, mean) buckets, oldest first.  Metrics are
+                           peak_left/right and rms_left/right (linear),
+                           lufs_momentary, lufs_short_term and correlation.
+        history_window:    Seconds covered by *history* when full.
+
+    The feature fields are only filled for plugins whose manifest lists
+    ``"features"`` in ``analysis`` (or has no ``analysis`` list), and
+    *history* for those that list ``"history"``.  History travels only
+    through shared memory; over the JSON fallback it stays empty.
     """
 
     # Stream info
@@ -95,6 +114,20 @@ class AudioData:
     bpm: float = 0.0
     beat_phase: float = 0.0
 
+    # Spectral / pitch features
+    spectral_centroid: float = 0.0
+    spectral_flux: float = 0.0
+    spectral_rolloff: float = 0.0
+    spectral_flatness: float = 0.0
+    chroma: List[float] = field(default_factory=lambda: [0.0] * 12)
+    mfcc: List[float] = field(default_factory=lambda: [0.0] * 13)
+    pitch_hz: float = 0.0
+    pitch_confidence: float = 0.0
+
+    # Metric history from the host store
+    history: Dict[str, List[Tuple[float, float, float]]] = field(default_factory=dict)
+    history_window: float = 0.0
+
     # ── Convenience helpers ─────────────────────────────────────────────────
 
     @property
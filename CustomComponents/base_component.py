@@ -186,6 +186,21 @@ class BaseComponent(abc.ABC):
             self._fps = 30.0 / elapsed if elapsed > 0 else 0.0
             self._last_time = now
 
+    # ── Cloning ─────────────────────────────────────────────────────────────
+
+    def clone(self) -> "BaseComponent":
+        """Return an independent copy of this instance, state included.
+
+        The default deep-copies the whole object.  Override it if the
+        component holds resources that cannot be copied (files, sockets,
+        native handles) and rebuild those in the copy.
+        """
+        import copy
+        twin = copy.deepcopy(self)
+        twin._frame_count = 0
+        twin._last_time = time.perf_counter()
+        return twin
+
     # ── Serialisation helpers ───────────────────────────────────────────────
 
     def serialise(self) -> Dict[str, Any]:
@@ -5,6 +5,9 @@ The bridge uses a JSON-line protocol over stdin/stdout:
     - Host → Python:  JSON messages with ``{ "type": "...", ... }``
     - Python → Host:  JSON responses with ``{ "type": "...", ... }``
 
+A request may carry an ``"id"``; its response echoes it, so the host can
+have several requests in flight and match replies that arrive late.
+
 This module implements the Python side of the bridge.  The C++ side spawns
 a ``python bridge_runner.py`` subprocess and communicates via pipes.
 
@@ -12,8 +15,11 @@ Message types (Host → Python):
     scan             — scan plugins directory
     list             — get manifest list for TOOLBOX
     create           — create a component instance
+    clone_instance   — duplicate a live instance, state included
     render           — request render commands for a frame
+    render_batch     — render several instances against one audio snapshot
     set_property     — update a property value
+    set_properties   — update several property values at once
     resize           — notify component of size change
     mouse_event      — forward mouse interaction
     destroy          — destroy an instance
@@ -25,8 +31,9 @@ Message types (Host → Python):
 Message types (Python → Host):
     scan_result      — list of PluginInfo
     manifest_list    — JSON manifest list
-    created          — instance created (with property descriptors)
+    created          — instance created or cloned (with property descriptors)
     render_commands  — serialised draw commands
+    render_batch_result — per-instance draw commands for a render_batch
     properties       — property descriptors for panel
     save_data        — serialised state
     error            — error message
@@ -37,6 +44,7 @@ from __future__ import annotations
 
 import json
 import logging
+import re
 import sys
 import traceback
 from typing import Any, Callable, Dict, Optional
@@ -48,6 +56,9 @@ from .shared_memory import AudioSharedMemoryReader
 
 logger = logging.getLogger("maximeter.bridge")
 
+# Request ids are integers; lets a malformed line still get a tagged reply
+_ID_PATTERN = re.compile(r'"id"\s*:\s*(-?\d+)')
+
 
 class BridgeProtocol:
     """JSON-line IPC protocol handler."""
@@ -58,8 +69,11 @@ class BridgeProtocol:
             "scan": self._handle_scan,
             "list": self._handle_list,
             "create": self._handle_create,
+            "clone_instance": self._handle_clone_instance,
             "render": self._handle_render,
+            "render_batch": self._handle_render_batch,
             "set_property": self._handle_set_property,
+            "set_properties": self._handle_set_properties,
             "resize": self._handle_resize,
             "mouse_event": self._handle_mouse_event,
             "destroy": self._handle_destroy,
@@ -73,6 +87,8 @@ class BridgeProtocol:
         # Shared memory reader for zero-copy audio transport
         self._shm_reader = AudioSharedMemoryReader()
         self._shm_available = False
+        # Embedded mode: hand plugins memoryviews over the mapping, not lists
+        self._shm_zero_copy = False
 
         # Per-instance error tracking for error overlay
         self._instance_errors: Dict[str, str] = {}  # instance_id → last error message
@@ -91,12 +107,14 @@ class BridgeProtocol:
             logger.info("SharedMemory not available, using JSON audio transport (fallback)")
 
         while self._running:
+            msg_id = None
             try:
                 line = sys.stdin.readline()
                 if not line:
                     break  # EOF — host closed pipe
 
                 msg = json.loads(line.strip())
+                msg_id = msg.get("id")
                 msg_type = msg.get("type", "")
 
                 handler = self._handlers.get(msg_type)
@@ -106,18 +124,22 @@ class BridgeProtocol:
                     response = {"type": "error", "message": f"Unknown message type: {msg_type}"}
 
                 if response:
-                    self._send(response)
+                    self._send(response, msg_id)
 
             except json.JSONDecodeError as e:
-                self._send({"type": "error", "message": f"Invalid JSON: {e}"})
+                match = _ID_PATTERN.search(line)
+                self._send({"type": "error", "message": f"Invalid JSON: {e}"},
+                           int(match.group(1)) if match else None)
             except Exception as e:
                 logger.exception("Bridge error")
-                self._send({"type": "error", "message": str(e)})
+                self._send({"type": "error", "message": str(e)}, msg_id)
 
         logger.info("Bridge protocol stopped")
 
-    def _send(self, msg: Dict[str, Any]):
-        """Write a JSON message to stdout."""
+    def _send(self, msg: Dict[str, Any], msg_id: Any = None):
+        """Write a JSON message to stdout, tagged with the request's id."""
+        if msg_id is not None:
+            msg = dict(msg, id=msg_id)
         try:
             line = json.dumps(msg, default=str)
             sys.stdout.write(line + "\n")
@@ -164,29 +186,22 @@ class BridgeProtocol:
         if instance is None:
              return {"type": "error", "message": f"Unknown error creating '{manifest_id}'"}
 
-        # Return property descriptors so the host can build the property panel
-        props = instance.get_properties()
-        return {
-            "type": "created",
-            "instance_id": instance_id,
-            "manifest_id": manifest_id,
-            "properties": [
-                {
-                    "key": p.key,
-                    "label": p.label,
-                    "type": p.type.name,
-                    "default": _serialise_value(p.default),
-                    "group": p.group,
-                    "min": p.min_value,
-                    "max": p.max_value,
-                    "step": p.step,
-                    "choices": p.choices,
-                    "description": p.description,
-                }
-                for p in props
-            ],
-            "images": instance.get_images(),
-        }
+        return _created_response(instance_id, manifest_id, instance)
+
+    def _handle_clone_instance(self, msg: Dict) -> Dict:
+        source_id = msg.get("source_id", "")
+        instance_id = msg.get("instance_id")
+        values = msg.get("values") or {}
+
+        try:
+            instance = self.registry.clone(source_id, instance_id)
+        except Exception as e:
+            return {"type": "error", "message": str(e)}
+
+        for key, value in values.items():
+            instance.set_property(key, value)
+
+        return _created_response(instance_id, instance.get_manifest().id, instance)
 
     def _handle_render(self, msg: Dict) -> Dict:
         instance_id = msg.get("instance_id", "")
@@ -197,20 +212,57 @@ class BridgeProtocol:
         if instance is None:
             return {"type": "error", "message": f"Instance not found: {instance_id}"}
 
-        # Build AudioData — prefer shared memory, fall back to JSON.
-        # Offline instances (video export) must always use JSON audio because
-        # SHM contains live playback data, not the exported file's audio.
         use_json = msg.get("use_json_audio", False) or instance_id.startswith("offline_")
-
+        audio = self._read_audio(use_json, msg.get("audio", {}))
+
+        result = self._render_instance(instance, instance_id, width, height, audio)
+        result["type"] = "render_commands"
+        return result
+
+    def _handle_render_batch(self, msg: Dict) -> Dict:
+        """Render every entry of one frame against a single audio snapshot.
+
+        The snapshot is built at most once per transport (SHM / JSON) rather
+        than once per instance, and all results return in one response.
+        """
+        force_json = msg.get("use_json_audio", False)
+        shared = msg.get("audio", {})
+        audio_cache: Dict[bool, AudioData] = {}
+
+        results = []
+        for entry in msg.get("entries", []):
+            instance_id = entry.get("instance_id", "")
+            instance = self.registry.get_instance(instance_id)
+            if instance is None:
+                results.append({"instance_id": instance_id, "commands": [],
+                                "error": f"Instance not found: {instance_id}"})
+                continue
+
+            use_json = force_json or instance_id.startswith("offline_")
+            if use_json not in audio_cache:
+                audio_cache[use_json] = self._read_audio(use_json, shared)
+
+            results.append(self._render_instance(
+                instance, instance_id,
+                entry.get("width", 300), entry.get("height", 200),
+                audio_cache[use_json]))
+
+        return {"type": "render_batch_result", "results": results}
+
+    def _read_audio(self, use_json: bool, audio_json: Dict) -> AudioData:
+        """Build AudioData — prefer shared memory, fall back to JSON.
+
+        Offline instances (video export) must always use JSON audio because
+        SHM contains live playback data, not the exported file's audio.
+        """
         if not use_json and self._shm_available and self._shm_reader.is_open:
-            shm_data = self._shm_reader.read_raw()
+            shm_data = self._shm_reader.read_raw(zero_copy=self._shm_zero_copy)
             if shm_data is not None:
-                audio = _build_audio_data(shm_data)
-            else:
-                audio = _build_audio_data(msg.get("audio", {}))
-        else:
-            audio = _build_audio_data(msg.get("audio", {}))
+                return _build_audio_data(shm_data)
+        return _build_audio_data(audio_json)
 
+    def _render_instance(self, instance, instance_id: str,
+                         width: int, height: int, audio: AudioData) -> Dict:
         # Create render context and execute
         ctx = RenderContext(width, height)
         try:
@@ -228,7 +280,6 @@ class BridgeProtocol:
             _render_error_overlay(ctx, width, height, str(e))
 
         return {
-            "type": "render_commands",
             "instance_id": instance_id,
             "commands": ctx._get_commands(),
             "has_error": instance_id in self._instance_errors,
@@ -246,6 +297,18 @@ class BridgeProtocol:
         instance.set_property(key, value)
         return {"type": "ok"}
 
+    def _handle_set_properties(self, msg: Dict) -> Dict:
+        instance_id = msg.get("instance_id", "")
+        values = msg.get("values") or {}
+
+        instance = self.registry.get_instance(instance_id)
+        if instance is None:
+            return {"type": "error", "message": f"Instance not found: {instance_id}"}
+
+        for key, value in values.items():
+            instance.set_property(key, value)
+        return {"type": "ok"}
+
     def _handle_resize(self, msg: Dict) -> Dict:
         instance_id = msg.get("instance_id", "")
         width = msg.get("width", 0)
@@ -310,6 +373,31 @@ class BridgeProtocol:
 
 # ── Helpers ─────────────────────────────────────────────────────────────────
 
+def _created_response(instance_id: str, manifest_id: str, instance) -> Dict:
+    """The ``created`` reply: property descriptors for the host's property panel."""
+    return {
+        "type": "created",
+        "instance_id": instance_id,
+        "manifest_id": manifest_id,
+        "properties": [
+            {
+                "key": p.key,
+                "label": p.label,
+                "type": p.type.name,
+                "default": _serialise_value(p.default),
+                "group": p.group,
+                "min": p.min_value,
+                "max": p.max_value,
+                "step": p.step,
+                "choices": p.choices,
+                "description": p.description,
+            }
+            for p in instance.get_properties()
+        ],
+        "images": instance.get_images(),
+    }
+
+
 def _build_audio_data(d: Dict) -> AudioData:
     """Construct an AudioData from a dict received from the C++ host."""
     channels = []
@@ -343,6 +431,16 @@ def _build_audio_data(d: Dict) -> AudioData:
         loudness_range=d.get("loudness_range", 0.0),
         bpm=d.get("bpm", 0.0),
         beat_phase=d.get("beat_phase", 0.0),
+        spectral_centroid=d.get("spectral_centroid", 0.0),
+        spectral_flux=d.get("spectral_flux", 0.0),
+        spectral_rolloff=d.get("spectral_rolloff", 0.0),
+        spectral_flatness=d.get("spectral_flatness", 0.0),
+        chroma=d.get("chroma") or [0.0] * 12,
+        mfcc=d.get("mfcc") or [0.0] * 13,
+        pitch_hz=d.get("pitch_hz", 0.0),
+        pitch_confidence=d.get("pitch_confidence", 0.0),
+        history=d.get("history") or {},
+        history_window=d.get("history_window", 0.0),
     )
 
 
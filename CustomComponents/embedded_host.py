@@ -0,0 +1,92 @@
+"""
+Embedded host — in-process entry point used when MaxiMeter embeds CPython.
+
+Instead of spawning ``bridge_runner.py`` and talking JSON over pipes, a host
+built with embedded Python imports this module and calls ``EmbeddedHost``
+methods directly from its interpreter worker thread.  Messages are plain dicts (the same
+shape as the pipe protocol), so every handler in ``BridgeProtocol`` is reused
+unchanged — only the transport is gone.
+
+Only plugins whose manifest sets ``embedded=True`` are served here; all
+others stay in the isolated subprocess.
+
+Audio arrives through the host's shared-memory mapping, which lives in the
+same process, so spectrum and waveform are exposed as zero-copy
+``memoryview`` objects rather than lists.
+"""
+
+from __future__ import annotations
+
+import logging
+from typing import Any, Dict, List, Optional
+
+from .bridge import BridgeProtocol
+from .registry import ComponentRegistry
+
+logger = logging.getLogger("maximeter.embedded")
+
+
+class EmbeddedHost:
+    """Direct-call facade over ``BridgeProtocol`` for the embedded runtime."""
+
+    def __init__(self, plugins_dir: str):
+        self.registry = ComponentRegistry(plugins_dir)
+        self.protocol = BridgeProtocol(self.registry)
+        # The host makes every call from one worker thread, so the registry
+        # (not thread-safe) needs no lock of its own.
+
+        self.protocol._shm_available = self.protocol._shm_reader.open()
+        self.protocol._shm_zero_copy = True
+        if not self.protocol._shm_available:
+            logger.info("Embedded host: shared memory not yet available, JSON audio only")
+
+    # ── Discovery ───────────────────────────────────────────────────────────
+
+    def scan(self) -> List[Dict[str, Any]]:
+        """Scan plugins and return manifests of those that opted in."""
+        self.registry.scan()
+        return [m for m in self.registry.get_manifest_list() if m.get("embedded")]
+
+    # ── Generic dispatch ────────────────────────────────────────────────────
+
+    def dispatch(self, msg: Dict[str, Any]) -> Optional[Dict[str, Any]]:
+        """Handle one protocol message (same dicts as the pipe protocol)."""
+        handler = self.protocol._handlers.get(msg.get("type", ""))
+        if handler is None:
+            return {"type": "error", "message": f"Unknown message type: {msg.get('type')}"}
+        try:
+            return handler(msg)
+        except Exception as e:
+            logger.exception("Embedded host error")
+            return {"type": "error", "message": str(e)}
+
+    # ── Hot path ────────────────────────────────────────────────────────────
+
+    def wants_audio(self, use_json_audio: bool = False) -> bool:
+        """True if the next render() calls will read the audio dict rather
+        than shared memory — the host only builds the dict then."""
+        if not self.protocol._shm_available and not use_json_audio:
+            # The host creates the mapping lazily; retry until it exists.
+            self.protocol._shm_available = self.protocol._shm_reader.open()
+        return bool(use_json_audio) or not self.protocol._shm_available
+
+    def render(self, instance_id: str, width: int, height: int,
+               audio: Optional[Dict[str, Any]] = None,
+               use_json_audio: bool = False) -> Optional[List[Dict[str, Any]]]:
+        """Render one frame and return the command list (None if the
+        instance does not exist).  ``audio`` is the AudioData dict, passed
+        when wants_audio() asked for it."""
+        msg: Dict[str, Any] = {
+            "type": "render",
+            "instance_id": instance_id,
+            "width": width,
+            "height": height,
+            "use_json_audio": use_json_audio,
+        }
+        if audio is not None:
+            msg["audio"] = audio
+
+        result = self.dispatch(msg) or {}
+        if result.get("type") == "error":
+            return None
+        return result.get("commands", [])
@@ -45,6 +45,17 @@ class Manifest:
         url:           Project / documentation URL (optional).
         requires:      Python package dependencies (e.g. ("numpy", "scipy")).
                        These will be auto-installed if missing.
+        embedded:      Run inside the host's embedded interpreter instead of the
+                       bridge subprocess (no IPC; trusted plugins only — a
+                       crash takes the host down with it).  Ignored when the
+                       host was built without embedded Python.
+        analysis:      Host analyzers the component reads — any of "spectrum",
+                       "levels", "loudness", "stereo", "history", "features"
+                       (spectral / chroma / MFCC / pitch).  Analyzers no
+                       visible item asks for are switched off, so fields fed
+                       by them go stale.  None (default) = everything.
+        fft_size:      Preferred FFT size (1024–8192) when reading the
+                       spectrum; 0 = host default.
     """
 
     id: str
@@ -60,6 +71,9 @@ class Manifest:
     tags: Tuple[str, ...] = ()
     url: str = ""
     requires: Tuple[str, ...] = ()
+    embedded: bool = False
+    analysis: Optional[Tuple[str, ...]] = None
+    fft_size: int = 0
 
     def __post_init__(self):
         if not self.id or not self.name:
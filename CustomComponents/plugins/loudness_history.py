@@ -55,8 +55,14 @@ class LoudnessHistory(BaseComponent):
                      default=Color(0x0E, 0x0E, 0x18), group="Colour"),
         ]
 
+    # Minimum spacing between stored samples, in seconds of audio
+    _SAMPLE_PERIOD = 0.05
+
     def on_init(self):
-        self._history: deque[float] = deque(maxlen=1800)  # 30s * 60fps
+        # (position_seconds, lufs) pairs — keyed by audio time, not frame
+        # count, so the graph spans the same time at any frame rate and
+        # during offline export.
+        self._history: deque[tuple[float, float]] = deque()
 
     def on_render(self, ctx: RenderContext, audio: AudioData):
         mode = self.get_property("mode", "momentary")
@@ -67,15 +73,15 @@ class LoudnessHistory(BaseComponent):
         bg = self.get_property("bg_color", Color(0x0E, 0x0E, 0x18))
         hist_sec = self.get_property("history_seconds", 30.0)
 
-        # Update max history length
-        max_len = int(hist_sec * 60)
-        if self._history.maxlen != max_len:
-            old = list(self._history)
-            self._history = deque(old[-max_len:], maxlen=max_len)
-
-        # Sample current loudness
+        # Sample current loudness against playback time
+        now = audio.position_seconds
         lufs = audio.lufs_momentary if mode == "momentary" else audio.lufs_short_term
-        self._history.append(lufs)
+        if self._history and now < self._history[-1][0]:
+            self._history.clear()                       # seek backwards
+        if not self._history or now - self._history[-1][0] >= self._SAMPLE_PERIOD:
+            self._history.append((now, lufs))
+        while self._history and self._history[0][0] < now - hist_sec:
+            self._history.popleft()
 
         ctx.clear(bg)
         w, h = ctx.width, ctx.height
@@ -113,11 +119,10 @@ class LoudnessHistory(BaseComponent):
                       target_col, Font(size=9.0, bold=True), TextAlign.RIGHT)
 
         # Data line
-        n = len(self._history)
-        if n > 1:
+        if len(self._history) > 1:
             points = []
-            for i, val in enumerate(self._history):
-                px = gx + gw * (i / (n - 1))
+            for t, val in self._history:
+                px = gx + gw * (1.0 - (now - t) / hist_sec)
                 py = db_to_y(val)
                 points.append((px, py))
 
@@ -126,7 +131,7 @@ class LoudnessHistory(BaseComponent):
             ctx.reset_clip()
 
         # Current value label
-        current = self._history[-1] if self._history else -100.0
+        current = lufs
         label = f"{current:.1f} LUFS" if current > -100 else "--- LUFS"
         ctx.draw_text(label, gx + 6, gy + 4, gw, 14,
                       line_col, Font(size=11.0, bold=True))
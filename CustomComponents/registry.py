@@ -195,6 +195,9 @@ class ComponentRegistry:
                 "tags": list(m.tags),
                 "icon": m.icon,
                 "source_file": Path(plugin.module_path).stem,
+                "embedded": m.embedded,
+                "analysis": list(m.analysis) if m.analysis is not None else None,
+                "fft_size": m.fft_size,
             })
         return result
 
@@ -256,6 +259,35 @@ class ComponentRegistry:
                          manifest_id, traceback.format_exc())
             raise RuntimeError(f"Error initializing '{manifest_id}': {e}")
 
+    def clone(self, source_id: str, instance_id: Optional[str] = None) -> BaseComponent:
+        """Duplicate a live instance, internal state included, under a new id.
+
+        Used by the exporter so offline copies start from what is on screen
+        (histories, particle systems, ...) instead of a fresh ``on_init``.
+        """
+        source = self._instances.get(source_id)
+        if source is None:
+            raise ValueError(f"Instance not found: {source_id}")
+
+        try:
+            instance = source.clone()
+        except Exception:
+            # Unpicklable state (open handles, native objects): a fresh
+            # instance with the source's saved properties and state instead
+            logger.warning("Deep copy of %s failed, re-creating it:\n%s",
+                           source_id, traceback.format_exc())
+            instance = self.create(source.get_manifest().id, instance_id)
+            instance.deserialise(source.serialise())
+            return instance
+
+        if instance_id is None:
+            import uuid
+            instance_id = str(uuid.uuid4())
+        self._instances[instance_id] = instance
+
+        logger.info("Cloned instance %s as %s", source_id, instance_id)
+        return instance
+
     def get_instance(self, instance_id: str) -> Optional[BaseComponent]:
         """Retrieve a live instance by its id."""
         return self._instances.get(instance_id)
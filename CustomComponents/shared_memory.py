@@ -11,7 +11,7 @@ Layout of the shared memory region::
     Offset  Size        Description
     ──────  ──────────  ─────────────────────────────────────
     0       4 bytes     Magic number (0x4D584D41 = "MXMA")
-    4       4 bytes     Version (uint32, currently 1)
+    4       4 bytes     Version (uint32, currently 3)
     8       4 bytes     Frame counter (uint32, incremented by host each frame)
     12      4 bytes     Total buffer size in bytes (uint32)
     16      4 bytes     sample_rate (float32)
@@ -35,9 +35,28 @@ Layout of the shared memory region::
     236     N×4 bytes   spectrum_linear[] (float32 array, length = fft_size/2+1)
     ── Waveform data ──
     236+N×4 M×4 bytes   waveform[] (float32 array, length = waveform_size)
+    ── Feature block (version 2+) ──
+    F       4 bytes     block size in bytes (uint32, currently 128)
+    F+4     24 bytes    spectral_centroid, spectral_flux, spectral_rolloff,
+                        spectral_flatness, pitch_hz, pitch_confidence (6 × float32)
+    F+28    48 bytes    chroma[12] (float32)
+    F+76    52 bytes    mfcc[13] (float32)
+
+    where F = 236 + N×4 + M×4.  Version-1 hosts write no feature block.
+    ── History block (version 3+) ──
+    H       4 bytes     block size in bytes (uint32)
+    H+4     4 bytes     metric count K (uint32, currently 7)
+    H+8     4 bytes     bucket capacity P per metric (uint32, currently 256)
+    H+12    4 bytes     buckets valid (uint32, ≤ P, fewer until history fills)
+    H+16    4 bytes     window seconds (float32, currently 30)
+    H+20    K×P×12      {min, max, mean} float32 triples per bucket, metric-
+                        major in HISTORY_METRICS order, oldest bucket first
+
+    where H = F + 128.  This is the host's MetricHistory store, so plugins
+    get long, rate-independent history without keeping their own.
 
     Total typical size (FFT 4096, waveform 1024):
-        236 + 2049×4 + 1024×4 = 236 + 8196 + 4096 = 12,528 bytes ≈ 12 KB
+        236 + 2049×4 + 1024×4 + 128 + 20 + 7×256×12 = 34,180 bytes ≈ 33 KB
 
 Performance:
     - JSON IPC: ~500 µs per frame (serialize + deserialize + pipe I/O)
@@ -61,12 +80,20 @@ logger = logging.getLogger("maximeter.shared_memory")
 
 # Constants
 SHM_MAGIC = 0x4D584D41  # "MXMA"
-SHM_VERSION = 1
+SHM_VERSION = 3
 SHM_HEADER_SIZE = 236    # bytes before spectrum data
 SHM_MAX_CHANNELS = 8
 SHM_CHANNEL_STRIDE = 20  # 5 × float32 per channel
 SHM_CHANNELS_OFFSET = 76
 SHM_SPECTRUM_OFFSET = SHM_CHANNELS_OFFSET + SHM_MAX_CHANNELS * SHM_CHANNEL_STRIDE  # 236
+SHM_CHROMA_BINS = 12
+SHM_NUM_MFCC = 13
+SHM_FEATURE_BLOCK_SIZE = 4 + (6 + SHM_CHROMA_BINS + SHM_NUM_MFCC) * 4  # 128
+SHM_HISTORY_HEADER_SIZE = 20
+
+# MetricHistory::Metric order on the C++ side
+HISTORY_METRICS = ("peak_left", "peak_right", "rms_left", "rms_right",
+                   "lufs_momentary", "lufs_short_term", "correlation")
 
 # Default shared memory name (must match C++ side)
 SHM_NAME = "MaxiMeter_AudioSHM"
@@ -88,6 +115,8 @@ class AudioSharedMemoryReader:
         self._mmap: Optional[mmap.mmap] = None
         self._file_handle = None
         self._last_frame: int = 0
+        self._view: Optional[memoryview] = None
+        self._version: int = 0
 
     def open(self) -> bool:
         """Open the shared memory region. Returns True on success."""
@@ -114,9 +143,10 @@ class AudioSharedMemoryReader:
                 return False
 
             version = struct.unpack_from("<I", self._mmap, 4)[0]
-            if version != SHM_VERSION:
-                logger.warning("Shared memory version mismatch: %d (expected %d)",
+            if version > SHM_VERSION:
+                logger.warning("Shared memory version %d is newer than this reader (%d)",
                                version, SHM_VERSION)
+            self._version = version
 
             logger.info("Shared memory opened: %s (%d bytes)", self._name,
                         struct.unpack_from("<I", self._mmap, 12)[0])
@@ -129,6 +159,12 @@ class AudioSharedMemoryReader:
 
     def close(self):
         """Close the shared memory region."""
+        if self._view is not None:
+            try:
+                self._view.release()
+            except Exception:
+                pass
+            self._view = None
         if self._mmap is not None:
             try:
                 self._mmap.close()
@@ -153,10 +189,16 @@ class AudioSharedMemoryReader:
         frame = struct.unpack_from("<I", self._mmap, 8)[0]
         return frame != self._last_frame
 
-    def read_raw(self) -> Optional[dict]:
+    def read_raw(self, zero_copy: bool = False) -> Optional[dict]:
         """Read current audio data from shared memory into a dict
         compatible with ``_build_audio_data()`` in bridge.py.
 
+        With *zero_copy* the linear spectrum and waveform are returned as
+        ``memoryview`` objects cast to float32 over the mapped region instead
+        of lists.  Only used by the embedded runtime, where the mapping lives
+        in the host process; the views see the next frame's data once the
+        host writes it, so copy them if history is needed.
+
         Returns None if shared memory is not open or data is invalid.
         """
         if self._mmap is None:
@@ -203,7 +245,10 @@ class AudioSharedMemoryReader:
             # Spectrum data (float32 array)
             spectrum_count = fft_size // 2 + 1
             spectrum_offset = SHM_SPECTRUM_OFFSET
-            spectrum_linear = list(struct.unpack_from(f"<{spectrum_count}f", buf, spectrum_offset))
+            if zero_copy:
+                spectrum_linear = self._float_view(spectrum_offset, spectrum_count)
+            else:
+                spectrum_linear = list(struct.unpack_from(f"<{spectrum_count}f", buf, spectrum_offset))
 
             # Convert linear to dB for spectrum
             import math
@@ -216,9 +261,12 @@ class AudioSharedMemoryReader:
 
             # Waveform data
             waveform_offset = spectrum_offset + spectrum_count * 4
-            waveform = list(struct.unpack_from(f"<{waveform_size}f", buf, waveform_offset))
+            if zero_copy:
+                waveform = self._float_view(waveform_offset, waveform_size)
+            else:
+                waveform = list(struct.unpack_from(f"<{waveform_size}f", buf, waveform_offset))
 
-            return {
+            result = {
                 "sample_rate": sample_rate,
                 "num_channels": num_channels,
                 "is_playing": is_playing,
@@ -239,14 +287,69 @@ class AudioSharedMemoryReader:
                 "beat_phase": beat_phase,
             }
 
+            # Feature block (version 2+)
+            feature_offset = waveform_offset + waveform_size * 4
+            if self._version >= 2 and feature_offset + SHM_FEATURE_BLOCK_SIZE <= len(buf):
+                block_size = struct.unpack_from("<I", buf, feature_offset)[0]
+                if block_size >= SHM_FEATURE_BLOCK_SIZE:
+                    result.update(_unpack_features(buf, feature_offset + 4))
+
+            # History block (version 3+)
+            history_offset = feature_offset + SHM_FEATURE_BLOCK_SIZE
+            if self._version >= 3 and history_offset + SHM_HISTORY_HEADER_SIZE <= len(buf):
+                result.update(_unpack_history(buf, history_offset))
+
+            return result
+
         except Exception as e:
             logger.error("Error reading shared memory: %s", e)
             return None
 
+    def _float_view(self, offset: int, count: int) -> memoryview:
+        """Read-only float32 view over part of the mapping (no copy)."""
+        if self._view is None:
+            self._view = memoryview(self._mmap).toreadonly()
+        return self._view[offset:offset + count * 4].cast("f")
+
     def __del__(self):
         self.close()
 
 
+def _unpack_features(buf, offset: int) -> dict:
+    """Decode the version-2 feature block starting after its size field."""
+    centroid, flux, rolloff, flatness, pitch, confidence = struct.unpack_from("<6f", buf, offset)
+    offset += 24
+    chroma = list(struct.unpack_from(f"<{SHM_CHROMA_BINS}f", buf, offset))
+    offset += SHM_CHROMA_BINS * 4
+    mfcc = list(struct.unpack_from(f"<{SHM_NUM_MFCC}f", buf, offset))
+    return {
+        "spectral_centroid": centroid,
+        "spectral_flux": flux,
+        "spectral_rolloff": rolloff,
+        "spectral_flatness": flatness,
+        "chroma": chroma,
+        "mfcc": mfcc,
+        "pitch_hz": pitch,
+        "pitch_confidence": confidence,
+    }
+
+
+def _unpack_history(buf, offset: int) -> dict:
+    """Decode the version-3 history block starting at its size field."""
+    block_size, metrics, capacity, valid = struct.unpack_from("<4I", buf, offset)
+    window = struct.unpack_from("<f", buf, offset + 16)[0]
+    if block_size < SHM_HISTORY_HEADER_SIZE + metrics * capacity * 12 or offset + block_size > len(buf):
+        return {}
+
+    valid = min(valid, capacity)
+    history = {}
+    for m, name in enumerate(HISTORY_METRICS[:metrics]):
+        values = struct.unpack_from(f"<{valid * 3}f", buf,
+                                    offset + SHM_HISTORY_HEADER_SIZE + m * capacity * 12)
+        history[name] = [tuple(values[i:i + 3]) for i in range(0, len(values), 3)]
+    return {"history": history, "history_window": window}
+
+
 # ── C++ Host-side reference (for documentation) ────────────────────────────
 #
 #  The C++ host should create the shared memory region like this:
@@ -263,7 +366,7 @@ class AudioSharedMemoryReader:
 #  // Write header
 #  auto* header = reinterpret_cast<uint32_t*>(pBuf);
 #  header[0] = 0x4D584D41;  // Magic
-#  header[1] = 1;           // Version
+#  header[1] = 3;           // Version
 #  header[2] = frameCounter++;
 #  header[3] = bufferSize;
 #  // ... write float fields and arrays ...
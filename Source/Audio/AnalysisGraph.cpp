@@ -0,0 +1,103 @@
+#include "AnalysisGraph.h"
+#include "FFTProcessor.h"
+#include <cmath>
+
+//==============================================================================
+namespace Analysis
+{
+    Requirements parseManifestRequirements(const juce::var& analysisList, const juce::var& fftSize)
+    {
+        Requirements r;
+
+        if (auto* list = analysisList.getArray())
+        {
+            for (auto& v : *list)
+            {
+                auto name = v.toString().trim().toLowerCase();
+                if      (name == "spectrum") r.needs |= Spectrum;
+                else if (name == "levels")   r.needs |= Levels;
+                else if (name == "loudness") r.needs |= Loudness;
+                else if (name == "stereo")   r.needs |= Stereo;
+                else if (name == "history")  r.needs |= History;
+                else if (name == "features") r.needs |= Features | Spectrum;
+                else if (name == "all")      r.needs |= All;
+            }
+        }
+        else
+        {
+            r.needs = All;   // legacy manifest — may read any field
+        }
+
+        const int size = static_cast<int>(fftSize);
+        if (size > 0)
+        {
+            r.needs   |= Spectrum;
+            r.fftOrder = juce::jlimit(10, 13, juce::roundToInt(std::log2(static_cast<double>(size))));
+        }
+        return r;
+    }
+}
+
+//==============================================================================
+void AnalysisGraph::setRequirements(const Analysis::Requirements& r)
+{
+    canvas = r;
+    apply();
+}
+
+void AnalysisGraph::setBaseRequirements(const Analysis::Requirements& r)
+{
+    base = r;
+    apply();
+}
+
+Analysis::Requirements AnalysisGraph::getRequirements() const
+{
+    return { active.load(std::memory_order_relaxed),
+             fftOrder.load(std::memory_order_relaxed),
+             bandsPerOctave.load(std::memory_order_relaxed) };
+}
+
+void AnalysisGraph::apply()
+{
+    auto combined = canvas;
+    combined |= base;
+
+    const auto previous = active.exchange(combined.needs, std::memory_order_acq_rel);
+    if (const auto turnedOn = combined.needs & ~previous)
+        activated.fetch_or(turnedOn, std::memory_order_acq_rel);
+
+    fftOrder.store(combined.fftOrder, std::memory_order_relaxed);
+    bandsPerOctave.store(combined.bandsPerOctave, std::memory_order_relaxed);
+}
+
+int AnalysisGraph::getFFTOrder() const
+{
+    const int order = fftOrder.load(std::memory_order_relaxed);
+    return order > 0 ? order : FFTProcessor::kDefaultFFTOrder;
+}
+
+int AnalysisGraph::getBandsPerOctave() const
+{
+    const int bands = bandsPerOctave.load(std::memory_order_relaxed);
+    return bands > 0 ? bands : 3;
+}
+
+juce::String AnalysisGraph::describe(const Analysis::Requirements& r)
+{
+    juce::StringArray parts;
+    if (r.has(Analysis::Spectrum)) parts.add("spectrum");
+    if (r.has(Analysis::Levels))   parts.add("levels");
+    if (r.has(Analysis::Loudness)) parts.add("loudness");
+    if (r.has(Analysis::Stereo))   parts.add("stereo");
+    if (r.has(Analysis::History))  parts.add("history");
+    if (r.has(Analysis::Bands))    parts.add("bands");
+    if (r.has(Analysis::Features)) parts.add("features");
+
+    auto s = parts.isEmpty() ? juce::String("none") : parts.joinIntoString(" ");
+    if (r.has(Analysis::Spectrum))
+        s << " (fft " << (1 << (r.fftOrder > 0 ? r.fftOrder : FFTProcessor::kDefaultFFTOrder)) << ")";
+    if (r.has(Analysis::Bands))
+        s << " (1/" << (r.bandsPerOctave > 0 ? r.bandsPerOctave : 3) << " oct)";
+    return s;
+}
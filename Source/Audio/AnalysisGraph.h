@@ -0,0 +1,113 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <cstdint>
+
+//==============================================================================
+namespace Analysis
+{
+    /// One bit per analysis stage fed from the audio callback.
+    enum Need : uint32_t
+    {
+        None     = 0,
+        Spectrum = 1u << 0,     ///< FFTProcessor
+        Levels   = 1u << 1,     ///< LevelAnalyzer
+        Loudness = 1u << 2,     ///< LoudnessAnalyzer (K-weighting, gating, LRA)
+        Stereo   = 1u << 3,     ///< StereoFieldAnalyzer
+        History  = 1u << 4,     ///< MetricHistory
+        Features = 1u << 6,     ///< FeatureExtractor (runs on the FFT frames)
+        All      = Spectrum | Levels | Loudness | Stereo | History | Features,
+
+        /// OctaveBandAnalyzer.  Not part of All: only meters that select the
+        /// filter bank read it, plugins never do.
+        Bands    = 1u << 5
+    };
+
+    /// What a meter type or plugin reads.  fftOrder = 0 means "no preference"
+    /// (the FFTProcessor default); bandsPerOctave likewise (third octaves).
+    struct Requirements
+    {
+        uint32_t needs    = None;
+        int      fftOrder = 0;
+        int      bandsPerOctave = 0;
+
+        bool has(Need n) const { return (needs & n) != 0; }
+
+        Requirements& operator|=(const Requirements& other)
+        {
+            needs   |= other.needs;
+            fftOrder = juce::jmax(fftOrder, other.fftOrder);
+            bandsPerOctave = juce::jmax(bandsPerOctave, other.bandsPerOctave);
+            return *this;
+        }
+
+        bool operator==(const Requirements& o) const
+        {
+            return needs == o.needs && fftOrder == o.fftOrder && bandsPerOctave == o.bandsPerOctave;
+        }
+        bool operator!=(const Requirements& o) const { return !(*this == o); }
+    };
+
+    /// Parse a plugin manifest's "analysis" list (e.g. ["spectrum", "loudness"])
+    /// and "fft_size".  A missing list means the plugin may read anything.
+    Requirements parseManifestRequirements(const juce::var& analysisList, const juce::var& fftSize);
+}
+
+//==============================================================================
+/// AnalysisGraph — the set of analyzers the current canvas actually reads.
+///
+/// The canvas folds the Requirements of its visible items together and
+/// installs them with `setRequirements()`; the audio callback asks
+/// `isActive()` before running each analyzer, so a layout with a single VU
+/// meter never pays for K-weighting or the goniometer rings.
+///
+/// Analyzers that come back on are reset (see `takeActivated()`), so they
+/// never show state from before they were switched off.
+class AnalysisGraph
+{
+public:
+    AnalysisGraph() = default;
+
+    /// Message thread.  Installs the union of @p r and the base requirements.
+    void setRequirements(const Analysis::Requirements& r);
+    Analysis::Requirements getRequirements() const;
+
+    /// Stages that are always on, whatever the canvas holds (e.g. the status
+    /// bar's level readout).
+    void setBaseRequirements(const Analysis::Requirements& r);
+
+    /// Audio thread — one relaxed load.
+    bool isActive(Analysis::Need n) const noexcept
+    {
+        return (active.load(std::memory_order_relaxed) & n) != 0;
+    }
+
+    /// Audio thread: stages switched on since the previous call.  The caller
+    /// resets them, or asks the thread that owns their state to.
+    uint32_t takeActivated() noexcept
+    {
+        return activated.exchange(0, std::memory_order_acq_rel);
+    }
+
+    /// FFT order the visible items need (FFTProcessor default when none asks).
+    int getFFTOrder() const;
+
+    /// Finest filter-bank resolution the visible items need (3 when none asks).
+    int getBandsPerOctave() const;
+
+    /// Short description for the debug log, e.g. "spectrum levels (fft 2048)".
+    static juce::String describe(const Analysis::Requirements& r);
+
+private:
+    void apply();
+
+    Analysis::Requirements canvas { Analysis::All, 0 };
+    Analysis::Requirements base;
+    std::atomic<uint32_t>  active    { Analysis::All };
+    std::atomic<uint32_t>  activated { 0 };
+    std::atomic<int>       fftOrder  { 0 };
+    std::atomic<int>       bandsPerOctave { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisGraph)
+};
@@ -0,0 +1,126 @@
+#include "AnalyzerSet.h"
+
+//==============================================================================
+void AnalyzerSet::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    fft.getFeatureExtractor().setSampleRate(newSampleRate);
+    bands.setSampleRate(newSampleRate);
+    levels.setSampleRate(newSampleRate);
+    loudness.setSampleRate(newSampleRate);
+    stereo.setSampleRate(newSampleRate);
+    history.setSampleRate(newSampleRate);
+    reset();
+}
+
+void AnalyzerSet::reset()
+{
+    fft.reset();
+    bands.reset();
+    levels.reset();
+    loudness.reset();
+    stereo.reset();
+    history.reset();
+
+    const juce::SpinLock::ScopedLockType lock(snapshotLock);
+    snapshotCount = 0;
+    spectrumCount = 0;
+}
+
+//==============================================================================
+void AnalyzerSet::process(const float* left, const float* right, int numSamples)
+{
+    if (numSamples <= 0)
+        return;
+
+    using Analysis::Need;
+
+    // Stages switched back on start from a clean state
+    if (const auto activated = graph.takeActivated())
+    {
+        if (activated & Analysis::Spectrum) fft.reset();
+        if (activated & Analysis::Bands)    bands.reset();
+        if (activated & Analysis::Levels)   levels.reset();
+        if (activated & Analysis::Loudness) loudness.reset();
+        if (activated & Analysis::Stereo)   stereo.reset();
+        if (activated & Analysis::History)  history.reset();
+    }
+
+    // Mono snapshot (last kSnapshotSize samples of the block)
+    {
+        const int count = juce::jmin(numSamples, kSnapshotSize);
+        const int start = numSamples - count;
+        const juce::SpinLock::ScopedLockType lock(snapshotLock);
+        for (int i = 0; i < count; ++i)
+            snapshot[static_cast<size_t>(i)] = (left[start + i] + right[start + i]) * 0.5f;
+        snapshotCount = count;
+    }
+
+    if (graph.isActive(Need::Spectrum))
+    {
+        if (graph.getFFTOrder() != fft.getFFTOrder())
+            fft.setFFTOrder(graph.getFFTOrder());
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float mono = (left[i] + right[i]) * 0.5f;
+            fft.pushSamples(&mono, 1);
+        }
+
+        // This thread is the only one touching the FFT, so it also turns
+        // the buffered frames into spectra (the GUI does this for the mix).
+        fft.setFeaturesEnabled(graph.isActive(Need::Features));
+        bool newFrame = false;
+        while (fft.processNextBlock())
+            newFrame = true;
+
+        // Publish a copy for the meters; the FFT buffers stay ours
+        if (newFrame)
+        {
+            const int bins = fft.getSpectrumSize();
+            const juce::SpinLock::ScopedLockType lock(snapshotLock);
+            std::copy(fft.getSpectrumData(), fft.getSpectrumData() + bins, spectrumSnapshot.begin());
+            spectrumCount = bins;
+        }
+    }
+
+    if (graph.isActive(Need::Bands))
+    {
+        bands.setBandsPerOctave(graph.getBandsPerOctave());
+        bands.processSamples(left, right, numSamples);
+    }
+
+    if (graph.isActive(Need::Levels))
+        levels.processSamples(left, right, numSamples);
+
+    if (graph.isActive(Need::Loudness))
+        loudness.processSamples(left, right, numSamples);
+
+    if (graph.isActive(Need::Stereo))
+        stereo.processSamples(left, right, numSamples);
+
+    if (graph.isActive(Need::History))
+        history.processSamples(left, right, numSamples,
+                               loudness.getMomentaryLUFS(),
+                               loudness.getShortTermLUFS(),
+                               stereo.getCorrelation());
+}
+
+int AnalyzerSet::getLatestMonoSamples(float* dest, int maxSamples) const
+{
+    if (dest == nullptr || maxSamples <= 0) return 0;
+    const juce::SpinLock::ScopedLockType lock(snapshotLock);
+    const int count = juce::jmin(snapshotCount, maxSamples);
+    for (int i = 0; i < count; ++i)
+        dest[i] = snapshot[static_cast<size_t>(i)];
+    return count;
+}
+
+int AnalyzerSet::getLatestSpectrum(float* dest, int maxBins) const
+{
+    if (dest == nullptr || maxBins <= 0) return 0;
+    const juce::SpinLock::ScopedLockType lock(snapshotLock);
+    const int count = juce::jmin(spectrumCount, maxBins);
+    std::copy(spectrumSnapshot.begin(), spectrumSnapshot.begin() + count, dest);
+    return count;
+}
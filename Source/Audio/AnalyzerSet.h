@@ -0,0 +1,67 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "FFTProcessor.h"
+#include "LevelAnalyzer.h"
+#include "LoudnessAnalyzer.h"
+#include "StereoFieldAnalyzer.h"
+#include "MetricHistory.h"
+#include "OctaveBandAnalyzer.h"
+#include "AnalysisGraph.h"
+#include <array>
+
+//==============================================================================
+/// AnalyzerSet — one complete analysis pipeline (FFT, octave bands, levels,
+/// loudness, stereo field, metric history) for a single audio source.
+///
+/// The main mix keeps its analyzers in MainComponent and feeds them from the
+/// audio callback; every stem in a StemBank owns one of these and is fed from
+/// a worker thread.  `process()` must only ever be called from one thread at
+/// a time; meters read the results from the message thread the same way they
+/// read the mix analyzers, except for the spectrum, which the worker rewrites
+/// in place — read that through `getLatestSpectrum()`.
+struct AnalyzerSet
+{
+    AnalyzerSet() = default;
+
+    /// Set the sample rate on every analyzer and clear all state.
+    void prepare(double newSampleRate);
+
+    /// Clear all analyzer state (seek, export start).
+    void reset();
+
+    /// Run the stages `graph` has switched on over one block, then turn any
+    /// complete FFT frames into spectra.  Also keeps a mono snapshot of the
+    /// block for oscilloscopes.
+    void process(const float* left, const float* right, int numSamples);
+
+    /// Copy the latest mono snapshot into @p dest; returns the sample count.
+    int getLatestMonoSamples(float* dest, int maxSamples) const;
+
+    /// Copy the spectrum of the latest FFT frame into @p dest; returns the
+    /// bin count (0 before the first frame).
+    int getLatestSpectrum(float* dest, int maxBins) const;
+
+    double getSampleRate() const { return sampleRate; }
+
+    FFTProcessor          fft;
+    OctaveBandAnalyzer    bands;
+    LevelAnalyzer         levels;
+    LoudnessAnalyzer      loudness;
+    StereoFieldAnalyzer   stereo;
+    MetricHistory         history;
+    AnalysisGraph         graph;    ///< which of the above this source's items read
+
+private:
+    double sampleRate = 44100.0;
+
+    static constexpr int kSnapshotSize = 2048;
+    mutable juce::SpinLock              snapshotLock;
+    std::array<float, kSnapshotSize>    snapshot {};
+    int                                 snapshotCount = 0;
+
+    std::array<float, FFTProcessor::kMaxFFTSize / 2> spectrumSnapshot {};
+    int                                 spectrumCount = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalyzerSet)
+};
@@ -1,11 +1,19 @@
 #include "AudioEngine.h"
+#include "AudioTelemetry.h"
+#include "MappedAudioReader.h"
 
 //==============================================================================
-AudioEngine::AudioEngine()
+AudioEngine::AudioEngine(bool openAudioDevice)
+    : deviceOpened(openAudioDevice)
 {
     // Register all built-in audio formats (WAV, AIFF, FLAC, OGG, + platform-specific)
     formatManager.registerBasicFormats();
 
+    transportSource.addChangeListener(this);
+
+    if (!deviceOpened)
+        return;
+
     // Set up audio device with default stereo output
     auto err = deviceManager.initialiseWithDefaultDevices(0, 2);
     if (err.isNotEmpty())
@@ -14,16 +22,20 @@ AudioEngine::AudioEngine()
     deviceManager.addAudioCallback(&sourcePlayer);
     sourcePlayer.setSource(this);
 
-    transportSource.addChangeListener(this);
+    readAheadThread.startThread();
 }
 
 AudioEngine::~AudioEngine()
 {
     transportSource.removeChangeListener(this);
-    sourcePlayer.setSource(nullptr);
-    deviceManager.removeAudioCallback(&sourcePlayer);
+    if (deviceOpened)
+    {
+        sourcePlayer.setSource(nullptr);
+        deviceManager.removeAudioCallback(&sourcePlayer);
+    }
     transportSource.setSource(nullptr);
     readerSource.reset();
+    readAheadThread.stopThread(1000);
 }
 
 //==============================================================================
@@ -35,8 +47,8 @@ bool AudioEngine::loadFile(const juce::File& file)
     transportSource.setSource(nullptr);
     readerSource.reset();
 
-    // Try to create a reader for this file
-    auto* reader = formatManager.createReaderFor(file);
+    // Try to create a reader for this file (memory-mapped for WAV/AIFF)
+    auto reader = MappedAudio::createReader(formatManager, file);
     if (reader == nullptr)
     {
         DBG("Failed to create reader for: " + file.getFullPathName());
@@ -47,8 +59,9 @@ bool AudioEngine::loadFile(const juce::File& file)
     fileSampleRate = reader->sampleRate;
     totalSamples   = reader->lengthInSamples;
 
-    readerSource = std::make_unique<juce::AudioFormatReaderSource>(reader, true);
-    transportSource.setSource(readerSource.get(), 0, nullptr, reader->sampleRate);
+    readerSource = std::make_unique<juce::AudioFormatReaderSource>(reader.release(), true);
+    transportSource.setSource(readerSource.get(), kReadAheadSamples,
+                              deviceOpened ? &readAheadThread : nullptr, fileSampleRate);
 
     DBG("Loaded: " + file.getFileName()
         + " | SR: " + juce::String(fileSampleRate)
@@ -70,6 +83,7 @@ void AudioEngine::unloadFile()
     currentFile = {};
     fileSampleRate = 0.0;
     totalSamples = 0;
+    analysisClock.store(0.0);
 }
 
 juce::String AudioEngine::getLoadedFileName() const
@@ -152,7 +166,9 @@ float AudioEngine::getGain() const
 //==============================================================================
 void AudioEngine::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
 {
+    deviceSampleRate = sampleRate;
     transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    AudioTelemetry::getInstance().reset();
 }
 
 void AudioEngine::releaseResources()
@@ -168,7 +184,13 @@ void AudioEngine::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferTo
         return;
     }
 
-    transportSource.getNextAudioBlock(bufferToFill);
+    const AudioTelemetry::ScopedCallback timing(bufferToFill.numSamples, deviceSampleRate);
+
+    {
+        const AudioTelemetry::ScopedStage stage(AudioTelemetry::Stage::Transport);
+        transportSource.getNextAudioBlock(bufferToFill);
+    }
+    analysisClock.store(transportSource.getCurrentPosition(), std::memory_order_release);
 
     // Store raw mono sample snapshot for oscilloscope
     {
@@ -203,6 +225,14 @@ void AudioEngine::changeListenerCallback(juce::ChangeBroadcaster* /*source*/)
     });
 }
 
+//==============================================================================
+int AudioEngine::getXRunCount() const
+{
+    if (auto* device = deviceManager.getCurrentAudioDevice())
+        return device->getXRunCount();
+    return -1;
+}
+
 //==============================================================================
 int AudioEngine::getLatestMonoSamples(float* dest, int maxSamples) const
 {
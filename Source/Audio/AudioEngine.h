@@ -12,7 +12,10 @@ class AudioEngine : public juce::AudioSource,
                     public juce::ChangeListener
 {
 public:
-    AudioEngine();
+    /// @p openAudioDevice false gives an engine that never plays (render
+    /// workers, which only need it for MeterFactory): no audio device is
+    /// opened and no read-ahead thread is started.
+    explicit AudioEngine(bool openAudioDevice = true);
     ~AudioEngine() override;
 
     //--- File I/O ---
@@ -46,6 +49,15 @@ public:
     //--- Audio device ---
     juce::AudioDeviceManager& getDeviceManager() { return deviceManager; }
 
+    /// Buffer under/overruns reported by the current device driver
+    /// since it was opened, or -1 if the driver does not report them.
+    int getXRunCount() const;
+
+    /// Position (seconds) of the end of the last block handed to the analysis
+    /// callback.  Written on the audio thread; stem analysis follows it so
+    /// every source is metered at the same point of the song.
+    double getAnalysisClock() const { return analysisClock.load(std::memory_order_acquire); }
+
     //--- Callback for audio blocks (FFT / level analysis) ---
     /// Set a callback that receives raw audio samples from the real-time thread.
     /// The callback MUST be lock-free and non-blocking.
@@ -71,10 +83,16 @@ public:
     void removeListener(Listener* l) { listeners.remove(l); }
 
 private:
+    const bool                     deviceOpened;
     juce::AudioDeviceManager       deviceManager;
     juce::AudioFormatManager       formatManager;
     juce::AudioSourcePlayer        sourcePlayer;
 
+    /// Reads the file ahead of the transport, so disk reads and page faults
+    /// on the mapped file stay off the audio thread
+    static constexpr int kReadAheadSamples = 1 << 18;
+    juce::TimeSliceThread          readAheadThread { "Audio read-ahead" };
+
     std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
     juce::AudioTransportSource     transportSource;
 
@@ -82,8 +100,10 @@ private:
     double                         fileSampleRate  = 0.0;
     juce::int64                    totalSamples    = 0;
     bool                           paused_         = false;
+    double                         deviceSampleRate = 0.0;
 
     AudioBlockCallback             audioBlockCallback;
+    std::atomic<double>            analysisClock { 0.0 };
     juce::ListenerList<Listener>   listeners;
 
     // Raw sample snapshot for oscilloscope (written by audio thread, read by GUI)
@@ -0,0 +1,184 @@
+#include "AudioTelemetry.h"
+#include <algorithm>
+
+//==============================================================================
+const char* AudioTelemetry::getStageName(Stage s)
+{
+    switch (s)
+    {
+        case Stage::Transport: return "Transport";
+        case Stage::Fft:       return "FFT";
+        case Stage::Bands:     return "Bands";
+        case Stage::Level:     return "Level";
+        case Stage::Loudness:  return "Loudness";
+        case Stage::Stereo:    return "Stereo";
+        case Stage::History:   return "History";
+        default:               break;
+    }
+    return "?";
+}
+
+//==============================================================================
+// Audio thread — the only writer, so read-modify-write on the atomics below
+// needs no compare-exchange.
+//==============================================================================
+void AudioTelemetry::beginCallback(int numSamples, double sampleRate) noexcept
+{
+    if (resetPending.exchange(false, std::memory_order_acq_rel))
+        clearAll();
+
+    const double periodSeconds = (sampleRate > 0.0) ? numSamples / sampleRate : 0.0;
+    periodTicks = periodSeconds * static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+    currentStage.fill(0);
+
+    blockSize.store(numSamples, std::memory_order_relaxed);
+    bufferMs.store(periodSeconds * 1000.0, std::memory_order_relaxed);
+
+    callbackStart = juce::Time::getHighResolutionTicks();
+}
+
+void AudioTelemetry::addStageTicks(Stage s, juce::int64 ticks) noexcept
+{
+    currentStage[static_cast<size_t>(s)] += ticks;
+}
+
+void AudioTelemetry::endCallback() noexcept
+{
+    if (periodTicks <= 0.0)
+        return;
+
+    const auto  total = juce::Time::getHighResolutionTicks() - callbackStart;
+    const float load  = static_cast<float>(total / periodTicks);
+
+    lastLoad.store(load, std::memory_order_relaxed);
+    smoothedLoad.store(smoothedLoad.load(std::memory_order_relaxed) * 0.95f + load * 0.05f,
+                       std::memory_order_relaxed);
+    loadSum.store(loadSum.load(std::memory_order_relaxed) + load, std::memory_order_relaxed);
+    if (load > worstLoad.load(std::memory_order_relaxed))
+        worstLoad.store(load, std::memory_order_relaxed);
+
+    int slowest = 0;
+    for (int i = 0; i < kNumStages; ++i)
+    {
+        const auto idx = static_cast<size_t>(i);
+        const float stageLoad = static_cast<float>(currentStage[idx] / periodTicks);
+        stageSum[idx].store(stageSum[idx].load(std::memory_order_relaxed) + stageLoad,
+                            std::memory_order_relaxed);
+        if (stageLoad > stageWorst[idx].load(std::memory_order_relaxed))
+            stageWorst[idx].store(stageLoad, std::memory_order_relaxed);
+        if (currentStage[idx] > currentStage[static_cast<size_t>(slowest)])
+            slowest = i;
+    }
+
+    const int bin = juce::jlimit(0, kHistogramBins - 1, static_cast<int>(load / kHistogramWidth));
+    histogram[static_cast<size_t>(bin)].fetch_add(1, std::memory_order_relaxed);
+
+    if (load >= 1.0f)
+    {
+        overruns.fetch_add(1, std::memory_order_relaxed);
+        stageBlamed[static_cast<size_t>(slowest)].fetch_add(1, std::memory_order_relaxed);
+        lastBlamed.store(slowest, std::memory_order_relaxed);
+    }
+
+    // Published last so readers never divide sums by a count that is too small
+    callbacks.fetch_add(1, std::memory_order_release);
+}
+
+void AudioTelemetry::clearAll() noexcept
+{
+    callbacks.store(0, std::memory_order_relaxed);
+    lastLoad.store(0.0f, std::memory_order_relaxed);
+    smoothedLoad.store(0.0f, std::memory_order_relaxed);
+    loadSum.store(0.0, std::memory_order_relaxed);
+    worstLoad.store(0.0f, std::memory_order_relaxed);
+
+    for (auto& a : stageSum)    a.store(0.0, std::memory_order_relaxed);
+    for (auto& a : stageWorst)  a.store(0.0f, std::memory_order_relaxed);
+    for (auto& a : stageBlamed) a.store(0, std::memory_order_relaxed);
+    for (auto& a : histogram)   a.store(0, std::memory_order_relaxed);
+
+    overruns.store(0, std::memory_order_relaxed);
+    lastBlamed.store(-1, std::memory_order_relaxed);
+}
+
+//==============================================================================
+AudioTelemetry::Snapshot AudioTelemetry::getSnapshot() const
+{
+    Snapshot s;
+    s.callbacks    = callbacks.load(std::memory_order_acquire);
+    s.blockSize    = blockSize.load(std::memory_order_relaxed);
+    s.bufferMs     = bufferMs.load(std::memory_order_relaxed);
+    s.lastLoad     = lastLoad.load(std::memory_order_relaxed);
+    s.smoothedLoad = smoothedLoad.load(std::memory_order_relaxed);
+    s.worstLoad    = worstLoad.load(std::memory_order_relaxed);
+
+    const double n = static_cast<double>(std::max<uint64_t>(1, s.callbacks));
+    s.averageLoad = static_cast<float>(loadSum.load(std::memory_order_relaxed) / n);
+
+    for (size_t i = 0; i < static_cast<size_t>(kNumStages); ++i)
+    {
+        s.stageAverage[i] = static_cast<float>(stageSum[i].load(std::memory_order_relaxed) / n);
+        s.stageWorst[i]   = stageWorst[i].load(std::memory_order_relaxed);
+        s.stageBlamed[i]  = stageBlamed[i].load(std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < static_cast<size_t>(kHistogramBins); ++i)
+        s.histogram[i] = histogram[i].load(std::memory_order_relaxed);
+
+    s.overruns    = overruns.load(std::memory_order_relaxed);
+    s.deviceXRuns = deviceXRuns.load(std::memory_order_relaxed);
+    s.lastBlamed  = lastBlamed.load(std::memory_order_relaxed);
+    return s;
+}
+
+//==============================================================================
+juce::String AudioTelemetry::formatSummary(const Snapshot& s)
+{
+    juce::String str;
+    str << "DSP " << juce::roundToInt(s.smoothedLoad * 100.0f) << "%"
+        << " (max " << juce::roundToInt(s.worstLoad * 100.0f) << "%)"
+        << "  " << s.blockSize << " smp / " << juce::String(s.bufferMs, 1) << " ms"
+        << "  overruns " << static_cast<int>(s.overruns);
+
+    if (s.deviceXRuns >= 0)
+        str << "  xruns " << s.deviceXRuns;
+
+    if (s.lastBlamed >= 0)
+        str << "  last: " << getStageName(static_cast<Stage>(s.lastBlamed));
+
+    return str;
+}
+
+juce::String AudioTelemetry::toCsv(const Snapshot& s)
+{
+    juce::String csv;
+    csv << "# MaxiMeter audio-thread telemetry" << juce::newLine
+        << "callbacks," << juce::String(static_cast<juce::int64>(s.callbacks)) << juce::newLine
+        << "block_size," << s.blockSize << juce::newLine
+        << "buffer_ms," << juce::String(s.bufferMs, 3) << juce::newLine
+        << "average_load_pct," << juce::String(s.averageLoad * 100.0f, 2) << juce::newLine
+        << "worst_load_pct," << juce::String(s.worstLoad * 100.0f, 2) << juce::newLine
+        << "overruns," << static_cast<int>(s.overruns) << juce::newLine
+        << "device_xruns," << s.deviceXRuns << juce::newLine
+        << juce::newLine;
+
+    csv << "stage,average_pct,worst_pct,overruns_blamed" << juce::newLine;
+    for (size_t i = 0; i < static_cast<size_t>(kNumStages); ++i)
+        csv << getStageName(static_cast<Stage>(i)) << ","
+            << juce::String(s.stageAverage[i] * 100.0f, 3) << ","
+            << juce::String(s.stageWorst[i] * 100.0f, 3) << ","
+            << static_cast<int>(s.stageBlamed[i]) << juce::newLine;
+    csv << juce::newLine;
+
+    csv << "load_from_pct,load_to_pct,callbacks" << juce::newLine;
+    for (int i = 0; i < kHistogramBins; ++i)
+    {
+        const int from = juce::roundToInt(i * kHistogramWidth * 100.0f);
+        csv << from << ","
+            << (i == kHistogramBins - 1 ? juce::String("inf")
+                                        : juce::String(juce::roundToInt((i + 1) * kHistogramWidth * 100.0f)))
+            << "," << static_cast<int>(s.histogram[static_cast<size_t>(i)]) << juce::newLine;
+    }
+
+    return csv;
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+//==============================================================================
+/// AudioTelemetry — lock-free timing of the real-time audio callback.
+///
+/// The audio thread brackets each callback with `ScopedCallback` and each
+/// processing stage with `ScopedStage`.  At the end of a callback the
+/// measured times are expressed as a fraction of the buffer period (1.0 =
+/// the whole deadline was used) and folded into atomics: running totals,
+/// a smoothed load, per-stage worst cases, a load histogram and an overrun
+/// count.  A callback that overruns its period is blamed on the stage that
+/// took longest, so a dropout can be traced to a specific analyzer.
+///
+/// GUI threads read a consistent-enough `Snapshot` at any time.  Device
+/// xruns are reported by the driver, not measured here, so the GUI passes
+/// them in via `setDeviceXRunCount()`.
+class AudioTelemetry
+{
+public:
+    enum class Stage
+    {
+        Transport,      ///< transport read + file decode
+        Fft,            ///< mono mix-down + FFT push
+        Bands,          ///< fractional-octave filter bank
+        Level,
+        Loudness,
+        Stereo,
+        History,        ///< MetricHistory recording
+        NumStages
+    };
+
+    static constexpr int kNumStages = static_cast<int>(Stage::NumStages);
+
+    /// Load histogram: 5 % wide bins, the last one collects >= 100 %.
+    static constexpr int   kHistogramBins  = 21;
+    static constexpr float kHistogramWidth = 0.05f;
+
+    static AudioTelemetry& getInstance()
+    {
+        static AudioTelemetry inst;
+        return inst;
+    }
+
+    static const char* getStageName(Stage s);
+
+    //--- Audio thread ---
+
+    /// Times one whole callback.  @p numSamples / @p sampleRate is the deadline.
+    class ScopedCallback
+    {
+    public:
+        ScopedCallback(int numSamples, double sampleRate) noexcept
+        {
+            getInstance().beginCallback(numSamples, sampleRate);
+        }
+        ~ScopedCallback() noexcept { getInstance().endCallback(); }
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE(ScopedCallback)
+    };
+
+    /// Times one stage inside the current callback.
+    class ScopedStage
+    {
+    public:
+        explicit ScopedStage(Stage s) noexcept
+            : stage(s), start(juce::Time::getHighResolutionTicks()) {}
+        ~ScopedStage() noexcept
+        {
+            getInstance().addStageTicks(stage, juce::Time::getHighResolutionTicks() - start);
+        }
+
+    private:
+        Stage       stage;
+        juce::int64 start;
+        JUCE_DECLARE_NON_COPYABLE(ScopedStage)
+    };
+
+    void beginCallback(int numSamples, double sampleRate) noexcept;
+    void addStageTicks(Stage s, juce::int64 ticks) noexcept;
+    void endCallback() noexcept;
+
+    //--- GUI thread ---
+
+    struct Snapshot
+    {
+        uint64_t callbacks      = 0;
+        int      blockSize      = 0;
+        double   bufferMs       = 0.0;
+
+        float    lastLoad       = 0.0f;     ///< fractions of the buffer period
+        float    smoothedLoad   = 0.0f;
+        float    averageLoad    = 0.0f;     ///< since the last reset
+        float    worstLoad      = 0.0f;
+
+        std::array<float, kNumStages>    stageAverage {};
+        std::array<float, kNumStages>    stageWorst {};
+        std::array<uint32_t, kNumStages> stageBlamed {};   ///< overruns attributed to each stage
+
+        std::array<uint32_t, kHistogramBins> histogram {};
+
+        uint32_t overruns       = 0;        ///< callbacks that exceeded their period
+        int      deviceXRuns    = -1;       ///< from the driver; -1 if not reported
+        int      lastBlamed     = -1;       ///< Stage of the most recent overrun
+    };
+
+    Snapshot getSnapshot() const;
+
+    /// Clear all statistics.  Applied by the audio thread on its next callback.
+    void reset() { resetPending.store(true, std::memory_order_release); }
+
+    void setDeviceXRunCount(int count) { deviceXRuns.store(count, std::memory_order_relaxed); }
+
+    /// One-line summary for the status bar / log.
+    static juce::String formatSummary(const Snapshot& s);
+
+    /// Multi-line report (per-stage table + histogram) as CSV.
+    static juce::String toCsv(const Snapshot& s);
+
+private:
+    AudioTelemetry() = default;
+
+    void clearAll() noexcept;
+
+    // Audio-thread scratch for the callback in flight
+    juce::int64 callbackStart = 0;
+    double      periodTicks   = 0.0;
+    std::array<juce::int64, kNumStages> currentStage {};
+
+    // Published statistics
+    std::atomic<uint64_t> callbacks { 0 };
+    std::atomic<int>      blockSize { 0 };
+    std::atomic<double>   bufferMs { 0.0 };
+    std::atomic<float>    lastLoad { 0.0f };
+    std::atomic<float>    smoothedLoad { 0.0f };
+    std::atomic<double>   loadSum { 0.0 };
+    std::atomic<float>    worstLoad { 0.0f };
+
+    std::array<std::atomic<double>, kNumStages>   stageSum {};
+    std::array<std::atomic<float>, kNumStages>    stageWorst {};
+    std::array<std::atomic<uint32_t>, kNumStages> stageBlamed {};
+    std::array<std::atomic<uint32_t>, kHistogramBins> histogram {};
+
+    std::atomic<uint32_t> overruns { 0 };
+    std::atomic<int>      lastBlamed { -1 };
+    std::atomic<int>      deviceXRuns { -1 };
+    std::atomic<bool>     resetPending { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioTelemetry)
+};
@@ -0,0 +1,141 @@
+#include "FFTBenchmark.h"
+#include "FFTKernels.h"
+#include "../Utils/AsyncLogger.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace FFTBenchmark
+{
+namespace
+{
+    /// Deterministic test signal: two tones plus a little noise.
+    std::vector<float> makeSignal(int n)
+    {
+        std::vector<float> x(static_cast<size_t>(n));
+        juce::Random rng(1234);
+        for (int i = 0; i < n; ++i)
+            x[static_cast<size_t>(i)] = 0.5f * std::sin(0.031f * static_cast<float>(i))
+                                      + 0.25f * std::sin(0.57f * static_cast<float>(i))
+                                      + 0.01f * (rng.nextFloat() - 0.5f);
+        return x;
+    }
+
+    /// Calls @p fn repeatedly for about @p seconds; returns µs per call.
+    template <typename Fn>
+    double timeIt(Fn&& fn, double seconds)
+    {
+        fn();   // warm-up (plans, caches)
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        const auto budget = juce::Time::secondsToHighResolutionTicks(seconds);
+        juce::int64 runs = 0;
+        juce::int64 elapsed = 0;
+        do
+        {
+            for (int i = 0; i < 8; ++i)
+                fn();
+            runs += 8;
+            elapsed = juce::Time::getHighResolutionTicks() - start;
+        }
+        while (elapsed < budget);
+
+        return juce::Time::highResolutionTicksToSeconds(elapsed) * 1.0e6 / static_cast<double>(runs);
+    }
+
+    std::atomic<bool> running { false };
+}
+
+//==============================================================================
+std::vector<Result> run(int minOrder, int maxOrder, double secondsPerCase)
+{
+    std::vector<Result> results;
+
+    for (int order = minOrder; order <= maxOrder; ++order)
+    {
+        const int n    = 1 << order;
+        const int bins = n / 2 + 1;
+        const auto input = makeSignal(n);
+
+        std::vector<float> refRe(static_cast<size_t>(bins)), refIm(static_cast<size_t>(bins));
+        FFTEngine::create(order, FFTEngine::Backend::Juce)->forward(input.data(), refRe.data(), refIm.data());
+
+        std::vector<float> re(static_cast<size_t>(bins)), im(static_cast<size_t>(bins));
+
+        for (auto backend : FFTEngine::getAvailableBackends())
+        {
+            auto engine = FFTEngine::create(order, backend);
+            if (engine->getBackend() != backend)
+                continue;   // unsupported at this size
+
+            Result r;
+            r.label = FFTEngine::getBackendName(backend);
+            r.order = order;
+            r.microsPerRun = timeIt([&] { engine->forward(input.data(), re.data(), im.data()); },
+                                    secondsPerCase);
+
+            engine->forward(input.data(), re.data(), im.data());
+            for (int k = 0; k < bins; ++k)
+                r.maxError = std::max(r.maxError,
+                                      static_cast<double>(std::abs(re[static_cast<size_t>(k)] - refRe[static_cast<size_t>(k)])
+                                                          + std::abs(im[static_cast<size_t>(k)] - refIm[static_cast<size_t>(k)])));
+            results.push_back(r);
+        }
+
+        // Post-FFT kernels: magnitude followed by dB, scalar vs. selected SIMD set
+        std::vector<const FFTKernels::Table*> kernelSets { &FFTKernels::scalar() };
+        if (&FFTKernels::get() != &FFTKernels::scalar())
+            kernelSets.push_back(&FFTKernels::get());
+
+        std::vector<float> mag(static_cast<size_t>(bins)), db(static_cast<size_t>(bins));
+        for (const auto* table : kernelSets)
+        {
+            Result r;
+            r.label = juce::String("mag+dB ") + table->name;
+            r.order = order;
+            r.microsPerRun = timeIt([&]
+            {
+                table->magnitude(refRe.data(), refIm.data(), mag.data(), bins, 2.0f / static_cast<float>(n));
+                table->decibels(mag.data(), db.data(), bins, -120.0f);
+            }, secondsPerCase);
+            results.push_back(r);
+        }
+    }
+
+    return results;
+}
+
+juce::StringArray format(const std::vector<Result>& results)
+{
+    juce::StringArray lines;
+    lines.add("FFT benchmark - kernels: " + juce::String(FFTKernels::get().name));
+    lines.add(juce::String("backend").paddedRight(' ', 20) + "order    size      us/run   max err");
+
+    for (auto& r : results)
+    {
+        juce::String line;
+        line << r.label.paddedRight(' ', 20)
+             << juce::String(r.order).paddedLeft(' ', 5)
+             << juce::String(1 << r.order).paddedLeft(' ', 8)
+             << juce::String(r.microsPerRun, 2).paddedLeft(' ', 12);
+        if (!r.label.startsWith("mag+dB"))
+            line << "   " << juce::String(r.maxError, 6);
+        lines.add(line);
+    }
+    return lines;
+}
+
+void runAsync()
+{
+    if (running.exchange(true))
+        return;
+
+    MAXIMETER_LOG("AUDIO", "FFT benchmark started (orders 10-15)");
+    juce::Thread::launch([]
+    {
+        for (auto& line : format(run()))
+            MAXIMETER_LOG("AUDIO", line);
+        running.store(false);
+    });
+}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "FFTEngine.h"
+#include <vector>
+
+//==============================================================================
+/// FFTBenchmark — times every compiled-in FFTEngine backend, plus the scalar
+/// and SIMD magnitude / dB kernels, over a range of FFT orders.
+///
+/// Run from the debug log window ("FFT Benchmark"); results go to the AUDIO
+/// log category and can be copied from there.  Each case runs for a fixed
+/// wall-clock budget, so a full 10–15 sweep takes a couple of seconds.
+namespace FFTBenchmark
+{
+    struct Result
+    {
+        juce::String label;         ///< backend or kernel name
+        int          order = 0;
+        double       microsPerRun = 0.0;
+        double       maxError = 0.0;     ///< vs. the JUCE backend (FFT rows only)
+    };
+
+    /// Blocking — call from a background thread.
+    std::vector<Result> run(int minOrder = 10, int maxOrder = 15, double secondsPerCase = 0.05);
+
+    /// Fixed-width table, one line per result.
+    juce::StringArray format(const std::vector<Result>& results);
+
+    /// Run on a background thread and log the table.  Ignored while a
+    /// previous run is still in progress.
+    void runAsync();
+}
@@ -0,0 +1,345 @@
+#include "FFTEngine.h"
+#include "FFTKernels.h"
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+#if MAXIMETER_WITH_FFTW
+ #include <fftw3.h>
+#endif
+
+#if MAXIMETER_WITH_PFFFT
+ #include <pffft.h>
+#endif
+
+namespace
+{
+//==============================================================================
+/// Radix-2 real FFT: the N real inputs are packed as N/2 complex values,
+/// transformed with an iterative decimation-in-time FFT on split arrays, then
+/// unpacked into the N/2 + 1 real-signal bins.  The first two stages use
+/// trivial twiddles and run inline; every later stage is a run of contiguous
+/// butterflies handed to the SIMD kernel.
+class BuiltinFFTEngine final : public FFTEngine
+{
+public:
+    explicit BuiltinFFTEngine(int fftOrder)
+        : FFTEngine(fftOrder),
+          half(1 << (fftOrder - 1)),
+          kernels(FFTKernels::get())
+    {
+        const double twoPi = juce::MathConstants<double>::twoPi;
+
+        // Bit-reversal permutation of the packed complex input
+        bitReverse.resize(static_cast<size_t>(half));
+        const int bits = fftOrder - 1;
+        for (int i = 0; i < half; ++i)
+        {
+            int r = 0;
+            for (int b = 0; b < bits; ++b)
+                r |= ((i >> b) & 1) << (bits - 1 - b);
+            bitReverse[static_cast<size_t>(i)] = r;
+        }
+
+        // Stage twiddles, stage with half-span m stored at offset m - 1
+        stageRe.resize(static_cast<size_t>(std::max(1, half)));
+        stageIm.resize(static_cast<size_t>(std::max(1, half)));
+        for (int m = 1; m < half; m *= 2)
+            for (int j = 0; j < m; ++j)
+            {
+                const double a = -twoPi * j / (2.0 * m);
+                stageRe[static_cast<size_t>(m - 1 + j)] = static_cast<float>(std::cos(a));
+                stageIm[static_cast<size_t>(m - 1 + j)] = static_cast<float>(std::sin(a));
+            }
+
+        // Unpacking twiddles W_N^k
+        unpackRe.resize(static_cast<size_t>(half + 1));
+        unpackIm.resize(static_cast<size_t>(half + 1));
+        for (int k = 0; k <= half; ++k)
+        {
+            const double a = -twoPi * k / static_cast<double>(getSize());
+            unpackRe[static_cast<size_t>(k)] = static_cast<float>(std::cos(a));
+            unpackIm[static_cast<size_t>(k)] = static_cast<float>(std::sin(a));
+        }
+
+        zr.resize(static_cast<size_t>(half));
+        zi.resize(static_cast<size_t>(half));
+    }
+
+    Backend getBackend() const override { return Backend::Builtin; }
+
+    void forward(const float* input, float* re, float* im) override
+    {
+        float* r = zr.data();
+        float* i = zi.data();
+
+        for (int n = 0; n < half; ++n)
+        {
+            const auto dst = static_cast<size_t>(bitReverse[static_cast<size_t>(n)]);
+            r[dst] = input[2 * n];
+            i[dst] = input[2 * n + 1];
+        }
+
+        // Stage m = 1 (w = 1)
+        for (int k = 0; k + 1 < half; k += 2)
+        {
+            const float ar = r[k], ai = i[k];
+            r[k]     = ar + r[k + 1];  i[k]     = ai + i[k + 1];
+            r[k + 1] = ar - r[k + 1];  i[k + 1] = ai - i[k + 1];
+        }
+
+        // Stage m = 2 (w = 1, −i)
+        for (int k = 0; k + 3 < half; k += 4)
+        {
+            const float ar = r[k], ai = i[k];
+            r[k]     = ar + r[k + 2];  i[k]     = ai + i[k + 2];
+            r[k + 2] = ar - r[k + 2];  i[k + 2] = ai - i[k + 2];
+
+            const float br = r[k + 3], bi = i[k + 3];   // −i·b = (bi, −br)
+            const float cr = r[k + 1], ci = i[k + 1];
+            r[k + 1] = cr + bi;  i[k + 1] = ci - br;
+            r[k + 3] = cr - bi;  i[k + 3] = ci + br;
+        }
+
+        for (int m = 4; m < half; m *= 2)
+        {
+            const float* wr = stageRe.data() + (m - 1);
+            const float* wi = stageIm.data() + (m - 1);
+            for (int k = 0; k < half; k += 2 * m)
+                kernels.butterfly(r + k, i + k, r + k + m, i + k + m, wr, wi, m);
+        }
+
+        // Unpack: X[k] = E[k] + W^k·O[k] with
+        //   E = (Z[k] + conj Z[M−k]) / 2,  O = (Z[k] − conj Z[M−k]) / 2i
+        re[0]    = r[0] + i[0];  im[0]    = 0.0f;
+        re[half] = r[0] - i[0];  im[half] = 0.0f;
+
+        for (int k = 1; k < half; ++k)
+        {
+            const float ar = r[k], ai = i[k];
+            const float br = r[half - k], bi = -i[half - k];
+
+            const float er = 0.5f * (ar + br), ei = 0.5f * (ai + bi);
+            const float orr = 0.5f * (ai - bi), oi = -0.5f * (ar - br);
+
+            const float wr = unpackRe[static_cast<size_t>(k)], wi = unpackIm[static_cast<size_t>(k)];
+            re[k] = er + (orr * wr - oi * wi);
+            im[k] = ei + (orr * wi + oi * wr);
+        }
+    }
+
+private:
+    const int half;
+    const FFTKernels::Table& kernels;
+
+    std::vector<int>   bitReverse;
+    std::vector<float> stageRe, stageIm;
+    std::vector<float> unpackRe, unpackIm;
+    std::vector<float> zr, zi;
+};
+
+//==============================================================================
+class JuceFFTEngine final : public FFTEngine
+{
+public:
+    explicit JuceFFTEngine(int fftOrder)
+        : FFTEngine(fftOrder), fft(fftOrder),
+          buffer(static_cast<size_t>(2 * getSize()), 0.0f)
+    {
+    }
+
+    Backend getBackend() const override { return Backend::Juce; }
+
+    void forward(const float* input, float* re, float* im) override
+    {
+        const int n = getSize();
+        std::copy(input, input + n, buffer.begin());
+        std::fill(buffer.begin() + n, buffer.end(), 0.0f);
+
+        fft.performRealOnlyForwardTransform(buffer.data(), true);
+
+        for (int k = 0; k <= n / 2; ++k)
+        {
+            re[k] = buffer[static_cast<size_t>(2 * k)];
+            im[k] = buffer[static_cast<size_t>(2 * k + 1)];
+        }
+    }
+
+private:
+    juce::dsp::FFT     fft;
+    std::vector<float> buffer;
+};
+
+//==============================================================================
+#if MAXIMETER_WITH_FFTW
+/// The FFTW planner is not thread-safe; execution is.
+std::mutex& fftwPlannerLock()
+{
+    static std::mutex m;
+    return m;
+}
+
+class FftwFFTEngine final : public FFTEngine
+{
+public:
+    explicit FftwFFTEngine(int fftOrder) : FFTEngine(fftOrder)
+    {
+        const int n = getSize();
+        in  = fftwf_alloc_real(static_cast<size_t>(n));
+        out = fftwf_alloc_complex(static_cast<size_t>(n / 2 + 1));
+
+        const std::lock_guard<std::mutex> lock(fftwPlannerLock());
+        plan = fftwf_plan_dft_r2c_1d(n, in, out, FFTW_MEASURE);
+    }
+
+    ~FftwFFTEngine() override
+    {
+        {
+            const std::lock_guard<std::mutex> lock(fftwPlannerLock());
+            fftwf_destroy_plan(plan);
+        }
+        fftwf_free(in);
+        fftwf_free(out);
+    }
+
+    Backend getBackend() const override { return Backend::FFTW; }
+
+    void forward(const float* input, float* re, float* im) override
+    {
+        const int n = getSize();
+        std::copy(input, input + n, in);
+        fftwf_execute(plan);
+
+        for (int k = 0; k <= n / 2; ++k)
+        {
+            re[k] = out[k][0];
+            im[k] = out[k][1];
+        }
+    }
+
+private:
+    float*        in   = nullptr;
+    fftwf_complex* out = nullptr;
+    fftwf_plan    plan = nullptr;
+};
+#endif
+
+//==============================================================================
+#if MAXIMETER_WITH_PFFFT
+class PffftFFTEngine final : public FFTEngine
+{
+public:
+    explicit PffftFFTEngine(int fftOrder) : FFTEngine(fftOrder)
+    {
+        const auto bytes = sizeof(float) * static_cast<size_t>(getSize());
+        setup = pffft_new_setup(getSize(), PFFFT_REAL);
+        in    = static_cast<float*>(pffft_aligned_malloc(bytes));
+        out   = static_cast<float*>(pffft_aligned_malloc(bytes));
+        work  = static_cast<float*>(pffft_aligned_malloc(bytes));
+    }
+
+    ~PffftFFTEngine() override
+    {
+        pffft_destroy_setup(setup);
+        pffft_aligned_free(in);
+        pffft_aligned_free(out);
+        pffft_aligned_free(work);
+    }
+
+    Backend getBackend() const override { return Backend::PFFFT; }
+
+    void forward(const float* input, float* re, float* im) override
+    {
+        const int n = getSize();
+        std::copy(input, input + n, in);
+        pffft_transform_ordered(setup, in, out, work, PFFFT_FORWARD);
+
+        // Ordered real output: [DC, Nyquist, re1, im1, re2, im2, ...]
+        re[0] = out[0];      im[0] = 0.0f;
+        re[n / 2] = out[1];  im[n / 2] = 0.0f;
+        for (int k = 1; k < n / 2; ++k)
+        {
+            re[k] = out[2 * k];
+            im[k] = out[2 * k + 1];
+        }
+    }
+
+private:
+    PFFFT_Setup* setup = nullptr;
+    float* in   = nullptr;
+    float* out  = nullptr;
+    float* work = nullptr;
+};
+#endif
+
+bool isCompiledIn(FFTEngine::Backend b, int order)
+{
+    switch (b)
+    {
+        case FFTEngine::Backend::Builtin: return true;
+        case FFTEngine::Backend::Juce:    return true;
+       #if MAXIMETER_WITH_FFTW
+        case FFTEngine::Backend::FFTW:    return true;
+       #endif
+       #if MAXIMETER_WITH_PFFFT
+        case FFTEngine::Backend::PFFFT:   return order >= 5;   // needs a multiple of 32
+       #endif
+        default:                          break;
+    }
+    juce::ignoreUnused(order);
+    return false;
+}
+}
+
+//==============================================================================
+std::unique_ptr<FFTEngine> FFTEngine::create(int order, Backend backend)
+{
+    order = juce::jlimit(2, 16, order);
+
+    if (backend == Backend::Auto)
+    {
+        for (auto candidate : { Backend::FFTW, Backend::PFFFT })
+            if (isCompiledIn(candidate, order))
+                return create(order, candidate);
+        backend = Backend::Builtin;
+    }
+
+    if (!isCompiledIn(backend, order))
+        backend = Backend::Builtin;
+
+    switch (backend)
+    {
+        case Backend::Juce:  return std::make_unique<JuceFFTEngine>(order);
+       #if MAXIMETER_WITH_FFTW
+        case Backend::FFTW:  return std::make_unique<FftwFFTEngine>(order);
+       #endif
+       #if MAXIMETER_WITH_PFFFT
+        case Backend::PFFFT: return std::make_unique<PffftFFTEngine>(order);
+       #endif
+        default:             break;
+    }
+    return std::make_unique<BuiltinFFTEngine>(order);
+}
+
+juce::Array<FFTEngine::Backend> FFTEngine::getAvailableBackends()
+{
+    juce::Array<Backend> result;
+    for (auto b : { Backend::Builtin, Backend::Juce, Backend::FFTW, Backend::PFFFT })
+        if (isCompiledIn(b, 10))
+            result.add(b);
+    return result;
+}
+
+juce::String FFTEngine::getBackendName(Backend b)
+{
+    switch (b)
+    {
+        case Backend::Auto:    return "Auto";
+        case Backend::Builtin: return juce::String("Builtin (") + FFTKernels::get().name + ")";
+        case Backend::Juce:    return "JUCE";
+        case Backend::FFTW:    return "FFTW";
+        case Backend::PFFFT:   return "PFFFT";
+        default:               break;
+    }
+    return "?";
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+
+//==============================================================================
+/// FFTEngine — pluggable forward real FFT used by FFTProcessor and the
+/// offline renderer.
+///
+/// Input is `getSize()` real samples; output is the `getSize() / 2 + 1`
+/// non-negative-frequency bins in split form (separate real and imaginary
+/// arrays), ready for the FFTKernels magnitude kernel.  Engines are not
+/// thread-safe — give every analysis pipeline its own instance.
+///
+/// Backends:
+///   - Builtin  radix-2 real FFT on split-complex data, butterflies run by the
+///              widest FFTKernels set the CPU supports (SSE2 / AVX2 / NEON)
+///   - Juce     juce::dsp::FFT (IPP / vDSP / FFTW / fallback, as JUCE picks)
+///   - FFTW     fftwf r2c plans (MAXIMETER_WITH_FFTW builds only)
+///   - PFFFT    pffft ordered real transform (MAXIMETER_WITH_PFFFT builds only)
+class FFTEngine
+{
+public:
+    enum class Backend { Auto, Builtin, Juce, FFTW, PFFFT };
+
+    virtual ~FFTEngine() = default;
+
+    /// Forward transform.  @p input is not modified.  @p re and @p im receive
+    /// getSize() / 2 + 1 values each; no normalisation is applied.
+    virtual void forward(const float* input, float* re, float* im) = 0;
+
+    virtual Backend getBackend() const = 0;
+    int getOrder() const { return order; }
+    int getSize() const  { return 1 << order; }
+
+    /// Create an engine for 2^@p order points.  Auto picks FFTW, then PFFFT,
+    /// then Builtin — whichever is compiled in first.  Falls back to Builtin
+    /// when the requested backend is unavailable.
+    static std::unique_ptr<FFTEngine> create(int order, Backend backend = Backend::Auto);
+
+    /// Backends compiled into this build (never includes Auto).
+    static juce::Array<Backend> getAvailableBackends();
+
+    static juce::String getBackendName(Backend b);
+
+protected:
+    explicit FFTEngine(int fftOrder) : order(fftOrder) {}
+
+    const int order;
+};
@@ -0,0 +1,361 @@
+#include "FFTKernels.h"
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define MAXIMETER_KERNELS_X86 1
+ #include <immintrin.h>
+#else
+ #define MAXIMETER_KERNELS_X86 0
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+ #define MAXIMETER_KERNELS_NEON 1
+ #include <arm_neon.h>
+#else
+ #define MAXIMETER_KERNELS_NEON 0
+#endif
+
+// AVX2 code is compiled per function so the rest of the binary keeps the
+// baseline instruction set; it only runs after a CPUID check.
+#if MAXIMETER_KERNELS_X86 && (defined(__GNUC__) || defined(__clang__))
+ #define MAXIMETER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+ #define MAXIMETER_TARGET_AVX2
+#endif
+
+namespace FFTKernels
+{
+namespace
+{
+    //==========================================================================
+    // Scalar reference
+    //==========================================================================
+    void butterflyScalar(float* reA, float* imA, float* reB, float* imB,
+                         const float* wr, const float* wi, int n)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            const float tr = reB[i] * wr[i] - imB[i] * wi[i];
+            const float ti = reB[i] * wi[i] + imB[i] * wr[i];
+            reB[i] = reA[i] - tr;
+            imB[i] = imA[i] - ti;
+            reA[i] += tr;
+            imA[i] += ti;
+        }
+    }
+
+    void magnitudeScalar(const float* re, const float* im, float* out, int n, float scale)
+    {
+        for (int i = 0; i < n; ++i)
+            out[i] = std::sqrt(re[i] * re[i] + im[i] * im[i]) * scale;
+    }
+
+    void decibelsScalar(const float* in, float* out, int n, float floorDb)
+    {
+        for (int i = 0; i < n; ++i)
+            out[i] = in[i] > 0.0f ? std::max(floorDb, 20.0f * std::log10(in[i])) : floorDb;
+    }
+
+    float dotScalar(const float* a, const float* b, int n)
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < n; ++i)
+            sum += a[i] * b[i];
+        return sum;
+    }
+
+    //==========================================================================
+    // Fast log10 used by the vector dB kernels.
+    //   x = 2^e · m, m ∈ [1, 2);  ln m = 2·atanh(t), t = (m − 1)/(m + 1) ≤ 1/3
+    // Four odd terms of the atanh series keep the error near 1e-4 dB.
+    //==========================================================================
+    constexpr float kLog10Of2  = 0.30102999566f;
+    constexpr float kLog10OfE2 = 0.86858896381f;   // 2 / ln 10
+    constexpr float kTinyValue = 1.0e-30f;
+
+    //==========================================================================
+   #if MAXIMETER_KERNELS_X86
+    // SSE2
+    void butterflySse2(float* reA, float* imA, float* reB, float* imB,
+                       const float* wr, const float* wi, int n)
+    {
+        int i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m128 ar = _mm_loadu_ps(reA + i), ai = _mm_loadu_ps(imA + i);
+            const __m128 br = _mm_loadu_ps(reB + i), bi = _mm_loadu_ps(imB + i);
+            const __m128 cr = _mm_loadu_ps(wr + i),  ci = _mm_loadu_ps(wi + i);
+            const __m128 tr = _mm_sub_ps(_mm_mul_ps(br, cr), _mm_mul_ps(bi, ci));
+            const __m128 ti = _mm_add_ps(_mm_mul_ps(br, ci), _mm_mul_ps(bi, cr));
+            _mm_storeu_ps(reB + i, _mm_sub_ps(ar, tr));
+            _mm_storeu_ps(imB + i, _mm_sub_ps(ai, ti));
+            _mm_storeu_ps(reA + i, _mm_add_ps(ar, tr));
+            _mm_storeu_ps(imA + i, _mm_add_ps(ai, ti));
+        }
+        butterflyScalar(reA + i, imA + i, reB + i, imB + i, wr + i, wi + i, n - i);
+    }
+
+    void magnitudeSse2(const float* re, const float* im, float* out, int n, float scale)
+    {
+        const __m128 s = _mm_set1_ps(scale);
+        int i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m128 r = _mm_loadu_ps(re + i), m = _mm_loadu_ps(im + i);
+            const __m128 p = _mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(m, m));
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_sqrt_ps(p), s));
+        }
+        magnitudeScalar(re + i, im + i, out + i, n - i, scale);
+    }
+
+    inline __m128 log10Sse2(__m128 x)
+    {
+        const __m128i bits = _mm_castps_si128(x);
+        const __m128i expo = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+        const __m128  mant = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)),
+                                                           _mm_set1_epi32(0x3F800000)));
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 t   = _mm_div_ps(_mm_sub_ps(mant, one), _mm_add_ps(mant, one));
+        const __m128 t2  = _mm_mul_ps(t, t);
+        __m128 poly = _mm_set1_ps(1.0f / 7.0f);
+        poly = _mm_add_ps(_mm_mul_ps(poly, t2), _mm_set1_ps(1.0f / 5.0f));
+        poly = _mm_add_ps(_mm_mul_ps(poly, t2), _mm_set1_ps(1.0f / 3.0f));
+        poly = _mm_add_ps(_mm_mul_ps(poly, t2), one);
+        const __m128 lnMant10 = _mm_mul_ps(_mm_mul_ps(poly, t), _mm_set1_ps(kLog10OfE2));
+        return _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(expo), _mm_set1_ps(kLog10Of2)), lnMant10);
+    }
+
+    void decibelsSse2(const float* in, float* out, int n, float floorDb)
+    {
+        const __m128 tiny = _mm_set1_ps(kTinyValue), twenty = _mm_set1_ps(20.0f);
+        const __m128 fl = _mm_set1_ps(floorDb);
+        int i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m128 x = _mm_max_ps(_mm_loadu_ps(in + i), tiny);
+            _mm_storeu_ps(out + i, _mm_max_ps(_mm_mul_ps(log10Sse2(x), twenty), fl));
+        }
+        decibelsScalar(in + i, out + i, n - i, floorDb);
+    }
+
+    float dotSse2(const float* a, const float* b, int n)
+    {
+        // Two accumulators hide the add latency
+        __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+        int i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i),     _mm_loadu_ps(b + i)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+        }
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, _mm_add_ps(acc0, acc1));
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3] + dotScalar(a + i, b + i, n - i);
+    }
+
+    //--------------------------------------------------------------------------
+    // AVX2
+    MAXIMETER_TARGET_AVX2
+    void butterflyAvx2(float* reA, float* imA, float* reB, float* imB,
+                       const float* wr, const float* wi, int n)
+    {
+        int i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m256 ar = _mm256_loadu_ps(reA + i), ai = _mm256_loadu_ps(imA + i);
+            const __m256 br = _mm256_loadu_ps(reB + i), bi = _mm256_loadu_ps(imB + i);
+            const __m256 cr = _mm256_loadu_ps(wr + i),  ci = _mm256_loadu_ps(wi + i);
+            const __m256 tr = _mm256_sub_ps(_mm256_mul_ps(br, cr), _mm256_mul_ps(bi, ci));
+            const __m256 ti = _mm256_add_ps(_mm256_mul_ps(br, ci), _mm256_mul_ps(bi, cr));
+            _mm256_storeu_ps(reB + i, _mm256_sub_ps(ar, tr));
+            _mm256_storeu_ps(imB + i, _mm256_sub_ps(ai, ti));
+            _mm256_storeu_ps(reA + i, _mm256_add_ps(ar, tr));
+            _mm256_storeu_ps(imA + i, _mm256_add_ps(ai, ti));
+        }
+        butterflySse2(reA + i, imA + i, reB + i, imB + i, wr + i, wi + i, n - i);
+    }
+
+    MAXIMETER_TARGET_AVX2
+    void magnitudeAvx2(const float* re, const float* im, float* out, int n, float scale)
+    {
+        const __m256 s = _mm256_set1_ps(scale);
+        int i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m256 r = _mm256_loadu_ps(re + i), m = _mm256_loadu_ps(im + i);
+            const __m256 p = _mm256_add_ps(_mm256_mul_ps(r, r), _mm256_mul_ps(m, m));
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_sqrt_ps(p), s));
+        }
+        magnitudeSse2(re + i, im + i, out + i, n - i, scale);
+    }
+
+    MAXIMETER_TARGET_AVX2
+    void decibelsAvx2(const float* in, float* out, int n, float floorDb)
+    {
+        const __m256  one = _mm256_set1_ps(1.0f), tiny = _mm256_set1_ps(kTinyValue);
+        const __m256  twenty = _mm256_set1_ps(20.0f), fl = _mm256_set1_ps(floorDb);
+        const __m256i mantMask = _mm256_set1_epi32(0x007FFFFF), oneBits = _mm256_set1_epi32(0x3F800000);
+        const __m256i bias = _mm256_set1_epi32(127);
+        int i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            const __m256  x    = _mm256_max_ps(_mm256_loadu_ps(in + i), tiny);
+            const __m256i bits = _mm256_castps_si256(x);
+            const __m256i expo = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), bias);
+            const __m256  mant = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, mantMask), oneBits));
+            const __m256  t    = _mm256_div_ps(_mm256_sub_ps(mant, one), _mm256_add_ps(mant, one));
+            const __m256  t2   = _mm256_mul_ps(t, t);
+            __m256 poly = _mm256_set1_ps(1.0f / 7.0f);
+            poly = _mm256_add_ps(_mm256_mul_ps(poly, t2), _mm256_set1_ps(1.0f / 5.0f));
+            poly = _mm256_add_ps(_mm256_mul_ps(poly, t2), _mm256_set1_ps(1.0f / 3.0f));
+            poly = _mm256_add_ps(_mm256_mul_ps(poly, t2), one);
+            const __m256 lg = _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(expo), _mm256_set1_ps(kLog10Of2)),
+                                            _mm256_mul_ps(_mm256_mul_ps(poly, t), _mm256_set1_ps(kLog10OfE2)));
+            _mm256_storeu_ps(out + i, _mm256_max_ps(_mm256_mul_ps(lg, twenty), fl));
+        }
+        decibelsSse2(in + i, out + i, n - i, floorDb);
+    }
+
+    MAXIMETER_TARGET_AVX2
+    float dotAvx2(const float* a, const float* b, int n)
+    {
+        __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+        int i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+            acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + i),     _mm256_loadu_ps(b + i)));
+            acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+        }
+        const __m256 acc = _mm256_add_ps(acc0, acc1);
+        const __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, half);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3] + dotSse2(a + i, b + i, n - i);
+    }
+   #endif
+
+    //==========================================================================
+   #if MAXIMETER_KERNELS_NEON
+    void butterflyNeon(float* reA, float* imA, float* reB, float* imB,
+                       const float* wr, const float* wi, int n)
+    {
+        int i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const float32x4_t ar = vld1q_f32(reA + i), ai = vld1q_f32(imA + i);
+            const float32x4_t br = vld1q_f32(reB + i), bi = vld1q_f32(imB + i);
+            const float32x4_t cr = vld1q_f32(wr + i),  ci = vld1q_f32(wi + i);
+            const float32x4_t tr = vmlsq_f32(vmulq_f32(br, cr), bi, ci);
+            const float32x4_t ti = vmlaq_f32(vmulq_f32(br, ci), bi, cr);
+            vst1q_f32(reB + i, vsubq_f32(ar, tr));
+            vst1q_f32(imB + i, vsubq_f32(ai, ti));
+            vst1q_f32(reA + i, vaddq_f32(ar, tr));
+            vst1q_f32(imA + i, vaddq_f32(ai, ti));
+        }
+        butterflyScalar(reA + i, imA + i, reB + i, imB + i, wr + i, wi + i, n - i);
+    }
+
+    void magnitudeNeon(const float* re, const float* im, float* out, int n, float scale)
+    {
+        int i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const float32x4_t r = vld1q_f32(re + i), m = vld1q_f32(im + i);
+            const float32x4_t p = vmlaq_f32(vmulq_f32(r, r), m, m);
+           #if defined(__aarch64__) || defined(_M_ARM64)
+            vst1q_f32(out + i, vmulq_n_f32(vsqrtq_f32(p), scale));
+           #else
+            // ARMv7 has no vector sqrt: x · rsqrt(x), with zero kept at zero
+            float32x4_t rs = vrsqrteq_f32(vmaxq_f32(p, vdupq_n_f32(kTinyValue)));
+            rs = vmulq_f32(rs, vrsqrtsq_f32(vmulq_f32(p, rs), rs));
+            vst1q_f32(out + i, vmulq_n_f32(vmulq_f32(p, rs), scale));
+           #endif
+        }
+        magnitudeScalar(re + i, im + i, out + i, n - i, scale);
+    }
+
+    void decibelsNeon(const float* in, float* out, int n, float floorDb)
+    {
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        int i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const float32x4_t x    = vmaxq_f32(vld1q_f32(in + i), vdupq_n_f32(kTinyValue));
+            const int32x4_t   bits = vreinterpretq_s32_f32(x);
+            const int32x4_t   expo = vsubq_s32(vshrq_n_s32(bits, 23), vdupq_n_s32(127));
+            const float32x4_t mant = vreinterpretq_f32_s32(vorrq_s32(vandq_s32(bits, vdupq_n_s32(0x007FFFFF)),
+                                                                     vdupq_n_s32(0x3F800000)));
+            // t = (m - 1) / (m + 1) via two Newton steps on the reciprocal
+            const float32x4_t den = vaddq_f32(mant, one);
+            float32x4_t rcp = vrecpeq_f32(den);
+            rcp = vmulq_f32(rcp, vrecpsq_f32(den, rcp));
+            rcp = vmulq_f32(rcp, vrecpsq_f32(den, rcp));
+            const float32x4_t t  = vmulq_f32(vsubq_f32(mant, one), rcp);
+            const float32x4_t t2 = vmulq_f32(t, t);
+            float32x4_t poly = vdupq_n_f32(1.0f / 7.0f);
+            poly = vmlaq_f32(vdupq_n_f32(1.0f / 5.0f), poly, t2);
+            poly = vmlaq_f32(vdupq_n_f32(1.0f / 3.0f), poly, t2);
+            poly = vmlaq_f32(one, poly, t2);
+            const float32x4_t lg = vmlaq_f32(vmulq_n_f32(vmulq_f32(poly, t), kLog10OfE2),
+                                             vcvtq_f32_s32(expo), vdupq_n_f32(kLog10Of2));
+            vst1q_f32(out + i, vmaxq_f32(vmulq_n_f32(lg, 20.0f), vdupq_n_f32(floorDb)));
+        }
+        decibelsScalar(in + i, out + i, n - i, floorDb);
+    }
+
+    float dotNeon(const float* a, const float* b, int n)
+    {
+        float32x4_t acc0 = vdupq_n_f32(0.0f), acc1 = vdupq_n_f32(0.0f);
+        int i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            acc0 = vmlaq_f32(acc0, vld1q_f32(a + i),     vld1q_f32(b + i));
+            acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+        }
+        const float32x4_t acc = vaddq_f32(acc0, acc1);
+        return vgetq_lane_f32(acc, 0) + vgetq_lane_f32(acc, 1)
+             + vgetq_lane_f32(acc, 2) + vgetq_lane_f32(acc, 3)
+             + dotScalar(a + i, b + i, n - i);
+    }
+   #endif
+
+    //==========================================================================
+    const Table kScalar { "Scalar", 1, butterflyScalar, magnitudeScalar, decibelsScalar, dotScalar };
+   #if MAXIMETER_KERNELS_X86
+    const Table kSse2   { "SSE2",   4, butterflySse2,   magnitudeSse2,   decibelsSse2,   dotSse2 };
+    const Table kAvx2   { "AVX2",   8, butterflyAvx2,   magnitudeAvx2,   decibelsAvx2,   dotAvx2 };
+   #endif
+   #if MAXIMETER_KERNELS_NEON
+    const Table kNeon   { "NEON",   4, butterflyNeon,   magnitudeNeon,   decibelsNeon,   dotNeon };
+   #endif
+
+    const Table& detect()
+    {
+       #if MAXIMETER_KERNELS_X86
+        if (juce::SystemStats::hasAVX2())
+            return kAvx2;
+        return kSse2;       // baseline on every x86-64 target
+       #elif MAXIMETER_KERNELS_NEON
+        return kNeon;       // mandatory on AArch64; compile-time on ARMv7
+       #else
+        return kScalar;
+       #endif
+    }
+}
+
+//==============================================================================
+const Table& get()
+{
+    static const Table& best = detect();
+    return best;
+}
+
+const Table& scalar()
+{
+    return kScalar;
+}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+//==============================================================================
+/// FFTKernels — vectorised inner loops for the spectrum pipeline.
+///
+/// Every kernel has a portable scalar version plus SSE2, AVX2 and NEON
+/// versions where the compiler can build them.  `get()` picks the widest set
+/// the running CPU supports once, on first use, so one binary runs on every
+/// machine.  All kernels accept any length; vector versions finish the tail
+/// with scalar code.
+namespace FFTKernels
+{
+    /// Radix-2 butterflies on split-complex data:
+    ///   t = w·b,  b = a − t,  a = a + t   for n consecutive values.
+    using ButterflyFn = void (*)(float* reA, float* imA, float* reB, float* imB,
+                                 const float* wr, const float* wi, int n);
+
+    /// out[i] = sqrt(re[i]² + im[i]²) · scale
+    using MagnitudeFn = void (*)(const float* re, const float* im, float* out, int n, float scale);
+
+    /// out[i] = max(floorDb, 20·log10(in[i])) — vector versions use a fast
+    /// log approximation (error about 1e-4 dB).
+    using DecibelFn = void (*)(const float* in, float* out, int n, float floorDb);
+
+    /// Σ a[i]·b[i] — weighted band sums and moments for the feature extractor.
+    using DotFn = float (*)(const float* a, const float* b, int n);
+
+    struct Table
+    {
+        const char* name;       ///< "Scalar", "SSE2", "AVX2", "NEON"
+        int         width;      ///< floats per vector
+        ButterflyFn butterfly;
+        MagnitudeFn magnitude;
+        DecibelFn   decibels;
+        DotFn       dot;
+    };
+
+    /// Best kernels for this CPU (chosen once, thread-safe).
+    const Table& get();
+
+    /// Portable reference kernels.
+    const Table& scalar();
+}
@@ -1,4 +1,5 @@
 #include "FFTProcessor.h"
+#include "FFTKernels.h"
 
 //==============================================================================
 FFTProcessor::FFTProcessor()
@@ -9,16 +10,49 @@ FFTProcessor::FFTProcessor()
 void FFTProcessor::setFFTOrder(int order)
 {
     jassert(order >= 10 && order <= 13);
+    configure(order);
+    reset();
+}
+
+void FFTProcessor::configure(int order)
+{
     fftOrder = juce::jlimit(10, 13, order);
     fftSize  = 1 << fftOrder;
 
-    fft    = std::make_unique<juce::dsp::FFT>(fftOrder);
+    engine = FFTEngine::create(fftOrder, backend);
     window = std::make_unique<juce::dsp::WindowingFunction<float>>(
         static_cast<size_t>(fftSize),
         juce::dsp::WindowingFunction<float>::hann
     );
+}
 
-    reset();
+void FFTProcessor::setBackend(FFTEngine::Backend newBackend)
+{
+    backend = newBackend;
+    setFFTOrder(fftOrder);
+}
+
+//==============================================================================
+void FFTProcessor::requestFFTOrder(int order) noexcept
+{
+    requestedOrder.store(juce::jlimit(10, 13, order), std::memory_order_relaxed);
+}
+
+void FFTProcessor::requestReset() noexcept
+{
+    resetRequested.store(true, std::memory_order_release);
+}
+
+void FFTProcessor::beginBlock() noexcept
+{
+    const int order = requestedOrder.load(std::memory_order_relaxed);
+    const bool resetNow = resetRequested.exchange(false, std::memory_order_acq_rel);
+
+    if (resetNow || order != acceptedOrder)
+    {
+        acceptedOrder = order;
+        pendingSwitch.store((samplesWritten << 4) | order, std::memory_order_release);
+    }
 }
 
 //==============================================================================
@@ -34,11 +68,44 @@ void FFTProcessor::pushSamples(const float* data, int numSamples)
         std::memcpy(fifoBuffer.data() + scope.startIndex2,
                      data + scope.blockSize1,
                      sizeof(float) * static_cast<size_t>(scope.blockSize2));
+
+    samplesWritten += scope.blockSize1 + scope.blockSize2;
 }
 
 //==============================================================================
+bool FFTProcessor::applyPendingSwitch()
+{
+    const auto next = pendingSwitch.load(std::memory_order_acquire);
+    if (next == appliedSwitch)
+        return true;
+
+    // Drop what the audio thread queued before the change
+    const auto switchAt = next >> 4;
+    const auto stale = static_cast<int>(juce::jmin<int64_t>(switchAt - samplesRead,
+                                                            fifo.getNumReady()));
+    if (stale > 0)
+    {
+        fifo.finishedRead(stale);
+        samplesRead += stale;
+    }
+
+    if (samplesRead < switchAt)
+        return false;
+
+    const int order = static_cast<int>(next & 0xf);
+    if (order != fftOrder)
+        configure(order);
+
+    clearAnalysis();
+    appliedSwitch = next;
+    return true;
+}
+
 bool FFTProcessor::processNextBlock()
 {
+    if (!applyPendingSwitch())
+        return false;
+
     // Check if we have enough samples for one FFT frame
     if (fifo.getNumReady() < fftSize)
         return false;
@@ -56,43 +123,52 @@ bool FFTProcessor::processNextBlock()
                          fifoBuffer.data() + scope.startIndex2,
                          sizeof(float) * static_cast<size_t>(scope.blockSize2));
     }
+    samplesRead += fftSize;
+
+    if (featuresEnabled)
+        std::memcpy(rawFrame.data(), fftData.data(), sizeof(float) * static_cast<size_t>(fftSize));
 
     computeSpectrum();
+
+    if (featuresEnabled)
+        features.processFrame(rawFrame.data(), spectrumData.data(), fftSize);
     return true;
 }
 
+void FFTProcessor::setFeaturesEnabled(bool shouldExtract)
+{
+    if (shouldExtract && !featuresEnabled)
+        features.reset();
+    featuresEnabled = shouldExtract;
+}
+
 //==============================================================================
 void FFTProcessor::computeSpectrum()
 {
     // Apply windowing function
     window->multiplyWithWindowingTable(fftData.data(), static_cast<size_t>(fftSize));
 
-    // Zero-pad the second half (required for in-place real FFT)
-    std::fill(fftData.begin() + fftSize, fftData.begin() + fftSize * 2, 0.0f);
-
-    // Perform forward FFT
-    fft->performRealOnlyForwardTransform(fftData.data());
-
-    // Compute magnitude spectrum (normalized)
-    const float invSize = 1.0f / static_cast<float>(fftSize);
-    const int halfSize = fftSize / 2;
+    // Forward real FFT into split-complex bins
+    engine->forward(fftData.data(), binRe.data(), binIm.data());
 
-    for (int i = 0; i < halfSize; ++i)
-    {
-        float re = fftData[static_cast<size_t>(i * 2)];
-        float im = fftData[static_cast<size_t>(i * 2 + 1)];
-        float mag = std::sqrt(re * re + im * im) * invSize * 2.0f;
-        spectrumData[static_cast<size_t>(i)] = mag;
-    }
+    // Normalised magnitude spectrum (fftSize / 2 bins, Nyquist dropped)
+    FFTKernels::get().magnitude(binRe.data(), binIm.data(), spectrumData.data(),
+                                fftSize / 2, 2.0f / static_cast<float>(fftSize));
 }
 
 //==============================================================================
 void FFTProcessor::getLogSpectrumBands(float* dest, int numBands, double sampleRate) const
 {
-    if (sampleRate <= 0.0 || numBands <= 0)
+    computeLogSpectrumBands(spectrumData.data(), fftSize / 2, dest, numBands, sampleRate);
+}
+
+void FFTProcessor::computeLogSpectrumBands(const float* spectrum, int numBins,
+                                           float* dest, int numBands, double sampleRate)
+{
+    if (sampleRate <= 0.0 || numBands <= 0 || numBins <= 0)
         return;
 
-    const int halfSize = fftSize / 2;
+    const int halfSize = numBins;
     const double nyquist = sampleRate * 0.5;
     const double minFreq = 20.0;
     const double maxFreq = std::min(20000.0, nyquist);
@@ -116,16 +192,17 @@ void FFTProcessor::getLogSpectrumBands(float* dest, int numBands, double sampleR
         int count = 0;
         for (int b = binLow; b <= binHigh; ++b)
         {
-            sum += spectrumData[static_cast<size_t>(b)];
+            sum += spectrum[b];
             ++count;
         }
 
-        float avg = (count > 0) ? (sum / static_cast<float>(count)) : 0.0f;
-
-        // Convert to dB (clamped to -60..0)
-        float db = (avg > 0.0f) ? (20.0f * std::log10(avg)) : -60.0f;
-        dest[band] = juce::jlimit(-60.0f, 0.0f, db);
+        dest[band] = (count > 0) ? (sum / static_cast<float>(count)) : 0.0f;
     }
+
+    // Convert all band averages to dB at once (clamped to -60..0)
+    FFTKernels::get().decibels(dest, dest, numBands, -60.0f);
+    for (int band = 0; band < numBands; ++band)
+        dest[band] = juce::jmin(dest[band], 0.0f);
 }
 
 //==============================================================================
@@ -133,7 +210,21 @@ void FFTProcessor::reset()
 {
     fifo.reset();
     fifoBuffer.fill(0.0f);
+    samplesWritten = samplesRead = 0;
+
+    requestedOrder.store(fftOrder, std::memory_order_relaxed);
+    resetRequested.store(false, std::memory_order_relaxed);
+    acceptedOrder = fftOrder;
+    appliedSwitch = fftOrder;
+    pendingSwitch.store(appliedSwitch, std::memory_order_release);
+
+    clearAnalysis();
+}
+
+void FFTProcessor::clearAnalysis()
+{
     fftData.fill(0.0f);
     spectrumData.fill(0.0f);
+    features.reset();
     nextBlockReady.store(false);
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "FFTEngine.h"
+#include "FeatureExtractor.h"
 #include <array>
 #include <atomic>
 
@@ -11,7 +13,18 @@
 /// `getFFTData()` / `getSpectrumData()` to read the latest frequency-domain
 /// snapshot.
 ///
+/// While the audio thread is pushing, size changes and resets go through
+/// `requestFFTOrder()` / `requestReset()`: the audio thread marks where the
+/// change applies in `beginBlock()`, and `processNextBlock()` drops the
+/// samples queued before that point and rebuilds its own state.
+///
 /// Supports configurable FFT orders (10=1024, 11=2048, 12=4096, 13=8192).
+/// The transform itself runs on a pluggable FFTEngine; magnitudes and dB
+/// values use the SIMD kernels in FFTKernels.
+///
+/// When features are enabled, every new frame is also handed to the
+/// FeatureExtractor (centroid, flux, chroma, MFCC, pitch, …) on the same
+/// thread that runs `processNextBlock()`.
 class FFTProcessor
 {
 public:
@@ -21,11 +34,26 @@ public:
     FFTProcessor();
     ~FFTProcessor() = default;
 
-    /// Set FFT order (10..13). Resets internal buffers.
+    /// Set FFT order (10..13). Resets internal buffers.  Only while nothing
+    /// else is pushing samples — the live path uses requestFFTOrder().
     void setFFTOrder(int order);
     int  getFFTOrder() const { return fftOrder; }
     int  getFFTSize() const  { return fftSize; }
 
+    /// Choose the FFT backend (GUI thread).  Resets internal buffers.
+    void setBackend(FFTEngine::Backend backend);
+    FFTEngine::Backend getBackend() const { return engine->getBackend(); }
+
+    /// Any thread.  Switch to @p order (10..13) from the next audio block on.
+    void requestFFTOrder(int order) noexcept;
+
+    /// Any thread.  Clear the analysis from the next audio block on.
+    void requestReset() noexcept;
+
+    /// Audio thread, before the block's pushSamples() calls.  Picks up
+    /// pending requests; processNextBlock() carries them out.
+    void beginBlock() noexcept;
+
     /// Call from the audio thread to push new samples.
     /// Expects interleaved or mono float samples.
     void pushSamples(const float* data, int numSamples);
@@ -42,14 +70,28 @@ public:
     /// Band boundaries are logarithmically spaced from 20 Hz to 20 kHz.
     void getLogSpectrumBands(float* dest, int numBands, double sampleRate) const;
 
-    /// Reset all buffers
+    /// The same mapping for a spectrum copied out of a processor
+    /// (@p numBins = fftSize / 2).
+    static void computeLogSpectrumBands(const float* spectrum, int numBins,
+                                        float* dest, int numBands, double sampleRate);
+
+    /// Run the FeatureExtractor on every frame from now on (call from the
+    /// thread that runs processNextBlock()).  Switching on clears its state.
+    void setFeaturesEnabled(bool shouldExtract);
+    bool areFeaturesEnabled() const { return featuresEnabled; }
+
+    FeatureExtractor&       getFeatureExtractor()       { return features; }
+    const FeatureExtractor& getFeatureExtractor() const { return features; }
+
+    /// Reset all buffers.  Same threading rule as setFFTOrder().
     void reset();
 
 private:
     int fftOrder = kDefaultFFTOrder;
     int fftSize  = 1 << kDefaultFFTOrder;
 
-    std::unique_ptr<juce::dsp::FFT>              fft;
+    FFTEngine::Backend                           backend = FFTEngine::Backend::Auto;
+    std::unique_ptr<FFTEngine>                   engine;
     std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
 
     // Lock-free FIFO for pushing samples from audio thread
@@ -57,11 +99,32 @@ private:
     std::array<float, kMaxFFTSize * 2> fifoBuffer {};
 
     // FFT working buffers (GUI thread only)
-    std::array<float, kMaxFFTSize * 2> fftData {};       // input → output (in-place)
-    std::array<float, kMaxFFTSize>     spectrumData {};   // magnitude spectrum
+    std::array<float, kMaxFFTSize>         fftData {};       // windowed input frame
+    std::array<float, kMaxFFTSize / 2 + 1> binRe {}, binIm {};  // split-complex output
+    std::array<float, kMaxFFTSize>         spectrumData {};  // magnitude spectrum
+
+    // Per-frame features (un-windowed copy of the frame for pitch)
+    FeatureExtractor                       features;
+    bool                                   featuresEnabled = false;
+    std::array<float, kMaxFFTSize>         rawFrame {};
 
     std::atomic<bool> nextBlockReady { false };
 
+    // Requests from other threads, picked up by beginBlock()
+    std::atomic<int>  requestedOrder { kDefaultFFTOrder };
+    std::atomic<bool> resetRequested { false };
+
+    // Where the last accepted change starts: (FIFO sample count << 4) | order.
+    // Written by beginBlock(), applied by processNextBlock().
+    std::atomic<int64_t> pendingSwitch { kDefaultFFTOrder };
+    int64_t appliedSwitch  = kDefaultFFTOrder;  // consumer side
+    int     acceptedOrder  = kDefaultFFTOrder;  // audio side
+    int64_t samplesWritten = 0;                 // audio side
+    int64_t samplesRead    = 0;                 // consumer side
+
+    void configure(int order);
+    void clearAnalysis();
+    bool applyPendingSwitch();
     void computeSpectrum();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FFTProcessor)
@@ -0,0 +1,328 @@
+#include "FeatureExtractor.h"
+#include "FFTKernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr float  kRolloffFraction = 0.85f;
+    constexpr float  kFlatnessFloorDb = -200.0f;
+    constexpr double kMelLowHz        = 20.0;
+    constexpr int    kLowestMidiNote  = 24;      // C1, 32.7 Hz
+    constexpr int    kHighestMidiNote = 107;     // B7, 3951 Hz
+    constexpr int    kMaxYinWindow    = 2048;
+    constexpr float  kYinThreshold    = 0.15f;
+    constexpr double kMaxPitchHz      = 2000.0;
+    constexpr float  kSilenceEnergy   = 1.0e-8f; // mean square below this = unvoiced
+
+    double hzToMel(double hz)  { return 2595.0 * std::log10(1.0 + hz / 700.0); }
+    double melToHz(double mel) { return 700.0 * (std::pow(10.0, mel / 2595.0) - 1.0); }
+}
+
+//==============================================================================
+void FeatureExtractor::Features::writeTo(juce::DynamicObject& audioObj) const
+{
+    audioObj.setProperty("spectral_centroid", centroidHz);
+    audioObj.setProperty("spectral_flux",     flux);
+    audioObj.setProperty("spectral_rolloff",  rolloffHz);
+    audioObj.setProperty("spectral_flatness", flatness);
+
+    juce::Array<juce::var> chromaArr, mfccArr;
+    for (auto c : chroma) chromaArr.add(c);
+    for (auto c : mfcc)   mfccArr.add(c);
+    audioObj.setProperty("chroma", chromaArr);
+    audioObj.setProperty("mfcc",   mfccArr);
+
+    audioObj.setProperty("pitch_hz",         pitchHz);
+    audioObj.setProperty("pitch_confidence", pitchConfidence);
+}
+
+//==============================================================================
+FeatureExtractor::FeatureExtractor()
+{
+    // Orthonormal DCT-II over the log mel energies
+    const double n = static_cast<double>(kNumMelBands);
+    for (int i = 0; i < kNumMFCC; ++i)
+    {
+        const double scale = std::sqrt((i == 0 ? 1.0 : 2.0) / n);
+        for (int b = 0; b < kNumMelBands; ++b)
+            dct[static_cast<size_t>(i * kNumMelBands + b)] = static_cast<float>(
+                scale * std::cos(juce::MathConstants<double>::pi * i * (b + 0.5) / n));
+    }
+}
+
+void FeatureExtractor::setSampleRate(double sr)
+{
+    if (sr > 0.0)
+        requestedRate.store(sr);
+}
+
+void FeatureExtractor::reset()
+{
+    resetPending.store(true);
+
+    const juce::SpinLock::ScopedLockType lock(resultLock);
+    latest = {};
+}
+
+FeatureExtractor::Features FeatureExtractor::getFeatures() const
+{
+    const juce::SpinLock::ScopedLockType lock(resultLock);
+    return latest;
+}
+
+//==============================================================================
+void FeatureExtractor::configure(int fftSize, double sampleRate)
+{
+    configuredSize = fftSize;
+    configuredRate = sampleRate;
+    numBins        = fftSize / 2;
+    hasPrevious    = false;
+
+    const double binWidth = sampleRate / fftSize;
+    binHz.resize(static_cast<size_t>(numBins));
+    power.assign(static_cast<size_t>(numBins), 0.0f);
+    previous.assign(static_cast<size_t>(numBins), 0.0f);
+    scratch.assign(static_cast<size_t>(numBins), 0.0f);
+    for (int k = 0; k < numBins; ++k)
+        binHz[static_cast<size_t>(k)] = static_cast<float>(k * binWidth);
+
+    // Triangular mel filters, equally spaced on the HTK mel scale.  Each band
+    // keeps its own contiguous weight run so its energy is one dot product.
+    melWeights.clear();
+    {
+        const double melLo = hzToMel(kMelLowHz);
+        const double melHi = hzToMel(sampleRate * 0.5);
+        std::array<double, kNumMelBands + 2> edges {};
+        for (size_t i = 0; i < edges.size(); ++i)
+            edges[i] = melToHz(melLo + (melHi - melLo) * static_cast<double>(i) / (kNumMelBands + 1));
+
+        for (int b = 0; b < kNumMelBands; ++b)
+        {
+            const double lo = edges[static_cast<size_t>(b)];
+            const double mid = edges[static_cast<size_t>(b + 1)];
+            const double hi = edges[static_cast<size_t>(b + 2)];
+
+            auto& band = melBands[static_cast<size_t>(b)];
+            band.start = juce::jlimit(0, numBins, static_cast<int>(std::floor(lo / binWidth)) + 1);
+            const int end = juce::jlimit(band.start, numBins, static_cast<int>(std::ceil(hi / binWidth)));
+            band.count = end - band.start;
+            band.weightOffset = static_cast<int>(melWeights.size());
+
+            for (int k = band.start; k < end; ++k)
+            {
+                const double f = k * binWidth;
+                const double w = f <= mid ? (f - lo) / (mid - lo) : (hi - f) / (hi - mid);
+                melWeights.push_back(static_cast<float>(juce::jmax(0.0, w)));
+            }
+        }
+    }
+
+    // Semitone bin ranges for chroma.  Notes narrower than a bin are left
+    // out: their energy would land on a neighbour's pitch class, so at small
+    // FFT sizes chroma comes from the harmonics the FFT does resolve.
+    semitones.clear();
+    for (int note = kLowestMidiNote; note <= kHighestMidiNote; ++note)
+    {
+        const double lo = 440.0 * std::pow(2.0, (note - 69.5) / 12.0);
+        const double hi = 440.0 * std::pow(2.0, (note - 68.5) / 12.0);
+        if (hi - lo < binWidth)
+            continue;
+        const int start = juce::jlimit(0, numBins, static_cast<int>(std::ceil(lo / binWidth)));
+        const int end   = juce::jlimit(start, numBins, static_cast<int>(std::ceil(hi / binWidth)));
+        if (end > start)
+            semitones.push_back({ start, end - start, note % 12 });
+    }
+
+    // YIN works on the newest 2W samples of the frame
+    yinWindow = juce::jmin(kMaxYinWindow, fftSize / 2);
+    const int corrOrder = juce::roundToInt(std::log2(2.0 * yinWindow));
+    yinFft = std::make_unique<juce::dsp::FFT>(corrOrder);
+    yinA.assign(static_cast<size_t>(4 * yinWindow), 0.0f);
+    yinX.assign(static_cast<size_t>(4 * yinWindow), 0.0f);
+    yinDiff.assign(static_cast<size_t>(yinWindow), 0.0f);
+}
+
+//==============================================================================
+void FeatureExtractor::processFrame(const float* samples, const float* magnitudes, int fftSize)
+{
+    if (samples == nullptr || magnitudes == nullptr || fftSize < 64)
+        return;
+
+    const double sr = requestedRate.load();
+    if (fftSize != configuredSize || sr != configuredRate)
+        configure(fftSize, sr);
+
+    if (resetPending.exchange(false))
+        hasPrevious = false;
+
+    Features result;
+    computeSpectral(magnitudes, result);
+    computePitch(samples + (fftSize - 2 * yinWindow), result);
+
+    const juce::SpinLock::ScopedLockType lock(resultLock);
+    latest = result;
+}
+
+//==============================================================================
+void FeatureExtractor::computeSpectral(const float* mag, Features& out)
+{
+    const auto& k = FFTKernels::get();
+    const int n = numBins;
+
+    // Power and the rectified difference against the previous frame.  Plain
+    // element-wise loops; the compiler vectorises them.
+    float magSum = 0.0f, flux = 0.0f;
+    for (int i = 0; i < n; ++i)
+    {
+        power[static_cast<size_t>(i)] = mag[i] * mag[i];
+        magSum += mag[i];
+        flux   += juce::jmax(0.0f, mag[i] - previous[static_cast<size_t>(i)]);
+    }
+    out.flux = hasPrevious ? flux : 0.0f;
+    std::copy(mag, mag + n, previous.begin());
+    hasPrevious = true;
+
+    const float totalPower = k.dot(mag, mag, n);
+    if (magSum <= 0.0f || totalPower <= 0.0f)
+        return;
+
+    out.centroidHz = k.dot(mag, binHz.data(), n) / magSum;
+
+    // Rolloff: first bin where the running power passes the fraction
+    {
+        const float target = kRolloffFraction * totalPower;
+        float running = 0.0f;
+        int bin = 0;
+        for (; bin < n - 1; ++bin)
+        {
+            running += power[static_cast<size_t>(bin)];
+            if (running >= target)
+                break;
+        }
+        out.rolloffHz = binHz[static_cast<size_t>(bin)];
+    }
+
+    // Flatness from the mean dB (= log of the geometric mean), DC excluded
+    {
+        k.decibels(mag + 1, scratch.data(), n - 1, kFlatnessFloorDb);
+        float dbSum = 0.0f;
+        for (int i = 0; i < n - 1; ++i)
+            dbSum += scratch[static_cast<size_t>(i)];
+        const float geometric  = std::pow(10.0f, dbSum / static_cast<float>(n - 1) / 10.0f);
+        const float arithmetic = (totalPower - power[0]) / static_cast<float>(n - 1);
+        out.flatness = arithmetic > 0.0f ? juce::jlimit(0.0f, 1.0f, geometric / arithmetic) : 0.0f;
+    }
+
+    // Chroma: per-semitone power (contiguous bins = one dot product each)
+    {
+        float peak = 0.0f;
+        for (const auto& s : semitones)
+        {
+            auto& c = out.chroma[static_cast<size_t>(s.pitchClass)];
+            c += k.dot(mag + s.start, mag + s.start, s.count);
+            peak = juce::jmax(peak, c);
+        }
+        if (peak > 0.0f)
+            for (auto& c : out.chroma)
+                c /= peak;
+    }
+
+    // MFCC: mel energies -> ln -> DCT-II
+    {
+        std::array<float, kNumMelBands> logMel {};
+        for (int b = 0; b < kNumMelBands; ++b)
+        {
+            const auto& band = melBands[static_cast<size_t>(b)];
+            const float e = band.count > 0
+                ? k.dot(melWeights.data() + band.weightOffset, power.data() + band.start, band.count)
+                : 0.0f;
+            logMel[static_cast<size_t>(b)] = std::log(juce::jmax(e, 1.0e-10f));
+        }
+        for (int i = 0; i < kNumMFCC; ++i)
+            out.mfcc[static_cast<size_t>(i)] = k.dot(dct.data() + i * kNumMelBands, logMel.data(), kNumMelBands);
+    }
+}
+
+//==============================================================================
+void FeatureExtractor::computePitch(const float* x, Features& out)
+{
+    const int w = yinWindow;
+    const int m = 2 * w;
+    const auto& k = FFTKernels::get();
+
+    const float e1 = k.dot(x, x, w);
+    if (e1 < kSilenceEnergy * static_cast<float>(w))
+        return;
+
+    // Cross-correlation c(τ) = Σ_{j<W} x[j]·x[j+τ] as IFFT(conj(A)·X), with
+    // A the first W samples zero-padded to 2W.  No wrap for τ < W.
+    std::fill(yinA.begin(), yinA.end(), 0.0f);
+    std::fill(yinX.begin(), yinX.end(), 0.0f);
+    std::copy(x, x + w, yinA.begin());
+    std::copy(x, x + m, yinX.begin());
+    yinFft->performRealOnlyForwardTransform(yinA.data());
+    yinFft->performRealOnlyForwardTransform(yinX.data());
+
+    for (int i = 0; i < m; ++i)
+    {
+        const float ar = yinA[static_cast<size_t>(2 * i)], ai = yinA[static_cast<size_t>(2 * i + 1)];
+        const float xr = yinX[static_cast<size_t>(2 * i)], xi = yinX[static_cast<size_t>(2 * i + 1)];
+        yinX[static_cast<size_t>(2 * i)]     = ar * xr + ai * xi;
+        yinX[static_cast<size_t>(2 * i + 1)] = ar * xi - ai * xr;
+    }
+    yinFft->performRealOnlyInverseTransform(yinX.data());
+
+    // c(0) is e1 by definition — calibrates whatever scaling the backend uses
+    const float c0 = yinX[0];
+    if (c0 <= 0.0f)
+        return;
+    const float scale = e1 / c0;
+
+    // Cumulative mean normalised difference d'(τ), energies kept running
+    float e2 = e1, runningSum = 0.0f;
+    yinDiff[0] = 1.0f;
+    for (int tau = 1; tau < w; ++tau)
+    {
+        const float leaving  = x[tau - 1];
+        const float entering = x[tau - 1 + w];
+        e2 += entering * entering - leaving * leaving;
+
+        const float d = juce::jmax(0.0f, e1 + e2 - 2.0f * scale * yinX[static_cast<size_t>(tau)]);
+        runningSum += d;
+        yinDiff[static_cast<size_t>(tau)] = runningSum > 0.0f ? d * static_cast<float>(tau) / runningSum : 1.0f;
+    }
+
+    // First dip under the threshold (its local minimum), else the global one
+    const int minTau = juce::jmax(2, static_cast<int>(configuredRate / kMaxPitchHz));
+    int best = -1;
+    for (int tau = minTau; tau < w - 1; ++tau)
+    {
+        if (yinDiff[static_cast<size_t>(tau)] < kYinThreshold)
+        {
+            while (tau + 1 < w - 1 && yinDiff[static_cast<size_t>(tau + 1)] < yinDiff[static_cast<size_t>(tau)])
+                ++tau;
+            best = tau;
+            break;
+        }
+    }
+    if (best < 0)
+    {
+        best = minTau;
+        for (int tau = minTau + 1; tau < w - 1; ++tau)
+            if (yinDiff[static_cast<size_t>(tau)] < yinDiff[static_cast<size_t>(best)])
+                best = tau;
+    }
+    if (best < 1 || best >= w - 1)
+        return;
+
+    // Parabolic interpolation around the minimum
+    const float y0 = yinDiff[static_cast<size_t>(best - 1)];
+    const float y1 = yinDiff[static_cast<size_t>(best)];
+    const float y2 = yinDiff[static_cast<size_t>(best + 1)];
+    const float denom = y0 - 2.0f * y1 + y2;
+    const float shift = std::abs(denom) > 1.0e-12f ? juce::jlimit(-0.5f, 0.5f, 0.5f * (y0 - y2) / denom) : 0.0f;
+
+    out.pitchHz         = static_cast<float>(configuredRate / (best + shift));
+    out.pitchConfidence = juce::jlimit(0.0f, 1.0f, 1.0f - y1);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/// FeatureExtractor — per-frame audio descriptors for plugins.
+///
+/// Runs once per FFT analysis hop (FFTProcessor calls `processFrame()` with
+/// the frame it has just transformed) and derives:
+///
+///   - spectral centroid, positive flux, 85 % rolloff and flatness
+///   - 12-bin chroma (semitone energies folded to pitch classes, max = 1)
+///   - 13 MFCCs (40 HTK mel bands, natural log, orthonormal DCT-II)
+///   - a YIN pitch estimate with its confidence (1 − CMNDF minimum)
+///
+/// Band sums and moments use the FFTKernels dot kernel; the YIN difference
+/// function comes from an FFT cross-correlation instead of the O(W²) loop.
+///
+/// `processFrame()` runs on whichever thread drives the FFTProcessor; any
+/// thread may read the latest results with `getFeatures()`.
+class FeatureExtractor
+{
+public:
+    static constexpr int kChromaBins  = 12;
+    static constexpr int kNumMFCC     = 13;
+    static constexpr int kNumMelBands = 40;
+
+    struct Features
+    {
+        float centroidHz = 0.0f;    ///< magnitude-weighted mean frequency
+        float flux       = 0.0f;    ///< Σ max(0, |X| − |X_prev|) over bins
+        float rolloffHz  = 0.0f;    ///< frequency below which 85 % of the power lies
+        float flatness   = 0.0f;    ///< geometric / arithmetic mean power, 0..1
+        std::array<float, kChromaBins> chroma {};   ///< C, C#, … B
+        std::array<float, kNumMFCC>    mfcc {};
+        float pitchHz         = 0.0f;   ///< 0 = unvoiced / silent
+        float pitchConfidence = 0.0f;   ///< 0..1
+
+        /// Add the fields to a plugin audio snapshot (flat keys, as in
+        /// AudioData: "spectral_centroid", "chroma", "mfcc", "pitch_hz", …).
+        void writeTo(juce::DynamicObject& audioObj) const;
+    };
+
+    FeatureExtractor();
+    ~FeatureExtractor() = default;
+
+    void setSampleRate(double sr);
+
+    /// Analysis thread.  @p samples is the un-windowed time-domain frame and
+    /// @p magnitudes its linear spectrum (fftSize / 2 bins).
+    void processFrame(const float* samples, const float* magnitudes, int fftSize);
+
+    /// Latest results (zeros before the first frame and after reset()).
+    Features getFeatures() const;
+
+    /// Forget the previous spectrum (flux) and clear the results.
+    void reset();
+
+private:
+    void configure(int fftSize, double sampleRate);
+    void computeSpectral(const float* magnitudes, Features& out);
+    void computePitch(const float* samples, Features& out);
+
+    std::atomic<double> requestedRate { 44100.0 };
+    std::atomic<bool>   resetPending  { false };
+
+    // Tables for the running configuration (analysis thread only)
+    int    configuredSize = 0;
+    double configuredRate = 0.0;
+    int    numBins = 0;
+
+    std::vector<float> binHz, power, previous, scratch;
+    bool               hasPrevious = false;
+
+    struct WeightedRange { int start = 0, count = 0, weightOffset = 0; };
+    std::array<WeightedRange, kNumMelBands> melBands {};
+    std::vector<float>                      melWeights;
+    std::array<float, kNumMFCC * kNumMelBands> dct {};
+
+    struct Semitone { int start = 0, count = 0, pitchClass = 0; };
+    std::vector<Semitone> semitones;
+
+    // YIN: window W, lags 0..W-1, cross-correlation by FFT of size 2W
+    int                                yinWindow = 0;
+    std::unique_ptr<juce::dsp::FFT>    yinFft;
+    std::vector<float>                 yinA, yinX, yinDiff;
+
+    mutable juce::SpinLock resultLock;
+    Features               latest;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FeatureExtractor)
+};
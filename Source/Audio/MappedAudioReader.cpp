@@ -0,0 +1,455 @@
+#include "MappedAudioReader.h"
+#include <cstdint>
+#include <cstring>
+
+#if JUCE_WINDOWS
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define MAXIMETER_PCM_X86 1
+ #include <immintrin.h>
+#else
+ #define MAXIMETER_PCM_X86 0
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+ #define MAXIMETER_PCM_NEON 1
+ #include <arm_neon.h>
+#else
+ #define MAXIMETER_PCM_NEON 0
+#endif
+
+// The 24-bit shuffles need SSSE3; compiled per function and only run after
+// a CPUID check, like the AVX2 FFT kernels.
+#if MAXIMETER_PCM_X86 && (defined(__GNUC__) || defined(__clang__))
+ #define MAXIMETER_TARGET_SSSE3 __attribute__((target("ssse3")))
+#else
+ #define MAXIMETER_TARGET_SSSE3
+#endif
+
+namespace
+{
+   #if JUCE_LITTLE_ENDIAN
+    constexpr bool kLittleEndianHost = true;
+   #else
+    constexpr bool kLittleEndianHost = false;
+   #endif
+
+    //==========================================================================
+    // Scalar reference — little-endian PCM to the left-justified int32 that
+    // AudioFormatReader::readSamples() hands out.  32-bit files are copied
+    // as they are, which covers float data too (the reader's output then
+    // holds float bits).
+    //==========================================================================
+    template <int Bytes>
+    inline int loadSample(const uint8_t* p)
+    {
+        if constexpr (Bytes == 2)
+            return static_cast<int>(static_cast<uint32_t>(p[0]) << 16 | static_cast<uint32_t>(p[1]) << 24);
+        else if constexpr (Bytes == 3)
+            return static_cast<int>(static_cast<uint32_t>(p[0]) << 8 | static_cast<uint32_t>(p[1]) << 16
+                                    | static_cast<uint32_t>(p[2]) << 24);
+        else
+        {
+            int v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+    }
+
+    template <int Bytes>
+    void channelScalar(const uint8_t* src, int stride, int* dst, int n)
+    {
+        for (int i = 0; i < n; ++i, src += stride)
+            dst[i] = loadSample<Bytes>(src);
+    }
+
+    template <int Bytes>
+    void stereoScalar(const uint8_t* src, int* l, int* r, int n)
+    {
+        for (int i = 0; i < n; ++i, src += 2 * Bytes)
+        {
+            l[i] = loadSample<Bytes>(src);
+            r[i] = loadSample<Bytes>(src + Bytes);
+        }
+    }
+
+#if MAXIMETER_PCM_X86
+    //==========================================================================
+    // SSE2 / SSSE3
+    //==========================================================================
+    inline __m128i load128(const uint8_t* p)          { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    inline void    store128(int* p, __m128i v)        { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    inline void    store128(int* p, __m128 v)         { _mm_storeu_ps(reinterpret_cast<float*>(p), v); }
+
+    void stereo16Sse2(const uint8_t* src, int* l, int* r, int n)
+    {
+        // Each 32-bit lane is one frame: L in the low half, R in the high
+        const __m128i high = _mm_set1_epi32(static_cast<int>(0xffff0000u));
+        int i = 0;
+        for (; i + 4 <= n; i += 4, src += 16)
+        {
+            const __m128i v = load128(src);
+            store128(l + i, _mm_slli_epi32(v, 16));
+            store128(r + i, _mm_and_si128(v, high));
+        }
+        stereoScalar<2>(src, l + i, r + i, n - i);
+    }
+
+    void mono16Sse2(const uint8_t* src, int* dst, int n)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 8 <= n; i += 8, src += 16)
+        {
+            const __m128i v = load128(src);
+            store128(dst + i,     _mm_unpacklo_epi16(zero, v));
+            store128(dst + i + 4, _mm_unpackhi_epi16(zero, v));
+        }
+        channelScalar<2>(src, 2, dst + i, n - i);
+    }
+
+    void stereo32Sse2(const uint8_t* src, int* l, int* r, int n)
+    {
+        int i = 0;
+        for (; i + 4 <= n; i += 4, src += 32)
+        {
+            const __m128 a = _mm_loadu_ps(reinterpret_cast<const float*>(src));        // L0 R0 L1 R1
+            const __m128 b = _mm_loadu_ps(reinterpret_cast<const float*>(src + 16));   // L2 R2 L3 R3
+            store128(l + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+            store128(r + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+        stereoScalar<4>(src, l + i, r + i, n - i);
+    }
+
+    /// Four packed 3-byte samples -> the top three bytes of four lanes
+    MAXIMETER_TARGET_SSSE3
+    inline __m128i spread24(__m128i v)
+    {
+        return _mm_shuffle_epi8(v, _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11));
+    }
+
+    MAXIMETER_TARGET_SSSE3
+    void stereo24Ssse3(const uint8_t* src, int* l, int* r, int n)
+    {
+        int i = 0;
+        // The second load ends 4 bytes past the 24 consumed, so keep a frame spare
+        for (; i + 5 <= n; i += 4, src += 24)
+        {
+            const __m128 a = _mm_castsi128_ps(spread24(load128(src)));        // L0 R0 L1 R1
+            const __m128 b = _mm_castsi128_ps(spread24(load128(src + 12)));   // L2 R2 L3 R3
+            store128(l + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+            store128(r + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+        stereoScalar<3>(src, l + i, r + i, n - i);
+    }
+
+    MAXIMETER_TARGET_SSSE3
+    void mono24Ssse3(const uint8_t* src, int* dst, int n)
+    {
+        int i = 0;
+        // 16-byte loads for 12 bytes of samples
+        for (; i + 6 <= n; i += 4, src += 12)
+            store128(dst + i, spread24(load128(src)));
+        channelScalar<3>(src, 3, dst + i, n - i);
+    }
+#endif
+
+#if MAXIMETER_PCM_NEON
+    //==========================================================================
+    // NEON
+    //==========================================================================
+    void stereo16Neon(const uint8_t* src, int* l, int* r, int n)
+    {
+        int i = 0;
+        for (; i + 4 <= n; i += 4, src += 16)
+        {
+            const int16x4x2_t v = vld2_s16(reinterpret_cast<const int16_t*>(src));
+            vst1q_s32(l + i, vshll_n_s16(v.val[0], 16));
+            vst1q_s32(r + i, vshll_n_s16(v.val[1], 16));
+        }
+        stereoScalar<2>(src, l + i, r + i, n - i);
+    }
+
+    void mono16Neon(const uint8_t* src, int* dst, int n)
+    {
+        int i = 0;
+        for (; i + 4 <= n; i += 4, src += 8)
+            vst1q_s32(dst + i, vshll_n_s16(vld1_s16(reinterpret_cast<const int16_t*>(src)), 16));
+        channelScalar<2>(src, 2, dst + i, n - i);
+    }
+
+    void stereo32Neon(const uint8_t* src, int* l, int* r, int n)
+    {
+        int i = 0;
+        for (; i + 4 <= n; i += 4, src += 32)
+        {
+            const int32x4x2_t v = vld2q_s32(reinterpret_cast<const int32_t*>(src));
+            vst1q_s32(l + i, v.val[0]);
+            vst1q_s32(r + i, v.val[1]);
+        }
+        stereoScalar<4>(src, l + i, r + i, n - i);
+    }
+#endif
+
+    //==========================================================================
+    // Dispatch
+    //==========================================================================
+   #if MAXIMETER_PCM_X86
+    bool hasSsse3()
+    {
+        static const bool ssse3 = juce::SystemStats::hasSSSE3();
+        return ssse3;
+    }
+   #endif
+
+    void readStereo(int bytes, const uint8_t* src, int* l, int* r, int n)
+    {
+        switch (bytes)
+        {
+           #if MAXIMETER_PCM_X86
+            case 2:  stereo16Sse2(src, l, r, n); break;
+            case 3:  if (hasSsse3()) stereo24Ssse3(src, l, r, n); else stereoScalar<3>(src, l, r, n); break;
+            default: stereo32Sse2(src, l, r, n); break;
+           #elif MAXIMETER_PCM_NEON
+            case 2:  stereo16Neon(src, l, r, n); break;
+            case 3:  stereoScalar<3>(src, l, r, n); break;
+            default: stereo32Neon(src, l, r, n); break;
+           #else
+            case 2:  stereoScalar<2>(src, l, r, n); break;
+            case 3:  stereoScalar<3>(src, l, r, n); break;
+            default: stereoScalar<4>(src, l, r, n); break;
+           #endif
+        }
+    }
+
+    void readMono(int bytes, const uint8_t* src, int* dst, int n)
+    {
+        switch (bytes)
+        {
+           #if MAXIMETER_PCM_X86
+            case 2:  mono16Sse2(src, dst, n); break;
+            case 3:  if (hasSsse3()) mono24Ssse3(src, dst, n); else channelScalar<3>(src, 3, dst, n); break;
+           #elif MAXIMETER_PCM_NEON
+            case 2:  mono16Neon(src, dst, n); break;
+            case 3:  channelScalar<3>(src, 3, dst, n); break;
+           #else
+            case 2:  channelScalar<2>(src, 2, dst, n); break;
+            case 3:  channelScalar<3>(src, 3, dst, n); break;
+           #endif
+            default: std::memcpy(dst, src, static_cast<size_t>(n) * 4); break;
+        }
+    }
+
+    void readStrided(int bytes, const uint8_t* src, int stride, int* dst, int n)
+    {
+        switch (bytes)
+        {
+            case 2:  channelScalar<2>(src, stride, dst, n); break;
+            case 3:  channelScalar<3>(src, stride, dst, n); break;
+            default: channelScalar<4>(src, stride, dst, n); break;
+        }
+    }
+
+    //==========================================================================
+    // Paging hints
+    //==========================================================================
+   #if JUCE_WINDOWS
+    /// WIN32_MEMORY_RANGE_ENTRY, which older SDK targets do not declare
+    struct MemoryRange
+    {
+        void*  address;
+        SIZE_T bytes;
+    };
+   #endif
+
+    /// Ask the OS to start reading @p bytes at @p p into memory
+    void willNeed(const void* p, juce::int64 bytes)
+    {
+       #if JUCE_WINDOWS
+        // PrefetchVirtualMemory is Windows 8+; looked up so older systems just skip it
+        using PrefetchFn = BOOL (WINAPI*)(HANDLE, ULONG_PTR, MemoryRange*, ULONG);
+        static const auto prefetch = reinterpret_cast<PrefetchFn>(
+            ::GetProcAddress(::GetModuleHandleW(L"kernel32.dll"), "PrefetchVirtualMemory"));
+
+        if (prefetch != nullptr)
+        {
+            MemoryRange range { const_cast<void*>(p), static_cast<SIZE_T>(bytes) };
+            prefetch(::GetCurrentProcess(), 1, &range, 0);
+        }
+       #else
+        // madvise() wants a page-aligned start
+        static const auto pageSize = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+        const auto start = reinterpret_cast<uintptr_t>(p) & ~(pageSize - 1);
+        ::madvise(reinterpret_cast<void*>(start),
+                  static_cast<size_t>(reinterpret_cast<uintptr_t>(p) + static_cast<uintptr_t>(bytes) - start),
+                  MADV_WILLNEED);
+       #endif
+    }
+
+    /// Tell the OS the whole mapping will be read front to back
+    void adviseSequential(const void* p, juce::int64 bytes)
+    {
+       #if JUCE_WINDOWS
+        juce::ignoreUnused(p, bytes);   // no equivalent for views; willNeed() does the work
+       #else
+        static const auto pageSize = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+        const auto start = reinterpret_cast<uintptr_t>(p) & ~(pageSize - 1);
+        ::madvise(reinterpret_cast<void*>(start),
+                  static_cast<size_t>(reinterpret_cast<uintptr_t>(p) + static_cast<uintptr_t>(bytes) - start),
+                  MADV_SEQUENTIAL);
+       #endif
+    }
+
+    //==========================================================================
+    /// Reaches the mapping of a MemoryMappedAudioFormatReader, which JUCE
+    /// only exposes to subclasses.
+    struct MappedAccess : juce::MemoryMappedAudioFormatReader
+    {
+        static const uint8_t* firstFrame(const juce::MemoryMappedAudioFormatReader& r)
+        {
+            return static_cast<const uint8_t*>((r.*&MappedAccess::sampleToPointer)(0));
+        }
+
+        static int frameSize(const juce::MemoryMappedAudioFormatReader& r)
+        {
+            return r.*&MappedAccess::bytesPerFrame;
+        }
+    };
+
+    //==========================================================================
+    /// Reads a fully mapped file.  Little-endian PCM is converted here;
+    /// anything else is left to JUCE's mapped reader.
+    class MappedReader final : public juce::AudioFormatReader
+    {
+    public:
+        MappedReader(std::unique_ptr<juce::MemoryMappedAudioFormatReader> source, bool littleEndianPcm)
+            : AudioFormatReader(nullptr, source->getFormatName()),
+              mapped(std::move(source))
+        {
+            sampleRate            = mapped->sampleRate;
+            bitsPerSample         = mapped->bitsPerSample;
+            lengthInSamples       = mapped->lengthInSamples;
+            numChannels           = mapped->numChannels;
+            usesFloatingPointData = mapped->usesFloatingPointData;
+            metadataValues        = mapped->metadataValues;
+
+            data           = MappedAccess::firstFrame(*mapped);
+            bytesPerFrame  = MappedAccess::frameSize(*mapped);
+            bytesPerSample = static_cast<int>(bitsPerSample) / 8;
+            prefetchFrames = juce::jmax<juce::int64>(1, static_cast<juce::int64>(sampleRate * MappedAudio::kPrefetchSeconds));
+
+            convertHere = littleEndianPcm && kLittleEndianHost
+                       && (bitsPerSample == 16 || bitsPerSample == 24 || bitsPerSample == 32)
+                       && bytesPerFrame == bytesPerSample * static_cast<int>(numChannels);
+
+            adviseSequential(data, lengthInSamples * bytesPerFrame);
+        }
+
+        bool readSamples(int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                         juce::int64 startSampleInFile, int numSamples) override
+        {
+            clearSamplesBeyondAvailableLength(destChannels, numDestChannels, startOffsetInDestBuffer,
+                                              startSampleInFile, numSamples, lengthInSamples);
+            if (numSamples <= 0)
+                return true;
+
+            prefetchAhead(startSampleInFile, numSamples);
+
+            if (!convertHere)
+                return mapped->readSamples(destChannels, numDestChannels, startOffsetInDestBuffer,
+                                           startSampleInFile, numSamples);
+
+            const uint8_t* src = data + startSampleInFile * bytesPerFrame;
+            const int fileChannels = static_cast<int>(numChannels);
+            int c = 0;
+
+            if (fileChannels == 2 && numDestChannels >= 2
+                && destChannels[0] != nullptr && destChannels[1] != nullptr)
+            {
+                readStereo(bytesPerSample, src, destChannels[0] + startOffsetInDestBuffer,
+                           destChannels[1] + startOffsetInDestBuffer, numSamples);
+                c = 2;
+            }
+
+            for (; c < numDestChannels; ++c)
+            {
+                int* dst = destChannels[c];
+                if (dst == nullptr)
+                    continue;
+                dst += startOffsetInDestBuffer;
+
+                if (c >= fileChannels)
+                    std::memset(dst, 0, static_cast<size_t>(numSamples) * sizeof(int));
+                else if (fileChannels == 1)
+                    readMono(bytesPerSample, src, dst, numSamples);
+                else
+                    readStrided(bytesPerSample, src + c * bytesPerSample, bytesPerFrame, dst, numSamples);
+            }
+            return true;
+        }
+
+    private:
+        /// Keep the pages for the next kPrefetchSeconds on their way in.  A
+        /// new hint is only issued once the read position gets within half
+        /// a window of the end of the last one.
+        void prefetchAhead(juce::int64 start, int numSamples)
+        {
+            if (start < lastReadStart || start > hintedUpTo)
+                hintedUpTo = start;                 // seeked: start a new window
+            lastReadStart = start;
+
+            const auto end = start + numSamples;
+            if (end + prefetchFrames / 2 <= hintedUpTo)
+                return;
+
+            const auto to = juce::jmin(lengthInSamples, end + prefetchFrames);
+            if (to > hintedUpTo)
+                willNeed(data + hintedUpTo * bytesPerFrame, (to - hintedUpTo) * bytesPerFrame);
+            hintedUpTo = to;
+        }
+
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped;
+
+        const uint8_t* data           = nullptr;   ///< first frame of the sample data
+        int            bytesPerFrame  = 0;
+        int            bytesPerSample = 0;
+        bool           convertHere    = false;
+
+        juce::int64    prefetchFrames = 0;
+        juce::int64    hintedUpTo     = 0;
+        juce::int64    lastReadStart  = 0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MappedReader)
+    };
+}
+
+//==============================================================================
+std::unique_ptr<juce::AudioFormatReader> MappedAudio::createReader(juce::AudioFormatManager& formats,
+                                                                   const juce::File& file)
+{
+    // Tried in turn, like createReaderFor(), so a misnamed file is still
+    // recognised.  Only uncompressed formats offer a mapped reader.
+    for (int i = 0; i < formats.getNumKnownFormats(); ++i)
+    {
+        auto* format = formats.getKnownFormat(i);
+        std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+
+        if (mapped != nullptr && mapped->lengthInSamples > 0 && mapped->bitsPerSample % 8 == 0
+            && mapped->mapEntireFile())
+        {
+            // WavAudioFormat also parses RF64 (not W64); AIFF is big-endian
+            const bool littleEndianPcm = dynamic_cast<juce::WavAudioFormat*>(format) != nullptr;
+            return std::make_unique<MappedReader>(std::move(mapped), littleEndianPcm);
+        }
+    }
+
+    return std::unique_ptr<juce::AudioFormatReader>(formats.createReaderFor(file));
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+
+//==============================================================================
+/// MappedAudio — readers for playback, thumbnails and export that map
+/// uncompressed files (WAV/RF64, AIFF) into memory instead of copying
+/// them through stream reads.
+///
+/// Little-endian integer and float PCM is converted straight out of the
+/// mapping with SSE/NEON code; big-endian AIFF goes through JUCE's mapped
+/// reader.  As the read position advances the reader asks the OS to page in
+/// the next couple of seconds, so sequential reads rarely fault.  Compressed
+/// formats, and files that cannot be mapped, get the normal stream reader.
+namespace MappedAudio
+{
+    /// How far ahead of each read the pages are prefetched
+    constexpr double kPrefetchSeconds = 2.0;
+
+    /// A reader for @p file, or nullptr if none of @p formats can open it.
+    /// Like every AudioFormatReader, use it from one thread at a time.
+    std::unique_ptr<juce::AudioFormatReader> createReader(juce::AudioFormatManager& formats,
+                                                          const juce::File& file);
+}
@@ -0,0 +1,193 @@
+#include "MetricHistory.h"
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+MetricHistory::MetricHistory()
+{
+    for (int l = 0; l < kNumLevels; ++l)
+        rings[static_cast<size_t>(l)].resize(static_cast<size_t>(kLevelCapacity[static_cast<size_t>(l)] * kNumMetrics));
+
+    clearAll();
+}
+
+void MetricHistory::setSampleRate(double sr)
+{
+    sampleRate  = sr;
+    stepSamples = std::max(1, static_cast<int>(std::round(sr * kBasePeriodSeconds)));
+    reset();
+}
+
+double MetricHistory::getLevelPeriod(int level)
+{
+    double period = kBasePeriodSeconds;
+    for (int l = 1; l <= level; ++l)
+        period *= kLevelRatio[static_cast<size_t>(l)];
+    return period;
+}
+
+void MetricHistory::clearAll()
+{
+    stepCount  = 0;
+    stepPeakL  = stepPeakR  = 0.0f;
+    stepSumSqL = stepSumSqR = 0.0;
+    aggregateCount.fill(0);
+
+    for (auto& w : written)
+        w.store(0, std::memory_order_release);
+}
+
+//==============================================================================
+void MetricHistory::processSamples(const float* left, const float* right, int numSamples,
+                                   float momentaryLUFS, float shortTermLUFS, float correlation)
+{
+    if (resetPending.exchange(false, std::memory_order_acq_rel))
+        clearAll();
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float l = left[i];
+        const float r = right[i];
+        stepPeakL = std::max(stepPeakL, std::fabs(l));
+        stepPeakR = std::max(stepPeakR, std::fabs(r));
+        stepSumSqL += static_cast<double>(l) * l;
+        stepSumSqR += static_cast<double>(r) * r;
+
+        if (++stepCount < stepSamples)
+            continue;
+
+        std::array<float, kNumMetrics> values {};
+        values[static_cast<size_t>(Metric::PeakLeft)]      = stepPeakL;
+        values[static_cast<size_t>(Metric::PeakRight)]     = stepPeakR;
+        values[static_cast<size_t>(Metric::RmsLeft)]       = static_cast<float>(std::sqrt(stepSumSqL / stepCount));
+        values[static_cast<size_t>(Metric::RmsRight)]      = static_cast<float>(std::sqrt(stepSumSqR / stepCount));
+        values[static_cast<size_t>(Metric::MomentaryLUFS)] = momentaryLUFS;
+        values[static_cast<size_t>(Metric::ShortTermLUFS)] = shortTermLUFS;
+        values[static_cast<size_t>(Metric::Correlation)]   = correlation;
+        appendStep(values);
+
+        stepCount  = 0;
+        stepPeakL  = stepPeakR  = 0.0f;
+        stepSumSqL = stepSumSqR = 0.0;
+    }
+}
+
+void MetricHistory::appendStep(const std::array<float, kNumMetrics>& values)
+{
+    std::array<Point, kNumMetrics> points;
+    for (int m = 0; m < kNumMetrics; ++m)
+    {
+        const float v = values[static_cast<size_t>(m)];
+        points[static_cast<size_t>(m)] = { v, v, v };
+    }
+    append(0, points);
+}
+
+void MetricHistory::append(int level, const std::array<Point, kNumMetrics>& points)
+{
+    const auto lv  = static_cast<size_t>(level);
+    const auto cap = static_cast<uint64_t>(kLevelCapacity[lv]);
+    const auto index = written[lv].load(std::memory_order_relaxed);
+
+    auto& ring = rings[lv];
+    for (int m = 0; m < kNumMetrics; ++m)
+        ring[static_cast<size_t>(static_cast<uint64_t>(m) * cap + index % cap)] = points[static_cast<size_t>(m)];
+
+    written[lv].store(index + 1, std::memory_order_release);
+
+    // Roll up into the next level
+    const int next = level + 1;
+    if (next >= kNumLevels)
+        return;
+
+    const auto nx = static_cast<size_t>(next);
+    auto& agg = aggregates[nx];
+    const bool first = (aggregateCount[nx] == 0);
+    for (int m = 0; m < kNumMetrics; ++m)
+    {
+        const auto& p = points[static_cast<size_t>(m)];
+        auto& a = agg[static_cast<size_t>(m)];
+        a.min = first ? p.min : std::min(a.min, p.min);
+        a.max = first ? p.max : std::max(a.max, p.max);
+        a.sum = (first ? 0.0 : a.sum) + p.mean;
+    }
+
+    if (++aggregateCount[nx] < kLevelRatio[nx])
+        return;
+
+    std::array<Point, kNumMetrics> rolled;
+    for (int m = 0; m < kNumMetrics; ++m)
+    {
+        const auto& a = agg[static_cast<size_t>(m)];
+        rolled[static_cast<size_t>(m)] = { a.min, a.max,
+                                           static_cast<float>(a.sum / kLevelRatio[nx]) };
+    }
+    aggregateCount[nx] = 0;
+    append(next, rolled);
+}
+
+//==============================================================================
+uint64_t MetricHistory::getOldestReadable(int level) const
+{
+    const auto n = getNumWritten(level);
+    const auto span = static_cast<uint64_t>(kLevelCapacity[static_cast<size_t>(level)] - kReadGuard);
+    return n > span ? n - span : 0;
+}
+
+int MetricHistory::query(Metric m, double windowSeconds, int numBuckets,
+                         std::vector<Point>& out) const
+{
+    out.clear();
+    if (windowSeconds <= 0.0 || numBuckets <= 0)
+        return 0;
+
+    const double bucketSeconds = windowSeconds / numBuckets;
+
+    // Coarsest level that still resolves one bucket — or, if the window is
+    // longer than a level retains, the first level that covers it.
+    int level = 0;
+    while (level + 1 < kNumLevels
+           && (getLevelPeriod(level + 1) <= bucketSeconds
+               || (kLevelCapacity[static_cast<size_t>(level)] - kReadGuard) * getLevelPeriod(level) < windowSeconds))
+        ++level;
+
+    const auto newest    = getNumWritten(level);
+    const auto oldest    = getOldestReadable(level);
+    const auto wanted    = static_cast<uint64_t>(std::ceil(windowSeconds / getLevelPeriod(level)));
+    const auto available = newest - oldest;
+    const auto total     = std::min(wanted, available);
+    if (total == 0)
+        return 0;
+
+    // Buckets keep their nominal width; missing history shortens the result
+    // and only buckets whose rounded newest edge lies inside it are kept
+    const double perBucket = std::max(1.0, bucketSeconds / getLevelPeriod(level));
+    auto bucketEdge = [perBucket](int b) { return static_cast<uint64_t>(std::llround(b * perBucket)); };
+    int count = 0;
+    while (count < numBuckets && bucketEdge(count) < total)
+        ++count;
+    out.resize(static_cast<size_t>(count));
+
+    // Walk buckets from newest to oldest so the newest stays aligned
+    for (int b = 0; b < count; ++b)
+    {
+        const auto endOffset   = bucketEdge(b);
+        const auto startOffset = std::min(total, bucketEdge(b + 1));
+        const auto first = newest - startOffset;
+        const auto last  = newest - endOffset;     // exclusive
+
+        Point acc = entry(level, m, first);
+        double sum = acc.mean;
+        for (auto i = first + 1; i < last; ++i)
+        {
+            const auto& p = entry(level, m, i);
+            acc.min = std::min(acc.min, p.min);
+            acc.max = std::max(acc.max, p.max);
+            sum += p.mean;
+        }
+        acc.mean = static_cast<float>(sum / static_cast<double>(std::max<uint64_t>(1, last - first)));
+        out[static_cast<size_t>(count - 1 - b)] = acc;
+    }
+
+    return count;
+}
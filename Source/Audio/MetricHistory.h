@@ -0,0 +1,129 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+//==============================================================================
+/// MetricHistory — fixed-rate time series of analysis metrics.
+///
+/// The audio thread calls `processSamples()`; every 10 ms of audio one value
+/// per metric is appended to level 0.  Each coarser level stores min/max/mean
+/// aggregates of the level below (10 ms → 1 s → 1 min) in preallocated ring
+/// buffers, so writing never allocates or locks.
+///
+/// Readers on the GUI / export thread call `query()`, which picks the
+/// coarsest level that still resolves the requested bucket width — drawing
+/// N points costs O(N × level ratio) whatever the window length, so a
+/// multi-hour view costs the same as a 30-second one.
+class MetricHistory
+{
+public:
+    enum class Metric
+    {
+        PeakLeft, PeakRight,            ///< linear
+        RmsLeft, RmsRight,              ///< linear
+        MomentaryLUFS, ShortTermLUFS,   ///< LUFS, -100 = silence
+        Correlation,                    ///< -1 .. +1
+        NumMetrics
+    };
+
+    struct Point
+    {
+        float min  = 0.0f;
+        float max  = 0.0f;
+        float mean = 0.0f;
+    };
+
+    //--- Pyramid layout ---
+    static constexpr int    kNumLevels = 3;
+    static constexpr double kBasePeriodSeconds = 0.01;
+    static constexpr std::array<int, kNumLevels> kLevelRatio    { 1, 100, 60 };     ///< entries of level-1 per entry
+    /// Entries kept clear of the write head so a slow reader never sees a
+    /// slot being overwritten.
+    static constexpr int kReadGuard = 64;
+    /// Readable span (60 s, 2 h, 24 h) plus the guard entries
+    static constexpr std::array<int, kNumLevels> kLevelCapacity { 6000 + kReadGuard, 7200 + kReadGuard, 1440 + kReadGuard };
+
+    MetricHistory();
+    ~MetricHistory() = default;
+
+    /// Set sample rate (call before processing; also resets the history)
+    void setSampleRate(double sr);
+
+    /// Clear all history.  Safe to call from any thread — the audio thread
+    /// performs the reset at the start of its next block.
+    void reset() { resetPending.store(true, std::memory_order_release); }
+
+    /// Called from the audio thread.  Scalar metrics produced by other
+    /// analyzers are sampled once per 10 ms step.
+    void processSamples(const float* left, const float* right, int numSamples,
+                        float momentaryLUFS, float shortTermLUFS, float correlation);
+
+    //--- Reading (any thread) ---
+
+    /// Seconds covered by one entry of @p level.
+    static double getLevelPeriod(int level);
+
+    /// Total number of entries ever written to @p level since the last reset.
+    uint64_t getNumWritten(int level) const
+    {
+        return written[static_cast<size_t>(level)].load(std::memory_order_acquire);
+    }
+
+    /// Oldest absolute index of @p level that can still be read safely.
+    uint64_t getOldestReadable(int level) const;
+
+    /// Level-0 value of @p m at absolute index @p index (must be readable).
+    float getValue(Metric m, uint64_t index) const
+    {
+        return entry(0, m, index).mean;
+    }
+
+    /// Fill @p out with at most @p numBuckets min/max/mean buckets covering
+    /// the most recent @p windowSeconds, oldest first.  Buckets are
+    /// `windowSeconds / numBuckets` wide and aligned to the newest value, so
+    /// when less history exists the result is shorter than @p numBuckets.
+    /// @return Number of buckets written.
+    int query(Metric m, double windowSeconds, int numBuckets, std::vector<Point>& out) const;
+
+private:
+    static constexpr int kNumMetrics = static_cast<int>(Metric::NumMetrics);
+
+    double sampleRate = 48000.0;
+    int    stepSamples = 480;
+
+    // Level-0 accumulator (audio thread only)
+    int   stepCount = 0;
+    float stepPeakL = 0.0f, stepPeakR = 0.0f;
+    double stepSumSqL = 0.0, stepSumSqR = 0.0;
+
+    // Aggregators feeding levels 1.. (audio thread only)
+    struct Aggregate
+    {
+        float  min = 0.0f, max = 0.0f;
+        double sum = 0.0;
+    };
+    std::array<std::array<Aggregate, kNumMetrics>, kNumLevels> aggregates {};
+    std::array<int, kNumLevels> aggregateCount {};
+
+    // Ring buffers: rings[level][metric * capacity + slot]
+    std::array<std::vector<Point>, kNumLevels> rings;
+    std::array<std::atomic<uint64_t>, kNumLevels> written {};
+
+    std::atomic<bool> resetPending { false };
+
+    void clearAll();
+    void appendStep(const std::array<float, kNumMetrics>& values);
+    void append(int level, const std::array<Point, kNumMetrics>& points);
+
+    const Point& entry(int level, Metric m, uint64_t index) const
+    {
+        const auto cap = static_cast<uint64_t>(kLevelCapacity[static_cast<size_t>(level)]);
+        return rings[static_cast<size_t>(level)][static_cast<size_t>(static_cast<uint64_t>(m) * cap + index % cap)];
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MetricHistory)
+};
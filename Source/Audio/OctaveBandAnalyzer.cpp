@@ -0,0 +1,332 @@
+#include "OctaveBandAnalyzer.h"
+#include <cmath>
+#include <complex>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define MAXIMETER_BANK_SSE2 1
+ #include <immintrin.h>
+#else
+ #define MAXIMETER_BANK_SSE2 0
+#endif
+
+#if !MAXIMETER_BANK_SSE2 && (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64))
+ #define MAXIMETER_BANK_NEON 1
+ #include <arm_neon.h>
+#else
+ #define MAXIMETER_BANK_NEON 0
+#endif
+
+namespace
+{
+    constexpr double kOctaveRatio      = 1.9952623149688795;   // G = 10^(3/10), base-10 system
+    constexpr double kReferenceFreq    = 1000.0;
+    constexpr double kLowestEdgeHz     = 17.5;     // keeps the 20 Hz third-octave band
+    constexpr double kHighestEdgeHz    = 22500.0;  // keeps the 20 kHz third-octave band
+    constexpr double kMaxEdgeOfNyquist = 0.98;     // bands must end below Nyquist
+    constexpr float  kPeakReleaseDbPerSec = 20.0f;
+    constexpr int    kChunkSize = 512;
+
+    //==========================================================================
+    // Four bands per vector.  The kernel below is written once against these.
+   #if MAXIMETER_BANK_SSE2
+    struct Vec4
+    {
+        __m128 v;
+        static Vec4 load(const float* p)  { return { _mm_load_ps(p) }; }
+        static Vec4 broadcast(float x)    { return { _mm_set1_ps(x) }; }
+        void store(float* p) const        { _mm_store_ps(p, v); }
+    };
+    inline Vec4 operator+(Vec4 a, Vec4 b) { return { _mm_add_ps(a.v, b.v) }; }
+    inline Vec4 operator-(Vec4 a, Vec4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+    inline Vec4 operator*(Vec4 a, Vec4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+    inline Vec4 vmax(Vec4 a, Vec4 b)      { return { _mm_max_ps(a.v, b.v) }; }
+    inline Vec4 vabs(Vec4 a)              { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+   #elif MAXIMETER_BANK_NEON
+    struct Vec4
+    {
+        float32x4_t v;
+        static Vec4 load(const float* p)  { return { vld1q_f32(p) }; }
+        static Vec4 broadcast(float x)    { return { vdupq_n_f32(x) }; }
+        void store(float* p) const        { vst1q_f32(p, v); }
+    };
+    inline Vec4 operator+(Vec4 a, Vec4 b) { return { vaddq_f32(a.v, b.v) }; }
+    inline Vec4 operator-(Vec4 a, Vec4 b) { return { vsubq_f32(a.v, b.v) }; }
+    inline Vec4 operator*(Vec4 a, Vec4 b) { return { vmulq_f32(a.v, b.v) }; }
+    inline Vec4 vmax(Vec4 a, Vec4 b)      { return { vmaxq_f32(a.v, b.v) }; }
+    inline Vec4 vabs(Vec4 a)              { return { vabsq_f32(a.v) }; }
+   #else
+    struct Vec4
+    {
+        float v[4];
+        static Vec4 load(const float* p)  { return { { p[0], p[1], p[2], p[3] } }; }
+        static Vec4 broadcast(float x)    { return { { x, x, x, x } }; }
+        void store(float* p) const        { for (int i = 0; i < 4; ++i) p[i] = v[i]; }
+    };
+    inline Vec4 operator+(Vec4 a, Vec4 b) { for (int i = 0; i < 4; ++i) a.v[i] += b.v[i]; return a; }
+    inline Vec4 operator-(Vec4 a, Vec4 b) { for (int i = 0; i < 4; ++i) a.v[i] -= b.v[i]; return a; }
+    inline Vec4 operator*(Vec4 a, Vec4 b) { for (int i = 0; i < 4; ++i) a.v[i] *= b.v[i]; return a; }
+    inline Vec4 vmax(Vec4 a, Vec4 b)      { for (int i = 0; i < 4; ++i) a.v[i] = std::max(a.v[i], b.v[i]); return a; }
+    inline Vec4 vabs(Vec4 a)              { for (int i = 0; i < 4; ++i) a.v[i] = std::abs(a.v[i]); return a; }
+   #endif
+
+    /// Snap to the fractions the standard defines mid-band frequencies for here.
+    int snapFraction(int bandsPerOctave)
+    {
+        return bandsPerOctave <= 1 ? 1 : (bandsPerOctave <= 4 ? 3 : 6);
+    }
+}
+
+//==============================================================================
+OctaveBandAnalyzer::OctaveBandAnalyzer()
+{
+    reset();
+}
+
+void OctaveBandAnalyzer::setSampleRate(double sr)
+{
+    if (sr > 0.0)
+        requestedRate.store(sr);
+}
+
+void OctaveBandAnalyzer::setBandsPerOctave(int bandsPerOctave)
+{
+    requestedFraction.store(snapFraction(bandsPerOctave));
+}
+
+void OctaveBandAnalyzer::reset()
+{
+    resetPending.store(true);
+    for (int i = 0; i < kMaxBands; ++i)
+    {
+        rmsOut[static_cast<size_t>(i)].store(0.0f, std::memory_order_relaxed);
+        peakOut[static_cast<size_t>(i)].store(0.0f, std::memory_order_relaxed);
+    }
+}
+
+//==============================================================================
+int OctaveBandAnalyzer::computeBands(int bandsPerOctave, double sampleRate,
+                                     std::array<Band, kMaxBands>& dest)
+{
+    const int b = snapFraction(bandsPerOctave);
+    const double highest = juce::jmin(kHighestEdgeHz, 0.5 * sampleRate * kMaxEdgeOfNyquist);
+    const double halfBand = std::pow(kOctaveRatio, 1.0 / (2.0 * b));
+
+    // IEC 61260-1: fm = fr·G^(x/b) for odd b, fr·G^((2x+1)/(2b)) for even b
+    int count = 0;
+    const int firstX = static_cast<int>(std::floor(b * std::log(kLowestEdgeHz / kReferenceFreq)
+                                                     / std::log(kOctaveRatio))) - 1;
+    for (int x = firstX; count < kMaxBands; ++x)
+    {
+        const double exponent = (b % 2 == 1) ? static_cast<double>(x) / b
+                                             : (2.0 * x + 1.0) / (2.0 * b);
+        const double centre = kReferenceFreq * std::pow(kOctaveRatio, exponent);
+        const double lower  = centre / halfBand;
+        const double upper  = centre * halfBand;
+
+        if (upper > highest)
+            break;
+        if (lower < kLowestEdgeHz)
+            continue;
+
+        auto& band = dest[static_cast<size_t>(count++)];
+        band.centre = static_cast<float>(centre);
+        band.lower  = static_cast<float>(lower);
+        band.upper  = static_cast<float>(upper);
+        band.rms    = 0.0f;
+        band.peak   = 0.0f;
+    }
+    return count;
+}
+
+//==============================================================================
+void OctaveBandAnalyzer::design(int bandsPerOctave, double sampleRate)
+{
+    using Complex = std::complex<double>;
+
+    std::array<Band, kMaxBands> bands;
+    const int n = computeBands(bandsPerOctave, sampleRate, bands);
+
+    for (int i = 0; i < kMaxBands; ++i)
+    {
+        for (int s = 0; s < kSections; ++s)
+        {
+            a1[s].v[i] = a2[s].v[i] = a3[s].v[i] = 0.0f;
+            ic1[s].v[i] = ic2[s].v[i] = 0.0f;
+        }
+        gain.v[i] = meanSquare.v[i] = peak.v[i] = 0.0f;
+    }
+
+    const double twoFs = 2.0 * sampleRate;
+    for (int i = 0; i < n; ++i)
+    {
+        const auto& band = bands[static_cast<size_t>(i)];
+
+        // Pre-warped edges; the analog band-pass is the 3rd-order Butterworth
+        // low-pass prototype under s -> (s² + w0²) / (B·s)
+        const double w1 = twoFs * std::tan(juce::MathConstants<double>::pi * band.lower / sampleRate);
+        const double w2 = twoFs * std::tan(juce::MathConstants<double>::pi * band.upper / sampleRate);
+        const double w0 = std::sqrt(w1 * w2);
+        const double bw = w2 - w1;
+
+        // Each section is ω·s / (s² + k·ω·s + ω²), given as (ω, k)
+        std::array<std::pair<double, double>, kSections> sections;
+
+        // Real prototype pole p = −1 gives s² + B·s + w0² directly
+        sections[0] = { w0, bw / w0 };
+
+        // Complex pole pair e^(±j2π/3): the roots of s² − p·B·s + w0² and
+        // their conjugates give the other two sections
+        const Complex p = std::polar(1.0, 2.0 * juce::MathConstants<double>::pi / 3.0);
+        const Complex disc = std::sqrt(p * p * bw * bw - 4.0 * w0 * w0);
+        const Complex roots[2] = { (p * bw + disc) * 0.5, (p * bw - disc) * 0.5 };
+        for (int r = 0; r < 2; ++r)
+        {
+            const double omega = std::abs(roots[r]);
+            sections[static_cast<size_t>(r + 1)] = { omega, -2.0 * roots[r].real() / omega };
+        }
+
+        // Trapezoidal SVF (bilinear with the pre-warped ω), unity gain at fm
+        double response = 1.0;
+        for (int s = 0; s < kSections; ++s)
+        {
+            const auto [omega, k] = sections[static_cast<size_t>(s)];
+            const double g  = omega / twoFs;
+            const double c1 = 1.0 / (1.0 + g * (g + k));
+            a1[s].v[i] = static_cast<float>(c1);
+            a2[s].v[i] = static_cast<float>(g * c1);
+            a3[s].v[i] = static_cast<float>(g * g * c1);
+
+            const Complex jw(0.0, w0 / omega);
+            response *= std::abs(jw / (jw * jw + k * jw + 1.0));
+        }
+        gain.v[i] = static_cast<float>(1.0 / response);
+    }
+
+    numBands.store(n);
+    designedFraction.store(snapFraction(bandsPerOctave));
+    designedRate.store(sampleRate);
+}
+
+//==============================================================================
+void OctaveBandAnalyzer::processSamples(const float* left, const float* right, int numSamples)
+{
+    if (numSamples <= 0 || left == nullptr)
+        return;
+
+    juce::ScopedNoDenormals noDenormals;
+
+    // Pick up configuration changes
+    const int    fraction = requestedFraction.load();
+    const double rate     = requestedRate.load();
+    if (fraction != designedFraction.load(std::memory_order_relaxed)
+        || rate != designedRate.load(std::memory_order_relaxed))
+    {
+        design(fraction, rate);
+        resetPending.store(false);
+    }
+    else if (resetPending.exchange(false))
+    {
+        for (int s = 0; s < kSections; ++s)
+        {
+            std::fill(std::begin(ic1[s].v), std::end(ic1[s].v), 0.0f);
+            std::fill(std::begin(ic2[s].v), std::end(ic2[s].v), 0.0f);
+        }
+        std::fill(std::begin(meanSquare.v), std::end(meanSquare.v), 0.0f);
+        std::fill(std::begin(peak.v), std::end(peak.v), 0.0f);
+    }
+
+    const float weighting = timeWeightingMs.load(std::memory_order_relaxed);
+    if (weighting != designedWeightingMs || msCoeff == 0.0f)
+    {
+        designedWeightingMs = weighting;
+        msCoeff = 1.0f - static_cast<float>(std::exp(-1000.0 / (weighting * rate)));
+        peakRelease = std::pow(10.0f, -kPeakReleaseDbPerSec / (20.0f * static_cast<float>(rate)));
+    }
+
+    const int n = numBands.load(std::memory_order_relaxed);
+    const int groups = (n + 3) / 4;
+
+    const Vec4 two   = Vec4::broadcast(2.0f);
+    const Vec4 msK   = Vec4::broadcast(msCoeff);
+    const Vec4 rel   = Vec4::broadcast(peakRelease);
+
+    float mono[kChunkSize];
+    for (int start = 0; start < numSamples; start += kChunkSize)
+    {
+        const int count = juce::jmin(kChunkSize, numSamples - start);
+        for (int i = 0; i < count; ++i)
+            mono[i] = right != nullptr ? (left[start + i] + right[start + i]) * 0.5f
+                                       : left[start + i];
+
+        // Each group of four bands keeps its state in registers for the chunk
+        for (int grp = 0; grp < groups; ++grp)
+        {
+            const int lane = grp * 4;
+
+            Vec4 c1[kSections], c2[kSections], c3[kSections], s1[kSections], s2[kSections];
+            for (int s = 0; s < kSections; ++s)
+            {
+                c1[s] = Vec4::load(a1[s].v + lane);
+                c2[s] = Vec4::load(a2[s].v + lane);
+                c3[s] = Vec4::load(a3[s].v + lane);
+                s1[s] = Vec4::load(ic1[s].v + lane);
+                s2[s] = Vec4::load(ic2[s].v + lane);
+            }
+            const Vec4 g = Vec4::load(gain.v + lane);
+            Vec4 ms = Vec4::load(meanSquare.v + lane);
+            Vec4 pk = Vec4::load(peak.v + lane);
+
+            for (int i = 0; i < count; ++i)
+            {
+                Vec4 v = Vec4::broadcast(mono[i]);
+                for (int s = 0; s < kSections; ++s)
+                {
+                    const Vec4 v3 = v - s2[s];
+                    const Vec4 v1 = c1[s] * s1[s] + c2[s] * v3;
+                    const Vec4 v2 = s2[s] + c2[s] * s1[s] + c3[s] * v3;
+                    s1[s] = two * v1 - s1[s];
+                    s2[s] = two * v2 - s2[s];
+                    v = v1;
+                }
+
+                const Vec4 y = v * g;
+                ms = ms + msK * (y * y - ms);
+                pk = vmax(vabs(y), pk * rel);
+            }
+
+            for (int s = 0; s < kSections; ++s)
+            {
+                s1[s].store(ic1[s].v + lane);
+                s2[s].store(ic2[s].v + lane);
+            }
+            ms.store(meanSquare.v + lane);
+            pk.store(peak.v + lane);
+        }
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        rmsOut[static_cast<size_t>(i)].store(std::sqrt(meanSquare.v[i]), std::memory_order_relaxed);
+        peakOut[static_cast<size_t>(i)].store(peak.v[i], std::memory_order_relaxed);
+    }
+}
+
+//==============================================================================
+int OctaveBandAnalyzer::getBands(Band* dest, int maxBands) const
+{
+    const int fraction = designedFraction.load();
+    const double rate  = designedRate.load();
+    if (dest == nullptr || fraction == 0 || rate <= 0.0)
+        return 0;
+
+    std::array<Band, kMaxBands> bands;
+    const int n = juce::jmin(computeBands(fraction, rate, bands), maxBands,
+                             numBands.load(std::memory_order_relaxed));
+    for (int i = 0; i < n; ++i)
+    {
+        dest[i] = bands[static_cast<size_t>(i)];
+        dest[i].rms  = rmsOut[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+        dest[i].peak = peakOut[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+    }
+    return n;
+}
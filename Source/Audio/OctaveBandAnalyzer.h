@@ -0,0 +1,89 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+//==============================================================================
+/// OctaveBandAnalyzer — ANSI S1.11 / IEC 61260-1 fractional-octave filter bank.
+///
+/// Runs one 6th-order Butterworth band-pass (three state-variable sections)
+/// per band in the time domain, with base-10 mid-band frequencies at 1/1,
+/// 1/3 or 1/6 octave spacing over 20 Hz – 20 kHz.  Bands are processed four
+/// at a time in SIMD lanes (SSE2 / NEON, scalar elsewhere), so the cost per
+/// sample is fixed by the band count and does not depend on any block size.
+///
+/// Each band keeps exponentially time-weighted mean square (Fast, 125 ms by
+/// default) and a peak with a constant release, updated every sample.
+///
+/// The audio thread calls `processSamples()`; the GUI thread reads the
+/// results with `getBands()`.  Configuration changes are picked up by the
+/// audio thread at the start of its next block.
+class OctaveBandAnalyzer
+{
+public:
+    static constexpr int kMaxBands = 64;
+
+    /// One band's nominal edges and its latest levels (linear).
+    struct Band
+    {
+        float centre = 0.0f, lower = 0.0f, upper = 0.0f;
+        float rms = 0.0f, peak = 0.0f;
+    };
+
+    OctaveBandAnalyzer();
+    ~OctaveBandAnalyzer() = default;
+
+    void setSampleRate(double sr);
+
+    /// 1, 3 or 6 bands per octave (others are rounded to the nearest).
+    void setBandsPerOctave(int bandsPerOctave);
+    int  getBandsPerOctave() const { return designedFraction.load(std::memory_order_relaxed); }
+
+    /// RMS time weighting in ms (125 = Fast, 1000 = Slow).
+    void setTimeWeightingMs(float ms) { timeWeightingMs.store(juce::jmax(1.0f, ms)); }
+
+    /// Called from the audio thread; analyses the mono mix of L/R.
+    void processSamples(const float* left, const float* right, int numSamples);
+
+    /// GUI thread: copy the bands of the running configuration into @p dest.
+    /// Returns the band count (0 before the first block has been analysed).
+    int getBands(Band* dest, int maxBands) const;
+
+    void reset();
+
+    /// Nominal bands at @p bandsPerOctave that fit below Nyquist at
+    /// @p sampleRate.  Levels are left at zero.
+    static int computeBands(int bandsPerOctave, double sampleRate,
+                            std::array<Band, kMaxBands>& dest);
+
+private:
+    void design(int bandsPerOctave, double sampleRate);
+
+    static constexpr int kSections = 3;
+
+    // Configuration requested by the GUI, applied by the audio thread
+    std::atomic<int>    requestedFraction { 3 };
+    std::atomic<double> requestedRate     { 48000.0 };
+    std::atomic<float>  timeWeightingMs   { 125.0f };
+    std::atomic<bool>   resetPending      { false };
+
+    // Configuration the audio thread is running (published for getBands())
+    std::atomic<int>    designedFraction  { 0 };
+    std::atomic<double> designedRate      { 0.0 };
+    std::atomic<int>    numBands          { 0 };
+    float               designedWeightingMs = 0.0f;
+
+    // Per-band coefficients and state, laid out as SIMD lanes
+    struct alignas(16) Lanes { float v[kMaxBands]; };
+    std::array<Lanes, kSections> a1 {}, a2 {}, a3 {};     ///< SVF coefficients
+    std::array<Lanes, kSections> ic1 {}, ic2 {};          ///< SVF integrator state
+    Lanes gain {}, meanSquare {}, peak {};
+    float msCoeff = 0.0f;           ///< one-pole weight of the mean square
+    float peakRelease = 1.0f;       ///< per-sample peak multiplier
+
+    std::array<std::atomic<float>, kMaxBands> rmsOut {};
+    std::array<std::atomic<float>, kMaxBands> peakOut {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OctaveBandAnalyzer)
+};
@@ -0,0 +1,194 @@
+#include "StemBank.h"
+#include "MappedAudioReader.h"
+#include "../Utils/AsyncLogger.h"
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+StemBank::StemBank()
+{
+    formatManager.registerBasicFormats();
+}
+
+StemBank::~StemBank()
+{
+    waitForAnalysis();
+    pool.reset();
+}
+
+juce::ThreadPool& StemBank::getPool()
+{
+    if (pool == nullptr)
+        pool = std::make_unique<juce::ThreadPool>(
+            juce::jlimit(1, kMaxStems, juce::SystemStats::getNumCpus() - 1));
+    return *pool;
+}
+
+//==============================================================================
+juce::String StemBank::addStem(const juce::File& file, const juce::String& preferredId)
+{
+    if (getNumStems() >= kMaxStems)
+    {
+        MAXIMETER_LOG("AUDIO", "Stem not added (limit " + juce::String(kMaxStems) + "): " + file.getFileName());
+        return {};
+    }
+
+    auto reader = MappedAudio::createReader(formatManager, file);
+    if (reader == nullptr)
+    {
+        MAXIMETER_LOG("ERROR", "Cannot open stem: " + file.getFullPathName());
+        return {};
+    }
+
+    auto stem = std::make_unique<Stem>();
+    stem->id   = (preferredId.isNotEmpty() && !contains(preferredId))
+                     ? preferredId
+                     : makeUniqueId(file.getFileNameWithoutExtension());
+    stem->file = file;
+    stem->analyzers.prepare(reader->sampleRate);
+    stem->block.setSize(2, kBlockSize);
+    stem->reader = std::move(reader);
+
+    MAXIMETER_LOG("AUDIO", "Stem '" + stem->id + "' loaded: " + file.getFileName()
+                  + " (" + juce::String(stem->reader->sampleRate, 0) + " Hz)");
+
+    const auto id = stem->id;
+    stems.push_back(std::move(stem));
+    return id;
+}
+
+void StemBank::removeStem(const juce::String& id)
+{
+    waitForAnalysis();
+    stems.erase(std::remove_if(stems.begin(), stems.end(),
+                               [&](const std::unique_ptr<Stem>& s) { return s->id == id; }),
+                stems.end());
+}
+
+void StemBank::clear()
+{
+    waitForAnalysis();
+    stems.clear();
+}
+
+void StemBank::setStems(const juce::StringPairArray& newStems)
+{
+    clear();
+    for (int i = 0; i < newStems.size(); ++i)
+        addStem(juce::File(newStems.getAllValues()[i]), newStems.getAllKeys()[i]);
+}
+
+juce::StringArray StemBank::getStemIds() const
+{
+    juce::StringArray ids;
+    for (auto& s : stems)
+        ids.add(s->id);
+    return ids;
+}
+
+juce::StringPairArray StemBank::getStemFiles() const
+{
+    juce::StringPairArray files(false);
+    for (auto& s : stems)
+        files.set(s->id, s->file.getFullPathName());
+    return files;
+}
+
+AnalyzerSet* StemBank::getAnalyzers(const juce::String& id)
+{
+    auto* s = findStem(id);
+    return s != nullptr ? &s->analyzers : nullptr;
+}
+
+StemBank::Stem* StemBank::findStem(const juce::String& id) const
+{
+    if (id.isEmpty())
+        return nullptr;
+    for (auto& s : stems)
+        if (s->id == id)
+            return s.get();
+    return nullptr;
+}
+
+juce::String StemBank::makeUniqueId(const juce::String& base) const
+{
+    const auto root = base.isNotEmpty() ? base : juce::String("stem");
+    auto id = root;
+    for (int n = 2; contains(id); ++n)
+        id = root + " " + juce::String(n);
+    return id;
+}
+
+//==============================================================================
+void StemBank::setUsage(const juce::String& id, bool used, const Analysis::Requirements& needs)
+{
+    if (auto* s = findStem(id))
+    {
+        s->used = used;
+        s->analyzers.graph.setRequirements(needs);
+    }
+}
+
+void StemBank::advanceTo(double seconds)
+{
+    for (auto& s : stems)
+    {
+        if (!s->used || s->busy.exchange(true))
+            continue;
+
+        auto* stem = s.get();
+        pendingJobs.fetch_add(1);
+        getPool().addJob([this, stem, seconds]
+        {
+            analyse(*stem, seconds);
+            stem->busy.store(false);
+            if (pendingJobs.fetch_sub(1) == 1)
+                jobsFinished.signal();
+        });
+    }
+}
+
+void StemBank::waitForAnalysis()
+{
+    while (pendingJobs.load() > 0)
+        jobsFinished.wait(20);
+}
+
+void StemBank::rewind()
+{
+    waitForAnalysis();
+    for (auto& s : stems)
+    {
+        s->position = 0;
+        s->analyzers.reset();
+    }
+}
+
+//==============================================================================
+void StemBank::analyse(Stem& stem, double seconds)
+{
+    auto& reader = *stem.reader;
+    const double sr = reader.sampleRate;
+    const auto target = juce::jlimit<juce::int64>(0, reader.lengthInSamples,
+                                                  static_cast<juce::int64>(std::llround(seconds * sr)));
+
+    // Seek: restart a little before the clock so the FFT window is full
+    if (target < stem.position || target - stem.position > static_cast<juce::int64>(sr))
+    {
+        stem.analyzers.reset();
+        stem.position = juce::jmax<juce::int64>(0, target - kSeekPreroll);
+    }
+
+    const bool stereo = reader.numChannels >= 2;
+
+    while (stem.position < target)
+    {
+        const int n = static_cast<int>(juce::jmin<juce::int64>(kBlockSize, target - stem.position));
+        reader.read(&stem.block, 0, n, stem.position, true, stereo);
+        if (!stereo)
+            stem.block.copyFrom(1, 0, stem.block, 0, 0, n);
+
+        stem.analyzers.process(stem.block.getReadPointer(0), stem.block.getReadPointer(1), n);
+        stem.position += n;
+    }
+}
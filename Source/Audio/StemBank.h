@@ -0,0 +1,98 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "AnalyzerSet.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/// StemBank — stems (drums, bass, vocals, ...) loaded next to the main mix,
+/// each with its own AnalyzerSet so canvas items can meter a single stem.
+///
+/// Stems are never played; they are read straight from disk and analysed on
+/// a small worker pool, one job per stem, following a shared clock in
+/// seconds: the mix position the audio callback has reached (live) or the
+/// end of the current video frame (export).  Only stems some item reads are
+/// analysed (see `setUsage()`).
+///
+/// Stems are added and removed on the owning thread (message thread live,
+/// render thread for export).  Structural changes wait for running jobs.
+class StemBank
+{
+public:
+    static constexpr int kMaxStems = 8;
+
+    StemBank();
+    ~StemBank();
+
+    //--- Stem list ---
+    /// Open @p file as a stem.  The id is @p preferredId when given and
+    /// free, otherwise derived from the file name ("drums", "drums 2").
+    /// Returns the id, or an empty string if the file cannot be read or the
+    /// bank is full.
+    juce::String addStem(const juce::File& file, const juce::String& preferredId = {});
+    void removeStem(const juce::String& id);
+    void clear();
+
+    /// Replace the bank's contents with @p stems (id -> file path).
+    void setStems(const juce::StringPairArray& stems);
+
+    int  getNumStems() const { return static_cast<int>(stems.size()); }
+    bool contains(const juce::String& id) const { return findStem(id) != nullptr; }
+    juce::StringArray getStemIds() const;
+
+    /// id -> file path, in load order (project files, export settings).
+    juce::StringPairArray getStemFiles() const;
+
+    /// Analyzers of stem @p id, or nullptr if no such stem is loaded.
+    AnalyzerSet* getAnalyzers(const juce::String& id);
+
+    //--- Analysis ---
+    /// Install what the items bound to stem @p id read.  Stems with no
+    /// items (@p used false) are skipped entirely.
+    void setUsage(const juce::String& id, bool used, const Analysis::Requirements& needs);
+
+    /// Queue one job per used stem that analyses it up to @p seconds and
+    /// return at once.  A stem whose previous job is still running is left
+    /// for the next call.  Jumps backwards or further ahead than a second
+    /// are treated as a seek: the stem is reset and resumes just before the
+    /// clock.
+    void advanceTo(double seconds);
+
+    /// Block until every queued job has finished.
+    void waitForAnalysis();
+
+    /// Reset every stem to the start (export).  Waits for running jobs.
+    void rewind();
+
+private:
+    struct Stem
+    {
+        juce::String                                id;
+        juce::File                                  file;
+        std::unique_ptr<juce::AudioFormatReader>    reader;
+        AnalyzerSet                                 analyzers;
+        juce::AudioBuffer<float>                    block;
+        juce::int64                                 position = 0;   ///< next sample to analyse
+        bool                                        used     = false;
+        std::atomic<bool>                           busy     { false };
+    };
+
+    Stem* findStem(const juce::String& id) const;
+    juce::String makeUniqueId(const juce::String& base) const;
+    void analyse(Stem& stem, double seconds);
+    juce::ThreadPool& getPool();
+
+    juce::AudioFormatManager            formatManager;
+    std::vector<std::unique_ptr<Stem>>  stems;
+
+    std::unique_ptr<juce::ThreadPool>   pool;          ///< created on first use
+    std::atomic<int>                    pendingJobs { 0 };
+    juce::WaitableEvent                 jobsFinished;
+
+    static constexpr int kBlockSize = 4096;            ///< samples per analysis block
+    static constexpr int kSeekPreroll = 8192;          ///< samples analysed before the clock after a seek
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StemBank)
+};
@@ -39,7 +39,7 @@ AlignmentToolbar::AlignmentToolbar(CanvasModel& m) : model(m)
     {
         model.grid.enabled = gridToggle.getToggleState();
         model.grid.showGrid = gridToggle.getToggleState();
-        model.notifyItemsChanged();
+        model.notifyBackgroundChanged();   // grid is drawn with the background
     };
     addAndMakeVisible(gridToggle);
 
@@ -53,7 +53,7 @@ AlignmentToolbar::AlignmentToolbar(CanvasModel& m) : model(m)
     gridSizeCombo.onChange = [this]
     {
         model.grid.spacing = gridSizeCombo.getSelectedId();
-        model.notifyItemsChanged();
+        model.notifyBackgroundChanged();   // grid is drawn with the background
     };
     addAndMakeVisible(gridSizeCombo);
 
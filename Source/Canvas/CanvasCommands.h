@@ -16,7 +16,7 @@ public:
         for (auto& id : itemIds)
             if (auto* item = model.findItem(id))
             { item->x += deltaX; item->y += deltaY; }
-        model.notifyItemsChanged();
+        model.notifyItemsMoved(itemIds);
         return true;
     }
 
@@ -25,7 +25,7 @@ public:
         for (auto& id : itemIds)
             if (auto* item = model.findItem(id))
             { item->x -= deltaX; item->y -= deltaY; }
-        model.notifyItemsChanged();
+        model.notifyItemsMoved(itemIds);
         return true;
     }
 
@@ -51,7 +51,7 @@ public:
     {
         if (auto* item = model.findItem(itemId))
             item->setBounds(newB);
-        model.notifyItemsChanged();
+        model.notifyItemMoved(itemId);
         return true;
     }
 
@@ -59,7 +59,7 @@ public:
     {
         if (auto* item = model.findItem(itemId))
             item->setBounds(oldB);
-        model.notifyItemsChanged();
+        model.notifyItemMoved(itemId);
         return true;
     }
 
@@ -84,7 +84,7 @@ public:
         if (auto* item = model.findItem(itemId))
             item->zOrder = newZOrder;
         model.sortByZOrder();
-        model.notifyItemsChanged();
+        model.notifyZOrderChanged();
         return true;
     }
 
@@ -93,7 +93,7 @@ public:
         if (auto* item = model.findItem(itemId))
             item->zOrder = oldZOrder;
         model.sortByZOrder();
-        model.notifyItemsChanged();
+        model.notifyZOrderChanged();
         return true;
     }
 
@@ -118,7 +118,7 @@ public:
         if (auto* a = model.findItem(itemIdA)) a->zOrder = zOrderB;
         if (auto* b = model.findItem(itemIdB)) b->zOrder = zOrderA;
         model.sortByZOrder();
-        model.notifyItemsChanged();
+        model.notifyZOrderChanged();
         return true;
     }
 
@@ -127,7 +127,7 @@ public:
         if (auto* a = model.findItem(itemIdA)) a->zOrder = zOrderA;
         if (auto* b = model.findItem(itemIdB)) b->zOrder = zOrderB;
         model.sortByZOrder();
-        model.notifyItemsChanged();
+        model.notifyZOrderChanged();
         return true;
     }
 
@@ -151,7 +151,7 @@ public:
     {
         if (auto* item = model.findItem(itemId))
             item->rotation = newRotation;
-        model.notifyItemsChanged();
+        model.notifyItemMoved(itemId);
         return true;
     }
 
@@ -159,7 +159,7 @@ public:
     {
         if (auto* item = model.findItem(itemId))
             item->rotation = oldRotation;
-        model.notifyItemsChanged();
+        model.notifyItemMoved(itemId);
         return true;
     }
 
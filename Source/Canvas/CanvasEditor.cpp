@@ -10,19 +10,24 @@
 #include "../UI/TextLabelComponent.h"
 #include "../UI/MeterBase.h"
 #include "../UI/ShapeComponent.h"
+#include "../UI/ImageLayerComponent.h"
+#include "../UI/VideoLayerComponent.h"
 #include "../UI/SkinnedTitleBarLookAndFeel.h"
 
 //==============================================================================
-CanvasEditor::CanvasEditor(AudioEngine& ae, FFTProcessor& fft,
+CanvasEditor::CanvasEditor(AudioEngine& ae, FFTProcessor& fft, OctaveBandAnalyzer& bands,
                            LevelAnalyzer& la, LoudnessAnalyzer& loud,
-                           StereoFieldAnalyzer& stereo)
+                           StereoFieldAnalyzer& stereo, MetricHistory& history,
+                           AnalysisGraph& graph, StemBank& stems)
     : canvasView(model),
       propertyPanel(model),
       meterSettings(model),
       layerPanel(model),
       miniMap(model),
       alignToolbar(model),
-      meterFactory(ae, fft, la, loud, stereo)
+      meterFactory(ae, fft, bands, la, loud, stereo, history),
+      analysisGraph(graph),
+      stemBank(stems)
 {
     addAndMakeVisible(canvasView);
     addAndMakeVisible(toolbox);
@@ -37,6 +42,7 @@ CanvasEditor::CanvasEditor(AudioEngine& ae, FFTProcessor& fft,
     alignToolbar.onFreezeClicked = [this] { showRenderPreview(); };
 
     canvasView.addListener(this);
+    model.addListener(this);
 
     // Wire toolbox: clicking a meter type adds it to the canvas centre
     toolbox.onMeterSelected = [this](MeterType type)
@@ -46,10 +52,10 @@ CanvasEditor::CanvasEditor(AudioEngine& ae, FFTProcessor& fft,
     };
 
     // Wire toolbox: clicking a custom plugin adds a CustomPlugin meter
-    toolbox.onCustomPluginSelected = [this](const juce::String& pluginName)
+    toolbox.onCustomPluginSelected = [this](const juce::String& pluginKey)
     {
         auto centre = model.screenToCanvas(canvasView.getLocalBounds().getCentre().toFloat());
-        addCustomPluginAt(pluginName, centre);
+        addCustomPluginAt(pluginKey, centre);
     };
 
     // Wire layer panel divider drag (layers ↔ settings vertical resize)
@@ -89,9 +95,48 @@ CanvasEditor::CanvasEditor(AudioEngine& ae, FFTProcessor& fft,
 
 CanvasEditor::~CanvasEditor()
 {
+    model.removeListener(this);
     canvasView.removeListener(this);
 }
 
+//==============================================================================
+void CanvasEditor::itemChangesBatched(const CanvasChangeSet& changes)
+{
+    // Moves never change what is shown; everything else might
+    if (changes.changesLayout() || !changes.propertyChanged.empty())
+        updateAnalysisGraph();
+}
+
+void CanvasEditor::onStemsChanged()
+{
+    meterSettings.setAudioSources(stemBank.getStemIds());
+    updateAnalysisGraph();
+}
+
+void CanvasEditor::rebuildRenderGraph()
+{
+    std::vector<CanvasItem*> items;
+    items.reserve(static_cast<size_t>(model.getNumItems()));
+    for (int i = 0; i < model.getNumItems(); ++i)
+        items.push_back(model.getItem(i));
+
+    renderGraph.build(items, &stemBank);
+    renderGraphDirty_ = false;
+}
+
+void CanvasEditor::updateAnalysisGraph()
+{
+    rebuildRenderGraph();
+
+    const auto required = renderGraph.bindSources(&stemBank);
+    const auto before = analysisGraph.getRequirements();
+    analysisGraph.setRequirements(required);
+
+    const auto after = analysisGraph.getRequirements();
+    if (after != before)
+        MAXIMETER_LOG("AUDIO", "Active analysis: " + AnalysisGraph::describe(after));
+}
+
 //==============================================================================
 void CanvasEditor::applyThemeToAllPanels()
 {
@@ -105,18 +150,6 @@ void CanvasEditor::applyThemeToAllPanels()
 void CanvasEditor::paint(juce::Graphics& g)
 {
     g.fillAll(ThemeManager::getInstance().getPalette().panelBg);
-
-    // Grey overlay when export is running
-    if (exportOverlay_)
-    {
-        g.setColour(juce::Colour(0xAA000000));
-        g.fillRect(canvasView.getBounds());
-
-        g.setColour(juce::Colours::white.withAlpha(0.7f));
-        g.setFont(18.0f);
-        g.drawText("Exporting video\u2026",
-                   canvasView.getBounds(), juce::Justification::centred);
-    }
 }
 
 void CanvasEditor::resized()
@@ -161,14 +194,19 @@ void CanvasEditor::timerTick()
 {
     canvasView.tickFps();
 
-    // Freeze viewport during export — don't feed meters
-    if (exportOverlay_) return;
-
     // Skip feeding meters if in placeholder mode (save CPU)
     if (!canvasView.isInPlaceholderMode())
     {
-        for (int i = 0; i < model.getNumItems(); ++i)
-            meterFactory.feedMeter(*model.getItem(i));
+        // Edits only mark the graph; it is rebuilt here, before any node is
+        // fed, so it never holds an item the model has already deleted.
+        if (renderGraphDirty_)
+            rebuildRenderGraph();
+
+        // Culled and thumbnail items are skipped; meters read the latest
+        // analyser state, so they are current again on their first feed.
+        meterFactory.beginFrame();
+        renderGraph.feed(meterFactory, meterFactory.makeLiveContext(), true);
+        meterFactory.endFrame();
     }
 }
 
@@ -233,11 +271,32 @@ void CanvasEditor::ensureComponents()
             {
                 ci->component->setInterceptsMouseClicks(false, false);
                 canvasView.addAndMakeVisible(ci->component.get());
+                loadItemMedia(*ci);
             }
         }
     }
 }
 
+void CanvasEditor::loadItemMedia(CanvasItem& item)
+{
+    // Pasted and duplicated layers pick up the decode their source already
+    // holds in MediaRegistry rather than decoding the file again
+    auto* comp = item.component.get();
+
+    if (item.mediaFilePath.isNotEmpty() && juce::File(item.mediaFilePath).existsAsFile())
+    {
+        const juce::File file(item.mediaFilePath);
+        if (auto* img = dynamic_cast<ImageLayerComponent*>(comp))
+            img->loadFromFile(file);
+        else if (auto* vid = dynamic_cast<VideoLayerComponent*>(comp))
+            vid->loadFromFile(file);
+    }
+
+    if (item.svgPathData.isNotEmpty())
+        if (auto* shape = dynamic_cast<ShapeComponent*>(comp))
+            shape->setSvgPathData(item.svgPathData);
+}
+
 void CanvasEditor::applySkinToAll(const Skin::SkinModel* skin)
 {
     for (int i = 0; i < model.getNumItems(); ++i)
@@ -279,7 +338,7 @@ void CanvasEditor::canvasContextMenu(CanvasItem* item, juce::Point<int> screenPo
 }
 
 //==============================================================================
-CanvasItem* CanvasEditor::addCustomPluginAt(const juce::String& pluginName,
+CanvasItem* CanvasEditor::addCustomPluginAt(const juce::String& pluginKey,
                                              juce::Point<float> canvasPos)
 {
     auto* item = addMeter(MeterType::CustomPlugin, canvasPos);
@@ -292,38 +351,39 @@ CanvasItem* CanvasEditor::addCustomPluginAt(const juce::String& pluginName,
         auto pluginsDir = juce::File::getSpecialLocation(
             juce::File::currentExecutableFile).getParentDirectory()
             .getChildFile("CustomComponents").getChildFile("plugins");
-        if (!bridge.start(pluginsDir))
+        if (!bridge.start(pluginsDir) && !bridge.isAvailable())
         {
             model.removeItem(item->id);
             return nullptr;
         }
     }
 
-    // Match plugin name -> manifest ID
-    juce::String manifestId;
-    for (auto& m : bridge.getAvailablePlugins())
-    {
-        if (m.sourceFile.equalsIgnoreCase(pluginName) ||
-            m.id.endsWithIgnoreCase(pluginName) ||
-            m.name.removeCharacters(" ").equalsIgnoreCase(pluginName))
+    // The toolbox sends a manifest id; a file stem only when the runtime had
+    // not reported the manifest yet
+    const auto manifests = bridge.getAvailablePlugins();
+    auto match = std::find_if(manifests.begin(), manifests.end(),
+                              [&](const CustomPluginManifest& m) { return m.id == pluginKey; });
+    if (match == manifests.end())
+        match = std::find_if(manifests.begin(), manifests.end(), [&](const CustomPluginManifest& m)
         {
-            manifestId = m.id;
-            break;
-        }
-    }
-    if (manifestId.isEmpty())
-        manifestId = "com.maximeter.custom." + pluginName;
+            return m.sourceFile.equalsIgnoreCase(pluginKey)
+                || m.id.endsWithIgnoreCase(pluginKey)
+                || m.name.removeCharacters(" ").equalsIgnoreCase(pluginKey);
+        });
+
+    const auto manifestId = match != manifests.end() ? match->id
+                                                     : "com.maximeter.custom." + pluginKey;
 
     auto instanceId = juce::Uuid().toString();
     item->customPluginId   = manifestId;
     item->customInstanceId = instanceId;
-    item->name             = pluginName.replace("_", " ");
+    item->name             = match != manifests.end() ? match->name : pluginKey.replace("_", " ");
 
     auto* cpc = static_cast<CustomPluginComponent*>(item->component.get());
-    if (bridge.isRunning())
+    if (bridge.isAvailable())
     {
         auto props = bridge.createInstance(manifestId, instanceId);
-        if (props.empty())
+        if (!props)
         {
             DBG("CanvasEditor: createInstance FAILED for " + manifestId
                 + " — will retry automatically via auto-recovery");
@@ -332,8 +392,8 @@ CanvasItem* CanvasEditor::addCustomPluginAt(const juce::String& pluginName,
         else
         {
             MAXIMETER_LOG("INSTANCE", "createInstance OK for " + manifestId + " / " + instanceId
-                + " (" + juce::String((int)props.size()) + " props)");
-            cpc->setPluginProperties(props);
+                + " (" + juce::String((int)props->size()) + " props)");
+            cpc->setPluginProperties(*props);
         }
     }
     cpc->setPluginId(manifestId, instanceId);
@@ -375,8 +435,8 @@ void CanvasEditor::itemDropped(const SourceDetails& details)
         auto desc = details.description.toString();
         if (desc.startsWith(kToolboxCustomPluginDragPrefix))
         {
-            auto pluginName = desc.fromFirstOccurrenceOf(kToolboxCustomPluginDragPrefix, false, false);
-            addCustomPluginAt(pluginName, canvasPos);
+            auto pluginKey = desc.fromFirstOccurrenceOf(kToolboxCustomPluginDragPrefix, false, false);
+            addCustomPluginAt(pluginKey, canvasPos);
         }
         return;
     }
@@ -481,10 +541,10 @@ void CanvasEditor::showContextMenu(CanvasItem* item, juce::Point<int> screenPos)
                     duplicateItems();
                     break;
                 case 3: // Lock/Unlock
-                    if (item) { item->locked = !item->locked; model.notifyItemsChanged(); }
+                    if (item) { item->locked = !item->locked; model.notifyItemPropertyChanged(item->id); }
                     break;
                 case 4: // Show/Hide
-                    if (item) { item->visible = !item->visible; model.notifyItemsChanged(); }
+                    if (item) { item->visible = !item->visible; model.notifyItemPropertyChanged(item->id); }
                     break;
                 case 5: // Rotate
                     if (item && !item->locked)
@@ -516,7 +576,7 @@ void CanvasEditor::showContextMenu(CanvasItem* item, juce::Point<int> screenPos)
                                         if (auto* targetItem = model.findItem(itemId))
                                         {
                                             targetItem->name = newName;
-                                            model.notifyItemsChanged();
+                                            model.notifyItemPropertyChanged(itemId);
                                         }
                                     }
                                 }
@@ -542,7 +602,7 @@ void CanvasEditor::showContextMenu(CanvasItem* item, juce::Point<int> screenPos)
                     }
                     break;
                 case 12: // Toggle aspect
-                    if (item) { item->aspectLock = !item->aspectLock; model.notifyItemsChanged(); }
+                    if (item) { item->aspectLock = !item->aspectLock; model.notifyItemPropertyChanged(item->id); }
                     break;
                 case 20: // Paste
                 {
@@ -809,14 +869,6 @@ void CanvasEditor::showRenderPreview()
     window->centreWithSize(window->getWidth(), window->getHeight());
 }
 
-//==============================================================================
-void CanvasEditor::setExportOverlay(bool show)
-{
-    exportOverlay_ = show;
-    canvasView.setInterceptsMouseClicks(!show, !show);
-    repaint();
-}
-
 //==============================================================================
 // PanelEdgeDivider — thin vertical strip that lets the user drag to resize
 // the right properties/settings/layers panel.
@@ -19,14 +19,19 @@
 /// Stage 7: Implements DragAndDropTarget to receive meters dragged from toolbox.
 class CanvasEditor : public juce::Component,
                      public juce::DragAndDropTarget,
-                     public CanvasView::Listener
+                     public CanvasView::Listener,
+                     private CanvasModelListener
 {
 public:
     CanvasEditor(AudioEngine& audioEngine,
                  FFTProcessor& fftProcessor,
+                 OctaveBandAnalyzer& octaveBands,
                  LevelAnalyzer& levelAnalyzer,
                  LoudnessAnalyzer& loudnessAnalyzer,
-                 StereoFieldAnalyzer& stereoAnalyzer);
+                 StereoFieldAnalyzer& stereoAnalyzer,
+                 MetricHistory& metricHistory,
+                 AnalysisGraph& analysisGraph,
+                 StemBank& stemBank);
     ~CanvasEditor() override;
 
     void paint(juce::Graphics& g) override;
@@ -40,7 +45,8 @@ public:
 
     /// Add a custom Python plugin component at the given canvas position.
     /// Handles PythonPluginBridge startup, manifest lookup, and instance creation.
-    CanvasItem* addCustomPluginAt(const juce::String& pluginName, juce::Point<float> canvasPos);
+    /// @p pluginKey is a manifest id (or a plugin file stem as a fallback).
+    CanvasItem* addCustomPluginAt(const juce::String& pluginKey, juce::Point<float> canvasPos);
 
     /// Apply skin to all skinnable items.
     void applySkinToAll(const Skin::SkinModel* skin);
@@ -48,6 +54,10 @@ public:
     /// Reset meters on new file load.
     void onFileLoaded(double sampleRate);
 
+    /// Stems were added or removed: refresh the source choices and re-bind
+    /// the analysis graphs.
+    void onStemsChanged();
+
     /// Access model (for external wiring if needed).
     CanvasModel& getModel() { return model; }
 
@@ -75,10 +85,6 @@ public:
     /// Show or hide the MiniMap overlay.
     void setMiniMapVisible(bool visible) { miniMap.setVisible(visible); resized(); }
 
-    /// Freeze the viewport and show a grey overlay during export.
-    void setExportOverlay(bool show);
-    bool isExportOverlayActive() const { return exportOverlay_; }
-
     /// Render a single preview frame at the given resolution using the live
     /// component state.  Returns a software-backed Image.
     juce::Image renderPreviewFrame(int videoW, int videoH);
@@ -109,6 +115,15 @@ public:
     void itemDropped(const SourceDetails& details) override;
 
 private:
+    // CanvasModelListener — keeps the render and analysis graphs in step with the canvas
+    void itemsChanged() override { renderGraphDirty_ = true; }
+    void itemChangesBatched(const CanvasChangeSet& changes) override;
+    void updateAnalysisGraph();
+    void rebuildRenderGraph();
+
+    /// Load the media file / SVG of an item whose component was just created.
+    void loadItemMedia(CanvasItem& item);
+
     CanvasModel          model;
     CanvasView           canvasView;
     CanvasToolbox        toolbox;
@@ -118,6 +133,10 @@ private:
     MiniMap              miniMap;
     AlignmentToolbar     alignToolbar;
     MeterFactory         meterFactory;
+    AnalysisGraph&       analysisGraph;   ///< main mix
+    StemBank&            stemBank;        ///< per-stem analyzers
+    RenderGraph          renderGraph;     ///< live schedule of the canvas items
+    bool                 renderGraphDirty_ = true;  ///< items edited since the last build
 
     // Splitter positions
     static constexpr int kToolboxWidth    = 180;
@@ -145,9 +164,6 @@ private:
     /// Draggable divider ratio — fraction of right panel used by layer panel (bottom)
     float layerPanelRatio_ = 0.35f;
 
-    /// Export overlay state
-    bool exportOverlay_ = false;
-
     void showContextMenu(CanvasItem* item, juce::Point<int> screenPos);
 
     /// Toggle interactive mode for an item (enables/disables mouse passthrough).
@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "../UI/MeterBase.h"
+#include "../Audio/AnalysisGraph.h"
 #include <memory>
 #include <vector>
 
@@ -107,6 +108,67 @@ inline juce::Rectangle<int> meterDefaultSize(MeterType t)
     }
 }
 
+/// Analyzers a meter type reads when it is fed (see MeterFactory::feedMeter).
+/// CustomPlugin items use their manifest's declaration instead.
+inline Analysis::Requirements meterAnalysisRequirements(MeterType t)
+{
+    using namespace Analysis;
+    switch (t)
+    {
+        case MeterType::MultiBandAnalyzer:
+        case MeterType::Spectrogram:
+        case MeterType::SkinnedSpectrum:
+        case MeterType::SkinnedPlayer:      return { Spectrum, 0 };
+        case MeterType::Goniometer:
+        case MeterType::LissajousScope:
+        case MeterType::CorrelationMeter:   return { Stereo, 0 };
+        case MeterType::LoudnessMeter:      return { Loudness | History, 0 };
+        case MeterType::LevelHistogram:     return { History, 0 };
+        case MeterType::PeakMeter:
+        case MeterType::SkinnedVUMeter:     return { Levels, 0 };
+        case MeterType::CustomPlugin:       return { All, 0 };
+        default:                            return {};   // raw samples or static content
+    }
+}
+
+/// Meter types that can be bound to a stem instead of the main mix.  Plugins
+/// share one audio snapshot per frame and transport widgets follow the
+/// player, so both always read the mix.
+inline bool meterSupportsAudioSource(MeterType t)
+{
+    switch (t)
+    {
+        case MeterType::MultiBandAnalyzer:
+        case MeterType::Spectrogram:
+        case MeterType::SkinnedSpectrum:
+        case MeterType::Goniometer:
+        case MeterType::LissajousScope:
+        case MeterType::CorrelationMeter:
+        case MeterType::LoudnessMeter:
+        case MeterType::LevelHistogram:
+        case MeterType::PeakMeter:
+        case MeterType::SkinnedVUMeter:
+        case MeterType::SkinnedOscilloscope: return true;
+        default:                             return false;
+    }
+}
+
+/// Meter types that build up their own picture over time (a scrolling
+/// spectrogram), so they must keep being fed while culled.  Meters drawing
+/// from MetricHistory catch up on their next feed and don't need it.
+inline bool meterKeepsOwnHistory(MeterType t)
+{
+    return t == MeterType::Spectrogram;
+}
+
+/// Meter types that can be drawn from a component snapshot when tiny.
+/// Plugin output comes from an off-screen GL pipeline that a software
+/// snapshot does not capture, so plugins always render live.
+inline bool meterSupportsThumbnail(MeterType t)
+{
+    return t != MeterType::CustomPlugin;
+}
+
 //==============================================================================
 /// A single item on the canvas – wraps a Component (meter) with canvas-space
 /// transform (position, size, rotation), z-order, visibility, lock, and group.
@@ -143,6 +205,10 @@ struct CanvasItem
     /// VU meter channel: 0 = Left, 1 = Right
     int                                 vuChannel = 0;
 
+    /// Stem this meter reads (StemBank id); empty = the main mix.  Falls
+    /// back to the mix while the stem is not loaded.
+    juce::String                        audioSource;
+
     // ── Per-item background ──
     juce::Colour                        itemBackground { 0x00000000 }; ///< transparent by default
 
@@ -191,6 +257,16 @@ struct CanvasItem
     /// Toggle via double-click; exit via Escape or clicking outside.
     bool                                interactiveMode = false;
 
+    // ── View culling / LOD (runtime only, maintained by CanvasView) ──
+    /// False while the item lies outside the visible canvas area.
+    bool                                onScreen     = true;
+    /// True while the item is too small on screen to render live and is
+    /// drawn from a cached thumbnail instead.
+    bool                                useThumbnail = false;
+
+    /// Live items are painted by their component and fed every tick.
+    bool isRenderedLive() const { return onScreen && !useThumbnail; }
+
     /// Bounding rectangle in canvas space.
     juce::Rectangle<float> getBounds() const { return { x, y, width, height }; }
     void setBounds(juce::Rectangle<float> r) { x = r.getX(); y = r.getY(); width = r.getWidth(); height = r.getHeight(); }
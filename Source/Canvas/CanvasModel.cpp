@@ -5,6 +5,63 @@
 //==============================================================================
 CanvasModel::CanvasModel() {}
 
+//==============================================================================
+// Change notification
+//==============================================================================
+void CanvasModel::itemsDidChange()
+{
+    listeners.call(&CanvasModelListener::itemsChanged);
+    triggerAsyncUpdate();
+}
+
+void CanvasModel::handleAsyncUpdate()
+{
+    // Swap out first so listeners can safely trigger further edits
+    CanvasChangeSet changes;
+    std::swap(changes, pendingChanges);
+
+    // Resolve add/remove pairs within one turn against the final state:
+    // an item added then removed never existed for listeners, and one
+    // removed then re-added (undo/redo) just looks edited.
+    for (auto it = changes.added.begin(); it != changes.added.end();)
+    {
+        if (findItem(*it) == nullptr)
+        {
+            changes.removed.erase(*it);
+            it = changes.added.erase(it);
+        }
+        else if (changes.removed.erase(*it) > 0)
+        {
+            changes.propertyChanged.insert(*it);
+            it = changes.added.erase(it);
+        }
+        else
+            ++it;
+    }
+
+    listeners.call(&CanvasModelListener::itemChangesBatched, changes);
+}
+
+void CanvasModel::notifyItemsMoved(const std::vector<juce::Uuid>& ids)
+{
+    pendingChanges.moved.insert(ids.begin(), ids.end());
+    itemsDidChange();
+}
+
+void CanvasModel::notifyItemsMoved(const std::vector<CanvasItem*>& changed)
+{
+    for (auto* item : changed)
+        pendingChanges.moved.insert(item->id);
+    itemsDidChange();
+}
+
+void CanvasModel::notifyItemsPropertyChanged(const std::vector<CanvasItem*>& changed)
+{
+    for (auto* item : changed)
+        pendingChanges.propertyChanged.insert(item->id);
+    itemsDidChange();
+}
+
 //==============================================================================
 // Items
 //==============================================================================
@@ -13,7 +70,7 @@ CanvasItem* CanvasModel::addItem(std::unique_ptr<CanvasItem> item)
     item->zOrder = nextZOrder++;
     auto* ptr = item.get();
     items.push_back(std::move(item));
-    notifyItemsChanged();
+    notifyItemAdded(ptr->id);
     return ptr;
 }
 
@@ -22,7 +79,7 @@ void CanvasModel::removeItem(const juce::Uuid& id)
     selection.erase(id);
     items.erase(std::remove_if(items.begin(), items.end(),
         [&](auto& p) { return p->id == id; }), items.end());
-    notifyItemsChanged();
+    notifyItemRemoved(id);
 }
 
 CanvasItem* CanvasModel::findItem(const juce::Uuid& id)
@@ -277,7 +334,7 @@ void CanvasModel::alignSelection(AlignEdge edge)
             case AlignEdge::Bottom:  item->y = refVal - item->height; break;
         }
     }
-    notifyItemsChanged();
+    notifyItemsMoved(sel);
 }
 
 void CanvasModel::distributeSelectionH()
@@ -298,7 +355,7 @@ void CanvasModel::distributeSelectionH()
         if (!s->locked) s->x = cx;
         cx += s->width + gap;
     }
-    notifyItemsChanged();
+    notifyItemsMoved(sel);
 }
 
 void CanvasModel::distributeSelectionV()
@@ -319,7 +376,7 @@ void CanvasModel::distributeSelectionV()
         if (!s->locked) s->y = cy;
         cy += s->height + gap;
     }
-    notifyItemsChanged();
+    notifyItemsMoved(sel);
 }
 
 //==============================================================================
@@ -333,7 +390,7 @@ void CanvasModel::groupSelection()
     auto gid = juce::Uuid();
     for (auto* item : sel)
         item->groupId = gid;
-    notifyItemsChanged();
+    notifyItemsPropertyChanged(sel);
 }
 
 void CanvasModel::ungroupSelection()
@@ -341,7 +398,7 @@ void CanvasModel::ungroupSelection()
     auto sel = getSelectedItems();
     for (auto* item : sel)
         item->groupId = juce::Uuid();       // null Uuid = not grouped
-    notifyItemsChanged();
+    notifyItemsPropertyChanged(sel);
 }
 
 std::vector<CanvasItem*> CanvasModel::getGroupMembers(const juce::Uuid& gid)
@@ -419,6 +476,7 @@ void CanvasModel::copySelection()
         ci.locked          = s->locked;
         ci.visible         = s->visible;
         ci.vuChannel       = s->vuChannel;
+        ci.audioSource     = s->audioSource;
         ci.mediaFilePath   = s->mediaFilePath;
         ci.customPluginId  = s->customPluginId;
         ci.fillColour1       = s->fillColour1;
@@ -486,6 +544,7 @@ void CanvasModel::paste(juce::Point<float> at)
         item->locked           = ci.locked;
         item->visible          = ci.visible;
         item->vuChannel        = ci.vuChannel;
+        item->audioSource      = ci.audioSource;
         item->mediaFilePath    = ci.mediaFilePath;
         item->customPluginId   = ci.customPluginId;
         // customInstanceId intentionally blank — fresh instance on paste
@@ -43,6 +43,31 @@ struct GuideInfo
     float position = 0.0f;   ///< Canvas-space X or Y for the guide line
 };
 
+//==============================================================================
+/// Item edits coalesced over one message-loop turn, keyed by item id.
+struct CanvasChangeSet
+{
+    std::set<juce::Uuid> added;
+    std::set<juce::Uuid> removed;
+    std::set<juce::Uuid> moved;             ///< Position / size / rotation only
+    std::set<juce::Uuid> propertyChanged;   ///< Any other per-item field
+    bool zOrderChanged = false;
+    bool structural    = false;             ///< Unspecified change — refresh everything
+
+    /// True if @p id was touched in any way (or the change was structural).
+    bool affects(const juce::Uuid& id) const
+    {
+        return structural || added.count(id) || removed.count(id)
+            || moved.count(id) || propertyChanged.count(id);
+    }
+
+    /// True if rows/entries were added, removed or reordered.
+    bool changesLayout() const
+    {
+        return structural || zOrderChanged || !added.empty() || !removed.empty();
+    }
+};
+
 //==============================================================================
 /// Observer interface for canvas model changes.
 class CanvasModelListener
@@ -50,7 +75,12 @@ class CanvasModelListener
 public:
     virtual ~CanvasModelListener() = default;
 
+    /// Sent synchronously on every item edit.  Keep handlers cheap — use
+    /// itemChangesBatched() for anything that rebuilds UI.
     virtual void itemsChanged()       {}
+
+    /// Sent once per message-loop turn with every edit since the last call.
+    virtual void itemChangesBatched(const CanvasChangeSet&) {}
     virtual void selectionChanged()   {}
     virtual void zoomPanChanged()     {}
     virtual void backgroundChanged()  {}
@@ -59,7 +89,7 @@ public:
 //==============================================================================
 /// Central data model for the canvas editor.  Owns all CanvasItems,
 /// selection state, zoom/pan, grid, background, and undo manager.
-class CanvasModel
+class CanvasModel : private juce::AsyncUpdater
 {
 public:
     CanvasModel();
@@ -146,7 +176,18 @@ public:
     void addListener(CanvasModelListener* l)     { listeners.add(l); }
     void removeListener(CanvasModelListener* l)  { listeners.remove(l); }
 
-    void notifyItemsChanged()      { listeners.call(&CanvasModelListener::itemsChanged); }
+    /// Coarse notification for edits that don't say what changed.
+    void notifyItemsChanged()      { pendingChanges.structural = true; itemsDidChange(); }
+
+    void notifyItemAdded(const juce::Uuid& id)            { pendingChanges.added.insert(id); itemsDidChange(); }
+    void notifyItemRemoved(const juce::Uuid& id)          { pendingChanges.removed.insert(id); itemsDidChange(); }
+    void notifyItemMoved(const juce::Uuid& id)            { pendingChanges.moved.insert(id); itemsDidChange(); }
+    void notifyItemsMoved(const std::vector<juce::Uuid>& ids);
+    void notifyItemsMoved(const std::vector<CanvasItem*>& changed);
+    void notifyItemPropertyChanged(const juce::Uuid& id)  { pendingChanges.propertyChanged.insert(id); itemsDidChange(); }
+    void notifyItemsPropertyChanged(const std::vector<CanvasItem*>& changed);
+    void notifyZOrderChanged()     { pendingChanges.zOrderChanged = true; itemsDidChange(); }
+
     void notifySelectionChanged()   { listeners.call(&CanvasModelListener::selectionChanged); }
     void notifyZoomPanChanged()     { listeners.call(&CanvasModelListener::zoomPanChanged); }
     void notifyBackgroundChanged()  { listeners.call(&CanvasModelListener::backgroundChanged); }
@@ -155,6 +196,10 @@ private:
     std::vector<std::unique_ptr<CanvasItem>> items;
     std::set<juce::Uuid>                     selection;
     juce::ListenerList<CanvasModelListener>  listeners;
+    CanvasChangeSet                          pendingChanges;
+
+    void itemsDidChange();
+    void handleAsyncUpdate() override;
 
     // Clipboard buffer — carries every visual property so paste is a full clone.
     struct ClipItem
@@ -175,6 +220,7 @@ private:
         bool         locked       = false;
         bool         visible      = true;
         int          vuChannel    = 0;
+        juce::String audioSource;
         // Media
         juce::String mediaFilePath;
         juce::String customPluginId;  ///< manifest id; new instance created on paste
@@ -82,7 +82,7 @@ CanvasPropertyPanel::CanvasPropertyPanel(CanvasModel& m) : model(m)
                 model.grid.gridColour = c;
                 gridColourButton.setColour(juce::TextButton::buttonColourId, c);
                 gridColourButton.repaint();
-                model.notifyItemsChanged();
+                model.notifyBackgroundChanged();
             });
     };
 
@@ -102,7 +102,7 @@ CanvasPropertyPanel::CanvasPropertyPanel(CanvasModel& m) : model(m)
                     item->itemBackground = c;
                 itemBgColourButton.setColour(juce::TextButton::buttonColourId, c);
                 itemBgColourButton.repaint();
-                model.notifyItemsChanged();
+                model.notifyItemsPropertyChanged(model.getSelectedItems());
             });
     };
 
@@ -122,7 +122,7 @@ CanvasPropertyPanel::CanvasPropertyPanel(CanvasModel& m) : model(m)
                     item->meterBgColour = c;
                 meterBgButton.setColour(juce::TextButton::buttonColourId, c);
                 meterBgButton.repaint();
-                model.notifyItemsChanged();
+                model.notifyItemsPropertyChanged(model.getSelectedItems());
             });
     };
 
@@ -142,7 +142,7 @@ CanvasPropertyPanel::CanvasPropertyPanel(CanvasModel& m) : model(m)
                     item->meterFgColour = c;
                 meterFgButton.setColour(juce::TextButton::buttonColourId, c);
                 meterFgButton.repaint();
-                model.notifyItemsChanged();
+                model.notifyItemsPropertyChanged(model.getSelectedItems());
             });
     };
 
@@ -326,6 +326,37 @@ void CanvasPropertyPanel::layoutContent()
 }
 
 //==============================================================================
+void CanvasPropertyPanel::itemChangesBatched(const CanvasChangeSet& changes)
+{
+    auto sel = model.getSelectedItems();
+    if (sel.empty())
+    {
+        // A removed item may have been the one on display
+        if (changes.structural || !changes.removed.empty())
+            refresh();
+        return;
+    }
+
+    // Only the first selected item is displayed — ignore edits to others
+    auto* item = sel.front();
+    if (changes.structural || changes.added.count(item->id)
+        || changes.propertyChanged.count(item->id))
+        refresh();
+    else if (changes.moved.count(item->id))
+        refreshGeometry(*item);
+}
+
+void CanvasPropertyPanel::refreshGeometry(const CanvasItem& item)
+{
+    xEditor.setText(juce::String(item.x, 1), false);
+    yEditor.setText(juce::String(item.y, 1), false);
+    wEditor.setText(juce::String(item.width, 1), false);
+    hEditor.setText(juce::String(item.height, 1), false);
+
+    int rotIdx = (item.rotation / 90) + 1;
+    rotCombo.setSelectedId(juce::jlimit(1, 4, rotIdx), juce::dontSendNotification);
+}
+
 void CanvasPropertyPanel::refresh()
 {
     auto sel = model.getSelectedItems();
@@ -389,13 +420,7 @@ void CanvasPropertyPanel::refresh()
     blendCombo.setEnabled(true);
     auto* item = sel.front();
     nameEditor.setText(item->name, false);
-    xEditor.setText(juce::String(item->x, 1), false);
-    yEditor.setText(juce::String(item->y, 1), false);
-    wEditor.setText(juce::String(item->width, 1), false);
-    hEditor.setText(juce::String(item->height, 1), false);
-
-    int rotIdx = (item->rotation / 90) + 1;
-    rotCombo.setSelectedId(juce::jlimit(1, 4, rotIdx), juce::dontSendNotification);
+    refreshGeometry(*item);
     lockToggle.setToggleState(item->locked, juce::dontSendNotification);
     visibleToggle.setToggleState(item->visible, juce::dontSendNotification);
     aspectToggle.setToggleState(item->aspectLock, juce::dontSendNotification);
@@ -425,5 +450,5 @@ void CanvasPropertyPanel::applyEdits()
         item->opacity = static_cast<float>(opacitySlider.getValue());
         item->blendMode = static_cast<BlendMode>(blendCombo.getSelectedId() - 1);
     }
-    model.notifyItemsChanged();
+    model.notifyItemsPropertyChanged(sel);
 }
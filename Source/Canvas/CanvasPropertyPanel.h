@@ -18,7 +18,7 @@ public:
 
     // CanvasModelListener
     void selectionChanged() override { refresh(); }
-    void itemsChanged() override    { refresh(); }
+    void itemChangesBatched(const CanvasChangeSet& changes) override;
 
     void refresh();
     void applyThemeColours();
@@ -71,6 +71,7 @@ private:
     juce::ComboBox     blendCombo;
 
     void applyEdits();
+    void refreshGeometry(const CanvasItem& item);   ///< X/Y/W/H/rotation only
     void setupRow(juce::Label& lbl, const juce::String& text, juce::Component& editor);
     void launchColourPicker(juce::TextButton& btn, juce::Colour initial,
                             std::function<void(juce::Colour)> onChange);
@@ -1,4 +1,5 @@
 #include "CanvasToolbox.h"
+#include "NativePluginHost.h"
 
 //==============================================================================
 CanvasToolbox::CanvasToolbox()
@@ -110,20 +111,40 @@ void CanvasToolbox::refreshCustomPlugins()
     if (pluginsDir.isDirectory())
     {
         auto files = pluginsDir.findChildFiles(
-            juce::File::findFiles, false, "*.py");
+            juce::File::findFiles, false, "*.py;" + NativePluginHost::getModuleWildcard());
 
         // Sort alphabetically
         files.sort();
 
+        // Native modules are loaded here if the bridge has not done it yet,
+        // so each of their plugins gets its own entry
+        NativePluginHost::getInstance().scan(pluginsDir);
+        auto manifests = PythonPluginBridge::getInstance().getAvailablePlugins();
+
         for (auto& f : files)
         {
-            // Skip __init__.py and files starting with _
+            // Skip __init__.py and files starting with _ (Python and native)
             if (f.getFileName().startsWith("_"))
                 continue;
 
-            auto item = std::make_unique<CustomPluginItem>(f, *this);
-            itemContainer.addAndMakeVisible(item.get());
-            customItems.push_back(std::move(item));
+            bool listed = false;
+            for (auto& m : manifests)
+            {
+                if (m.sourceFile != f.getFileNameWithoutExtension())
+                    continue;
+
+                auto item = std::make_unique<CustomPluginItem>(f, *this, m.id, m.name);
+                itemContainer.addAndMakeVisible(item.get());
+                customItems.push_back(std::move(item));
+                listed = true;
+            }
+
+            if (!listed)
+            {
+                auto item = std::make_unique<CustomPluginItem>(f, *this);
+                itemContainer.addAndMakeVisible(item.get());
+                customItems.push_back(std::move(item));
+            }
         }
     }
 
@@ -359,7 +380,7 @@ void CanvasToolbox::applyFilter()
 {
     // Get custom plugin manifests for tag matching
     auto& bridge = PythonPluginBridge::getInstance();
-    auto manifests = bridge.isRunning() ? bridge.getAvailablePlugins()
+    auto manifests = bridge.isAvailable() ? bridge.getAvailablePlugins()
                                         : std::vector<CustomPluginManifest>();
 
     // Filter built-in meter items
@@ -381,7 +402,8 @@ void CanvasToolbox::applyFilter()
         auto stem = ci->pluginFile.getFileNameWithoutExtension();
         for (auto& m : manifests)
         {
-            if (m.sourceFile == stem || m.id.endsWithIgnoreCase(stem))
+            if (ci->manifestId.isNotEmpty() ? m.id == ci->manifestId
+                                            : (m.sourceFile == stem || m.id.endsWithIgnoreCase(stem)))
             {
                 for (auto& t : m.tags)
                     tags.addIfNotAlreadyThere(t.toLowerCase());
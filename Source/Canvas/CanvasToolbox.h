@@ -53,8 +53,9 @@ inline juce::StringArray allToolboxTags()
 /// The var payload is the integer value of the MeterType enum.
 static const juce::String kToolboxDragDescription = "ToolboxMeterDrag";
 
-/// Prefix used when dragging a custom Python plugin from the toolbox.
-/// Full description is  kToolboxCustomPluginDragPrefix + pluginFileNameWithoutExtension.
+/// Prefix used when dragging a custom plugin from the toolbox.  Full
+/// description is  kToolboxCustomPluginDragPrefix + manifest id, or + the
+/// plugin's file name without extension while its manifest is not known.
 static const juce::String kToolboxCustomPluginDragPrefix = "CustomPlugin:"; 
 
 //==============================================================================
@@ -79,8 +80,9 @@ public:
     /// The Point is in screen coordinates — the receiver converts to canvas space.
     std::function<void(MeterType, juce::Point<int>)> onMeterDragged;
 
-    /// Callback when user clicks a custom plugin to add.
-    std::function<void(const juce::String& pluginName)> onCustomPluginSelected;
+    /// Callback when user clicks a custom plugin to add.  @p pluginKey is
+    /// the manifest id, or the file name stem if the manifest is not known.
+    std::function<void(const juce::String& pluginKey)> onCustomPluginSelected;
 
     // ThemeManager::Listener
     void themeChanged(AppTheme newTheme) override;
@@ -216,9 +218,21 @@ private:
     class CustomPluginItem : public juce::Component
     {
     public:
-        CustomPluginItem(const juce::File& file, CanvasToolbox& owner)
-            : pluginFile(file), toolbox(owner)
+        /// One entry per manifest: a native module may export several
+        /// plugins, so entries are keyed by @p id when it is known.
+        CustomPluginItem(const juce::File& file, CanvasToolbox& owner,
+                         const juce::String& id = {}, const juce::String& name = {})
+            : pluginFile(file), manifestId(id), toolbox(owner)
         {
+            isNative = !file.hasFileExtension("py");
+            badge    = isNative ? "C++" : "Py";
+
+            if (name.isNotEmpty())
+            {
+                displayName = name;
+                return;
+            }
+
             displayName = file.getFileNameWithoutExtension()
                               .replace("_", " ");
             // Capitalize first letter of each word
@@ -229,6 +243,12 @@ private:
             displayName = words.joinIntoString(" ");
         }
 
+        /// What the canvas receives: the manifest id, or the file stem
+        juce::String getPluginKey() const
+        {
+            return manifestId.isNotEmpty() ? manifestId : pluginFile.getFileNameWithoutExtension();
+        }
+
         void paint(juce::Graphics& g) override
         {
             auto& pal = ThemeManager::getInstance().getPalette();
@@ -243,7 +263,7 @@ private:
                 auto iconArea = getLocalBounds().reduced(6).removeFromTop(24).toFloat();
                 g.setColour(juce::Colour(0xFF4EC9B0));
                 g.setFont(14.0f);
-                g.drawText("Py", iconArea.withSizeKeepingCentre(20, 20), juce::Justification::centred);
+                g.drawText(badge, iconArea.withSizeKeepingCentre(20, 20), juce::Justification::centred);
 
                 g.setColour(pal.buttonText);
                 g.setFont(9.0f);
@@ -255,7 +275,7 @@ private:
                 auto iconArea = getLocalBounds().reduced(4, 2).removeFromLeft(16).toFloat();
                 g.setColour(juce::Colour(0xFF4EC9B0));
                 g.setFont(11.0f);
-                g.drawText("Py", iconArea, juce::Justification::centred);
+                g.drawText(badge, iconArea, juce::Justification::centred);
 
                 auto textArea = getLocalBounds().reduced(22, 0).withTrimmedRight(4);
                 g.setColour(pal.buttonText);
@@ -268,7 +288,7 @@ private:
                 auto iconArea = getLocalBounds().reduced(6, 6).removeFromLeft(20).toFloat();
                 g.setColour(juce::Colour(0xFF4EC9B0));
                 g.setFont(14.0f);
-                g.drawText("Py", iconArea, juce::Justification::centred);
+                g.drawText(badge, iconArea, juce::Justification::centred);
 
                 // Plugin display name
                 auto textArea = getLocalBounds().reduced(30, 0).withTrimmedRight(10);
@@ -302,7 +322,7 @@ private:
                 {
                     auto& pal = ThemeManager::getInstance().getPalette();
 
-                    // Drag-image: teal "Py" badge + plugin name
+                    // Drag-image: teal runtime badge + plugin name
                     juce::Image dragImage(juce::Image::ARGB, 160, 28, true);
                     {
                         juce::Graphics ig(dragImage);
@@ -310,7 +330,7 @@ private:
                         ig.fillRoundedRectangle(dragImage.getBounds().toFloat(), 4.0f);
                         ig.setColour(juce::Colours::white);
                         ig.setFont(juce::Font(11.0f, juce::Font::bold));
-                        ig.drawText("Py", dragImage.getBounds().removeFromLeft(28).toFloat(),
+                        ig.drawText(badge, dragImage.getBounds().removeFromLeft(28).toFloat(),
                                     juce::Justification::centred);
                         ig.setFont(12.0f);
                         ig.drawText(displayName,
@@ -318,9 +338,9 @@ private:
                                     juce::Justification::centredLeft);
                     }
 
-                    // Description: prefix + plugin filename (without extension)
+                    // Description: prefix + manifest id (or file stem)
                     container->startDragging(
-                        kToolboxCustomPluginDragPrefix + pluginFile.getFileNameWithoutExtension(),
+                        kToolboxCustomPluginDragPrefix + getPluginKey(),
                         this, dragImage, true);
                 }
             }
@@ -333,11 +353,14 @@ private:
 
             if (!dragged && getLocalBounds().contains(e.getPosition()))
                 if (toolbox.onCustomPluginSelected)
-                    toolbox.onCustomPluginSelected(pluginFile.getFileNameWithoutExtension());
+                    toolbox.onCustomPluginSelected(getPluginKey());
         }
 
         juce::File pluginFile;
+        juce::String manifestId;    ///< empty until the runtime has reported it
         juce::String displayName;
+        juce::String badge;         ///< "Py" or "C++" (native module)
+        bool isNative = false;
         CanvasToolbox& toolbox;
         bool dragged = false;
 
@@ -345,8 +368,11 @@ private:
         void showContextMenu()
         {
             juce::PopupMenu menu;
-            menu.addItem(1, "Edit in Editor");
-            menu.addSeparator();
+            if (!isNative)
+            {
+                menu.addItem(1, "Edit in Editor");
+                menu.addSeparator();
+            }
             menu.addItem(2, "Delete Component");
 
             menu.showMenuAsync(juce::PopupMenu::Options(),
@@ -3,8 +3,10 @@
 #include "../UI/ThemeManager.h"
 #include "../UI/ShapeComponent.h"
 #include "CustomPluginComponent.h"
+#include "RenderGraph.h"
 #include "../Project/AppSettings.h"
 #include <cmath>
+#include <set>
 
 //==============================================================================
 CanvasView::CanvasView(CanvasModel& m) : model(m)
@@ -19,8 +21,16 @@ CanvasView::~CanvasView()
 }
 
 //==============================================================================
+juce::Rectangle<float> CanvasView::getVisibleCanvasArea() const
+{
+    return model.screenToCanvas(getLocalBounds().toFloat());
+}
+
 void CanvasView::updateChildBounds()
 {
+    const auto visibleArea = getVisibleCanvasArea().expanded(kCullMarginPx / model.zoom);
+    std::set<juce::Uuid> thumbnailIds;
+
     // Update JUCE child component z-order to match model's zOrder.
     // Items are already sorted by zOrder (low = back, high = front).
     for (int i = 0; i < model.getNumItems(); ++i)
@@ -28,12 +38,38 @@ void CanvasView::updateChildBounds()
         auto* item = model.getItem(i);
         if (!item->component) continue;
 
-        // Ensure JUCE child stacking matches z-order
-        item->component->toFront(false);
-
         auto canvasRect = item->getBounds();
         auto screenRect = model.canvasToScreen(canvasRect);
 
+        // ── Culling: rotated footprint vs. visible area ──
+        auto footprint = canvasRect;
+        if (item->rotation != 0)
+            footprint = canvasRect.transformedBy(juce::AffineTransform::rotation(
+                static_cast<float>(item->rotation) * juce::MathConstants<float>::pi / 180.0f,
+                canvasRect.getCentreX(), canvasRect.getCentreY()));
+        item->onScreen = footprint.intersects(visibleArea);
+
+        // ── LOD: tiny items are drawn from a thumbnail in paint() ──
+        bool tiny = item->onScreen && !item->interactiveMode
+                    && meterSupportsThumbnail(item->meterType)
+                    && juce::jmax(screenRect.getWidth(), screenRect.getHeight())
+                           < kThumbnailThresholdPx;
+        // Without a usable snapshot the item keeps rendering live
+        if (tiny && !thumbnails_.count(item->id))
+            tiny = captureThumbnail(*item);
+        item->useThumbnail = tiny;
+        if (tiny)
+            thumbnailIds.insert(item->id);
+
+        if (placeholderMode_ || !item->isRenderedLive())
+        {
+            item->component->setVisible(false);
+            continue;
+        }
+
+        // Ensure JUCE child stacking matches z-order
+        item->component->toFront(false);
+
         // CustomPluginComponent: keep bounds at canvas-space size and use
         // setTransform for zoom + position so that resized() reports the
         // logical (unzoomed) dimensions to the Python bridge.
@@ -78,15 +114,94 @@ void CanvasView::updateChildBounds()
             }
         }
 
-        // Hide actual components if we are in performance placeholder mode
-        if (placeholderMode_)
-            item->component->setVisible(false);
-        else
-            item->component->setVisible(item->visible);
+        item->component->setVisible(item->visible);
 
         // Apply opacity
         item->component->setAlpha(item->opacity);
     }
+
+    // Drop thumbnails of items that grew back or no longer exist
+    for (auto it = thumbnails_.begin(); it != thumbnails_.end();)
+    {
+        if (thumbnailIds.count(it->first))
+            ++it;
+        else
+            it = thumbnails_.erase(it);
+    }
+}
+
+void CanvasView::itemChangesBatched(const CanvasChangeSet& changes)
+{
+    // Edited items need a fresh thumbnail
+    bool stale = false;
+    for (auto it = thumbnails_.begin(); it != thumbnails_.end();)
+    {
+        if (changes.structural || changes.propertyChanged.count(it->first))
+        {
+            it = thumbnails_.erase(it);
+            stale = true;
+        }
+        else
+            ++it;
+    }
+
+    if (stale)
+    {
+        updateChildBounds();
+        repaint();
+    }
+}
+
+//==============================================================================
+bool CanvasView::captureThumbnail(const CanvasItem& item)
+{
+    auto& comp = *item.component;
+
+    // Items created while zoomed out have never been laid out; give the
+    // component its canvas-space size so there is something to paint.
+    if (comp.getWidth() <= 0 || comp.getHeight() <= 0)
+        comp.setBounds(comp.getBounds().withSize(juce::roundToInt(item.width),
+                                                 juce::roundToInt(item.height)));
+    if (comp.getWidth() <= 0 || comp.getHeight() <= 0)
+        return false;
+
+    // Otherwise it still has its last live size; snapshot it scaled down
+    const float scale = juce::jmin(1.0f, kThumbnailMaxPx
+                                         / static_cast<float>(juce::jmax(comp.getWidth(), comp.getHeight())));
+    auto snapshot = comp.createComponentSnapshot(comp.getLocalBounds(), true, scale);
+    if (!snapshot.isValid())
+        return false;
+
+    thumbnails_[item.id] = std::move(snapshot);
+    return true;
+}
+
+void CanvasView::drawThumbnails(juce::Graphics& g)
+{
+    // Thumbnails sit beneath live child components; at this size the
+    // stacking difference is not visible.
+    for (int i = 0; i < model.getNumItems(); ++i)
+    {
+        auto* item = model.getItem(i);
+        if (!item->visible || !item->onScreen || !item->useThumbnail) continue;
+
+        auto it = thumbnails_.find(item->id);
+        if (it == thumbnails_.end() || !it->second.isValid()) continue;
+
+        const auto& thumb = it->second;
+        auto screenRect = model.canvasToScreen(item->getBounds());
+        auto transform = juce::AffineTransform::scale(screenRect.getWidth()  / static_cast<float>(thumb.getWidth()),
+                                                      screenRect.getHeight() / static_cast<float>(thumb.getHeight()))
+                             .translated(screenRect.getX(), screenRect.getY());
+        if (item->rotation != 0)
+            transform = transform.rotated(static_cast<float>(item->rotation)
+                                              * juce::MathConstants<float>::pi / 180.0f,
+                                          screenRect.getCentreX(), screenRect.getCentreY());
+
+        g.setOpacity(item->opacity);
+        g.drawImageTransformed(thumb, transform);
+    }
+    g.setOpacity(1.0f);
 }
 
 //==============================================================================
@@ -104,7 +219,7 @@ void CanvasView::paint(juce::Graphics& g)
     for (int i = 0; i < model.getNumItems(); ++i)
     {
         auto* item = model.getItem(i);
-        if (!item->visible) continue;
+        if (!item->visible || !item->onScreen) continue;
         if (item->itemBackground.getAlpha() > 0)
         {
             auto screenRect = model.canvasToScreen(item->getBounds());
@@ -113,6 +228,10 @@ void CanvasView::paint(juce::Graphics& g)
         }
     }
 
+    // 2c. Zoomed-out items drawn from cached thumbnails
+    if (!placeholderMode_)
+        drawThumbnails(g);
+
     // 3. Smart guides (while dragging)
     drawSmartGuides(g);
 
@@ -159,92 +278,15 @@ void CanvasView::paintOverChildren(juce::Graphics& g)
 //==============================================================================
 void CanvasView::drawShapeStrokeOverlay(juce::Graphics& g)
 {
+    // Inside and Center strokes are drawn by ShapeComponent::paint(); only
+    // Outside strokes extend beyond the component bounds and need the overlay.
     for (int i = 0; i < model.getNumItems(); ++i)
     {
         auto* item = model.getItem(i);
-        if (!item->visible || !item->component) continue;
-
-        // Only process shape types
-        bool isShape = (item->meterType == MeterType::ShapeRectangle
-                     || item->meterType == MeterType::ShapeEllipse
-                     || item->meterType == MeterType::ShapeTriangle
-                     || item->meterType == MeterType::ShapeLine
-                     || item->meterType == MeterType::ShapeStar
-                     || item->meterType == MeterType::ShapeSVG);
-        if (!isShape) continue;
-
-        auto align = static_cast<StrokeAlignment>(item->strokeAlignment);
-
-        // Inside and Center strokes are drawn by ShapeComponent::paint() – skip.
-        // Only Outside strokes need the overlay (they extend beyond the component bounds).
-        if (align == StrokeAlignment::Inside) continue;
-        if (align == StrokeAlignment::Center) continue;
-        if (item->strokeWidth <= 0.0f) continue;
-
-        auto* sc = dynamic_cast<ShapeComponent*>(item->component.get());
-        if (!sc) continue;
-
-        // ── Use cached path from ShapeComponent (local coords) ──
-        // Transform from local component bounds to screen coordinates
-        auto screenRect = model.canvasToScreen(item->getBounds());
-        auto localBounds = sc->getLocalBounds().toFloat();
-        if (localBounds.getWidth() <= 0.0f || localBounds.getHeight() <= 0.0f)
-            continue;
-
-        float scaleX = screenRect.getWidth()  / localBounds.getWidth();
-        float scaleY = screenRect.getHeight() / localBounds.getHeight();
-
-        juce::Path shapePath = sc->getCachedPath();
-        shapePath.applyTransform(
-            juce::AffineTransform::scale(scaleX, scaleY)
-                .translated(screenRect.getX(), screenRect.getY()));
-
-        // ── Apply rotation ──
-        if (item->rotation != 0)
-        {
-            auto centre = screenRect.getCentre();
-            float rad = static_cast<float>(item->rotation)
-                        * juce::MathConstants<float>::pi / 180.0f;
-            shapePath.applyTransform(
-                juce::AffineTransform::rotation(rad, centre.x, centre.y));
-        }
+        if (!item->visible || !item->component || !item->isRenderedLive()) continue;
 
-        // ── Apply item opacity ──
-        float alpha = item->opacity;
-
-        // ── Stroke parameters ──
-        float screenStrokeW = item->strokeWidth * model.zoom;
-
-        juce::PathStrokeType::EndCapStyle cap = juce::PathStrokeType::butt;
-        switch (static_cast<LineCap>(item->lineCap))
-        {
-            case LineCap::Butt:   cap = juce::PathStrokeType::butt;    break;
-            case LineCap::Round:  cap = juce::PathStrokeType::rounded; break;
-            case LineCap::Square: cap = juce::PathStrokeType::square;  break;
-        }
-
-        g.setColour(item->strokeColour.withMultipliedAlpha(alpha));
-
-        if (align == StrokeAlignment::Center)
-        {
-            // Normal centered stroke
-            g.strokePath(shapePath, juce::PathStrokeType(screenStrokeW,
-                                                          juce::PathStrokeType::mitered, cap));
-        }
-        else // Outside
-        {
-            // Clip to outside the shape using even-odd rule, draw 2x width
-            juce::Path outsideClip;
-            // Use the entire CanvasView area as the outer rectangle
-            outsideClip.addRectangle(getLocalBounds().toFloat());
-            outsideClip.addPath(shapePath);
-            outsideClip.setUsingNonZeroWinding(false);
-
-            juce::Graphics::ScopedSaveState ss(g);
-            g.reduceClipRegion(outsideClip);
-            g.strokePath(shapePath, juce::PathStrokeType(screenStrokeW * 2.0f,
-                                                          juce::PathStrokeType::mitered, cap));
-        }
+        RenderGraph::strokeShapeOverlay(g, *item, model.canvasToScreen(item->getBounds()),
+                                        model.zoom, getLocalBounds().toFloat(), false);
     }
 }
 
@@ -687,7 +729,7 @@ void CanvasView::mouseDrag(const juce::MouseEvent& e)
                     }
             }
 
-            model.notifyItemsChanged();
+            model.notifyItemsMoved(sel);
             break;
         }
 
@@ -767,7 +809,6 @@ void CanvasView::mouseDrag(const juce::MouseEvent& e)
             }
 
             item->setBounds(b);
-            model.notifyItemsChanged();
 
             // ── Proportional group resize for all other selected items ──
             if (!resizeGroupIds_.empty())
@@ -812,8 +853,10 @@ void CanvasView::mouseDrag(const juce::MouseEvent& e)
                         juce::jmax(1.0f, ob.getHeight() * sy)
                     });
                 }
+                model.notifyItemsMoved(resizeGroupIds_);
             }
 
+            model.notifyItemMoved(item->id);
             break;
         }
 
@@ -1028,26 +1071,30 @@ bool CanvasView::keyPressed(const juce::KeyPress& key)
     float nudge = key.getModifiers().isShiftDown() ? 10.0f : 1.0f;
     if (key.getKeyCode() == juce::KeyPress::leftKey)
     {
-        for (auto* s : model.getSelectedItems()) if (!s->locked) s->x -= nudge;
-        model.notifyItemsChanged();
+        auto sel = model.getSelectedItems();
+        for (auto* s : sel) if (!s->locked) s->x -= nudge;
+        model.notifyItemsMoved(sel);
         return true;
     }
     if (key.getKeyCode() == juce::KeyPress::rightKey)
     {
-        for (auto* s : model.getSelectedItems()) if (!s->locked) s->x += nudge;
-        model.notifyItemsChanged();
+        auto sel = model.getSelectedItems();
+        for (auto* s : sel) if (!s->locked) s->x += nudge;
+        model.notifyItemsMoved(sel);
         return true;
     }
     if (key.getKeyCode() == juce::KeyPress::upKey)
     {
-        for (auto* s : model.getSelectedItems()) if (!s->locked) s->y -= nudge;
-        model.notifyItemsChanged();
+        auto sel = model.getSelectedItems();
+        for (auto* s : sel) if (!s->locked) s->y -= nudge;
+        model.notifyItemsMoved(sel);
         return true;
     }
     if (key.getKeyCode() == juce::KeyPress::downKey)
     {
-        for (auto* s : model.getSelectedItems()) if (!s->locked) s->y += nudge;
-        model.notifyItemsChanged();
+        auto sel = model.getSelectedItems();
+        for (auto* s : sel) if (!s->locked) s->y += nudge;
+        model.notifyItemsMoved(sel);
         return true;
     }
 
@@ -1156,7 +1203,7 @@ void CanvasView::drawPlaceholderItems(juce::Graphics& g)
     for (int i = 0; i < model.getNumItems(); ++i)
     {
         auto* item = model.getItem(i);
-        if (!item->visible) continue;
+        if (!item->visible || !item->onScreen) continue;
 
         auto screenRect = model.canvasToScreen(item->getBounds());
 
@@ -1197,15 +1244,7 @@ void CanvasView::restoreFromPlaceholderMode()
     placeholderMode_ = false;
     lowFpsFrames_ = 0;
 
-    // Re-show all components
-    for (int i = 0; i < model.getNumItems(); ++i)
-    {
-        auto* item = model.getItem(i);
-        if (item->component && item->visible)
-            item->component->setVisible(true);
-    }
-
-
+    // Re-show live components (culled / thumbnail items stay hidden)
     updateChildBounds();
     repaint();
 }
@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "CanvasModel.h"
+#include <map>
 
 //==============================================================================
 /// Interactive canvas surface — renders items, handles zoom/pan, selection
@@ -30,13 +31,19 @@ public:
 
     // CanvasModelListener
     void itemsChanged() override       { updateChildBounds(); repaint(); }
+    void itemChangesBatched(const CanvasChangeSet& changes) override;
     void selectionChanged() override   { repaint(); }
     void zoomPanChanged() override     { updateChildBounds(); repaint(); }
     void backgroundChanged() override  { repaint(); }
 
     /// Re-position all child components based on the current zoom/pan and item geometry.
+    /// Items outside the visible area, or smaller on screen than
+    /// kThumbnailThresholdPx, have their components hidden (see CanvasItem::onScreen).
     void updateChildBounds();
 
+    /// Visible area of the canvas in canvas coordinates.
+    juce::Rectangle<float> getVisibleCanvasArea() const;
+
     /// Listener for double-click on item (opens property panel).
     struct Listener
     {
@@ -131,4 +138,14 @@ private:
     void drawFpsOverlay(juce::Graphics& g);
     void drawPlaceholderItems(juce::Graphics& g);
     void enterPlaceholderMode();
+
+    //-- Viewport culling / LOD ------------------------------------------------
+    static constexpr float kCullMarginPx         = 64.0f;  ///< Off-screen slack before hiding
+    static constexpr float kThumbnailThresholdPx = 24.0f;  ///< Largest on-screen side for LOD
+    static constexpr float kThumbnailMaxPx       = 96.0f;  ///< Cached thumbnail resolution cap
+
+    std::map<juce::Uuid, juce::Image> thumbnails_;
+
+    bool captureThumbnail(const CanvasItem& item);
+    void drawThumbnails(juce::Graphics& g);
 };
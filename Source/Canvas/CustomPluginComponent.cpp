@@ -1,6 +1,7 @@
 #include "CustomPluginComponent.h"
 #include "PythonPluginBridge.h"
 #include "PluginRenderReplayer.h"
+#include "PluginRenderBatcher.h"
 #include "ShaderLibrary.h"
 #include "../UI/DebugLogWindow.h"
 #include <algorithm>
@@ -72,7 +73,7 @@ private:
                 try
                 {
                     auto& bridge = PythonPluginBridge::getInstance();
-                    if (bridge.isRunning())
+                    if (bridge.isAvailable())
                         bridge.destroyInstance(t.instanceId);
                 }
                 catch (...) {}
@@ -308,6 +309,9 @@ CustomPluginComponent::~CustomPluginComponent()
         }
     }
 
+    if (instanceId_.isNotEmpty())
+        PluginRenderBatcher::getInstance().forget(instanceId_);
+
     // 3. Hand the BridgeWorker and instance ID to the async cleanup queue.
     //    The queue thread calls stopThread() and destroyInstance() off the
     //    message thread, so we return immediately without any freeze.
@@ -333,16 +337,13 @@ void CustomPluginComponent::setPluginId(const juce::String& manifestId,
     SharedGLRenderer::getInstance().registerComponent(this);
 }
 
-void CustomPluginComponent::feedAudioData(const juce::String& audioJson, bool shmActive,
-                                          const float* pSpectrum, int spectrumLen,
+void CustomPluginComponent::feedAudioData(const float* pSpectrum, int spectrumLen,
                                           const float* pWaveform, int waveformLen)
 {
     {
         const juce::SpinLock::ScopedLockType sl(audioLock);
-        lastAudioJson_ = audioJson;
 
-        // Update GPU texture data from raw pointers if provided.
-        // This is preferred over JSON parsing for performance.
+        // GPU texture data
         if (pSpectrum != nullptr && spectrumLen > 0)
         {
             spectrumData.assign(pSpectrum, pSpectrum + spectrumLen);
@@ -354,49 +355,22 @@ void CustomPluginComponent::feedAudioData(const juce::String& audioJson, bool sh
         }
     }
 
-    // Parse spectrum/waveform from JSON only if raw pointers weren't provided AND we aren't using SHM.
-    // (If SHM is active, JSON likely doesn't contain the arrays anyway).
-    if (!shmActive && (pSpectrum == nullptr || pWaveform == nullptr))
-    {
-        auto parsed = juce::JSON::parse(audioJson);
-        if (auto* obj = parsed.getDynamicObject())
-        {
-            const juce::SpinLock::ScopedLockType sl(audioLock);
-
-            if (pSpectrum == nullptr)
-            {
-                if (auto* specArr = obj->getProperty("spectrum").getArray())
-                {
-                    spectrumData.resize(specArr->size());
-                    for (int i = 0; i < (int)specArr->size(); ++i)
-                        spectrumData[i] = (float)(*specArr)[i];
-                }
-            }
-            if (pWaveform == nullptr)
-            {
-                if (auto* waveArr = obj->getProperty("waveform").getArray())
-                {
-                    waveformData.resize(waveArr->size());
-                    for (int i = 0; i < (int)waveArr->size(); ++i)
-                        waveformData[i] = (float)(*waveArr)[i];
-                }
-            }
-        }
-    }
-
-    // Post render request to background worker (non-blocking).
-    // The worker thread calls bridge.renderInstance() off the message thread
+    // Post render request to the frame batcher (non-blocking).  Its worker
+    // renders every live instance in one bridge call off the message thread,
     // so mouse clicks / UI events are never blocked by Python pipe I/O.
     if (instanceId_.isNotEmpty() && bridgeWorker_)
     {
+        auto& batcher = PluginRenderBatcher::getInstance();
+
         // Pick up any completed result from the previous frame
-        std::vector<PluginRender::RenderCommand> result;
-        if (bridgeWorker_->fetchResult(result))
+        PluginRenderResult result;
+        if (batcher.fetchResult(instanceId_, result))
         {
-            if (!result.empty())
+            if (result.rendered)
             {
+                // An empty list is a plugin that drew nothing this frame
                 const juce::SpinLock::ScopedLockType sl(commandLock);
-                cachedCommands = std::move(result);
+                cachedCommands = std::move(result.commands);
                 commandsPending = true;
                 consecutiveErrors_ = 0;
             }
@@ -404,16 +378,16 @@ void CustomPluginComponent::feedAudioData(const juce::String& audioJson, bool sh
             {
                 consecutiveErrors_++;
 
-                // AUTO-RECOVERY: if we keep getting empty responses, the Python
-                // instance may have been lost (bridge restart, timeout during
-                // initial create, etc.).  Post a recreate request to the
-                // BridgeWorker so it happens off the message thread (avoids
-                // blocking the UI on pipeLock).
+                // AUTO-RECOVERY: if the runtime keeps not knowing the instance,
+                // it was lost (bridge restart, timeout during initial create,
+                // etc.).  Post a recreate request to the BridgeWorker so it
+                // happens off the message thread (avoids blocking the UI on
+                // pipeLock).
                 if (consecutiveErrors_ == 10 && manifestId_.isNotEmpty())
                 {
                     DBG("CustomPluginComponent: " + instanceId_
-                        + " — 10 consecutive empty frames, requesting re-create");
-                    MAXIMETER_LOG("INSTANCE", instanceId_ + " — 10 consecutive empty frames, requesting re-create for " + manifestId_);
+                        + " — 10 consecutive failed renders, requesting re-create");
+                    MAXIMETER_LOG("INSTANCE", instanceId_ + " — 10 consecutive failed renders, requesting re-create for " + manifestId_);
                     bridgeWorker_->postRecreateRequest(manifestId_, instanceId_);
                 }
                 // Retry periodically (every 60 frames ~ 1 second)
@@ -424,13 +398,17 @@ void CustomPluginComponent::feedAudioData(const juce::String& audioJson, bool sh
             }
         }
 
-        // Post new request (worker will skip if still busy)
-        bridgeWorker_->postRenderRequest(
-            instanceId_, getWidth(), getHeight(), audioJson);
-        workerBusy_.store(bridgeWorker_->busy.load());
+        // Queue for the next batch (skipped while a batch is in flight)
+        batcher.post({ instanceId_, getWidth(), getHeight(),
+                       getMeterBgColour(), getMeterFgColour() });
     }
 }
 
+bool CustomPluginComponent::isRenderThrottled() const
+{
+    return PluginRenderBatcher::getInstance().isBusy();
+}
+
 //==============================================================================
 // BridgeWorker — background thread for Python IPC
 //==============================================================================
@@ -448,24 +426,6 @@ CustomPluginComponent::BridgeWorker::~BridgeWorker()
     stopThread(2000);
 }
 
-void CustomPluginComponent::BridgeWorker::postRenderRequest(
-    const juce::String& instanceId, int w, int h, const juce::String& audioJson)
-{
-    // If the worker is still processing the last request, skip this frame
-    if (busy.load())
-        return;
-
-    {
-        const juce::ScopedLock sl(requestLock_);
-        reqInstanceId_ = instanceId;
-        reqWidth_      = w;
-        reqHeight_     = h;
-        reqAudioJson_  = audioJson;
-        hasRequest_    = true;
-    }
-    wakeUp_.signal();
-}
-
 void CustomPluginComponent::BridgeWorker::postRecreateRequest(
     const juce::String& manifestId, const juce::String& instanceId)
 {
@@ -478,16 +438,6 @@ void CustomPluginComponent::BridgeWorker::postRecreateRequest(
     wakeUp_.signal();
 }
 
-bool CustomPluginComponent::BridgeWorker::fetchResult(
-    std::vector<PluginRender::RenderCommand>& out)
-{
-    const juce::SpinLock::ScopedLockType sl(resultLock_);
-    if (!hasResult_) return false;
-    out = std::move(result_);
-    hasResult_ = false;
-    return true;
-}
-
 void CustomPluginComponent::BridgeWorker::run()
 {
     while (!threadShouldExit())
@@ -495,76 +445,30 @@ void CustomPluginComponent::BridgeWorker::run()
         wakeUp_.wait(-1);  // sleep until signalled
         if (threadShouldExit()) break;
 
-        // Handle recreate requests first (off the message thread)
-        {
-            juce::String manifestId, instanceId;
-            bool doRecreate = false;
-            {
-                const juce::ScopedLock sl(requestLock_);
-                if (hasRecreateRequest_)
-                {
-                    manifestId = recreateManifestId_;
-                    instanceId = recreateInstanceId_;
-                    hasRecreateRequest_ = false;
-                    doRecreate = true;
-                }
-            }
-            if (doRecreate)
-            {
-                try
-                {
-                    auto& bridge = PythonPluginBridge::getInstance();
-                    if (bridge.isRunning())
-                        bridge.createInstance(manifestId, instanceId);
-                }
-                catch (const std::exception& e)
-                {
-                    juce::Logger::writeToLog("CustomPlugin Create Error: " + juce::String(e.what()));
-                }
-                catch (...)
-                {
-                    juce::Logger::writeToLog("CustomPlugin Create Error: Unknown Exception");
-                }
-            }
-        }
-
-        // Grab the pending render request
-        juce::String instanceId, audioJson;
-        int w = 0, h = 0;
+        // Handle recreate requests (off the message thread)
+        juce::String manifestId, instanceId;
         {
             const juce::ScopedLock sl(requestLock_);
-            if (!hasRequest_) continue;
-            instanceId = reqInstanceId_;
-            audioJson  = reqAudioJson_;
-            w          = reqWidth_;
-            h          = reqHeight_;
-            hasRequest_ = false;
+            if (!hasRecreateRequest_) continue;
+            manifestId = recreateManifestId_;
+            instanceId = recreateInstanceId_;
+            hasRecreateRequest_ = false;
         }
 
-        busy.store(true);
-
-        // Call bridge on this background thread — this is the blocking call
-        // that previously froze the message thread.
-        std::vector<PluginRender::RenderCommand> commands;
         try
         {
             auto& bridge = PythonPluginBridge::getInstance();
-            if (bridge.isRunning())
-                commands = bridge.renderInstance(instanceId, w, h, audioJson);
+            if (bridge.isAvailable())
+                bridge.createInstance(manifestId, instanceId);
         }
-        catch (...)
+        catch (const std::exception& e)
         {
-            DBG("BridgeWorker: renderInstance threw an exception");
+            juce::Logger::writeToLog("CustomPlugin Create Error: " + juce::String(e.what()));
         }
-
-        // Store result for pickup by feedAudioData on the message thread
+        catch (...)
         {
-            const juce::SpinLock::ScopedLockType sl(resultLock_);
-            result_    = std::move(commands);
-            hasResult_ = true;
+            juce::Logger::writeToLog("CustomPlugin Create Error: Unknown Exception");
         }
-
-        busy.store(false);
     }
 }
 
@@ -783,7 +687,7 @@ void CustomPluginComponent::renderFrame_GL(juce::OpenGLContext& ctx)
     if (!postShaderCmds_.empty())
     {
         juce::Graphics g(frame);
-        PluginRenderReplayer::replay(g, postShaderCmds_);
+        PluginRenderReplayer::replay(g, postShaderCmds_, &postShaderPolylines_, &postShaderSprites_);
     }
 
     // Store for paint() on the message thread
@@ -942,7 +846,7 @@ void CustomPluginComponent::resized()
     if (instanceId_.isNotEmpty() && !isOffline_)
     {
         auto& bridge = PythonPluginBridge::getInstance();
-        if (bridge.isRunning())
+        if (bridge.isAvailable())
             bridge.notifyResize(instanceId_, w, h);
     }
 }
@@ -1005,7 +909,7 @@ void CustomPluginComponent::renderBackBuffer(
 
     backBuffer.clear(backBuffer.getBounds());
     juce::Graphics g(backBuffer);
-    PluginRenderReplayer::replay(g, stdCommands);
+    PluginRenderReplayer::replay(g, stdCommands, &backBufferPolylines_, &backBufferSprites_);
 }
 
 void CustomPluginComponent::executeShaderPass(juce::OpenGLContext& ctx, const ShaderPass& pass, int width, int height)
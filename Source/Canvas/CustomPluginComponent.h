@@ -119,19 +119,19 @@ public:
     }
 
     //-- Audio data feed (called 60fps from MeterFactory) --------------------
-    /// Non-blocking: posts work to a background thread.
-    /// @param audioJson   Serialized AudioData JSON (lightweight if SHM active).
-    /// @param shmActive   Whether shared memory is being used for main data transfer.
+    /// Non-blocking: picks up the previous frame's commands and posts this
+    /// instance to PluginRenderBatcher for the next batched render.
+    /// The plugin's own audio snapshot travels with the frame's batch (see
+    /// PluginAudioFrame); only the GPU texture data is passed here.
     /// @param pSpectrum   Optional raw pointer to linear magnitude spectrum (for GPU texture).
     /// @param spectrumLen Number of bins in pSpectrum.
     /// @param pWaveform   Optional raw pointer to mono waveform (for GPU texture).
     /// @param waveformLen Number of samples in pWaveform.
-    void feedAudioData(const juce::String& audioJson, bool shmActive,
-                       const float* pSpectrum = nullptr, int spectrumLen = 0,
+    void feedAudioData(const float* pSpectrum = nullptr, int spectrumLen = 0,
                        const float* pWaveform = nullptr, int waveformLen = 0);
 
     //-- Throttle query (called from MeterFactory before building JSON) ------
-    bool isRenderThrottled() const { return workerBusy_.load(); }
+    bool isRenderThrottled() const;
 
     //-- Component overrides -------------------------------------------------
     void paint(juce::Graphics& g) override;
@@ -180,7 +180,6 @@ private:
 
     // Thread-safe audio data exchange (message thread -> GL thread)
     juce::SpinLock audioLock;
-    juce::String lastAudioJson_;
 
     // Async bridge I/O: previous frame's commands used during GL render
     juce::SpinLock commandLock;
@@ -205,6 +204,13 @@ private:
     juce::Image renderedFrame_;
     juce::SpinLock frameLock_;
 
+    // Polyline rasterisers and sprite splatters for command replay
+    // (message thread / GL thread)
+    PolylineRasteriser backBufferPolylines_;
+    PolylineRasteriser postShaderPolylines_;
+    SpriteSplatter     backBufferSprites_;
+    SpriteSplatter     postShaderSprites_;
+
     // Back-buffer for 2D command replay (software rendering)
     juce::Image backBuffer;
     std::unique_ptr<juce::OpenGLTexture> backBufferTexture;
@@ -255,50 +261,34 @@ private:
     int  consecutiveErrors_ = 0;
 
     //-- Background worker for non-blocking Python IPC -----------------------
+    /// Rendering goes through the shared PluginRenderBatcher; this worker
+    /// only re-creates lost instances off the message thread.
     class BridgeWorker : public juce::Thread
     {
     public:
         BridgeWorker(CustomPluginComponent& owner);
         ~BridgeWorker() override;
 
-        void postRenderRequest(const juce::String& instanceId,
-                               int w, int h,
-                               const juce::String& audioJson);
-
         /// Post a non-blocking request to re-create the Python instance
         /// on the worker thread (avoids blocking the message thread).
         void postRecreateRequest(const juce::String& manifestId,
                                  const juce::String& instanceId);
 
-        bool fetchResult(std::vector<PluginRender::RenderCommand>& out);
-
-        std::atomic<bool> busy { false };
-
     private:
         void run() override;
 
         CustomPluginComponent& owner_;
         juce::CriticalSection  requestLock_;
-        juce::String           reqInstanceId_;
-        juce::String           reqAudioJson_;
-        int                    reqWidth_  = 0;
-        int                    reqHeight_ = 0;
-        bool                   hasRequest_ = false;
 
         // Recreate request (posted from message thread, executed on worker)
         juce::String           recreateManifestId_;
         juce::String           recreateInstanceId_;
         bool                   hasRecreateRequest_ = false;
 
-        juce::SpinLock         resultLock_;
-        std::vector<PluginRender::RenderCommand> result_;
-        bool                   hasResult_ = false;
-
         juce::WaitableEvent    wakeUp_ { true };
     };
 
     std::unique_ptr<BridgeWorker> bridgeWorker_;
-    std::atomic<bool>             workerBusy_ { false };
 
     //-- Internal helpers ----------------------------------------------------
     void processRenderCommands(const std::vector<PluginRender::RenderCommand>& commands);
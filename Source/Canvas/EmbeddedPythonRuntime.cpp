@@ -0,0 +1,477 @@
+#if MAXIMETER_EMBED_PYTHON
+ #define PY_SSIZE_T_CLEAN
+ #include <Python.h>   // must precede standard headers
+#endif
+
+#include "EmbeddedPythonRuntime.h"
+#include "../UI/DebugLogWindow.h"
+
+//==============================================================================
+EmbeddedPythonRuntime& EmbeddedPythonRuntime::getInstance()
+{
+    static EmbeddedPythonRuntime instance;
+    return instance;
+}
+
+bool EmbeddedPythonRuntime::isCompiledIn()
+{
+   #if MAXIMETER_EMBED_PYTHON
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+EmbeddedPythonRuntime::~EmbeddedPythonRuntime()
+{
+    worker.reset();   // finishes queued updates
+}
+
+void EmbeddedPythonRuntime::runOnWorker(std::function<void()> job)
+{
+    juce::WaitableEvent done;
+    worker->addJob([&job, &done]
+    {
+        job();
+        done.signal();
+    });
+    done.wait(-1);
+}
+
+std::vector<CustomPluginManifest> EmbeddedPythonRuntime::getManifests() const
+{
+    const juce::ScopedLock sl(lock);
+    return manifests;
+}
+
+bool EmbeddedPythonRuntime::hasManifest(const juce::String& manifestId) const
+{
+    const juce::ScopedLock sl(lock);
+    for (auto& m : manifests)
+        if (m.id == manifestId)
+            return true;
+    return false;
+}
+
+bool EmbeddedPythonRuntime::ownsInstance(const juce::String& instanceId) const
+{
+    const juce::ScopedLock sl(lock);
+    return instances.count(instanceId) > 0;
+}
+
+#if MAXIMETER_EMBED_PYTHON
+//==============================================================================
+namespace
+{
+    /// Holds the GIL for the current scope; safe from any thread.
+    struct ScopedGIL
+    {
+        ScopedGIL()  : state(PyGILState_Ensure()) {}
+        ~ScopedGIL() { PyGILState_Release(state); }
+        PyGILState_STATE state;
+    };
+
+    PyObject* toPy(const juce::var& v)
+    {
+        if (v.isBool())   return PyBool_FromLong((bool) v ? 1 : 0);
+        if (v.isInt() || v.isInt64()) return PyLong_FromLongLong((juce::int64) v);
+        if (v.isDouble()) return PyFloat_FromDouble((double) v);
+        if (v.isString()) return PyUnicode_FromString(v.toString().toRawUTF8());
+
+        if (auto* arr = v.getArray())
+        {
+            auto* list = PyList_New((Py_ssize_t) arr->size());
+            for (int i = 0; i < arr->size(); ++i)
+                PyList_SET_ITEM(list, i, toPy(arr->getReference(i)));   // steals
+            return list;
+        }
+
+        if (auto* obj = v.getDynamicObject())
+        {
+            auto* dict = PyDict_New();
+            for (auto& p : obj->getProperties())
+            {
+                auto* value = toPy(p.value);
+                PyDict_SetItemString(dict, p.name.toString().toRawUTF8(), value);
+                Py_DECREF(value);
+            }
+            return dict;
+        }
+
+        Py_RETURN_NONE;
+    }
+
+    juce::String strFromPy(PyObject* o)
+    {
+        if (const char* utf8 = PyUnicode_AsUTF8(o))
+            return juce::String::fromUTF8(utf8);
+        PyErr_Clear();
+        return {};
+    }
+
+    juce::var fromPy(PyObject* o)
+    {
+        if (o == nullptr || o == Py_None) return {};
+        if (PyBool_Check(o))    return o == Py_True;   // before PyLong: bool is an int
+        if (PyLong_Check(o))    return (juce::int64) PyLong_AsLongLong(o);
+        if (PyFloat_Check(o))   return PyFloat_AS_DOUBLE(o);
+        if (PyUnicode_Check(o)) return strFromPy(o);
+
+        if (PyList_Check(o) || PyTuple_Check(o))
+        {
+            auto* seq = PySequence_Fast(o, "");
+            const auto n = PySequence_Fast_GET_SIZE(seq);
+            auto** items = PySequence_Fast_ITEMS(seq);
+
+            juce::Array<juce::var> arr;
+            arr.ensureStorageAllocated((int) n);
+            for (Py_ssize_t i = 0; i < n; ++i)
+                arr.add(fromPy(items[i]));
+            Py_DECREF(seq);
+            return arr;
+        }
+
+        if (PyDict_Check(o))
+        {
+            juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+            PyObject* key = nullptr;
+            PyObject* value = nullptr;
+            Py_ssize_t pos = 0;
+            while (PyDict_Next(o, &pos, &key, &value))
+                if (PyUnicode_Check(key))
+                    obj->setProperty(juce::Identifier(strFromPy(key)), fromPy(value));
+            return juce::var(obj.get());
+        }
+
+        // Anything else (numpy scalars, enums...) — fall back to str()
+        juce::var result;
+        if (auto* s = PyObject_Str(o))
+        {
+            result = strFromPy(s);
+            Py_DECREF(s);
+        }
+        else
+        {
+            PyErr_Clear();
+        }
+        return result;
+    }
+
+    void logPyError(const juce::String& context)
+    {
+        if (!PyErr_Occurred()) return;
+
+        PyObject *type = nullptr, *value = nullptr, *trace = nullptr;
+        PyErr_Fetch(&type, &value, &trace);
+        juce::String text = context;
+        if (value != nullptr)
+            if (auto* s = PyObject_Str(value))
+            {
+                text << ": " << strFromPy(s);
+                Py_DECREF(s);
+            }
+        Py_XDECREF(type);
+        Py_XDECREF(value);
+        Py_XDECREF(trace);
+        PyErr_Clear();
+
+        MAXIMETER_LOG("EMBED-ERR", text);
+    }
+}
+
+//==============================================================================
+bool EmbeddedPythonRuntime::start(const juce::File& pluginsDir)
+{
+    if (worker == nullptr)
+        worker = std::make_unique<juce::ThreadPool>(1);
+
+    // CustomComponents/plugins -> the directory that contains the package
+    auto packageRoot = pluginsDir.getParentDirectory().getParentDirectory();
+
+    bool ok = false;
+    std::vector<CustomPluginManifest> found;
+
+    runOnWorker([&]
+    {
+        if (!Py_IsInitialized())
+        {
+            Py_InitializeEx(0);        // no signal handlers — the host owns them
+            PyEval_SaveThread();       // release the GIL acquired by initialisation
+            MAXIMETER_LOG("EMBED", juce::String("Embedded Python ") + Py_GetVersion());
+        }
+
+        ScopedGIL gil;
+
+        if (host.load() == nullptr)
+        {
+            if (auto* sysPath = PySys_GetObject("path"))   // borrowed
+            {
+                auto* dir = PyUnicode_FromString(packageRoot.getFullPathName().toRawUTF8());
+                if (PySequence_Contains(sysPath, dir) == 0)
+                    PyList_Insert(sysPath, 0, dir);
+                Py_DECREF(dir);
+            }
+
+            auto* module = PyImport_ImportModule("CustomComponents.embedded_host");
+            if (module == nullptr)
+            {
+                logPyError("import CustomComponents.embedded_host failed");
+                return;
+            }
+
+            auto* hostObj = PyObject_CallMethod(module, "EmbeddedHost", "s",
+                                                pluginsDir.getFullPathName().toRawUTF8());
+            Py_DECREF(module);
+            if (hostObj == nullptr)
+            {
+                logPyError("EmbeddedHost() failed");
+                return;
+            }
+            host.store(hostObj);
+        }
+
+        auto* list = PyObject_CallMethod(static_cast<PyObject*>(host.load()), "scan", nullptr);
+        if (list == nullptr)
+        {
+            logPyError("EmbeddedHost.scan() failed");
+            return;
+        }
+
+        if (auto* arr = fromPy(list).getArray())
+            for (auto& m : *arr)
+                found.push_back(PythonPluginBridge::parseManifest(m));
+        Py_DECREF(list);
+        ok = true;
+    });
+
+    if (!ok)
+        return false;
+
+    MAXIMETER_LOG("EMBED", "Embedded scan: " + juce::String((int) found.size()) + " plugins");
+
+    const juce::ScopedLock sl(lock);
+    manifests = std::move(found);
+    return true;
+}
+
+juce::var EmbeddedPythonRuntime::dispatch(const juce::var& msg)
+{
+    if (host.load() == nullptr) return {};
+
+    juce::var result;
+    runOnWorker([&] { result = callHost(msg); });
+    return result;
+}
+
+void EmbeddedPythonRuntime::post(const juce::var& msg)
+{
+    if (host.load() == nullptr) return;
+    worker->addJob([this, msg] { callHost(msg); });
+}
+
+juce::var EmbeddedPythonRuntime::callHost(const juce::var& msg)
+{
+    ScopedGIL gil;
+    auto* pyMsg = toPy(msg);
+    auto* result = PyObject_CallMethod(static_cast<PyObject*>(host.load()), "dispatch", "O", pyMsg);
+    Py_DECREF(pyMsg);
+
+    if (result == nullptr)
+    {
+        logPyError("EmbeddedHost.dispatch() failed");
+        return {};
+    }
+
+    auto v = fromPy(result);
+    Py_DECREF(result);
+    return v;
+}
+
+//==============================================================================
+std::optional<std::vector<CustomPluginProperty>> EmbeddedPythonRuntime::createInstance(
+    const juce::String& manifestId,
+    const juce::String& instanceId)
+{
+    juce::DynamicObject::Ptr msg = new juce::DynamicObject();
+    msg->setProperty("type", "create");
+    msg->setProperty("manifest_id", manifestId);
+    msg->setProperty("instance_id", instanceId);
+
+    auto result = dispatch(juce::var(msg.get()));
+    auto* resultObj = result.getDynamicObject();
+    if (resultObj == nullptr || resultObj->getProperty("type").toString() != "created")
+    {
+        MAXIMETER_LOG("EMBED-ERR", "createInstance failed for " + manifestId + ": "
+                                   + (resultObj ? resultObj->getProperty("message").toString()
+                                                : juce::String("no response")));
+        return std::nullopt;
+    }
+
+    {
+        const juce::ScopedLock sl(lock);
+        instances.insert(instanceId);
+    }
+
+    return PythonPluginBridge::parseProperties(resultObj->getProperty("properties"));
+}
+
+bool EmbeddedPythonRuntime::cloneInstance(const juce::String& sourceInstanceId,
+                                          const juce::String& newInstanceId,
+                                          const std::vector<std::pair<juce::String, juce::var>>& values)
+{
+    juce::DynamicObject::Ptr valuesObj = new juce::DynamicObject();
+    for (const auto& [key, value] : values)
+        valuesObj->setProperty(key, value);
+
+    juce::DynamicObject::Ptr msg = new juce::DynamicObject();
+    msg->setProperty("type", "clone_instance");
+    msg->setProperty("source_id", sourceInstanceId);
+    msg->setProperty("instance_id", newInstanceId);
+    msg->setProperty("values", juce::var(valuesObj.get()));
+
+    auto result = dispatch(juce::var(msg.get()));
+    auto* resultObj = result.getDynamicObject();
+    if (resultObj == nullptr || resultObj->getProperty("type").toString() != "created")
+    {
+        MAXIMETER_LOG("EMBED-ERR", "cloneInstance failed for " + sourceInstanceId + ": "
+                                   + (resultObj ? resultObj->getProperty("message").toString()
+                                                : juce::String("no response")));
+        return false;
+    }
+
+    const juce::ScopedLock sl(lock);
+    instances.insert(newInstanceId);
+    return true;
+}
+
+void EmbeddedPythonRuntime::destroyInstance(const juce::String& instanceId)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        instances.erase(instanceId);
+    }
+
+    juce::DynamicObject::Ptr msg = new juce::DynamicObject();
+    msg->setProperty("type", "destroy");
+    msg->setProperty("instance_id", instanceId);
+    post(juce::var(msg.get()));
+}
+
+std::vector<PluginRenderResult> EmbeddedPythonRuntime::renderBatch(
+    const std::vector<PluginRenderRequest>& requests,
+    const juce::var& audio,
+    bool forceJsonAudio)
+{
+    std::vector<PluginRenderResult> results(requests.size());
+    if (host.load() == nullptr || requests.empty()) return results;
+
+    runOnWorker([&]
+    {
+        ScopedGIL gil;
+        auto* hostObj = static_cast<PyObject*>(host.load());
+
+        PyObject* pyAudio = nullptr;
+        if (auto* wants = PyObject_CallMethod(hostObj, "wants_audio", "i", forceJsonAudio ? 1 : 0))
+        {
+            if (PyObject_IsTrue(wants) == 1)
+                pyAudio = toPy(audio);
+            Py_DECREF(wants);
+        }
+        else
+        {
+            logPyError("wants_audio failed");
+        }
+
+        if (pyAudio == nullptr)
+        {
+            Py_INCREF(Py_None);
+            pyAudio = Py_None;
+        }
+
+        for (size_t i = 0; i < requests.size(); ++i)
+        {
+            const auto& r = requests[i];
+            auto* list = PyObject_CallMethod(hostObj, "render", "siiOi",
+                                             r.instanceId.toRawUTF8(), r.width, r.height,
+                                             pyAudio, forceJsonAudio ? 1 : 0);
+            if (list == nullptr)
+            {
+                logPyError("render failed for " + r.instanceId);
+                continue;
+            }
+
+            // None: the host does not know the instance
+            auto& out = results[i];
+            out.rendered = list != Py_None;
+            if (PyList_Check(list))
+            {
+                const auto n = PyList_GET_SIZE(list);
+                out.commands.reserve((size_t) n);
+                for (Py_ssize_t k = 0; k < n; ++k)
+                    out.commands.push_back(PythonPluginBridge::parseRenderCommand(fromPy(PyList_GET_ITEM(list, k))));
+            }
+            Py_DECREF(list);
+        }
+
+        Py_DECREF(pyAudio);
+    });
+
+    return results;
+}
+
+void EmbeddedPythonRuntime::setProperty(const juce::String& instanceId,
+                                        const juce::String& key,
+                                        const juce::var& value)
+{
+    juce::DynamicObject::Ptr msg = new juce::DynamicObject();
+    msg->setProperty("type", "set_property");
+    msg->setProperty("instance_id", instanceId);
+    msg->setProperty("key", key);
+    msg->setProperty("value", value);
+    post(juce::var(msg.get()));
+}
+
+void EmbeddedPythonRuntime::setProperties(const juce::String& instanceId,
+                                          const std::vector<std::pair<juce::String, juce::var>>& values)
+{
+    juce::DynamicObject::Ptr valuesObj = new juce::DynamicObject();
+    for (const auto& [key, value] : values)
+        valuesObj->setProperty(key, value);
+
+    juce::DynamicObject::Ptr msg = new juce::DynamicObject();
+    msg->setProperty("type", "set_properties");
+    msg->setProperty("instance_id", instanceId);
+    msg->setProperty("values", juce::var(valuesObj.get()));
+    post(juce::var(msg.get()));
+}
+
+void EmbeddedPythonRuntime::notifyResize(const juce::String& instanceId, int width, int height)
+{
+    juce::DynamicObject::Ptr msg = new juce::DynamicObject();
+    msg->setProperty("type", "resize");
+    msg->setProperty("instance_id", instanceId);
+    msg->setProperty("width", width);
+    msg->setProperty("height", height);
+    post(juce::var(msg.get()));
+}
+
+#else
+//==============================================================================
+// Built without MAXIMETER_EMBED_PYTHON — every plugin uses the subprocess.
+
+bool EmbeddedPythonRuntime::start(const juce::File&)                       { return false; }
+juce::var EmbeddedPythonRuntime::dispatch(const juce::var&)                { return {}; }
+void EmbeddedPythonRuntime::post(const juce::var&)                         {}
+std::optional<std::vector<CustomPluginProperty>> EmbeddedPythonRuntime::createInstance(const juce::String&,
+                                                                                       const juce::String&) { return std::nullopt; }
+bool EmbeddedPythonRuntime::cloneInstance(const juce::String&, const juce::String&,
+                                          const std::vector<std::pair<juce::String, juce::var>>&) { return false; }
+void EmbeddedPythonRuntime::destroyInstance(const juce::String&)           {}
+std::vector<PluginRenderResult> EmbeddedPythonRuntime::renderBatch(
+    const std::vector<PluginRenderRequest>& requests, const juce::var&, bool) { return std::vector<PluginRenderResult>(requests.size()); }
+void EmbeddedPythonRuntime::setProperty(const juce::String&, const juce::String&,
+                                        const juce::var&)                  {}
+void EmbeddedPythonRuntime::setProperties(const juce::String&,
+                                          const std::vector<std::pair<juce::String, juce::var>>&) {}
+void EmbeddedPythonRuntime::notifyResize(const juce::String&, int, int)    {}
+#endif
@@ -0,0 +1,107 @@
+#pragma once
+
+/**
+ * @file EmbeddedPythonRuntime.h
+ * @brief Optional in-process CPython interpreter for trusted plugins.
+ *
+ * Built only when CMake is configured with MAXIMETER_EMBED_PYTHON=ON; in
+ * other builds every call is a no-op and isRunning() is false.
+ *
+ * Plugins opt in per manifest (``embedded=True``).  Everything else keeps
+ * running in the isolated bridge_runner.py subprocess, which stays the
+ * default.  Embedded plugins skip the pipe round-trip entirely: audio is
+ * read from the host's own shared-memory mapping as zero-copy memoryviews
+ * and render commands are converted straight from Python dicts.
+ *
+ * All interpreter work runs on one dedicated worker thread: render, create
+ * and clone calls wait for it, property and resize updates are queued and
+ * return at once, so the message thread never waits on the GIL for them.
+ *
+ * A crashing embedded plugin takes the whole app down with it — only opt
+ * in plugins you trust.
+ */
+
+#include <JuceHeader.h>
+#include "PythonPluginBridge.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <set>
+#include <vector>
+
+//==============================================================================
+class EmbeddedPythonRuntime
+{
+public:
+    static EmbeddedPythonRuntime& getInstance();
+
+    /// True when the binary was built with MAXIMETER_EMBED_PYTHON.
+    static bool isCompiledIn();
+
+    //-- Lifecycle -----------------------------------------------------------
+
+    /// Initialise the interpreter (first call only) and scan @p pluginsDir
+    /// for embedded plugins.  The interpreter is never finalised — CPython
+    /// does not reliably support re-initialisation, so it lives until exit.
+    bool start(const juce::File& pluginsDir);
+
+    bool isRunning() const { return host.load() != nullptr; }
+
+    //-- Discovery -----------------------------------------------------------
+
+    std::vector<CustomPluginManifest> getManifests() const;
+    bool hasManifest(const juce::String& manifestId) const;
+    bool ownsInstance(const juce::String& instanceId) const;
+
+    //-- Instance management -------------------------------------------------
+
+    std::optional<std::vector<CustomPluginProperty>> createInstance(const juce::String& manifestId,
+                                                                    const juce::String& instanceId);
+    bool cloneInstance(const juce::String& sourceInstanceId, const juce::String& newInstanceId,
+                       const std::vector<std::pair<juce::String, juce::var>>& values);
+    void destroyInstance(const juce::String& instanceId);
+
+    //-- Rendering -----------------------------------------------------------
+
+    /// Render one frame of every request, in order.  Live instances read
+    /// audio from shared memory; @p audio (a PluginAudioFrame's AudioData
+    /// tree) is converted to a dict once, and only when the host will read
+    /// it — @p forceJsonAudio is set (export) or the mapping is missing.
+    std::vector<PluginRenderResult> renderBatch(const std::vector<PluginRenderRequest>& requests,
+                                                const juce::var& audio,
+                                                bool forceJsonAudio);
+
+    void setProperty(const juce::String& instanceId, const juce::String& key,
+                     const juce::var& value);
+    void setProperties(const juce::String& instanceId,
+                       const std::vector<std::pair<juce::String, juce::var>>& values);
+    void notifyResize(const juce::String& instanceId, int width, int height);
+
+private:
+    EmbeddedPythonRuntime() = default;
+    ~EmbeddedPythonRuntime();
+
+    /// Call a protocol handler with @p msg on the worker; returns the
+    /// response or void.
+    juce::var dispatch(const juce::var& msg);
+
+    /// Queue @p msg for the worker without waiting for the response.
+    void post(const juce::var& msg);
+
+    /// The part of dispatch() that runs on the worker.
+    juce::var callHost(const juce::var& msg);
+
+    /// Run @p job on the worker thread and wait for it.
+    void runOnWorker(std::function<void()> job);
+
+    std::unique_ptr<juce::ThreadPool> worker;   ///< one thread; created by start()
+    std::atomic<void*> host { nullptr };        ///< PyObject* EmbeddedHost (owned reference),
+                                                ///< set once on the worker, never released
+
+    mutable juce::CriticalSection     lock;
+    std::vector<CustomPluginManifest> manifests;
+    std::set<juce::String>            instances;
+
+    JUCE_DECLARE_NON_COPYABLE(EmbeddedPythonRuntime)
+};
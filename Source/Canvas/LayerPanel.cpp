@@ -3,6 +3,7 @@
 #include "../UI/ThemeManager.h"
 // Icons not used here — layer buttons use text labels
 #include <algorithm>
+#include <map>
 
 //==============================================================================
 LayerPanel::LayerPanel(CanvasModel& m) : model(m)
@@ -128,25 +129,53 @@ void LayerPanel::layoutRows()
     }
 }
 
-void LayerPanel::rebuild()
+void LayerPanel::itemChangesBatched(const CanvasChangeSet& changes)
 {
-    rows.clear();
+    if (changes.changesLayout())
+    {
+        syncRows(changes.structural);
+        return;
+    }
 
-    // Build rows from items in reverse z-order (top layer first)
+    // Rows don't show geometry, so only property edits need a repaint
+    for (auto& row : rows)
+        if (changes.propertyChanged.count(row->getId()))
+            row->repaint();
+}
+
+void LayerPanel::syncRows(bool repaintAll)
+{
+    // Items in reverse z-order (top layer first)
     std::vector<CanvasItem*> sorted;
     for (int i = 0; i < model.getNumItems(); ++i)
         sorted.push_back(model.getItem(i));
     std::sort(sorted.begin(), sorted.end(), [](auto* a, auto* b) { return a->zOrder > b->zOrder; });
 
+    std::map<juce::Uuid, std::unique_ptr<LayerRow>> existing;
+    for (auto& row : rows)
+        existing[row->getId()] = std::move(row);
+    rows.clear();
+
     for (auto* item : sorted)
     {
-        auto row = std::make_unique<LayerRow>(model, item->id);
-        rowContainer.addAndMakeVisible(row.get());
-        rows.push_back(std::move(row));
+        auto it = existing.find(item->id);
+        if (it != existing.end())
+        {
+            rows.push_back(std::move(it->second));
+            existing.erase(it);
+            if (repaintAll)
+                rows.back()->repaint();
+        }
+        else
+        {
+            auto row = std::make_unique<LayerRow>(model, item->id);
+            rowContainer.addAndMakeVisible(row.get());
+            rows.push_back(std::move(row));
+        }
     }
 
+    // Rows left in 'existing' belong to removed items and are destroyed here
     layoutRows();
-    repaint();
 }
 
 //==============================================================================
@@ -207,7 +236,7 @@ void LayerPanel::LayerRow::setupButtons()
         if (auto* item = model.findItem(id))
         {
             item->visible = !item->visible;
-            model.notifyItemsChanged();
+            model.notifyItemPropertyChanged(id);
         }
     };
     lockBtn.onClick = [this]
@@ -215,7 +244,7 @@ void LayerPanel::LayerRow::setupButtons()
         if (auto* item = model.findItem(id))
         {
             item->locked = !item->locked;
-            model.notifyItemsChanged();
+            model.notifyItemPropertyChanged(id);
         }
     };
 }
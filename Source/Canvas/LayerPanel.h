@@ -20,7 +20,7 @@ public:
     void mouseUp(const juce::MouseEvent& e) override;
     void mouseMove(const juce::MouseEvent& e) override;
 
-    void itemsChanged() override    { rebuild(); }
+    void itemChangesBatched(const CanvasChangeSet& changes) override;
     void selectionChanged() override { repaint(); }
     void applyThemeColours();
 
@@ -39,6 +39,8 @@ private:
         void paint(juce::Graphics& g) override;
         void mouseUp(const juce::MouseEvent& e) override;
 
+        const juce::Uuid& getId() const { return id; }
+
     private:
         CanvasModel& model;
         juce::Uuid id;
@@ -57,7 +59,10 @@ private:
     juce::Viewport viewport;
     juce::Component rowContainer;
 
-    void rebuild();
+    /// Reconcile rows with the model: reuse rows for surviving items, create
+    /// rows for new ones and re-order.  Unchanged rows are not repainted
+    /// unless @p repaintAll is set.
+    void syncRows(bool repaintAll);
     void layoutRows();          ///< Position rows inside rowContainer
 
     static constexpr int kDividerHeight = 5;  ///< height of the drag zone at top
@@ -1,6 +1,7 @@
 #include "MeterFactory.h"
 #include "CanvasItem.h"
 #include "CustomPluginComponent.h"
+#include "PluginRenderBatcher.h"
 
 // Full includes for all meter types
 #include "../UI/MultiBandAnalyzer.h"
@@ -22,12 +23,15 @@
 #include "../UI/VideoLayerComponent.h"
 #include "../UI/ShapeComponent.h"
 #include "../UI/TextLabelComponent.h"
+#include <algorithm>
+#include <map>
 
 //==============================================================================
-MeterFactory::MeterFactory(AudioEngine& ae, FFTProcessor& fft, LevelAnalyzer& la,
-                           LoudnessAnalyzer& loud, StereoFieldAnalyzer& stereo)
-    : audioEngine(ae), fftProcessor(fft), levelAnalyzer(la),
-      loudnessAnalyzer(loud), stereoAnalyzer(stereo)
+MeterFactory::MeterFactory(AudioEngine& ae, FFTProcessor& fft, OctaveBandAnalyzer& bands,
+                           LevelAnalyzer& la, LoudnessAnalyzer& loud, StereoFieldAnalyzer& stereo,
+                           MetricHistory& history)
+    : audioEngine(ae), fftProcessor(fft), octaveBands(bands), levelAnalyzer(la),
+      loudnessAnalyzer(loud), stereoAnalyzer(stereo), metricHistory(history)
 {
     // Initialize shared memory for zero-copy audio transfer to Python plugins
     shmInitialised = audioSHM.create(fft.getFFTSize(), 1024);
@@ -180,7 +184,22 @@ std::unique_ptr<juce::Component> MeterFactory::createMeter(MeterType type)
 }
 
 //==============================================================================
-void MeterFactory::feedMeter(CanvasItem& item)
+RenderGraph::FrameContext MeterFactory::makeLiveContext() const
+{
+    using PlayState = RenderGraph::FrameContext::PlayState;
+
+    RenderGraph::FrameContext ctx;
+    ctx.playState = audioEngine.isPlaying() ? PlayState::Playing
+                  : audioEngine.isPaused()  ? PlayState::Paused
+                                            : PlayState::Stopped;
+    ctx.position  = audioEngine.getCurrentPosition();
+    ctx.length    = audioEngine.getLengthInSeconds();
+    ctx.title     = audioEngine.getLoadedFileName();
+    return ctx;
+}
+
+void MeterFactory::feedMeter(CanvasItem& item, AnalyzerSet* stem,
+                             const RenderGraph::FrameContext& ctx)
 {
     if (!item.component || !item.visible) return;
 
@@ -208,57 +227,109 @@ void MeterFactory::feedMeter(CanvasItem& item)
     }
 
     auto* comp = item.component.get();
-    const int specSize = fftProcessor.getSpectrumSize();
-    const double sr = audioEngine.getFileSampleRate();
+
+    // Items bound to a loaded stem read that stem's analyzers; the rest read the mix
+    FFTProcessor&        fft      = stem ? stem->fft      : fftProcessor;
+    OctaveBandAnalyzer&  bank     = stem ? stem->bands    : octaveBands;
+    LevelAnalyzer&       levels   = stem ? stem->levels   : levelAnalyzer;
+    LoudnessAnalyzer&    loudness = stem ? stem->loudness : loudnessAnalyzer;
+    StereoFieldAnalyzer& stereo   = stem ? stem->stereo   : stereoAnalyzer;
+    MetricHistory&       history  = stem ? stem->history  : metricHistory;
+    auto latestMono = [&](float* dest, int maxSamples)
+    {
+        if (stem != nullptr)
+            return stem->getLatestMonoSamples(dest, maxSamples);
+        if (ctx.mixMono == nullptr)
+            return audioEngine.getLatestMonoSamples(dest, maxSamples);
+
+        // Stepped clock: the newest samples of the frame's mix block
+        const int n = juce::jmin(ctx.mixMonoCount, maxSamples);
+        std::copy(ctx.mixMono + (ctx.mixMonoCount - n), ctx.mixMono + ctx.mixMonoCount, dest);
+        return n;
+    };
+
+    // A stem's FFT belongs to its pool job, which may be running; use the
+    // copy it published.  Only meters that draw a spectrum pay for it.
+    const float* spectrum = fft.getSpectrumData();
+    int specSize = fft.getSpectrumSize();
+    if (stem != nullptr)
+    {
+        switch (item.meterType)
+        {
+            case MeterType::MultiBandAnalyzer:
+            case MeterType::Spectrogram:
+            case MeterType::SkinnedSpectrum:
+            {
+                auto* copy = frameArena.allocateArray<float>(FFTProcessor::kMaxFFTSize / 2);
+                specSize = stem->getLatestSpectrum(copy, FFTProcessor::kMaxFFTSize / 2);
+                spectrum = copy;
+                break;
+            }
+            default:
+                specSize = 0;
+                break;
+        }
+    }
+    const double sr = stem ? stem->getSampleRate() : audioEngine.getFileSampleRate();
 
     switch (item.meterType)
     {
         case MeterType::MultiBandAnalyzer:
-            if (specSize > 0)
-                static_cast<MultiBandAnalyzer*>(comp)->setSpectrumData(
-                    fftProcessor.getSpectrumData(), specSize, sr);
+        {
+            auto* m = static_cast<MultiBandAnalyzer*>(comp);
+            if (m->getDataSource() == MultiBandAnalyzer::DataSource::FilterBank)
+            {
+                auto* bands = frameArena.allocateArray<OctaveBandAnalyzer::Band>(OctaveBandAnalyzer::kMaxBands);
+                const int n = bank.getBands(bands, OctaveBandAnalyzer::kMaxBands);
+                if (n > 0)
+                    m->setBandData(bands, n, bank.getBandsPerOctave(), sr);
+            }
+            else if (specSize > 0)
+            {
+                m->setSpectrumData(spectrum, specSize, sr);
+            }
             break;
+        }
 
         case MeterType::Spectrogram:
             if (specSize > 0)
-                static_cast<::Spectrogram*>(comp)->pushSpectrum(
-                    fftProcessor.getSpectrumData(), specSize);
+                static_cast<::Spectrogram*>(comp)->pushSpectrum(spectrum, specSize);
             break;
 
         case MeterType::Goniometer:
-            static_cast<::Goniometer*>(comp)->update(stereoAnalyzer);
+            static_cast<::Goniometer*>(comp)->update(stereo);
             break;
 
         case MeterType::LissajousScope:
-            static_cast<::LissajousScope*>(comp)->update(stereoAnalyzer);
+            static_cast<::LissajousScope*>(comp)->update(stereo);
             break;
 
         case MeterType::LoudnessMeter:
         {
             auto* m = static_cast<::LoudnessMeter*>(comp);
-            m->setMomentaryLUFS(loudnessAnalyzer.getMomentaryLUFS());
-            m->setShortTermLUFS(loudnessAnalyzer.getShortTermLUFS());
-            m->setIntegratedLUFS(loudnessAnalyzer.getIntegratedLUFS());
-            m->setLRA(loudnessAnalyzer.getLRA());
-            m->setTruePeakL(loudnessAnalyzer.getTruePeakLeft());
-            m->setTruePeakR(loudnessAnalyzer.getTruePeakRight());
+            m->setMomentaryLUFS(loudness.getMomentaryLUFS());
+            m->setShortTermLUFS(loudness.getShortTermLUFS());
+            m->setIntegratedLUFS(loudness.getIntegratedLUFS());
+            m->setLRA(loudness.getLRA());
+            m->setTruePeakL(loudness.getTruePeakLeft());
+            m->setTruePeakR(loudness.getTruePeakRight());
+            m->setHistorySource(&history);
             break;
         }
         case MeterType::LevelHistogram:
-            static_cast<::LevelHistogram*>(comp)->pushLevel(
-                levelAnalyzer.getRMSLeft(), levelAnalyzer.getRMSRight());
+            static_cast<::LevelHistogram*>(comp)->update(history);
             break;
 
         case MeterType::CorrelationMeter:
             static_cast<::CorrelationMeter*>(comp)->setCorrelation(
-                stereoAnalyzer.getCorrelation());
+                stereo.getCorrelation());
             break;
 
         case MeterType::PeakMeter:
         {
             auto* m = static_cast<::PeakMeter*>(comp);
-            m->setLevel(0, levelAnalyzer.getPeakLeft());
-            m->setLevel(1, levelAnalyzer.getPeakRight());
+            m->setLevel(0, levels.getPeakLeft());
+            m->setLevel(1, levels.getPeakRight());
             break;
         }
         case MeterType::SkinnedSpectrum:
@@ -266,24 +337,24 @@ void MeterFactory::feedMeter(CanvasItem& item)
             {
                 auto* m = static_cast<SkinnedSpectrumAnalyzer*>(comp);
                 int nb = m->getNumBands();
-                std::vector<float> bands(static_cast<size_t>(nb));
-                fftProcessor.getLogSpectrumBands(bands.data(), nb, sr);
-                m->setSpectrumData(bands.data(), nb);
+                auto* bands = frameArena.allocateArray<float>(static_cast<size_t>(nb));
+                FFTProcessor::computeLogSpectrumBands(spectrum, specSize, bands, nb, sr);
+                m->setSpectrumData(bands, nb);
             }
             break;
 
         case MeterType::SkinnedVUMeter:
             if (item.vuChannel == 1)
-                static_cast<::SkinnedVUMeter*>(comp)->setLevel(levelAnalyzer.getRMSRight());
+                static_cast<::SkinnedVUMeter*>(comp)->setLevel(levels.getRMSRight());
             else
-                static_cast<::SkinnedVUMeter*>(comp)->setLevel(levelAnalyzer.getRMSLeft());
+                static_cast<::SkinnedVUMeter*>(comp)->setLevel(levels.getRMSLeft());
             break;
 
         case MeterType::SkinnedOscilloscope:
         {
-            // Feed oscilloscope with latest raw mono samples from AudioEngine
+            // Feed oscilloscope with the latest raw mono samples of the item's source
             std::array<float, 2048> oscBuf {};
-            int n = audioEngine.getLatestMonoSamples(oscBuf.data(), static_cast<int>(oscBuf.size()));
+            int n = latestMono(oscBuf.data(), static_cast<int>(oscBuf.size()));
             if (n > 0)
                 static_cast<::SkinnedOscilloscope*>(comp)->pushSamples(oscBuf.data(), n);
             break;
@@ -294,21 +365,17 @@ void MeterFactory::feedMeter(CanvasItem& item)
             auto* r = static_cast<WinampSkinRenderer*>(comp);
             if (r->hasSkin())
             {
-                WinampSkinRenderer::PlayState ps;
-                if (audioEngine.isPlaying())
-                    ps = WinampSkinRenderer::PlayState::Playing;
-                else if (audioEngine.isPaused())
-                    ps = WinampSkinRenderer::PlayState::Paused;
-                else
-                    ps = WinampSkinRenderer::PlayState::Stopped;
-                r->setPlayState(ps);
-
-                if (sr > 0)
+                using PS = RenderGraph::FrameContext::PlayState;
+                r->setPlayState(ctx.playState == PS::Playing ? WinampSkinRenderer::PlayState::Playing
+                              : ctx.playState == PS::Paused  ? WinampSkinRenderer::PlayState::Paused
+                                                             : WinampSkinRenderer::PlayState::Stopped);
+
+                if (ctx.length > 0)
                 {
-                    double pos = audioEngine.getCurrentPosition();
-                    r->setTime(static_cast<int>(pos) / 60, static_cast<int>(pos) % 60);
+                    const int secs = static_cast<int>(ctx.position);
+                    r->setTime(secs / 60, secs % 60);
                 }
-                r->setTitleText(audioEngine.getLoadedFileName());
+                r->setTitleText(ctx.title);
             }
             break;
         }
@@ -317,25 +384,18 @@ void MeterFactory::feedMeter(CanvasItem& item)
             auto* p = static_cast<SkinnedPlayerPanel*>(comp);
             if (p->hasSkin())
             {
-                SkinnedPlayerPanel::PlayState sps;
-                if (audioEngine.isPlaying())
-                    sps = SkinnedPlayerPanel::PlayState::Playing;
-                else if (audioEngine.isPaused())
-                    sps = SkinnedPlayerPanel::PlayState::Paused;
-                else
-                    sps = SkinnedPlayerPanel::PlayState::Stopped;
-                p->setPlayState(sps);
+                using PS = RenderGraph::FrameContext::PlayState;
+                p->setPlayState(ctx.playState == PS::Playing ? SkinnedPlayerPanel::PlayState::Playing
+                              : ctx.playState == PS::Paused  ? SkinnedPlayerPanel::PlayState::Paused
+                                                             : SkinnedPlayerPanel::PlayState::Stopped);
 
-                double len = audioEngine.getLengthInSeconds();
-                if (len > 0)
+                if (ctx.length > 0)
                 {
-                    double pos = audioEngine.getCurrentPosition();
-                    p->setPosition(pos / len);
-                    int minutes = static_cast<int>(pos) / 60;
-                    int seconds = static_cast<int>(pos) % 60;
-                    p->setTime(minutes, seconds);
+                    p->setPosition(ctx.position / ctx.length);
+                    const int secs = static_cast<int>(ctx.position);
+                    p->setTime(secs / 60, secs % 60);
                 }
-                p->setTitleText(audioEngine.getLoadedFileName());
+                p->setTitleText(ctx.title);
 
                 // Feed spectrum
                 if (specSize > 0)
@@ -350,7 +410,7 @@ void MeterFactory::feedMeter(CanvasItem& item)
                         {
                             int idx = b * binsPer + j;
                             if (idx < specSize)
-                                sum += fftProcessor.getSpectrumData()[idx];
+                                sum += spectrum[idx];
                         }
                         float avg = sum / static_cast<float>(binsPer);
                         bands20[b] = (avg > 1e-10f) ? 20.0f * std::log10(avg) : -60.0f;
@@ -361,7 +421,7 @@ void MeterFactory::feedMeter(CanvasItem& item)
                 // Feed oscilloscope
                 {
                     float oscBuf[512];
-                    int n = audioEngine.getLatestMonoSamples(oscBuf, 512);
+                    int n = latestMono(oscBuf, 512);
                     p->setOscilloscopeData(oscBuf, n);
                 }
             }
@@ -372,11 +432,26 @@ void MeterFactory::feedMeter(CanvasItem& item)
             break;
 
         case MeterType::WaveformView:
-            // Self-driven component — no per-frame feed needed.
+            // Self-driven live; follows the clock when it is stepped
+            if (ctx.stepped)
+                static_cast<WaveformView*>(comp)->setOfflinePosition(ctx.position);
             break;
 
-        case MeterType::ImageLayer:
         case MeterType::VideoLayer:
+            // Plays on its own timer live; frame-locked to the clock when stepped
+            if (ctx.stepped)
+            {
+                auto* vid = static_cast<VideoLayerComponent*>(comp);
+                if (vid->getFrameCount() > 0)
+                {
+                    float videoFps = vid->getAverageFps();
+                    if (videoFps <= 0.0f) videoFps = 30.0f;
+                    vid->setCurrentFrame(static_cast<int>(ctx.position * videoFps) % vid->getFrameCount());
+                }
+            }
+            break;
+
+        case MeterType::ImageLayer:
             // Static display — no audio data feeding needed.
             break;
 
@@ -395,150 +470,177 @@ void MeterFactory::feedMeter(CanvasItem& item)
 
         case MeterType::CustomPlugin:
         {
-            // Feed audio data to custom plugin via JSON and shared memory
+            // Every plugin this frame shares one audio snapshot; its colours
+            // travel with its own render request instead.
             auto* cpc = static_cast<CustomPluginComponent*>(comp);
+            preparePluginFrame();
 
-            // Fetch raw audio data once
-            const float* pSpectrum = (specSize > 0) ? fftProcessor.getSpectrumData() : nullptr;
-            float waveBuf[1024];
-            int waveSamples = audioEngine.getLatestMonoSamples(waveBuf, 1024);
-            const float* pWaveform = (waveSamples > 0) ? waveBuf : nullptr;
+            const float* pSpectrum = (specSize > 0) ? spectrum : nullptr;
+            const float* pWaveform = (pluginWaveSamples > 0) ? pluginWave : nullptr;
 
-            // ── Write to shared memory (zero-copy path for Python) ──
-            if (shmInitialised)
-            {
-                // Per-channel level data
-                audioSHM.writeChannelData(0,
-                    levelAnalyzer.getRMSLeft(), levelAnalyzer.getPeakLeft(),
-                    levelAnalyzer.getPeakLeft(),
-                    levelAnalyzer.getRMSLeft(), levelAnalyzer.getPeakLeft());
-                audioSHM.writeChannelData(1,
-                    levelAnalyzer.getRMSRight(), levelAnalyzer.getPeakRight(),
-                    levelAnalyzer.getPeakRight(),
-                    levelAnalyzer.getRMSRight(), levelAnalyzer.getPeakRight());
-
-                if (pSpectrum)
-                    audioSHM.writeSpectrum(pSpectrum, fftProcessor.getSpectrumSize());
-
-                if (pWaveform)
-                    audioSHM.writeWaveform(pWaveform, waveSamples);
-
-                // Scalar frame data + increment frame counter
-                audioSHM.writeFrame(
-                    (float)audioEngine.getFileSampleRate(),
-                    2,                                       // numChannels
-                    audioEngine.isPlaying(),
-                    0.0f, 0.0f,                              // position, duration
-                    stereoAnalyzer.getCorrelation(),
-                    0.0f,                                    // stereoAngle
-                    loudnessAnalyzer.getMomentaryLUFS(),
-                    loudnessAnalyzer.getShortTermLUFS(),
-                    loudnessAnalyzer.getIntegratedLUFS(),
-                    loudnessAnalyzer.getLRA(),
-                    0.0f, 0.0f                               // bpm, beatPhase
-                );
-            }
+            // Pass raw pointers for GPU texture upload
+            cpc->feedAudioData(pSpectrum, specSize, pWaveform, pluginWaveSamples);
+            break;
+        }
 
-            // ── JSON path (legacy/fallback + metadata) ──
-            // Skip expensive JSON serialisation if the worker is throttled.
-            // But we must still call feedAudioData to allow worker result pickup.
-            if (cpc->isRenderThrottled())
-            {
-                cpc->feedAudioData({}, shmInitialised,
-                                   pSpectrum, specSize,
-                                   pWaveform, waveSamples);
-                break;
-            }
+        default: break;
+    }
+}
 
-            // Build a lightweight audio JSON snapshot
-            juce::DynamicObject::Ptr audioObj = new juce::DynamicObject();
+//==============================================================================
+void MeterFactory::preparePluginFrame()
+{
+    if (pluginFrameReady)
+        return;
+    pluginFrameReady = true;
 
-            // Channels array
-            juce::Array<juce::var> channelsArr;
-            {
-                juce::DynamicObject::Ptr leftCh = new juce::DynamicObject();
-                leftCh->setProperty("rms", levelAnalyzer.getRMSLeft());
-                leftCh->setProperty("peak", levelAnalyzer.getPeakLeft());
-                leftCh->setProperty("true_peak", levelAnalyzer.getPeakLeft());
-                leftCh->setProperty("rms_linear", levelAnalyzer.getRMSLeft());
-                leftCh->setProperty("peak_linear", levelAnalyzer.getPeakLeft());
-                channelsArr.add(juce::var(leftCh.get()));
-
-                juce::DynamicObject::Ptr rightCh = new juce::DynamicObject();
-                rightCh->setProperty("rms", levelAnalyzer.getRMSRight());
-                rightCh->setProperty("peak", levelAnalyzer.getPeakRight());
-                rightCh->setProperty("true_peak", levelAnalyzer.getPeakRight());
-                rightCh->setProperty("rms_linear", levelAnalyzer.getRMSRight());
-                rightCh->setProperty("peak_linear", levelAnalyzer.getPeakRight());
-                channelsArr.add(juce::var(rightCh.get()));
-            }
-            audioObj->setProperty("channels", channelsArr);
-            audioObj->setProperty("num_channels", 2);
+    // Fetch raw audio data once per frame
+    const int specSize = fftProcessor.getSpectrumSize();
+    const float* pSpectrum = (specSize > 0) ? fftProcessor.getSpectrumData() : nullptr;
+    pluginWaveSamples = audioEngine.getLatestMonoSamples(pluginWave, 1024);
+    const int waveSamples = pluginWaveSamples;
+    const float* pWaveform = (waveSamples > 0) ? pluginWave : nullptr;
 
-            // Loudness
-            audioObj->setProperty("lufs_momentary", loudnessAnalyzer.getMomentaryLUFS());
-            audioObj->setProperty("lufs_short_term", loudnessAnalyzer.getShortTermLUFS());
-            audioObj->setProperty("lufs_integrated", loudnessAnalyzer.getIntegratedLUFS());
-            audioObj->setProperty("loudness_range", loudnessAnalyzer.getLRA());
+    // ── Write to shared memory (zero-copy path for Python) ──
+    if (shmInitialised)
+    {
+        // Per-channel level data
+        audioSHM.writeChannelData(0,
+            levelAnalyzer.getRMSLeft(), levelAnalyzer.getPeakLeft(),
+            levelAnalyzer.getPeakLeft(),
+            levelAnalyzer.getRMSLeft(), levelAnalyzer.getPeakLeft());
+        audioSHM.writeChannelData(1,
+            levelAnalyzer.getRMSRight(), levelAnalyzer.getPeakRight(),
+            levelAnalyzer.getPeakRight(),
+            levelAnalyzer.getRMSRight(), levelAnalyzer.getPeakRight());
+
+        if (pSpectrum)
+            audioSHM.writeSpectrum(pSpectrum, fftProcessor.getSpectrumSize());
+
+        if (pWaveform)
+            audioSHM.writeWaveform(pWaveform, waveSamples);
+
+        if (fftProcessor.areFeaturesEnabled())
+            audioSHM.writeFeatures(fftProcessor.getFeatureExtractor().getFeatures());
+
+        audioSHM.writeHistory(metricHistory);
+
+        // Scalar frame data + increment frame counter
+        audioSHM.writeFrame(
+            (float)audioEngine.getFileSampleRate(),
+            2,                                       // numChannels
+            audioEngine.isPlaying(),
+            0.0f, 0.0f,                              // position, duration
+            stereoAnalyzer.getCorrelation(),
+            0.0f,                                    // stereoAngle
+            loudnessAnalyzer.getMomentaryLUFS(),
+            loudnessAnalyzer.getShortTermLUFS(),
+            loudnessAnalyzer.getIntegratedLUFS(),
+            loudnessAnalyzer.getLRA(),
+            0.0f, 0.0f                               // bpm, beatPhase
+        );
+    }
 
-            // Stereo
-            audioObj->setProperty("correlation", stereoAnalyzer.getCorrelation());
+    // ── Frame for the batch (native snapshot + AudioData tree) ──
+    // Skip it while the previous batch is still rendering — its posts
+    // would be dropped anyway.
+    if (PluginRenderBatcher::getInstance().isBusy())
+    {
+        pluginFrame.reset();
+        return;
+    }
 
-            // Spectrum & Waveform (always included in JSON as per user request)
-            if (specSize > 0)
-            {
-                juce::Array<juce::var> specArr;
-                juce::Array<juce::var> specLinArr;
-                int numBins = juce::jmin(specSize, 512);
-                for (int b = 0; b < numBins; ++b)
-                {
-                    float mag = pSpectrum ? pSpectrum[b] : 0.0f;
-                    specArr.add(mag);
-                    specLinArr.add(juce::jlimit(0.0f, 1.0f, mag));
-                }
-                audioObj->setProperty("spectrum", specArr);
-                audioObj->setProperty("spectrum_linear", specLinArr);
-                audioObj->setProperty("fft_size", specSize * 2);
-            }
+    // Reuse the previous frame's buffers once the batcher has let go of it
+    if (pluginFrame == nullptr || pluginFrame.use_count() > 1)
+        pluginFrame = std::make_shared<PluginAudioFrame>();
+
+    auto& snap = pluginFrame->snapshot;
+    snap = {};
+    snap.sampleRate  = (float)audioEngine.getFileSampleRate();
+    snap.numChannels = 2;
+    snap.isPlaying   = audioEngine.isPlaying() ? 1 : 0;
+    snap.channels[0] = { levelAnalyzer.getRMSLeft(),  levelAnalyzer.getPeakLeft(),  levelAnalyzer.getPeakLeft() };
+    snap.channels[1] = { levelAnalyzer.getRMSRight(), levelAnalyzer.getPeakRight(), levelAnalyzer.getPeakRight() };
+
+    snap.lufsMomentary  = loudnessAnalyzer.getMomentaryLUFS();
+    snap.lufsShortTerm  = loudnessAnalyzer.getShortTermLUFS();
+    snap.lufsIntegrated = loudnessAnalyzer.getIntegratedLUFS();
+    snap.loudnessRange  = loudnessAnalyzer.getLRA();
+    snap.correlation    = stereoAnalyzer.getCorrelation();
+    snap.fftSize        = specSize * 2;
+
+    if (pSpectrum != nullptr)
+        pluginFrame->spectrum.assign(pSpectrum, pSpectrum + specSize);
+    else
+        pluginFrame->spectrum.clear();
 
-            if (waveSamples > 0)
-            {
-                juce::Array<juce::var> waveArr;
-                for (int s = 0; s < waveSamples; ++s)
-                    waveArr.add(pWaveform ? pWaveform[s] : 0.0f);
-                audioObj->setProperty("waveform", waveArr);
-            }
+    if (pWaveform != nullptr)
+        pluginFrame->waveform.assign(pWaveform, pWaveform + waveSamples);
+    else
+        pluginFrame->waveform.clear();
 
-            // Include meter colours so Python plugins can use them
+    pluginFrame->finalise();
+
+    // Per-frame features (centroid, chroma, MFCC, pitch, ...)
+    if (fftProcessor.areFeaturesEnabled())
+        fftProcessor.getFeatureExtractor().getFeatures().writeTo(*pluginFrame->data.getDynamicObject());
+}
+
+void MeterFactory::endFrame()
+{
+    if (pluginFrameReady && pluginFrame != nullptr)
+        PluginRenderBatcher::getInstance().submitFrame(pluginFrame);
+}
+
+//==============================================================================
+Analysis::Requirements MeterFactory::collectAnalysisRequirements(const std::vector<const CanvasItem*>& items)
+{
+    Analysis::Requirements result;
+    std::vector<CustomPluginManifest> manifests;
+    bool manifestsFetched = false;
+
+    for (auto* item : items)
+    {
+        if (item == nullptr || !item->visible)
+            continue;
+
+        // Filter-bank analyzers read the octave bands instead of the FFT
+        if (item->meterType == MeterType::MultiBandAnalyzer)
+        {
+            auto* m = dynamic_cast<const MultiBandAnalyzer*>(item->component.get());
+            if (m != nullptr && m->getDataSource() == MultiBandAnalyzer::DataSource::FilterBank)
             {
-                auto bgC = item.meterBgColour;
-                auto fgC = item.meterFgColour;
-                juce::DynamicObject::Ptr bgObj = new juce::DynamicObject();
-                bgObj->setProperty("r", bgC.getFloatRed());
-                bgObj->setProperty("g", bgC.getFloatGreen());
-                bgObj->setProperty("b", bgC.getFloatBlue());
-                bgObj->setProperty("a", bgC.getFloatAlpha());
-                audioObj->setProperty("bg_color", juce::var(bgObj.get()));
-
-                juce::DynamicObject::Ptr fgObj = new juce::DynamicObject();
-                fgObj->setProperty("r", fgC.getFloatRed());
-                fgObj->setProperty("g", fgC.getFloatGreen());
-                fgObj->setProperty("b", fgC.getFloatBlue());
-                fgObj->setProperty("a", fgC.getFloatAlpha());
-                audioObj->setProperty("fg_color", juce::var(fgObj.get()));
+                result |= { Analysis::Bands, 0, m->getBandsPerOctave() };
+                continue;
             }
+        }
 
-            auto jsonStr = juce::JSON::toString(juce::var(audioObj.get()), true);
-            
-            // Pass raw pointers for GPU texture upload (avoids JSON parsing in Component)
-            cpc->feedAudioData(jsonStr, shmInitialised,
-                               pSpectrum, specSize,
-                               pWaveform, waveSamples);
-            break;
+        if (item->meterType != MeterType::CustomPlugin)
+        {
+            result |= meterAnalysisRequirements(item->meterType);
+            continue;
         }
 
-        default: break;
+        if (!manifestsFetched)
+        {
+            manifests = PythonPluginBridge::getInstance().getAvailablePlugins();
+            manifestsFetched = true;
+        }
+
+        // Unknown manifest (bridge not scanned yet) — assume it reads everything
+        auto it = std::find_if(manifests.begin(), manifests.end(),
+                               [&](const CustomPluginManifest& m) { return m.id == item->customPluginId; });
+        result |= (it != manifests.end()) ? it->analysis
+                                          : meterAnalysisRequirements(MeterType::CustomPlugin);
     }
+    return result;
+}
+
+juce::String MeterFactory::resolveAudioSource(const CanvasItem& item, const StemBank* stems)
+{
+    if (stems == nullptr || item.audioSource.isEmpty() || !meterSupportsAudioSource(item.meterType))
+        return {};
+    return stems->contains(item.audioSource) ? item.audioSource : juce::String();
 }
 
 //==============================================================================
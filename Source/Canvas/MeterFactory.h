@@ -2,13 +2,18 @@
 
 #include <JuceHeader.h>
 #include "CanvasItem.h"
+#include "RenderGraph.h"
 #include "../Audio/AudioEngine.h"
 #include "../Audio/FFTProcessor.h"
+#include "../Audio/OctaveBandAnalyzer.h"
 #include "../Audio/LevelAnalyzer.h"
 #include "../Audio/LoudnessAnalyzer.h"
 #include "../Audio/StereoFieldAnalyzer.h"
+#include "../Audio/MetricHistory.h"
+#include "../Audio/StemBank.h"
 #include "../Skin/SkinModel.h"
 #include "PythonPluginBridge.h"  // for AudioSharedMemory
+#include "../Utils/FrameArena.h"
 
 // Forward-declare all meter types to avoid heavy includes in the header.
 class MultiBandAnalyzer;
@@ -32,15 +37,39 @@ class WaveformView;
 class MeterFactory
 {
 public:
-    MeterFactory(AudioEngine& ae, FFTProcessor& fft, LevelAnalyzer& la,
-                 LoudnessAnalyzer& loud, StereoFieldAnalyzer& stereo);
+    MeterFactory(AudioEngine& ae, FFTProcessor& fft, OctaveBandAnalyzer& bands,
+                 LevelAnalyzer& la, LoudnessAnalyzer& loud, StereoFieldAnalyzer& stereo,
+                 MetricHistory& history);
 
     /// Create a new Component for the given meter type.
     /// The caller takes ownership. Returns nullptr on failure.
     std::unique_ptr<juce::Component> createMeter(MeterType type);
 
-    /// Push current frame data into a single item's component.
-    void feedMeter(CanvasItem& item);
+    /// Start a new frame: recycles the scratch arena used by feedMeter().
+    /// Call once per frame before feeding any items.
+    void beginFrame() { frameArena.reset(); pluginFrameReady = false; }
+
+    /// Push current frame data into a single item's component.  @p source is
+    /// the stem the item reads (nullptr = the mix); @p ctx carries the clock.
+    void feedMeter(CanvasItem& item, AnalyzerSet* source, const RenderGraph::FrameContext& ctx);
+
+    /// Frame context read from the AudioEngine's transport (live canvas).
+    RenderGraph::FrameContext makeLiveContext() const;
+
+    /// Finish the frame: sends every plugin render posted by feedMeter() to
+    /// the bridge as one batch.  Call once after all items have been fed.
+    void endFrame();
+
+    /// Heap allocations made by the scratch arena during the current frame.
+    int getFrameAllocations() const { return frameArena.getFrameAllocations(); }
+
+    /// Union of the analyzers read by the visible items in @p items (plugins
+    /// use their manifest's declaration).  Used to drive an AnalysisGraph.
+    static Analysis::Requirements collectAnalysisRequirements(const std::vector<const CanvasItem*>& items);
+
+    /// Source @p item is analysed from: its stem id when that stem is loaded
+    /// in @p stems, otherwise an empty string (the main mix).
+    static juce::String resolveAudioSource(const CanvasItem& item, const StemBank* stems);
 
     /// Apply skin to skinned meters.
     void applySkin(CanvasItem& item, const Skin::SkinModel* skin);
@@ -55,11 +84,23 @@ public:
 private:
     AudioEngine&         audioEngine;
     FFTProcessor&        fftProcessor;
+    OctaveBandAnalyzer&  octaveBands;
     LevelAnalyzer&       levelAnalyzer;
     LoudnessAnalyzer&    loudnessAnalyzer;
     StereoFieldAnalyzer& stereoAnalyzer;
+    MetricHistory&       metricHistory;
 
     /// Shared memory for zero-copy audio transfer to Python plugins
     AudioSharedMemory    audioSHM;
     bool                 shmInitialised = false;
+
+    /// Per-frame scratch memory (band buffers etc.), reset by beginFrame()
+    FrameArena           frameArena;
+
+    /// Audio snapshot shared by every plugin fed this frame (built on first use)
+    void preparePluginFrame();
+    bool                 pluginFrameReady = false;
+    std::shared_ptr<PluginAudioFrame> pluginFrame;   ///< null when this frame is skipped
+    float                pluginWave[1024] = {};
+    int                  pluginWaveSamples = 0;
 };
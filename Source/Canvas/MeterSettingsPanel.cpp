@@ -80,6 +80,11 @@ MeterSettingsPanel::MeterSettingsPanel(CanvasModel& m) : model(m)
     }
 
     // ── Audio / Analysis ──
+    styleLabel(audioSourceLabel);   addChildComponent(audioSourceLabel);
+    styleCombo(audioSourceCombo);   addChildComponent(audioSourceCombo);
+    audioSourceIds.add({});
+    audioSourceCombo.addItem("Mix", 1);
+    audioSourceCombo.setSelectedId(1, juce::dontSendNotification);
     styleLabel(smoothingLabel);     addChildComponent(smoothingLabel);
     styleSlider(smoothingSlider, 1, 100, 1, 20);   addChildComponent(smoothingSlider);
     styleLabel(dynamicRangeLabel);  addChildComponent(dynamicRangeLabel);
@@ -101,6 +106,12 @@ MeterSettingsPanel::MeterSettingsPanel(CanvasModel& m) : model(m)
     scaleModeCombo.addItem("Linear", 2);
     scaleModeCombo.addItem("Octave", 3);
 
+    styleLabel(bandAnalysisLabel);  addChildComponent(bandAnalysisLabel);
+    styleCombo(bandAnalysisCombo);  addChildComponent(bandAnalysisCombo);
+    bandAnalysisCombo.addItem("FFT", 1);
+    bandAnalysisCombo.addItem("Filter bank", 2);
+    bandAnalysisCombo.setSelectedId(1, juce::dontSendNotification);
+
     // ── Spectrogram ──
     styleLabel(colourMapLabel);     addChildComponent(colourMapLabel);
     styleCombo(colourMapCombo);     addChildComponent(colourMapCombo);
@@ -510,6 +521,7 @@ MeterSettingsPanel::MeterSettingsPanel(CanvasModel& m) : model(m)
             applySettingsToItem(sel.front());
     };
 
+    audioSourceCombo.onChange           = commitChange;
     smoothingSlider.onValueChange      = commitChange;
     minDbSlider.onValueChange          = commitChange;
     maxDbSlider.onValueChange          = commitChange;
@@ -517,6 +529,7 @@ MeterSettingsPanel::MeterSettingsPanel(CanvasModel& m) : model(m)
     fontFamilyCombo.onChange            = commitChange;
     numBandsCombo.onChange              = commitChange;
     scaleModeCombo.onChange             = commitChange;
+    bandAnalysisCombo.onChange          = commitChange;
     colourMapCombo.onChange             = commitChange;
     scrollDirCombo.onChange             = commitChange;
     dotSizeSlider.onValueChange        = commitChange;
@@ -668,6 +681,7 @@ void MeterSettingsPanel::layoutContent()
     // Common
     positionIfVisible(fontSizeLabel, fontSizeSlider);
     positionIfVisible(fontFamilyLabel, fontFamilyCombo);
+    positionIfVisible(audioSourceLabel, audioSourceCombo);
     positionIfVisible(smoothingLabel, smoothingSlider);
     positionIfVisible(dynamicRangeLabel, minDbSlider);
     if (maxDbSlider.isVisible())
@@ -680,6 +694,7 @@ void MeterSettingsPanel::layoutContent()
     // Spectrum
     positionIfVisible(numBandsLabel, numBandsCombo);
     positionIfVisible(scaleModeLabel, scaleModeCombo);
+    positionIfVisible(bandAnalysisLabel, bandAnalysisCombo);
 
     // Spectrogram
     positionIfVisible(colourMapLabel, colourMapCombo);
@@ -814,6 +829,10 @@ void MeterSettingsPanel::showControlsForType(MeterType type)
     audioFileButton.setVisible(true);
     audioPathLabel.setVisible(true);
 
+    // Mix / stem selector for meters that can follow a stem
+    audioSourceLabel.setVisible(meterSupportsAudioSource(type));
+    audioSourceCombo.setVisible(meterSupportsAudioSource(type));
+
     switch (type)
     {
         case MeterType::MultiBandAnalyzer:
@@ -821,6 +840,7 @@ void MeterSettingsPanel::showControlsForType(MeterType type)
             dynamicRangeLabel.setVisible(true); minDbSlider.setVisible(true); maxDbSlider.setVisible(true);
             numBandsLabel.setVisible(true);    numBandsCombo.setVisible(true);
             scaleModeLabel.setVisible(true);   scaleModeCombo.setVisible(true);
+            bandAnalysisLabel.setVisible(true); bandAnalysisCombo.setVisible(true);
             break;
 
         case MeterType::Spectrogram:
@@ -1060,6 +1080,37 @@ void MeterSettingsPanel::showControlsForType(MeterType type)
 }
 
 //==============================================================================
+void MeterSettingsPanel::setAudioSources(const juce::StringArray& stemIds)
+{
+    audioSourceIds.clear();
+    audioSourceIds.add({});
+    audioSourceIds.addArray(stemIds);
+
+    audioSourceCombo.clear(juce::dontSendNotification);
+    audioSourceCombo.addItem("Mix", 1);
+    for (int i = 0; i < stemIds.size(); ++i)
+        audioSourceCombo.addItem(stemIds[i], i + 2);
+    audioSourceCombo.setSelectedId(1, juce::dontSendNotification);
+
+    refresh();
+}
+
+void MeterSettingsPanel::itemChangesBatched(const CanvasChangeSet& changes)
+{
+    // Geometry never affects meter settings, so moves are ignored
+    auto sel = model.getSelectedItems();
+    if (sel.empty())
+    {
+        if (changes.structural || !changes.removed.empty())
+            refresh();
+        return;
+    }
+
+    auto id = sel.front()->id;
+    if (changes.structural || changes.added.count(id) || changes.propertyChanged.count(id))
+        refresh();
+}
+
 void MeterSettingsPanel::refresh()
 {
     auto sel = model.getSelectedItems();
@@ -1076,6 +1127,19 @@ void MeterSettingsPanel::refresh()
     if (item->meterType != currentType)
         showControlsForType(item->meterType);
 
+    // Source: a stem that is no longer loaded still shows, so the binding
+    // is visible (the meter reads the mix until it comes back)
+    if (audioSourceCombo.isVisible())
+    {
+        if (item->audioSource.isNotEmpty() && !audioSourceIds.contains(item->audioSource))
+        {
+            audioSourceIds.add(item->audioSource);
+            audioSourceCombo.addItem(item->audioSource + " (not loaded)", audioSourceIds.size());
+        }
+        audioSourceCombo.setSelectedId(audioSourceIds.indexOf(item->audioSource) + 1,
+                                       juce::dontSendNotification);
+    }
+
     // Read current values from the component where possible
     if (!item->component) return;
 
@@ -1083,6 +1147,9 @@ void MeterSettingsPanel::refresh()
     {
         case MeterType::MultiBandAnalyzer:
             // Settings are live; sliders keep their last-set values
+            if (auto* m = dynamic_cast<MultiBandAnalyzer*>(item->component.get()))
+                bandAnalysisCombo.setSelectedId(m->getDataSource() == MultiBandAnalyzer::DataSource::FilterBank ? 2 : 1,
+                                                juce::dontSendNotification);
             break;
 
         case MeterType::Spectrogram:
@@ -1254,7 +1321,7 @@ void MeterSettingsPanel::buildDynamicControls(
             {
                 auto val = juce::var(s->getValue());
                 auto& bridge = PythonPluginBridge::getInstance();
-                if (bridge.isRunning())
+                if (bridge.isAvailable())
                     bridge.setProperty(capturedInstanceId, capturedKey, val);
                 syncPropToComponent(capturedKey, val);
             };
@@ -1272,7 +1339,7 @@ void MeterSettingsPanel::buildDynamicControls(
             {
                 auto val = juce::var(t->getToggleState());
                 auto& bridge = PythonPluginBridge::getInstance();
-                if (bridge.isRunning())
+                if (bridge.isAvailable())
                     bridge.setProperty(capturedInstanceId, capturedKey, val);
                 syncPropToComponent(capturedKey, val);
             };
@@ -1296,7 +1363,7 @@ void MeterSettingsPanel::buildDynamicControls(
                 if (sel >= 0 && sel < (int)choices.size())
                 {
                     auto& bridge = PythonPluginBridge::getInstance();
-                    if (bridge.isRunning())
+                    if (bridge.isAvailable())
                         bridge.setProperty(capturedInstanceId, capturedKey, choices[sel].first);
                     syncPropToComponent(capturedKey, choices[sel].first);
                 }
@@ -1334,7 +1401,7 @@ void MeterSettingsPanel::buildDynamicControls(
                     // Send ARGB integer to Python — Property.validate() handles int → Color
                     auto val = juce::var((juce::int64)c.getARGB());
                     auto& bridge = PythonPluginBridge::getInstance();
-                    if (bridge.isRunning())
+                    if (bridge.isAvailable())
                         bridge.setProperty(capturedInstanceId, capturedKey, val);
                     syncPropToComponent(capturedKey, val);
                 };
@@ -1354,12 +1421,24 @@ void MeterSettingsPanel::applySettingsToItem(CanvasItem* item)
 
     auto* comp = item->component.get();
 
+    // Audio source (changing it re-binds the analysis graphs)
+    if (audioSourceCombo.isVisible())
+    {
+        const auto source = audioSourceIds[audioSourceCombo.getSelectedId() - 1];
+        if (source != item->audioSource)
+        {
+            item->audioSource = source;
+            model.notifyItemPropertyChanged(item->id);
+        }
+    }
+
     switch (item->meterType)
     {
         case MeterType::MultiBandAnalyzer:
         {
             auto* m = dynamic_cast<MultiBandAnalyzer*>(comp);
             if (!m) break;
+            const int bandsPerOctave = m->getBandsPerOctave();
             m->setDecayRate(static_cast<float>(smoothingSlider.getValue()));
             m->setDynamicRange(static_cast<float>(minDbSlider.getValue()),
                                static_cast<float>(maxDbSlider.getValue()));
@@ -1375,6 +1454,15 @@ void MeterSettingsPanel::applySettingsToItem(CanvasItem* item)
             if (scaleId == 1) m->setScaleMode(MultiBandAnalyzer::ScaleMode::Logarithmic);
             else if (scaleId == 2) m->setScaleMode(MultiBandAnalyzer::ScaleMode::Linear);
             else if (scaleId == 3) m->setScaleMode(MultiBandAnalyzer::ScaleMode::Octave);
+
+            // Analysis source — the analysis graph follows it, so the model is told
+            const auto source = bandAnalysisCombo.getSelectedId() == 2 ? MultiBandAnalyzer::DataSource::FilterBank
+                                                                       : MultiBandAnalyzer::DataSource::FFT;
+            if (source != m->getDataSource() || bandsPerOctave != m->getBandsPerOctave())
+            {
+                m->setDataSource(source);
+                model.notifyItemPropertyChanged(item->id);
+            }
             break;
         }
 
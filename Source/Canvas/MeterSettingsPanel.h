@@ -37,11 +37,14 @@ public:
 
     // CanvasModelListener
     void selectionChanged() override { refresh(); }
-    void itemsChanged() override    { refresh(); }
+    void itemChangesBatched(const CanvasChangeSet& changes) override;
 
     /// Refresh displayed settings for the current selection.
     void refresh();
 
+    /// Stems audio meters can be bound to (in addition to the main mix).
+    void setAudioSources(const juce::StringArray& stemIds);
+
     //-- Callbacks set by CanvasEditor to load skin/audio --
     std::function<void(const juce::File&)> onSkinFileSelected;
     std::function<void(const juce::File&)> onAudioFileSelected;
@@ -61,6 +64,9 @@ private:
     juce::ComboBox      fontFamilyCombo;
 
     // ── Audio / Analysis Settings ──
+    juce::Label         audioSourceLabel   { {}, "Source" };
+    juce::ComboBox      audioSourceCombo;    // 1 = mix, 2.. = stems
+    juce::StringArray   audioSourceIds;      // stem id per combo entry ("" = mix)
     juce::Label         smoothingLabel     { {}, "Smoothing" };
     juce::Slider        smoothingSlider;     // decay rate dB/s
     juce::Label         dynamicRangeLabel  { {}, "Range (dB)" };
@@ -72,6 +78,8 @@ private:
     juce::ComboBox      numBandsCombo;
     juce::Label         scaleModeLabel     { {}, "Scale" };
     juce::ComboBox      scaleModeCombo;
+    juce::Label         bandAnalysisLabel  { {}, "Analysis" };
+    juce::ComboBox      bandAnalysisCombo;   // FFT bins / IEC 61260 filter bank
 
     // ── Spectrogram Settings ──
     juce::Label         colourMapLabel     { {}, "Colour Map" };
@@ -16,7 +16,7 @@ public:
     void mouseDown(const juce::MouseEvent& e) override;
     void mouseDrag(const juce::MouseEvent& e) override;
 
-    void itemsChanged() override   { repaint(); }
+    void itemChangesBatched(const CanvasChangeSet&) override { repaint(); }
     void zoomPanChanged() override { repaint(); }
 
 private:
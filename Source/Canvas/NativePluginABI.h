@@ -0,0 +1,249 @@
+#pragma once
+
+/**
+ * @file NativePluginABI.h
+ * @brief Stable C interface for native (shared library) MaxiMeter plugins.
+ *
+ * Native plugins are .dll / .so / .dylib modules placed next to the Python
+ * plugins in CustomComponents/plugins/.  They are loaded in-process by
+ * NativePluginHost and appear in the Toolbox, the Property Panel and video
+ * export exactly like Python plugins — but render without the subprocess,
+ * JSON IPC or per-frame serialisation.
+ *
+ * This header is plain C and has no JUCE dependency, so plugin authors can
+ * copy it into their own project.  A minimal plugin:
+ *
+ * @code
+ * #include "NativePluginABI.h"
+ *
+ * static const MxmManifest kManifest = {
+ *     "com.example.native_vu", "Native VU", "METER", "Fast VU meter",
+ *     "Me", "1.0.0", "meter,vu", 200, 300, NULL, 0
+ * };
+ *
+ * static void* create (void)            { return calloc (1, 1); }
+ * static void  destroy (void* self)     { free (self); }
+ * static int   render (void* self, const MxmAudioSnapshot* a,
+ *                      MxmSurface* s, const MxmCommandSink* sink)
+ * {
+ *     MxmCommand c = { MXM_CMD_FILL_RECT, 0xff00ff00u };
+ *     c.f[2] = (float) s->width;
+ *     c.f[3] = s->height * a->channels[0].rms;
+ *     sink->push (sink->context, &c);
+ *     return MXM_RENDERED_COMMANDS;
+ * }
+ *
+ * static const MxmPluginDescriptor kPlugin = {
+ *     MXM_NATIVE_ABI_VERSION, &kManifest, create, destroy, NULL, NULL, render
+ * };
+ *
+ * MXM_EXPORT const MxmPluginDescriptor* maximeter_get_plugin (uint32_t hostAbi, int32_t index)
+ * {
+ *     return (hostAbi >= MXM_NATIVE_ABI_VERSION && index == 0) ? &kPlugin : NULL;
+ * }
+ * @endcode
+ *
+ * Compatibility rules: fields are only ever appended to the end of a struct,
+ * and every struct passed from host to plugin starts with its size so a
+ * plugin built against an older header can ignore newer fields.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+  #define MXM_EXPORT __declspec(dllexport)
+#else
+  #define MXM_EXPORT __attribute__((visibility("default")))
+#endif
+
+/** Bumped only on incompatible changes. */
+#define MXM_NATIVE_ABI_VERSION 1
+
+/** Name of the symbol the host looks up in every module. */
+#define MXM_ENTRY_POINT_NAME "maximeter_get_plugin"
+
+//==============================================================================
+// Analysis snapshot (host → plugin, read-only, valid for one render call)
+//==============================================================================
+
+#define MXM_MAX_CHANNELS 8
+
+typedef struct MxmChannelLevels
+{
+    float rms;          /**< linear 0..1 */
+    float peak;         /**< linear 0..1 */
+    float truePeak;     /**< linear 0..1 */
+} MxmChannelLevels;
+
+typedef struct MxmAudioSnapshot
+{
+    uint32_t         structSize;
+    float            sampleRate;
+    int32_t          numChannels;
+    int32_t          isPlaying;
+    float            position;          /**< seconds */
+    float            duration;          /**< seconds */
+    MxmChannelLevels channels[MXM_MAX_CHANNELS];
+
+    float            lufsMomentary;
+    float            lufsShortTerm;
+    float            lufsIntegrated;
+    float            loudnessRange;
+    float            correlation;       /**< -1..1 */
+
+    const float*     spectrum;          /**< linear magnitudes, spectrumSize bins */
+    int32_t          spectrumSize;
+    int32_t          fftSize;
+    const float*     waveform;          /**< mono samples, waveformSize long */
+    int32_t          waveformSize;
+
+    uint32_t         bgColour;          /**< meter background, 0xAARRGGBB */
+    uint32_t         fgColour;          /**< meter foreground, 0xAARRGGBB */
+} MxmAudioSnapshot;
+
+//==============================================================================
+// Drawing targets
+//==============================================================================
+
+/** Raw pixel target: premultiplied BGRA, 8 bits per channel, top-down rows.
+    Cleared to transparent by the host before every render call. */
+typedef struct MxmSurface
+{
+    uint32_t structSize;
+    uint8_t* pixels;
+    int32_t  width;
+    int32_t  height;
+    int32_t  lineStride;                /**< bytes between rows */
+} MxmSurface;
+
+/** Typed command — the native mirror of the Python RenderContext calls. */
+typedef enum MxmCmdType
+{
+    MXM_CMD_CLEAR = 0,                  /**< colour */
+    MXM_CMD_FILL_RECT,                  /**< f: x y w h */
+    MXM_CMD_STROKE_RECT,                /**< f: x y w h thickness */
+    MXM_CMD_FILL_ROUNDED_RECT,          /**< f: x y w h radius */
+    MXM_CMD_STROKE_ROUNDED_RECT,        /**< f: x y w h radius thickness */
+    MXM_CMD_FILL_ELLIPSE,               /**< f: cx cy rx ry */
+    MXM_CMD_STROKE_ELLIPSE,             /**< f: cx cy rx ry thickness */
+    MXM_CMD_DRAW_LINE,                  /**< f: x1 y1 x2 y2 thickness */
+    MXM_CMD_FILL_CIRCLE,                /**< f: cx cy radius */
+    MXM_CMD_STROKE_CIRCLE,              /**< f: cx cy radius thickness */
+    MXM_CMD_DRAW_ARC,                   /**< f: cx cy radius start end thickness */
+    MXM_CMD_FILL_ARC,                   /**< f: cx cy radius start end */
+    MXM_CMD_DRAW_POLYLINE,              /**< points; f: thickness */
+    MXM_CMD_FILL_POLYGON,               /**< points */
+    MXM_CMD_DRAW_TEXT,                  /**< text; f: x y w h fontSize align(0 l, 1 c, 2 r) */
+    MXM_CMD_SET_CLIP,                   /**< f: x y w h */
+    MXM_CMD_RESET_CLIP,
+    MXM_CMD_SET_OPACITY,                /**< f: opacity */
+    MXM_CMD_SAVE_STATE,
+    MXM_CMD_RESTORE_STATE,
+} MxmCmdType;
+
+typedef struct MxmCommand
+{
+    int32_t      type;                  /**< MxmCmdType */
+    uint32_t     colour;                /**< 0xAARRGGBB */
+    float        f[8];                  /**< per-type scalars, see MxmCmdType */
+    const float* points;                /**< interleaved x,y pairs (copied by host) */
+    int32_t      numPoints;
+    const char*  text;                  /**< UTF-8 (copied by host) */
+} MxmCommand;
+
+/** Sink passed to render(); push() copies the command immediately. */
+typedef struct MxmCommandSink
+{
+    uint32_t structSize;
+    void*    context;
+    void   (*push)(void* context, const MxmCommand* command);
+} MxmCommandSink;
+
+/** render() return flags — which targets the plugin wrote to.
+    When both are set the surface is composited beneath the commands. */
+#define MXM_RENDERED_COMMANDS 1
+#define MXM_RENDERED_SURFACE  2
+
+//==============================================================================
+// Manifest & properties (mirror CustomPluginManifest / CustomPluginProperty)
+//==============================================================================
+
+typedef struct MxmPropertyDesc
+{
+    const char* key;
+    const char* label;
+    const char* type;                   /**< "INT", "FLOAT", "BOOL", "STRING", "COLOR", "ENUM", "RANGE" */
+    const char* group;
+    const char* description;
+    double      defaultNumber;          /**< INT / FLOAT / BOOL / COLOR (0xAARRGGBB) / RANGE */
+    const char* defaultString;          /**< STRING / ENUM */
+    float       minVal;
+    float       maxVal;
+    float       step;
+    const char* choices;                /**< ENUM: "value:Label|value:Label|..." */
+} MxmPropertyDesc;
+
+typedef struct MxmManifest
+{
+    const char*            id;
+    const char*            name;
+    const char*            category;
+    const char*            description;
+    const char*            author;
+    const char*            version;
+    const char*            tags;        /**< comma-separated */
+    int32_t                defaultWidth;
+    int32_t                defaultHeight;
+    const MxmPropertyDesc* properties;
+    int32_t                numProperties;
+} MxmManifest;
+
+typedef enum MxmValueKind
+{
+    MXM_VALUE_NUMBER = 0,
+    MXM_VALUE_BOOL,
+    MXM_VALUE_STRING,
+} MxmValueKind;
+
+typedef struct MxmValue
+{
+    int32_t     kind;                   /**< MxmValueKind */
+    double      number;                 /**< NUMBER / BOOL (0 or 1) */
+    const char* string;                 /**< STRING, valid for the call only */
+} MxmValue;
+
+//==============================================================================
+// Plugin descriptor
+//==============================================================================
+
+typedef struct MxmPluginDescriptor
+{
+    uint32_t           abiVersion;      /**< MXM_NATIVE_ABI_VERSION the plugin was built with */
+    const MxmManifest* manifest;
+
+    void* (*create)(void);
+    void  (*destroy)(void* self);
+
+    /** Optional (may be NULL). */
+    void  (*setProperty)(void* self, const char* key, const MxmValue* value);
+
+    /** Optional (may be NULL). */
+    void  (*resize)(void* self, int32_t width, int32_t height);
+
+    /** Draw one frame into the surface and/or the command sink.
+        Returns a combination of MXM_RENDERED_* flags. */
+    int32_t (*render)(void* self, const MxmAudioSnapshot* audio,
+                      MxmSurface* surface, const MxmCommandSink* sink);
+} MxmPluginDescriptor;
+
+/** Module entry point.  Called with index 0, 1, 2, ... until it returns
+    NULL, so one module may export several plugins. */
+typedef const MxmPluginDescriptor* (*MxmGetPluginFn)(uint32_t hostAbiVersion, int32_t index);
+
+#ifdef __cplusplus
+}
+#endif
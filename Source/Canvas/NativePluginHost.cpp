@@ -0,0 +1,434 @@
+#include "NativePluginHost.h"
+#include "../UI/DebugLogWindow.h"
+
+//==============================================================================
+NativePluginHost& NativePluginHost::getInstance()
+{
+    static NativePluginHost instance;
+    return instance;
+}
+
+NativePluginHost::~NativePluginHost()
+{
+    // Instances must go before the libraries that own their code.
+    for (auto& [id, inst] : instances)
+        release(*inst);
+    instances.clear();
+    modules.clear();
+}
+
+juce::String NativePluginHost::getModuleWildcard()
+{
+#if JUCE_WINDOWS
+    return "*.dll";
+#elif JUCE_MAC
+    return "*.dylib";
+#else
+    return "*.so";
+#endif
+}
+
+//==============================================================================
+void NativePluginHost::scan(const juce::File& pluginsDir)
+{
+    if (!pluginsDir.isDirectory()) return;
+
+    const juce::ScopedLock sl(lock);
+
+    for (auto& f : pluginsDir.findChildFiles(juce::File::findFiles, false, getModuleWildcard()))
+    {
+        if (f.getFileName().startsWith("_"))
+            continue;
+
+        bool alreadyLoaded = false;
+        for (auto& m : modules)
+            if (m->file == f) { alreadyLoaded = true; break; }
+        if (alreadyLoaded) continue;
+
+        auto module = std::make_unique<Module>();
+        module->file    = f;
+        module->library = std::make_unique<juce::DynamicLibrary>();
+
+        if (!module->library->open(f.getFullPathName()))
+        {
+            MAXIMETER_LOG("NATIVE", "Could not load " + f.getFileName());
+            continue;
+        }
+
+        auto getPlugin = reinterpret_cast<MxmGetPluginFn>(
+            module->library->getFunction(MXM_ENTRY_POINT_NAME));
+        if (getPlugin == nullptr)
+        {
+            MAXIMETER_LOG("NATIVE", f.getFileName() + " has no " MXM_ENTRY_POINT_NAME " export");
+            continue;
+        }
+
+        for (int32_t index = 0; index < 64; ++index)
+        {
+            auto* desc = getPlugin(MXM_NATIVE_ABI_VERSION, index);
+            if (desc == nullptr) break;
+
+            if (desc->abiVersion != MXM_NATIVE_ABI_VERSION
+                || desc->manifest == nullptr || desc->manifest->id == nullptr
+                || desc->create == nullptr || desc->render == nullptr)
+            {
+                MAXIMETER_LOG("NATIVE", f.getFileName() + " plugin #" + juce::String(index)
+                              + " rejected (ABI " + juce::String((int)desc->abiVersion) + ")");
+                continue;
+            }
+
+            module->plugins.push_back(desc);
+            MAXIMETER_LOG("NATIVE", "  Plugin: " + juce::String::fromUTF8(desc->manifest->name)
+                          + " [" + juce::String::fromUTF8(desc->manifest->id) + "]  src="
+                          + f.getFileNameWithoutExtension());
+        }
+
+        if (!module->plugins.empty())
+            modules.push_back(std::move(module));
+    }
+}
+
+bool NativePluginHost::hasModules() const
+{
+    const juce::ScopedLock sl(lock);
+    return !modules.empty();
+}
+
+std::vector<CustomPluginManifest> NativePluginHost::getManifests() const
+{
+    const juce::ScopedLock sl(lock);
+
+    std::vector<CustomPluginManifest> result;
+    for (auto& m : modules)
+        for (auto* desc : m->plugins)
+            result.push_back(toManifest(*desc->manifest, m->file));
+    return result;
+}
+
+bool NativePluginHost::hasManifest(const juce::String& manifestId) const
+{
+    const juce::ScopedLock sl(lock);
+    return findDescriptor(manifestId) != nullptr;
+}
+
+bool NativePluginHost::ownsInstance(const juce::String& instanceId) const
+{
+    const juce::ScopedLock sl(lock);
+    return instances.find(instanceId) != instances.end();
+}
+
+//==============================================================================
+std::optional<std::vector<CustomPluginProperty>> NativePluginHost::createInstance(
+    const juce::String& manifestId, const juce::String& instanceId)
+{
+    const MxmPluginDescriptor* desc = nullptr;
+    std::shared_ptr<Instance> previous;
+    {
+        const juce::ScopedLock sl(lock);
+
+        desc = findDescriptor(manifestId);
+        if (desc == nullptr) return std::nullopt;
+
+        // Re-create replaces any previous instance with the same id.
+        if (auto it = instances.find(instanceId); it != instances.end())
+        {
+            previous = std::move(it->second);
+            instances.erase(it);
+        }
+    }
+
+    if (previous != nullptr)
+        release(*previous);
+
+    auto inst = std::make_shared<Instance>();
+    inst->desc   = desc;
+    inst->handle = desc->create();
+    if (inst->handle == nullptr)
+    {
+        MAXIMETER_LOG("ERROR", "Native createInstance FAILED for " + manifestId);
+        return std::nullopt;
+    }
+
+    std::vector<CustomPluginProperty> props;
+    for (int32_t i = 0; i < desc->manifest->numProperties; ++i)
+        props.push_back(toProperty(desc->manifest->properties[i]));
+
+    {
+        const juce::ScopedLock sl(lock);
+        instances[instanceId] = std::move(inst);
+    }
+    MAXIMETER_LOG("INSTANCE", "Native createInstance OK: " + manifestId + " / " + instanceId);
+    return props;
+}
+
+void NativePluginHost::destroyInstance(const juce::String& instanceId)
+{
+    std::shared_ptr<Instance> inst;
+    {
+        const juce::ScopedLock sl(lock);
+
+        auto it = instances.find(instanceId);
+        if (it == instances.end()) return;
+
+        inst = std::move(it->second);
+        instances.erase(it);
+    }
+
+    release(*inst);
+}
+
+std::shared_ptr<NativePluginHost::Instance> NativePluginHost::findInstance(const juce::String& instanceId) const
+{
+    const juce::ScopedLock sl(lock);
+    auto it = instances.find(instanceId);
+    return it != instances.end() ? it->second : nullptr;
+}
+
+void NativePluginHost::release(Instance& inst)
+{
+    // Waits for a render still running on another thread
+    const juce::ScopedLock sl(inst.lock);
+    if (inst.desc->destroy && inst.handle)
+        inst.desc->destroy(inst.handle);
+    inst.handle = nullptr;
+}
+
+//==============================================================================
+PluginRenderResult NativePluginHost::renderInstance(
+    const juce::String& instanceId, int width, int height, const MxmAudioSnapshot& audio)
+{
+    PluginRenderResult result;
+
+    auto inst = findInstance(instanceId);
+    if (inst == nullptr) return result;
+
+    const juce::ScopedLock sl(inst->lock);
+    if (inst->handle == nullptr) return result;
+
+    result.rendered = true;
+    if (width <= 0 || height <= 0) return result;
+
+    auto& commands = result.commands;
+    auto* holder = acquireSurface(*inst, width, height);
+    holder->image.clear(holder->image.getBounds());
+
+    int32_t flags = 0;
+    {
+        juce::Image::BitmapData bmp(holder->image, juce::Image::BitmapData::readWrite);
+
+        MxmSurface surface {};
+        surface.structSize = sizeof(MxmSurface);
+        surface.pixels     = bmp.data;
+        surface.width      = width;
+        surface.height     = height;
+        surface.lineStride = bmp.lineStride;
+
+        MxmCommandSink sink { sizeof(MxmCommandSink), &commands, &NativePluginHost::pushCommand };
+        flags = inst->desc->render(inst->handle, &audio, &surface, &sink);
+    }
+
+    // The pixel surface sits beneath any typed commands.
+    if ((flags & MXM_RENDERED_SURFACE) != 0)
+    {
+        juce::DynamicObject::Ptr params = new juce::DynamicObject();
+        params->setProperty("x", 0);
+        params->setProperty("y", 0);
+        params->setProperty("image", juce::var(holder));
+        commands.insert(commands.begin(),
+                        PluginRender::RenderCommand { PluginRender::CmdType::BlitImage, juce::var(params.get()) });
+    }
+
+    return result;
+}
+
+void NativePluginHost::setProperty(const juce::String& instanceId, const juce::String& key,
+                                   const juce::var& value)
+{
+    auto inst = findInstance(instanceId);
+    if (inst == nullptr || inst->desc->setProperty == nullptr) return;
+
+    MxmValue v {};
+    juce::String str;
+    if (value.isBool())
+    {
+        v.kind   = MXM_VALUE_BOOL;
+        v.number = (bool)value ? 1.0 : 0.0;
+    }
+    else if (value.isString())
+    {
+        str      = value.toString();
+        v.kind   = MXM_VALUE_STRING;
+        v.string = str.toRawUTF8();
+    }
+    else
+    {
+        v.kind   = MXM_VALUE_NUMBER;
+        v.number = (double)value;
+    }
+
+    const juce::ScopedLock sl(inst->lock);
+    if (inst->handle != nullptr)
+        inst->desc->setProperty(inst->handle, key.toRawUTF8(), &v);
+}
+
+void NativePluginHost::notifyResize(const juce::String& instanceId, int width, int height)
+{
+    auto inst = findInstance(instanceId);
+    if (inst == nullptr || inst->desc->resize == nullptr) return;
+
+    const juce::ScopedLock sl(inst->lock);
+    if (inst->handle != nullptr)
+        inst->desc->resize(inst->handle, width, height);
+}
+
+//==============================================================================
+const MxmPluginDescriptor* NativePluginHost::findDescriptor(const juce::String& manifestId) const
+{
+    for (auto& m : modules)
+        for (auto* desc : m->plugins)
+            if (manifestId == juce::String::fromUTF8(desc->manifest->id))
+                return desc;
+    return nullptr;
+}
+
+CustomPluginManifest NativePluginHost::toManifest(const MxmManifest& m, const juce::File& file)
+{
+    CustomPluginManifest result;
+    result.id          = juce::String::fromUTF8(m.id);
+    result.name        = juce::String::fromUTF8(m.name);
+    result.category    = juce::String::fromUTF8(m.category);
+    result.description = juce::String::fromUTF8(m.description);
+    result.author      = juce::String::fromUTF8(m.author);
+    result.version     = juce::String::fromUTF8(m.version);
+    result.sourceFile  = file.getFileNameWithoutExtension();
+    if (m.defaultWidth  > 0) result.defaultWidth  = m.defaultWidth;
+    if (m.defaultHeight > 0) result.defaultHeight = m.defaultHeight;
+    result.tags.addTokens(juce::String::fromUTF8(m.tags), ",", "");
+    result.tags.trim();
+    result.tags.removeEmptyStrings();
+    return result;
+}
+
+CustomPluginProperty NativePluginHost::toProperty(const MxmPropertyDesc& d)
+{
+    CustomPluginProperty p;
+    p.key         = juce::String::fromUTF8(d.key);
+    p.label       = juce::String::fromUTF8(d.label);
+    p.type        = juce::String::fromUTF8(d.type).toUpperCase();
+    p.group       = juce::String::fromUTF8(d.group);
+    p.description = juce::String::fromUTF8(d.description);
+    p.minVal      = d.minVal;
+    p.maxVal      = d.maxVal;
+    p.step        = d.step;
+
+    if (p.type == "STRING" || p.type == "ENUM")
+        p.defaultVal = juce::String::fromUTF8(d.defaultString);
+    else if (p.type == "BOOL")
+        p.defaultVal = d.defaultNumber != 0.0;
+    else if (p.type == "INT" || p.type == "COLOR")
+        p.defaultVal = (juce::int64)d.defaultNumber;
+    else
+        p.defaultVal = d.defaultNumber;
+
+    // ENUM choices: "value:Label|value:Label"
+    for (auto& choice : juce::StringArray::fromTokens(juce::String::fromUTF8(d.choices), "|", ""))
+    {
+        if (choice.isEmpty()) continue;
+        auto value = choice.upToFirstOccurrenceOf(":", false, false);
+        auto label = choice.contains(":") ? choice.fromFirstOccurrenceOf(":", false, false) : value;
+        p.choices.add({ value, label });
+    }
+
+    return p;
+}
+
+//==============================================================================
+PluginRender::ImageHolder* NativePluginHost::acquireSurface(Instance& inst, int width, int height)
+{
+    // Reuse a surface nobody else references any more (a previous frame's
+    // commands may still be queued for painting elsewhere).
+    for (int i = inst.surfaces.size(); --i >= 0;)
+    {
+        auto* s = inst.surfaces.getUnchecked(i);
+        if (s->getReferenceCount() > 1) continue;
+
+        if (s->image.getWidth() == width && s->image.getHeight() == height)
+            return s;
+
+        inst.surfaces.remove(i);
+    }
+
+    auto* s = new PluginRender::ImageHolder();
+    s->image = juce::Image(juce::Image::ARGB, width, height, true, juce::SoftwareImageType());
+    inst.surfaces.add(s);
+    return s;
+}
+
+void NativePluginHost::pushCommand(void* context, const MxmCommand* c)
+{
+    if (context == nullptr || c == nullptr) return;
+    auto& out = *static_cast<std::vector<PluginRender::RenderCommand>*>(context);
+
+    using PluginRender::CmdType;
+    juce::DynamicObject::Ptr p = new juce::DynamicObject();
+    p->setProperty("color", (juce::int64)c->colour);
+
+    auto set = [&p, c](std::initializer_list<const char*> names)
+    {
+        int i = 0;
+        for (auto* n : names)
+            p->setProperty(n, c->f[i++]);
+    };
+
+    auto points = [&p, c]()
+    {
+        juce::Array<juce::var> pts;
+        for (int32_t i = 0; c->points != nullptr && i < c->numPoints; ++i)
+            pts.add(juce::Array<juce::var> { c->points[i * 2], c->points[i * 2 + 1] });
+        p->setProperty("points", pts);
+    };
+
+    CmdType type;
+    switch (c->type)
+    {
+        case MXM_CMD_CLEAR:               type = CmdType::Clear; break;
+        case MXM_CMD_FILL_RECT:           type = CmdType::FillRect;          set({ "x", "y", "w", "h" }); break;
+        case MXM_CMD_STROKE_RECT:         type = CmdType::StrokeRect;        set({ "x", "y", "w", "h", "thickness" }); break;
+        case MXM_CMD_FILL_ROUNDED_RECT:   type = CmdType::FillRoundedRect;   set({ "x", "y", "w", "h", "radius" }); break;
+        case MXM_CMD_STROKE_ROUNDED_RECT: type = CmdType::StrokeRoundedRect; set({ "x", "y", "w", "h", "radius", "thickness" }); break;
+        case MXM_CMD_FILL_ELLIPSE:        type = CmdType::FillEllipse;       set({ "cx", "cy", "rx", "ry" }); break;
+        case MXM_CMD_STROKE_ELLIPSE:      type = CmdType::StrokeEllipse;     set({ "cx", "cy", "rx", "ry", "thickness" }); break;
+        case MXM_CMD_DRAW_LINE:           type = CmdType::DrawLine;          set({ "x1", "y1", "x2", "y2", "thickness" }); break;
+        case MXM_CMD_FILL_CIRCLE:         type = CmdType::FillCircle;        set({ "cx", "cy", "radius" }); break;
+        case MXM_CMD_STROKE_CIRCLE:       type = CmdType::StrokeCircle;      set({ "cx", "cy", "radius", "thickness" }); break;
+        case MXM_CMD_DRAW_ARC:            type = CmdType::DrawArc;           set({ "cx", "cy", "radius", "start", "end", "thickness" }); break;
+        case MXM_CMD_FILL_ARC:            type = CmdType::FillArc;           set({ "cx", "cy", "radius", "start", "end" }); break;
+        case MXM_CMD_DRAW_POLYLINE:       type = CmdType::DrawPolyline;      set({ "thickness" }); points(); break;
+        case MXM_CMD_FILL_POLYGON:        type = CmdType::FillPath;          points(); break;
+        case MXM_CMD_SET_CLIP:            type = CmdType::SetClip;           set({ "x", "y", "w", "h" }); break;
+        case MXM_CMD_RESET_CLIP:          type = CmdType::ResetClip; break;
+        case MXM_CMD_SET_OPACITY:         type = CmdType::SetOpacity;        set({ "opacity" }); break;
+        case MXM_CMD_SAVE_STATE:          type = CmdType::SaveState; break;
+        case MXM_CMD_RESTORE_STATE:       type = CmdType::RestoreState; break;
+
+        case MXM_CMD_DRAW_TEXT:
+        {
+            type = CmdType::DrawText;
+            set({ "x", "y", "w", "h" });
+            p->setProperty("text", juce::String::fromUTF8(c->text != nullptr ? c->text : ""));
+
+            juce::DynamicObject::Ptr font = new juce::DynamicObject();
+            font->setProperty("size", c->f[4] > 0.0f ? c->f[4] : 12.0f);
+            p->setProperty("font", juce::var(font.get()));
+
+            const int align = (int)c->f[5];
+            p->setProperty("align", align == 1 ? "center" : align == 2 ? "right" : "left");
+            break;
+        }
+
+        default:
+            return;  // unknown command from a newer plugin — ignore
+    }
+
+    out.push_back({ type, juce::var(p.get()) });
+}
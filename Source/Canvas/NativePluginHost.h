@@ -0,0 +1,102 @@
+#pragma once
+
+/**
+ * @file NativePluginHost.h
+ * @brief Loads native (shared library) plugins that implement NativePluginABI.h.
+ *
+ * Native modules live next to the Python plugins and are routed through
+ * PythonPluginBridge, so the Toolbox, CustomPluginComponent and
+ * OfflineRenderer do not need to know which runtime serves an instance.
+ *
+ * The host lock only guards the module list and the instance map; each
+ * instance has its own lock, so different instances render concurrently
+ * while calls into one instance stay serialised.
+ */
+
+#include <JuceHeader.h>
+#include "NativePluginABI.h"
+#include "PythonPluginBridge.h"
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+//==============================================================================
+class NativePluginHost
+{
+public:
+    static NativePluginHost& getInstance();
+
+    /// File pattern used to find native modules in a plugins directory.
+    static juce::String getModuleWildcard();
+
+    //-- Discovery -----------------------------------------------------------
+
+    /// Load every native module in @p pluginsDir that is not already loaded.
+    /// Modules are never unloaded while the app runs (instances may be live).
+    void scan(const juce::File& pluginsDir);
+
+    bool hasModules() const;
+    std::vector<CustomPluginManifest> getManifests() const;
+    bool hasManifest(const juce::String& manifestId) const;
+    bool ownsInstance(const juce::String& instanceId) const;
+
+    //-- Instance management -------------------------------------------------
+
+    /// @return Property descriptors (possibly none), or std::nullopt if
+    ///         @p manifestId is unknown or the plugin's create() failed.
+    std::optional<std::vector<CustomPluginProperty>> createInstance(const juce::String& manifestId,
+                                                                    const juce::String& instanceId);
+    void destroyInstance(const juce::String& instanceId);
+
+    //-- Rendering -----------------------------------------------------------
+
+    /// Render one frame against @p audio (colours already filled in).
+    /// Not rendered if the instance is unknown or was destroyed meanwhile.
+    PluginRenderResult renderInstance(const juce::String& instanceId,
+                                      int width, int height,
+                                      const MxmAudioSnapshot& audio);
+
+    void setProperty(const juce::String& instanceId, const juce::String& key,
+                     const juce::var& value);
+    void notifyResize(const juce::String& instanceId, int width, int height);
+
+private:
+    NativePluginHost() = default;
+    ~NativePluginHost();
+
+    struct Module
+    {
+        juce::File                                file;
+        std::unique_ptr<juce::DynamicLibrary>     library;
+        std::vector<const MxmPluginDescriptor*>   plugins;
+    };
+
+    struct Instance
+    {
+        juce::CriticalSection      lock;            ///< serialises calls into @c handle
+        const MxmPluginDescriptor* desc   = nullptr;
+        void*                      handle = nullptr; ///< null once destroyed
+
+        // Scratch reused across frames
+        juce::ReferenceCountedArray<PluginRender::ImageHolder> surfaces;
+    };
+
+    /// The instance registered as @p instanceId, or nullptr.
+    std::shared_ptr<Instance> findInstance(const juce::String& instanceId) const;
+
+    /// Destroy the plugin object once no call into it is running.
+    static void release(Instance& inst);
+
+    const MxmPluginDescriptor* findDescriptor(const juce::String& manifestId) const;
+    static CustomPluginManifest toManifest(const MxmManifest& m, const juce::File& file);
+    static CustomPluginProperty toProperty(const MxmPropertyDesc& d);
+    static PluginRender::ImageHolder* acquireSurface(Instance& inst, int width, int height);
+    static void pushCommand(void* context, const MxmCommand* command);
+
+    mutable juce::CriticalSection                      lock;    ///< modules and the instance map
+    std::vector<std::unique_ptr<Module>>               modules;
+    std::map<juce::String, std::shared_ptr<Instance>>  instances;
+
+    JUCE_DECLARE_NON_COPYABLE(NativePluginHost)
+};
@@ -0,0 +1,124 @@
+#include "PluginRenderBatcher.h"
+#include <algorithm>
+
+//==============================================================================
+PluginRenderBatcher::PluginRenderBatcher()
+    : juce::Thread("PluginRenderBatcher")
+{
+    startThread(juce::Thread::Priority::normal);
+}
+
+PluginRenderBatcher::~PluginRenderBatcher()
+{
+    signalThreadShouldExit();
+    wakeUp_.signal();
+    stopThread(2000);
+}
+
+//==============================================================================
+void PluginRenderBatcher::post(const PluginRenderRequest& request)
+{
+    if (busy_.load())
+        return;
+
+    const juce::ScopedLock sl(lock_);
+    for (auto& r : pending_)
+    {
+        if (r.instanceId == request.instanceId)
+        {
+            r = request;
+            return;
+        }
+    }
+    pending_.push_back(request);
+}
+
+void PluginRenderBatcher::submitFrame(std::shared_ptr<const PluginAudioFrame> audio)
+{
+    {
+        const juce::ScopedLock sl(lock_);
+        if (pending_.empty() || busy_.load() || audio == nullptr)
+            return;
+
+        inFlight_.swap(pending_);
+        pending_.clear();
+        inFlightAudio_ = std::move(audio);
+        busy_.store(true);
+    }
+    wakeUp_.signal();
+}
+
+bool PluginRenderBatcher::fetchResult(const juce::String& instanceId, PluginRenderResult& out)
+{
+    const juce::ScopedLock sl(lock_);
+    auto it = results_.find(instanceId);
+    if (it == results_.end())
+        return false;
+
+    out = std::move(it->second.result);
+    results_.erase(it);
+    return true;
+}
+
+void PluginRenderBatcher::forget(const juce::String& instanceId)
+{
+    const juce::ScopedLock sl(lock_);
+    results_.erase(instanceId);
+    pending_.erase(std::remove_if(pending_.begin(), pending_.end(),
+                                  [&](const PluginRenderRequest& r) { return r.instanceId == instanceId; }),
+                   pending_.end());
+}
+
+//==============================================================================
+void PluginRenderBatcher::run()
+{
+    while (!threadShouldExit())
+    {
+        wakeUp_.wait(-1);
+        if (threadShouldExit()) break;
+
+        std::vector<PluginRenderRequest> requests;
+        std::shared_ptr<const PluginAudioFrame> audio;
+        {
+            const juce::ScopedLock sl(lock_);
+            if (!busy_.load()) continue;
+            requests.swap(inFlight_);
+            audio = std::move(inFlightAudio_);
+        }
+
+        // One bridge call for the whole frame — this is the blocking part
+        std::vector<PluginRenderResult> batch;
+        try
+        {
+            auto& bridge = PythonPluginBridge::getInstance();
+            if (bridge.isAvailable())
+                batch = bridge.renderBatch(requests, *audio);
+        }
+        catch (...)
+        {
+            DBG("PluginRenderBatcher: renderBatch threw an exception");
+            batch.clear();
+        }
+        audio.reset();   // MeterFactory reuses the frame once nobody holds it
+
+        {
+            const juce::ScopedLock sl(lock_);
+            ++batchCount_;
+
+            // No bridge, no verdict: store nothing rather than failures
+            if (batch.size() == requests.size())
+                for (size_t i = 0; i < requests.size(); ++i)
+                    results_[requests[i].instanceId] = { std::move(batch[i]), batchCount_ };
+
+            for (auto it = results_.begin(); it != results_.end();)
+            {
+                if (batchCount_ - it->second.batch > 1)
+                    it = results_.erase(it);
+                else
+                    ++it;
+            }
+
+            busy_.store(false);
+        }
+    }
+}
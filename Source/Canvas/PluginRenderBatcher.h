@@ -0,0 +1,77 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "PythonPluginBridge.h"
+#include "PluginRenderReplayer.h"
+#include <map>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+ * Collects the live canvas's plugin render requests for one frame and sends
+ * them to the bridge as a single PythonPluginBridge::renderBatch() call on a
+ * background thread.
+ *
+ * Message thread, once per frame:
+ *   1. every CustomPluginComponent calls fetchResult() then post()
+ *   2. MeterFactory calls submitFrame() with the shared PluginAudioFrame
+ *
+ * While a batch is in flight new posts are ignored (the frame is skipped),
+ * exactly like the per-component workers this replaces.  A result nobody
+ * fetched by the end of the next batch belongs to an instance that stopped
+ * posting (culled or deleted) and is dropped.
+ */
+class PluginRenderBatcher : private juce::Thread
+{
+public:
+    static PluginRenderBatcher& getInstance()
+    {
+        static PluginRenderBatcher instance;
+        return instance;
+    }
+
+    /// Queue @p request for the next submitted frame (replaces an earlier
+    /// request for the same instance).
+    void post(const PluginRenderRequest& request);
+
+    /// Send everything posted since the last frame, sharing @p audio.  The
+    /// frame is held until the batch finishes, then released.
+    void submitFrame(std::shared_ptr<const PluginAudioFrame> audio);
+
+    /// True while a batch is being rendered.
+    bool isBusy() const { return busy_.load(); }
+
+    /// Take the latest completed render for @p instanceId, if one arrived
+    /// since the previous call.  Nothing arrives while the bridge is
+    /// unavailable, so that is not mistaken for a lost instance.
+    bool fetchResult(const juce::String& instanceId, PluginRenderResult& out);
+
+    /// Drop pending requests and results for a destroyed instance.
+    void forget(const juce::String& instanceId);
+
+private:
+    PluginRenderBatcher();
+    ~PluginRenderBatcher() override;
+
+    void run() override;
+
+    juce::CriticalSection            lock_;
+    std::vector<PluginRenderRequest> pending_;      ///< being collected (message thread)
+    std::vector<PluginRenderRequest> inFlight_;     ///< handed to the worker
+    std::shared_ptr<const PluginAudioFrame> inFlightAudio_;
+
+    struct StoredResult
+    {
+        PluginRenderResult result;
+        juce::uint32       batch = 0;     ///< batchCount_ when it was stored
+    };
+
+    std::map<juce::String, StoredResult> results_;
+    juce::uint32                         batchCount_ = 0;
+
+    std::atomic<bool>   busy_ { false };
+    juce::WaitableEvent wakeUp_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginRenderBatcher)
+};
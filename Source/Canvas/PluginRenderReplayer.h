@@ -5,11 +5,13 @@
  * @brief Replays render commands from the Python bridge through juce::Graphics.
  *
  * After calling PythonPluginBridge::renderInstance(), pass the resulting
- * command list to PluginRenderReplayer::replay() inside your Component::paint().
+ * commands to PluginRenderReplayer::replay() inside your Component::paint().
  */
 
 #include <JuceHeader.h>
 #include "PythonPluginBridge.h"
+#include "../UI/PolylineRasteriser.h"
+#include "../UI/SpriteSplatter.h"
 #include <vector>
 
 namespace PluginRenderReplayer
@@ -21,13 +23,20 @@ namespace PluginRenderReplayer
      *
      * @code
      * void paint(juce::Graphics& g) override {
-     *     auto cmds = bridge.renderInstance(instanceId, getWidth(), getHeight(), audioJson);
-     *     PluginRenderReplayer::replay(g, cmds);
+     *     auto result = bridge.renderInstance(request, audioFrame);
+     *     PluginRenderReplayer::replay(g, result.commands);
      * }
      * @endcode
+     *
+     * With @p polylines, dense polylines whose x never decreases are drawn by
+     * that PolylineRasteriser instead of being stroked as paths.  With
+     * @p sprites, DrawPoints batches are splatted in one blit instead of one
+     * fillEllipse per dot.
      */
     inline void replay(juce::Graphics& g,
-                        const std::vector<PluginRender::RenderCommand>& commands)
+                        const std::vector<PluginRender::RenderCommand>& commands,
+                        PolylineRasteriser* polylines = nullptr,
+                        SpriteSplatter* sprites = nullptr)
     {
         for (auto& cmd : commands)
         {
@@ -258,6 +267,26 @@ namespace PluginRenderReplayer
                     auto* pts = p["points"].getArray();
                     if (pts && pts->size() > 1)
                     {
+                        const juce::Colour colour(static_cast<juce::uint32>((int64_t)p["color"]));
+
+                        // Dense traces (spectra, scopes) go through the span
+                        // rasteriser; anything else is stroked as a path.
+                        static constexpr int kMinRasterPoints = 32;
+                        if (polylines != nullptr && pts->size() >= kMinRasterPoints)
+                        {
+                            std::vector<juce::Point<float>> points(static_cast<size_t>(pts->size()));
+                            for (int i = 0; i < pts->size(); ++i)
+                            {
+                                auto pt = (*pts)[i];
+                                points[static_cast<size_t>(i)] = { (float)pt[0], (float)pt[1] };
+                            }
+                            if (PolylineRasteriser::isMonotonicX(points.data(), pts->size()))
+                            {
+                                polylines->draw(g, points, (float)p["thickness"], colour);
+                                break;
+                            }
+                        }
+
                         juce::Path path;
                         auto first = (*pts)[0];
                         path.startNewSubPath((float)first[0], (float)first[1]);
@@ -266,12 +295,53 @@ namespace PluginRenderReplayer
                             auto pt = (*pts)[i];
                             path.lineTo((float)pt[0], (float)pt[1]);
                         }
-                        g.setColour(juce::Colour(static_cast<juce::uint32>((int64_t)p["color"])));
+                        g.setColour(colour);
                         g.strokePath(path, juce::PathStrokeType((float)p["thickness"]));
                     }
                     break;
                 }
 
+                case PluginRender::CmdType::DrawPoints:
+                {
+                    // "xy" holds float32 x, y pairs; "radii" (float32) and
+                    // "colors" (uint32 ARGB) are optional per-dot arrays
+                    // that fall back to the scalar "radius" / "color".  A
+                    // per-dot array too short for the points is ignored, and
+                    // missing scalars default to draw_points()' 2 px white.
+                    auto* xyData = p["xy"].getBinaryData();
+                    if (xyData == nullptr)
+                        break;
+
+                    const int count = (int)(xyData->getSize() / (2 * sizeof(float)));
+                    auto perDot = [count](const juce::var& v) -> const void*
+                    {
+                        auto* mb = v.getBinaryData();
+                        return mb != nullptr && mb->getSize() >= (size_t)count * 4 ? mb->getData() : nullptr;
+                    };
+
+                    const auto* xy      = static_cast<const float*>(xyData->getData());
+                    const auto* radii   = static_cast<const float*>(perDot(p["radii"]));
+                    const auto* colours = static_cast<const juce::uint32*>(perDot(p["colors"]));
+                    const float radius  = p.hasProperty("radius") ? (float)p["radius"] : 2.0f;
+                    const juce::Colour colour = p.hasProperty("color")
+                        ? juce::Colour(static_cast<juce::uint32>((int64_t)p["color"]))
+                        : juce::Colours::white;
+
+                    if (sprites != nullptr)
+                    {
+                        sprites->draw(g, xy, radii, colours, count, radius, colour);
+                        break;
+                    }
+
+                    for (int i = 0; i < count; ++i)
+                    {
+                        const float r = radii != nullptr ? radii[i] : radius;
+                        g.setColour(colours != nullptr ? juce::Colour(colours[i]) : colour);
+                        g.fillEllipse(xy[i * 2] - r, xy[i * 2 + 1] - r, r * 2, r * 2);
+                    }
+                    break;
+                }
+
                 case PluginRender::CmdType::SaveState:
                 {
                     g.saveState();
@@ -421,6 +491,16 @@ namespace PluginRenderReplayer
                     break;
                 }
 
+                //── Native plugin pixel surface ──────────────────────────────
+
+                case PluginRender::CmdType::BlitImage:
+                {
+                    if (auto* holder = dynamic_cast<PluginRender::ImageHolder*>(p["image"].getObject()))
+                        if (holder->image.isValid())
+                            g.drawImageAt(holder->image, (int)p["x"], (int)p["y"]);
+                    break;
+                }
+
                 //── GPU shader commands (v3) ── handled by OpenGL in CustomPluginComponent
                 case PluginRender::CmdType::DrawShader:
                 case PluginRender::CmdType::DrawCustomShader:
@@ -1,5 +1,114 @@
 #include "PythonPluginBridge.h"
+#include "NativePluginHost.h"
+#include "EmbeddedPythonRuntime.h"
 #include "../UI/DebugLogWindow.h"
+#include <algorithm>
+#include <string>
+
+//==============================================================================
+#if JUCE_WINDOWS
+/// Owns the read end of the subprocess's stdout: splits it into lines and
+/// hands each JSON response to the bridge, which routes it by request id.
+/// Between reads it sleeps on the pipe and a wake event together, timing
+/// out at the next request deadline — no polling.
+class PythonPluginBridge::ResponseReader : public juce::Thread
+{
+public:
+    ResponseReader(PythonPluginBridge& b, HANDLE pipeToRead)
+        : juce::Thread("Python bridge reader"), bridge(b), pipe(pipeToRead)
+    {
+        overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+        wakeEvent         = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+    }
+
+    ~ResponseReader() override
+    {
+        signalThreadShouldExit();
+        wake();
+        stopThread(2000);
+        CloseHandle(overlapped.hEvent);
+        CloseHandle(wakeEvent);
+    }
+
+    /// Re-read the deadlines (a request was posted with the earliest one).
+    void wake() { SetEvent(wakeEvent); }
+
+    void run() override
+    {
+        char buf[4096];
+        std::string partial;
+
+        while (!threadShouldExit())
+        {
+            DWORD got = 0;
+            if (!ReadFile(pipe, buf, sizeof(buf), &got, &overlapped))
+            {
+                if (GetLastError() != ERROR_IO_PENDING)
+                    break;                          // broken pipe — the process is gone
+
+                if (!waitForData())
+                {
+                    CancelIo(pipe);
+                    GetOverlappedResult(pipe, &overlapped, &got, TRUE);
+                    break;
+                }
+                if (!GetOverlappedResult(pipe, &overlapped, &got, FALSE))
+                    break;
+            }
+
+            // Split on whole lines only, so a multi-byte character cut by
+            // the read boundary is decoded once both halves are here
+            partial.append(buf, got);
+            for (auto nl = partial.find('\n'); nl != std::string::npos; nl = partial.find('\n'))
+            {
+                handleLine(juce::String::fromUTF8(partial.data(), (int) nl).trim());
+                partial.erase(0, nl + 1);
+            }
+        }
+
+        bridge.failPendingRequests();
+    }
+
+private:
+    bool waitForData()
+    {
+        HANDLE events[] = { overlapped.hEvent, wakeEvent };
+        while (!threadShouldExit())
+            if (WaitForMultipleObjects(2, events, FALSE, bridge.expirePendingRequests()) == WAIT_OBJECT_0)
+                return true;
+        return false;
+    }
+
+    void handleLine(const juce::String& line)
+    {
+        if (line.isEmpty())
+            return;
+
+        // IMPORTANT: Only accept lines that start with '{' as valid JSON responses.
+        // Any non-JSON output (Python stderr leak, print(), etc.) is logged and skipped —
+        // it helps diagnose why a plugin failed to load.
+        if (line[0] != '{')
+        {
+            MAXIMETER_LOG("PY-OUT", line);
+            DBG("PythonBridge: skipping non-JSON line: " + line.substring(0, 80));
+            return;
+        }
+
+        auto parsed = juce::JSON::parse(line);
+        if (parsed.isObject())
+            bridge.dispatchResponse(parsed);
+        else
+            DBG("PythonBridge: JSON parse failed for line: " + line.substring(0, 80));
+    }
+
+    PythonPluginBridge& bridge;
+    HANDLE              pipe;
+    OVERLAPPED          overlapped {};
+    HANDLE              wakeEvent = nullptr;
+};
+#else
+class PythonPluginBridge::ResponseReader {};
+#endif
 
 //==============================================================================
 PythonPluginBridge& PythonPluginBridge::getInstance()
@@ -11,6 +120,16 @@ PythonPluginBridge& PythonPluginBridge::getInstance()
 PythonPluginBridge::~PythonPluginBridge()
 {
     stop();
+    renderPool_.reset();
+}
+
+juce::ThreadPool& PythonPluginBridge::getRenderPool()
+{
+    const juce::ScopedLock sl(renderPoolLock_);
+    if (renderPool_ == nullptr)
+        renderPool_ = std::make_unique<juce::ThreadPool>(
+            juce::jlimit(1, 8, juce::SystemStats::getNumCpus() - 1));
+    return *renderPool_;
 }
 
 //==============================================================================
@@ -86,19 +205,30 @@ bool PythonPluginBridge::start(const juce::File& pluginsDir,
 {
     if (running) return true;
 
+    // Native modules don't need Python — load them first.
+    NativePluginHost::getInstance().scan(pluginsDir);
+
+    // Trusted plugins that opted in run in-process (MAXIMETER_EMBED_PYTHON builds)
+    if (EmbeddedPythonRuntime::isCompiledIn())
+        EmbeddedPythonRuntime::getInstance().start(pluginsDir);
+
     // Resolve Python executable: use the provided path or auto-detect.
     juce::String exeToUse = pythonExe.isEmpty() ? findPythonExe() : pythonExe;
     if (exeToUse.isEmpty())
     {
-        juce::MessageManager::callAsync([](){
-            juce::AlertWindow::showAsync(
-                juce::MessageBoxOptions()
-                    .withTitle("Python Not Found")
-                    .withMessage("MaxiMeter could not find a Python interpreter.\n\n"
-                                 "Please install Python 3.8+ from https://python.org\n"
-                                 "and restart MaxiMeter to use custom components."),
-                nullptr);
-        });
+        // Only nag about Python when there are no native plugins to fall back on
+        if (!NativePluginHost::getInstance().hasModules())
+        {
+            juce::MessageManager::callAsync([](){
+                juce::AlertWindow::showAsync(
+                    juce::MessageBoxOptions()
+                        .withTitle("Python Not Found")
+                        .withMessage("MaxiMeter could not find a Python interpreter.\n\n"
+                                     "Please install Python 3.8+ from https://python.org\n"
+                                     "and restart MaxiMeter to use custom components."),
+                    nullptr);
+            });
+        }
         if (onError) onError("Python not found — install Python 3.8+ from python.org");
         return false;
     }
@@ -133,21 +263,38 @@ bool PythonPluginBridge::start(const juce::File& pluginsDir,
     HANDLE hStdinReadChild  = nullptr;
     HANDLE hStdoutWriteChild = nullptr;
 
-    if (!CreatePipe(&hStdinReadChild, &hStdinWrite, &sa, 0))
+    // A roomy stdin buffer lets requests queue up while Python is busy
+    if (!CreatePipe(&hStdinReadChild, &hStdinWrite, &sa, 1 << 16))
     {
         if (onError) onError("Failed to create stdin pipe");
         return false;
     }
     SetHandleInformation(hStdinWrite, HANDLE_FLAG_INHERIT, 0);
 
-    if (!CreatePipe(&hStdoutRead, &hStdoutWriteChild, &sa, 0))
+    // stdout is a named pipe so that our end can be opened overlapped: the
+    // reader thread then waits on incoming data and the next request
+    // deadline together.  Anonymous pipes only support blocking reads.
+    static std::atomic<int> pipeSerial { 0 };
+    const auto pipeName = "\\\\.\\pipe\\MaxiMeter_bridge_" + juce::String((int) GetCurrentProcessId())
+                        + "_" + juce::String(++pipeSerial);
+
+    hStdoutRead = CreateNamedPipeA(pipeName.toRawUTF8(),
+                                   PIPE_ACCESS_INBOUND | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE,
+                                   PIPE_TYPE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+                                   1, 0, 1 << 16, 0, nullptr);
+    if (hStdoutRead != INVALID_HANDLE_VALUE)
+        hStdoutWriteChild = CreateFileA(pipeName.toRawUTF8(), GENERIC_WRITE, 0, &sa,
+                                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (hStdoutRead == INVALID_HANDLE_VALUE || hStdoutWriteChild == INVALID_HANDLE_VALUE)
     {
+        if (hStdoutRead != INVALID_HANDLE_VALUE) CloseHandle(hStdoutRead);
+        hStdoutRead = nullptr;
         CloseHandle(hStdinReadChild);
         CloseHandle(hStdinWrite); hStdinWrite = nullptr;
         if (onError) onError("Failed to create stdout pipe");
         return false;
     }
-    SetHandleInformation(hStdoutRead, HANDLE_FLAG_INHERIT, 0);
 
     // Open NUL device for stderr — Python log output must NOT go to the
     // stdout pipe, otherwise it corrupts the JSON-line IPC protocol.
@@ -204,6 +351,9 @@ bool PythonPluginBridge::start(const juce::File& pluginsDir,
     return false;
 #endif
 
+    reader_ = std::make_unique<ResponseReader>(*this, hStdoutRead);
+    reader_->startThread();
+
     running = true;
     MAXIMETER_LOG("BRIDGE", "Python bridge started successfully (pid=" + juce::String((int)(intptr_t)hProcess) + ")");
 
@@ -228,6 +378,8 @@ void PythonPluginBridge::stop()
     msg->setProperty("type", "shutdown");
     sendMessage(juce::var(msg.get()));
 
+    const juce::ScopedLock sl(pipeLock);
+
 #if JUCE_WINDOWS
     if (hProcess)
     {
@@ -235,6 +387,8 @@ void PythonPluginBridge::stop()
         TerminateProcess(hProcess, 0);
         CloseHandle(hProcess);  hProcess = nullptr;
     }
+    reader_.reset();
+    failPendingRequests();
     if (hStdinWrite)  { CloseHandle(hStdinWrite);  hStdinWrite = nullptr; }
     if (hStdoutRead)  { CloseHandle(hStdoutRead);  hStdoutRead = nullptr; }
 #endif
@@ -244,6 +398,12 @@ void PythonPluginBridge::stop()
     restartCount_ = 0;  // Reset for next start() cycle
 }
 
+bool PythonPluginBridge::isAvailable() const
+{
+    return isRunning() || NativePluginHost::getInstance().hasModules()
+        || EmbeddedPythonRuntime::getInstance().isRunning();
+}
+
 bool PythonPluginBridge::isRunning() const
 {
 #if JUCE_WINDOWS
@@ -277,11 +437,14 @@ bool PythonPluginBridge::tryRestart()
     }
 
     restartCount_++;
-    DBG("PythonPluginBridge: attempting restart #" + juce::String(restartCount_));
-    MAXIMETER_LOG("BRIDGE", "Attempting restart #" + juce::String(restartCount_));
+    DBG("PythonPluginBridge: attempting restart #" + juce::String(restartCount_.load()));
+    MAXIMETER_LOGV("BRIDGE", "Attempting restart #{}", restartCount_.load());
 
-    // Clean up old handles (without sending shutdown — process is dead)
+    // Clean up old handles (without sending shutdown — process is dead).
+    // Requests still waiting on the old process fail now.
 #if JUCE_WINDOWS
+    reader_.reset();
+    failPendingRequests();
     if (hProcess)   { CloseHandle(hProcess);   hProcess = nullptr; }
     if (hStdinWrite) { CloseHandle(hStdinWrite); hStdinWrite = nullptr; }
     if (hStdoutRead) { CloseHandle(hStdoutRead); hStdoutRead = nullptr; }
@@ -299,138 +462,218 @@ bool PythonPluginBridge::tryRestart()
         return false;
     }
 
-    DBG("PythonPluginBridge: restart successful (attempt #" + juce::String(restartCount_) + ")");
-    MAXIMETER_LOG("BRIDGE", "Restart successful (attempt #" + juce::String(restartCount_) + ")");
+    DBG("PythonPluginBridge: restart successful (attempt #" + juce::String(restartCount_.load()) + ")");
+    MAXIMETER_LOGV("BRIDGE", "Restart successful (attempt #{})", restartCount_.load());
     return true;
 }
 
 //==============================================================================
 juce::var PythonPluginBridge::sendMessage(const juce::var& msg, DWORD reqTimeout)
 {
-    juce::ScopedLock sl(pipeLock);
+    // Use caller-specified timeout, or default 500ms
+    const DWORD timeoutMs = (reqTimeout > 0) ? reqTimeout : 500;
 
-    if (!running)
+    auto request = std::make_shared<PendingRequest>();
+    request->deadlineMs = juce::Time::getMillisecondCounter() + timeoutMs;
+
+    if (!postRequest(msg, request))
+        return {};
+
+    // Only the reply carrying our id wakes us; other threads' requests are
+    // in flight meanwhile.  Past the deadline the request is withdrawn, so a
+    // late reply is dropped by the reader rather than answering someone else.
+    if (!request->done.wait((int) timeoutMs))
     {
-        // Process not running — try to restart
-        if (lastPluginsDir_.exists() && tryRestart())
+        if (withdrawRequest(request->id))
         {
-            // Retry the message after successful restart
+            DBG("PythonBridge: sendMessage timeout (" + juce::String((int)timeoutMs) + "ms)");
+            MAXIMETER_LOGV("BRIDGE", "sendMessage timeout ({}ms)", timeoutMs);
         }
         else
-            return {};
+        {
+            request->done.wait(-1);     // the reader is finishing it right now
+        }
     }
 
-#if JUCE_WINDOWS
-    if (!hStdinWrite || !hStdoutRead) return {};
+    // Don't restart on every timeout — the auto-recreate logic in
+    // CustomPluginComponent will handle recovery.  Only restart if the
+    // process actually died.
+    if (request->response.isVoid())
+    {
+        const juce::ScopedLock sl(pipeLock);
+        ensureRunning();
+    }
 
-    // Serialise to JSON line
-    auto jsonStr = juce::JSON::toString(msg, true) + "\n";
-    auto utf8 = jsonStr.toRawUTF8();
-    DWORD len = (DWORD) strlen(utf8);
+    return request->response;
+}
 
-    DWORD written = 0;
-    if (!WriteFile(hStdinWrite, utf8, len, &written, nullptr) || written != len)
+void PythonPluginBridge::sendMessageAsync(const juce::var& msg, ResponseCallback onResponse, DWORD reqTimeout)
+{
+    auto request = std::make_shared<PendingRequest>();
+    request->callback   = std::move(onResponse);
+    request->deadlineMs = juce::Time::getMillisecondCounter() + ((reqTimeout > 0) ? reqTimeout : 500);
+
+    if (!postRequest(msg, request) && request->callback)
+        request->callback({});
+}
+
+bool PythonPluginBridge::postRequest(const juce::var& msg, const std::shared_ptr<PendingRequest>& request)
+{
+    auto* obj = msg.getDynamicObject();
+    if (obj == nullptr)
+        return false;
+
+    const juce::ScopedLock sl(pipeLock);
+
+#if JUCE_WINDOWS
+    // One retry, after a restart, if the write fails
+    for (int attempt = 0; attempt < 2; ++attempt)
     {
-        if (onError) onError("Failed to write to Python bridge pipe — attempting restart");
-        running = false;
-        if (tryRestart())
+        if (!ensureRunning() || !hStdinWrite || !hStdoutRead)
+            return false;
+
+        // Register before writing: the reply can arrive before WriteFile returns
+        request->id = nextRequestId_++;
+        obj->setProperty("id", request->id);
+
+        // The reader sleeps until the earliest deadline it knows of; an
+        // earlier one (or the first) makes it re-read them
+        bool wakeReader = true;
         {
-            // Retry write after restart
-            if (!WriteFile(hStdinWrite, utf8, len, &written, nullptr) || written != len)
-                return {};
+            const juce::ScopedLock pl(pendingLock_);
+            for (const auto& entry : pending_)
+                if ((juce::int32) (entry.second->deadlineMs - request->deadlineMs) <= 0)
+                {
+                    wakeReader = false;
+                    break;
+                }
+            pending_[request->id] = request;
         }
-        else
-            return {};
-    }
-    FlushFileBuffers(hStdinWrite);
+        if (wakeReader && reader_ != nullptr)
+            reader_->wake();
 
-    // Read response line (blocking, with timeout).
-    // IMPORTANT: Only accept lines that start with '{' as valid JSON responses.
-    // Any non-JSON output (Python stderr leak, print(), etc.) is silently skipped.
-    juce::String responseLine;
-    auto startMs = juce::Time::getMillisecondCounter();
-    // Use caller-specified timeout, or default 500ms for render, 2000ms otherwise
-    const DWORD timeoutMs = (reqTimeout > 0) ? reqTimeout : 500;
+        // Serialise to JSON line.  No FlushFileBuffers: on a pipe it blocks
+        // until Python has read the line, i.e. behind every request queued
+        // ahead of this one.
+        auto jsonStr = juce::JSON::toString(msg, true) + "\n";
+        auto utf8 = jsonStr.toRawUTF8();
+        DWORD len = (DWORD) strlen(utf8);
 
-    while (true)
-    {
-        DWORD avail = 0;
-        PeekNamedPipe(hStdoutRead, nullptr, 0, nullptr, &avail, nullptr);
+        DWORD written = 0;
+        if (WriteFile(hStdinWrite, utf8, len, &written, nullptr) && written == len)
+            return true;
 
-        if (avail > 0)
-        {
-            char buf[4096];
-            DWORD bytesRead = 0;
-            DWORD toRead = juce::jmin(avail, (DWORD)(sizeof(buf) - 1));
-            if (ReadFile(hStdoutRead, buf, toRead, &bytesRead, nullptr) && bytesRead > 0)
-            {
-                buf[bytesRead] = '\0';
-                responseLine += juce::String::fromUTF8(buf, (int) bytesRead);
+        if (!withdrawRequest(request->id))
+            return true;                // the reader has already failed it
 
-                // Process all complete lines in the buffer
-                while (responseLine.contains("\n"))
-                {
-                    auto idx = responseLine.indexOf("\n");
-                    auto line = responseLine.substring(0, idx).trim();
-                    responseLine = responseLine.substring(idx + 1);
+        if (onError) onError("Failed to write to Python bridge pipe — attempting restart");
+        running = false;                // ensureRunning() restarts on the next pass
+    }
+#endif
+    return false;
+}
 
-                    if (line.isEmpty())
-                        continue;
+bool PythonPluginBridge::ensureRunning()
+{
+    if (running)
+    {
+        if (isRunning())
+            return true;
 
-                    // Only accept lines that look like JSON objects
-                    if (line[0] != '{')
-                    {
-                        // Log Python stdout/stderr that isn't JSON (likely tracebacks or print debugging)
-                        // This helps diagnose why a plugin failed to load.
-                        if (line.isNotEmpty())
-                            MAXIMETER_LOG("PY-OUT", line);
-                        
-                        DBG("PythonBridge: skipping non-JSON line: " + line.substring(0, 80));
-                        continue;
-                    }
+        running = false;
+#if JUCE_WINDOWS
+        DWORD exitCode = 0;
+        GetExitCodeProcess(hProcess, &exitCode);
+        if (onError) onError("Python bridge process exited (code " + juce::String((int)exitCode) + ") — attempting restart");
+#endif
+    }
 
-                    auto parsed = juce::JSON::parse(line);
-                    if (parsed.isObject())
-                    {
-                        restartCount_ = 0;  // Reset on successful communication
-                        return parsed;
-                    }
+    // Process not running — try to restart
+    return lastPluginsDir_.exists() && tryRestart();
+}
 
-                    DBG("PythonBridge: JSON parse failed for line: " + line.substring(0, 80));
-                }
-            }
-        }
+//==============================================================================
+void PythonPluginBridge::dispatchResponse(const juce::var& response)
+{
+    const auto idVar = response.getProperty("id", {});
 
-        if (juce::Time::getMillisecondCounter() - startMs > timeoutMs)
+    std::shared_ptr<PendingRequest> request;
+    {
+        const juce::ScopedLock sl(pendingLock_);
+        auto it = idVar.isVoid() ? pending_.end() : pending_.find((juce::int64) idVar);
+        if (it != pending_.end())
         {
-            DBG("PythonBridge: sendMessage timeout (" + juce::String((int)timeoutMs) + "ms)");
-            MAXIMETER_LOG("BRIDGE", "sendMessage timeout (" + juce::String((int)timeoutMs) + "ms)");
-            // Don't restart on every timeout — the auto-recreate logic in
-            // CustomPluginComponent will handle recovery.  Only restart if
-            // the process actually died (checked below).
-            return {};
+            request = it->second;
+            pending_.erase(it);
         }
+    }
 
-        // Check process is still alive
-        DWORD exitCode = 0;
-        if (GetExitCodeProcess(hProcess, &exitCode) && exitCode != STILL_ACTIVE)
+    if (request == nullptr)
+    {
+        // Its requester gave up at the deadline
+        DBG("PythonBridge: dropping late reply to request " + idVar.toString());
+        return;
+    }
+
+    restartCount_ = 0;  // Reset on successful communication
+    finishRequest(request, response);
+}
+
+bool PythonPluginBridge::withdrawRequest(juce::int64 id)
+{
+    const juce::ScopedLock sl(pendingLock_);
+    return pending_.erase(id) > 0;
+}
+
+DWORD PythonPluginBridge::expirePendingRequests()
+{
+    std::vector<std::shared_ptr<PendingRequest>> expired;
+    DWORD nextDeadline = INFINITE;
+    {
+        const juce::ScopedLock sl(pendingLock_);
+        const auto now = juce::Time::getMillisecondCounter();
+        for (auto it = pending_.begin(); it != pending_.end();)
         {
-            running = false;
-            if (onError) onError("Python bridge process exited (code " + juce::String((int)exitCode) + ") — attempting restart");
-            tryRestart();
-            return {};
+            const auto left = (juce::int32) (it->second->deadlineMs - now);
+            if (left <= 0)
+            {
+                expired.push_back(it->second);
+                it = pending_.erase(it);
+            }
+            else
+            {
+                nextDeadline = juce::jmin(nextDeadline, (DWORD) left);
+                ++it;
+            }
         }
+    }
 
-        // Yield CPU time without the 15ms Sleep(1) penalty on Windows.
-        // SwitchToThread gives up the rest of our timeslice to another ready
-        // thread; if none are ready it returns immediately.  This brings the
-        // effective polling interval from ~15ms down to ~0–1ms.
-        if (!SwitchToThread())
-            Sleep(0);
+    for (auto& request : expired)
+    {
+        MAXIMETER_LOGV("BRIDGE", "Request {} timed out", request->id);
+        finishRequest(request, {});
     }
-#else
-    return {};
-#endif
+    return nextDeadline;
+}
+
+void PythonPluginBridge::failPendingRequests()
+{
+    std::map<juce::int64, std::shared_ptr<PendingRequest>> failed;
+    {
+        const juce::ScopedLock sl(pendingLock_);
+        failed.swap(pending_);
+    }
+
+    for (auto& [id, request] : failed)
+        finishRequest(request, {});
+}
+
+void PythonPluginBridge::finishRequest(const std::shared_ptr<PendingRequest>& request, const juce::var& response)
+{
+    request->response = response;
+    if (request->callback)
+        request->callback(response);
+    request->done.signal();
 }
 
 //==============================================================================
@@ -450,6 +693,11 @@ void PythonPluginBridge::scanPlugins()
 
     insideScan_ = false;
 
+    // Pick up native modules dropped in since start()
+    NativePluginHost::getInstance().scan(lastPluginsDir_);
+    if (EmbeddedPythonRuntime::getInstance().isRunning())
+        EmbeddedPythonRuntime::getInstance().start(lastPluginsDir_);
+
     if (!result.isObject()) return;
 
     auto* resultObj = result.getDynamicObject();
@@ -471,14 +719,31 @@ void PythonPluginBridge::scanPlugins()
 
 std::vector<CustomPluginManifest> PythonPluginBridge::getAvailablePlugins() const
 {
-    return cachedManifests;
+    auto result = cachedManifests;
+    for (auto& m : NativePluginHost::getInstance().getManifests())
+        result.push_back(m);
+
+    // Embedded plugins are also listed by the subprocess when it is running
+    for (auto& m : EmbeddedPythonRuntime::getInstance().getManifests())
+        if (std::none_of(result.begin(), result.end(),
+                         [&](const CustomPluginManifest& e) { return e.id == m.id; }))
+            result.push_back(m);
+    return result;
 }
 
 //==============================================================================
-std::vector<CustomPluginProperty> PythonPluginBridge::createInstance(
+std::optional<std::vector<CustomPluginProperty>> PythonPluginBridge::createInstance(
     const juce::String& manifestId,
     const juce::String& instanceId)
 {
+    auto& native = NativePluginHost::getInstance();
+    if (native.hasManifest(manifestId))
+        return native.createInstance(manifestId, instanceId);
+
+    auto& embedded = EmbeddedPythonRuntime::getInstance();
+    if (embedded.hasManifest(manifestId))
+        return embedded.createInstance(manifestId, instanceId);
+
     juce::DynamicObject::Ptr msg = new juce::DynamicObject();
     msg->setProperty("type", "create");
     msg->setProperty("manifest_id", manifestId);
@@ -489,112 +754,313 @@ std::vector<CustomPluginProperty> PythonPluginBridge::createInstance(
     {
         DBG("PythonBridge: createInstance failed for " + manifestId + " (no response)");
         MAXIMETER_LOG("ERROR", "createInstance FAILED for " + manifestId + " / " + instanceId + " (timeout or no response)");
-        return {};
+        return std::nullopt;
     }
 
     auto* resultObj = result.getDynamicObject();
-    if (!resultObj) return {};
+    if (!resultObj) return std::nullopt;
 
     if (resultObj->getProperty("type").toString() == "error")
     {
         juce::String errorMsg = resultObj->getProperty("message");
         MAXIMETER_LOG("BRIDGE-ERR", "createInstance error for " + manifestId + ": " + errorMsg);
-        return {};
+        return std::nullopt;
     }
 
     if (resultObj->getProperty("type").toString() != "created")
-        return {};
+        return std::nullopt;
 
     MAXIMETER_LOG("INSTANCE", "createInstance OK: " + manifestId + " / " + instanceId);
 
-    std::vector<CustomPluginProperty> props;
-    auto propsVar = resultObj->getProperty("properties");
-    if (auto* arr = propsVar.getArray())
-    {
-        for (auto& pv : *arr)
-        {
-            if (auto* po = pv.getDynamicObject())
-            {
-                CustomPluginProperty prop;
-                prop.key = po->getProperty("key").toString();
-                prop.label = po->getProperty("label").toString();
-                prop.type = po->getProperty("type").toString();
-                prop.defaultVal = po->getProperty("default");
-                prop.group = po->getProperty("group").toString();
-                prop.minVal = (float)po->getProperty("min");
-                prop.maxVal = (float)po->getProperty("max");
-                prop.step = (float)po->getProperty("step");
-                prop.description = po->getProperty("description").toString();
+    return parseProperties(resultObj->getProperty("properties"));
+}
 
-                // Parse ENUM choices: Python sends [["value","Label"], ...]
-                if (auto* choicesArr = po->getProperty("choices").getArray())
-                {
-                    for (auto& cv : *choicesArr)
-                    {
-                        if (auto* pair = cv.getArray())
-                        {
-                            if (pair->size() >= 2)
-                                prop.choices.add({ (*pair)[0], (*pair)[1].toString() });
-                        }
-                    }
-                }
+bool PythonPluginBridge::cloneInstance(const juce::String& sourceInstanceId,
+                                       const juce::String& newInstanceId,
+                                       const std::vector<std::pair<juce::String, juce::var>>& values)
+{
+    // Native modules have no way to hand over their state
+    if (sourceInstanceId.isEmpty() || NativePluginHost::getInstance().ownsInstance(sourceInstanceId))
+        return false;
 
-                props.push_back(std::move(prop));
-            }
-        }
+    auto& embedded = EmbeddedPythonRuntime::getInstance();
+    if (embedded.ownsInstance(sourceInstanceId))
+        return embedded.cloneInstance(sourceInstanceId, newInstanceId, values);
+
+    if (!isRunning())
+        return false;
+
+    juce::DynamicObject::Ptr valuesObj = new juce::DynamicObject();
+    for (const auto& [key, value] : values)
+        valuesObj->setProperty(key, value);
+
+    juce::DynamicObject::Ptr msg = new juce::DynamicObject();
+    msg->setProperty("type", "clone_instance");
+    msg->setProperty("source_id", sourceInstanceId);
+    msg->setProperty("instance_id", newInstanceId);
+    msg->setProperty("values", juce::var(valuesObj.get()));
+
+    auto result = sendMessage(juce::var(msg.get()), 2000);
+    auto* resultObj = result.getDynamicObject();
+    if (resultObj == nullptr || resultObj->getProperty("type").toString() != "created")
+    {
+        MAXIMETER_LOG("BRIDGE-ERR", "cloneInstance failed for " + sourceInstanceId + ": "
+                                    + (resultObj ? resultObj->getProperty("message").toString()
+                                                 : juce::String("no response")));
+        return false;
     }
 
-    return props;
+    MAXIMETER_LOG("INSTANCE", "cloneInstance OK: " + sourceInstanceId + " -> " + newInstanceId);
+    return true;
 }
 
 void PythonPluginBridge::destroyInstance(const juce::String& instanceId)
 {
+    auto& native = NativePluginHost::getInstance();
+    if (native.ownsInstance(instanceId))
+    {
+        native.destroyInstance(instanceId);
+        return;
+    }
+
+    auto& embedded = EmbeddedPythonRuntime::getInstance();
+    if (embedded.ownsInstance(instanceId))
+    {
+        embedded.destroyInstance(instanceId);
+        return;
+    }
+
     juce::DynamicObject::Ptr msg = new juce::DynamicObject();
     msg->setProperty("type", "destroy");
     msg->setProperty("instance_id", instanceId);
-    sendMessage(juce::var(msg.get()));
+    sendMessageAsync(juce::var(msg.get()), nullptr);
 }
 
 //==============================================================================
-std::vector<PluginRender::RenderCommand> PythonPluginBridge::renderInstance(
-    const juce::String& instanceId,
-    int width, int height,
-    const juce::String& audioJson,
+void PluginAudioFrame::finalise()
+{
+    snapshot.structSize   = sizeof(MxmAudioSnapshot);
+    snapshot.spectrum     = spectrum.empty() ? nullptr : spectrum.data();
+    snapshot.spectrumSize = (int32_t)spectrum.size();
+    snapshot.waveform     = waveform.empty() ? nullptr : waveform.data();
+    snapshot.waveformSize = (int32_t)waveform.size();
+
+    juce::DynamicObject::Ptr audioObj = new juce::DynamicObject();
+
+    juce::Array<juce::var> channelsArr;
+    for (int c = 0; c < juce::jlimit(0, MXM_MAX_CHANNELS, (int)snapshot.numChannels); ++c)
+    {
+        const auto& levels = snapshot.channels[c];
+        juce::DynamicObject::Ptr ch = new juce::DynamicObject();
+        ch->setProperty("rms",         levels.rms);
+        ch->setProperty("peak",        levels.peak);
+        ch->setProperty("true_peak",   levels.truePeak);
+        ch->setProperty("rms_linear",  levels.rms);
+        ch->setProperty("peak_linear", levels.peak);
+        channelsArr.add(juce::var(ch.get()));
+    }
+    audioObj->setProperty("channels", channelsArr);
+    audioObj->setProperty("num_channels", (int)snapshot.numChannels);
+
+    audioObj->setProperty("lufs_momentary",  snapshot.lufsMomentary);
+    audioObj->setProperty("lufs_short_term", snapshot.lufsShortTerm);
+    audioObj->setProperty("lufs_integrated", snapshot.lufsIntegrated);
+    audioObj->setProperty("loudness_range",  snapshot.loudnessRange);
+    audioObj->setProperty("correlation",     snapshot.correlation);
+
+    audioObj->setProperty("sample_rate",      snapshot.sampleRate);
+    audioObj->setProperty("is_playing",       snapshot.isPlaying != 0);
+    audioObj->setProperty("position_seconds", snapshot.position);
+    audioObj->setProperty("duration_seconds", snapshot.duration);
+
+    // Python plugins get the first 512 bins, as they always have
+    if (!spectrum.empty())
+    {
+        juce::Array<juce::var> specArr;
+        juce::Array<juce::var> specLinArr;
+        const int numBins = juce::jmin((int)spectrum.size(), 512);
+        specArr.ensureStorageAllocated(numBins);
+        specLinArr.ensureStorageAllocated(numBins);
+        for (int b = 0; b < numBins; ++b)
+        {
+            specArr.add(spectrum[(size_t)b]);
+            specLinArr.add(juce::jlimit(0.0f, 1.0f, spectrum[(size_t)b]));
+        }
+        audioObj->setProperty("spectrum", specArr);
+        audioObj->setProperty("spectrum_linear", specLinArr);
+        audioObj->setProperty("fft_size", (int)snapshot.fftSize);
+    }
+
+    if (!waveform.empty())
+    {
+        juce::Array<juce::var> waveArr;
+        waveArr.ensureStorageAllocated((int)waveform.size());
+        for (auto s : waveform)
+            waveArr.add(s);
+        audioObj->setProperty("waveform", waveArr);
+    }
+
+    data = juce::var(audioObj.get());
+}
+
+//==============================================================================
+PluginRenderResult PythonPluginBridge::renderInstance(const PluginRenderRequest& request,
+                                                      const PluginAudioFrame& audio,
+                                                      bool forceJsonAudio)
+{
+    return renderBatch({ request }, audio, forceJsonAudio).front();
+}
+
+//==============================================================================
+namespace
+{
+    juce::var colourToVar(juce::Colour c)
+    {
+        juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+        obj->setProperty("r", c.getFloatRed());
+        obj->setProperty("g", c.getFloatGreen());
+        obj->setProperty("b", c.getFloatBlue());
+        obj->setProperty("a", c.getFloatAlpha());
+        return juce::var(obj.get());
+    }
+}
+
+std::vector<PluginRenderResult> PythonPluginBridge::renderBatch(
+    const std::vector<PluginRenderRequest>& requests,
+    const PluginAudioFrame& audio,
     bool forceJsonAudio)
 {
-    juce::DynamicObject::Ptr msg = new juce::DynamicObject();
-    msg->setProperty("type", "render");
-    msg->setProperty("instance_id", instanceId);
-    msg->setProperty("width", width);
-    msg->setProperty("height", height);
+    std::vector<PluginRenderResult> results(requests.size());
+    if (requests.empty())
+        return results;
+
+    auto& native   = NativePluginHost::getInstance();
+    auto& embedded = EmbeddedPythonRuntime::getInstance();
 
-    // For offline export, tell Python to use JSON audio instead of SHM
-    if (forceJsonAudio)
-        msg->setProperty("use_json_audio", true);
+    std::vector<size_t>              nativeIndex;
+    std::vector<PluginRenderRequest> embeddedRequests;
+    std::vector<size_t>              embeddedIndex;
+    juce::Array<juce::var>           entries;
+    std::vector<size_t>              entryIndex;   // entries[k] answers requests[entryIndex[k]]
 
-    // Parse audio JSON if provided
-    if (audioJson.isNotEmpty())
+    for (size_t i = 0; i < requests.size(); ++i)
     {
-        auto audioVar = juce::JSON::parse(audioJson);
-        msg->setProperty("audio", audioVar);
+        const auto& r = requests[i];
+
+        if (native.ownsInstance(r.instanceId))
+        {
+            nativeIndex.push_back(i);
+        }
+        else if (embedded.ownsInstance(r.instanceId))
+        {
+            embeddedRequests.push_back(r);
+            embeddedIndex.push_back(i);
+        }
+        else
+        {
+            juce::DynamicObject::Ptr entry = new juce::DynamicObject();
+            entry->setProperty("instance_id", r.instanceId);
+            entry->setProperty("width", r.width);
+            entry->setProperty("height", r.height);
+            entry->setProperty("bg_color", colourToVar(r.bgColour));
+            entry->setProperty("fg_color", colourToVar(r.fgColour));
+            entries.add(juce::var(entry.get()));
+            entryIndex.push_back(i);
+        }
     }
 
-    auto result = sendMessage(juce::var(msg.get()));
-    if (!result.isObject()) return {};
+    // In-process instances have no IPC to amortise: they render on the pool
+    // while this thread waits for the subprocess.
+    const int numJobs = static_cast<int>(nativeIndex.size()) + (embeddedIndex.empty() ? 0 : 1);
+    std::atomic<int>    jobsLeft { numJobs };
+    juce::WaitableEvent jobsDone;
 
-    auto* resultObj = result.getDynamicObject();
-    if (!resultObj) return {};
+    auto runJob = [&](std::function<void()> job)
+    {
+        getRenderPool().addJob([&jobsLeft, &jobsDone, job = std::move(job)]
+        {
+            try { job(); }
+            catch (...) { DBG("PythonBridge: in-process render threw an exception"); }
+
+            if (jobsLeft.fetch_sub(1) == 1)
+                jobsDone.signal();
+        });
+    };
+
+    // Natives read the typed snapshot with the entry's colours
+    for (auto i : nativeIndex)
+        runJob([&, i]
+        {
+            const auto& r = requests[i];
+            auto snap = audio.snapshot;
+            snap.bgColour = r.bgColour.getARGB();
+            snap.fgColour = r.fgColour.getARGB();
+            results[i] = native.renderInstance(r.instanceId, r.width, r.height, snap);
+        });
 
-    std::vector<PluginRender::RenderCommand> commands;
-    auto cmdsVar = resultObj->getProperty("commands");
-    if (auto* arr = cmdsVar.getArray())
+    if (!embeddedIndex.empty())
+        runJob([&]
+        {
+            auto batch = embedded.renderBatch(embeddedRequests, audio.data, forceJsonAudio);
+            for (size_t k = 0; k < embeddedIndex.size() && k < batch.size(); ++k)
+                results[embeddedIndex[k]] = std::move(batch[k]);
+        });
+
+    if (!entries.isEmpty())
     {
-        commands.reserve(arr->size());
-        for (auto& cv : *arr)
-            commands.push_back(parseRenderCommand(cv));
+        try
+        {
+            juce::DynamicObject::Ptr msg = new juce::DynamicObject();
+            msg->setProperty("type", "render_batch");
+            msg->setProperty("entries", entries);
+            if (forceJsonAudio)
+                msg->setProperty("use_json_audio", true);
+            if (!audio.data.isVoid())
+                msg->setProperty("audio", audio.data);
+
+            auto result = sendMessage(juce::var(msg.get()));
+
+            // Results come back in entry order; the id check guards against a
+            // runtime that skipped an entry.  An entry with an "error" names an
+            // instance the subprocess does not have.
+            auto* resultObj = result.getDynamicObject();
+            if (auto* arr = resultObj != nullptr ? resultObj->getProperty("results").getArray() : nullptr)
+            {
+                size_t k = 0;
+                for (auto& rv : *arr)
+                {
+                    auto* ro = rv.getDynamicObject();
+                    if (ro == nullptr) continue;
+
+                    const auto id = ro->getProperty("instance_id").toString();
+                    while (k < entryIndex.size() && requests[entryIndex[k]].instanceId != id)
+                        ++k;
+                    if (k == entryIndex.size())
+                        break;
+
+                    auto& out = results[entryIndex[k]];
+                    out.rendered = !ro->hasProperty("error");
+                    if (auto* cmds = ro->getProperty("commands").getArray())
+                    {
+                        out.commands.reserve(static_cast<size_t>(cmds->size()));
+                        for (auto& cv : *cmds)
+                            out.commands.push_back(parseRenderCommand(cv));
+                    }
+                    ++k;
+                }
+            }
+        }
+        catch (...)
+        {
+            DBG("PythonBridge: render_batch threw an exception");
+        }
     }
 
-    return commands;
+    // The jobs write into results and read requests / audio
+    if (numJobs > 0)
+        jobsDone.wait(-1);
+
+    return results;
 }
 
 //==============================================================================
@@ -602,22 +1068,84 @@ void PythonPluginBridge::setProperty(const juce::String& instanceId,
                                       const juce::String& key,
                                       const juce::var& value)
 {
+    auto& native = NativePluginHost::getInstance();
+    if (native.ownsInstance(instanceId))
+    {
+        native.setProperty(instanceId, key, value);
+        return;
+    }
+
+    auto& embedded = EmbeddedPythonRuntime::getInstance();
+    if (embedded.ownsInstance(instanceId))
+    {
+        embedded.setProperty(instanceId, key, value);
+        return;
+    }
+
     juce::DynamicObject::Ptr msg = new juce::DynamicObject();
     msg->setProperty("type", "set_property");
     msg->setProperty("instance_id", instanceId);
     msg->setProperty("key", key);
     msg->setProperty("value", value);
-    sendMessage(juce::var(msg.get()));
+
+    // Nothing to wait for: the pipe keeps it ahead of any later request
+    sendMessageAsync(juce::var(msg.get()), nullptr);
+}
+
+void PythonPluginBridge::setProperties(const juce::String& instanceId,
+                                       const std::vector<std::pair<juce::String, juce::var>>& values)
+{
+    if (values.empty())
+        return;
+
+    auto& native = NativePluginHost::getInstance();
+    if (native.ownsInstance(instanceId))
+    {
+        for (const auto& [key, value] : values)
+            native.setProperty(instanceId, key, value);
+        return;
+    }
+
+    auto& embedded = EmbeddedPythonRuntime::getInstance();
+    if (embedded.ownsInstance(instanceId))
+    {
+        embedded.setProperties(instanceId, values);
+        return;
+    }
+
+    juce::DynamicObject::Ptr valuesObj = new juce::DynamicObject();
+    for (const auto& [key, value] : values)
+        valuesObj->setProperty(key, value);
+
+    juce::DynamicObject::Ptr msg = new juce::DynamicObject();
+    msg->setProperty("type", "set_properties");
+    msg->setProperty("instance_id", instanceId);
+    msg->setProperty("values", juce::var(valuesObj.get()));
+    sendMessageAsync(juce::var(msg.get()), nullptr);
 }
 
 void PythonPluginBridge::notifyResize(const juce::String& instanceId, int width, int height)
 {
+    auto& native = NativePluginHost::getInstance();
+    if (native.ownsInstance(instanceId))
+    {
+        native.notifyResize(instanceId, width, height);
+        return;
+    }
+
+    auto& embedded = EmbeddedPythonRuntime::getInstance();
+    if (embedded.ownsInstance(instanceId))
+    {
+        embedded.notifyResize(instanceId, width, height);
+        return;
+    }
+
     juce::DynamicObject::Ptr msg = new juce::DynamicObject();
     msg->setProperty("type", "resize");
     msg->setProperty("instance_id", instanceId);
     msg->setProperty("width", width);
     msg->setProperty("height", height);
-    sendMessage(juce::var(msg.get()));
+    sendMessageAsync(juce::var(msg.get()), nullptr);
 }
 
 //==============================================================================
@@ -694,10 +1222,55 @@ CustomPluginManifest PythonPluginBridge::parseManifest(const juce::var& v)
         if (auto* tags = obj->getProperty("tags").getArray())
             for (auto& t : *tags)
                 m.tags.add(t.toString());
+
+        m.embedded = (bool)obj->getProperty("embedded");
+        m.analysis = Analysis::parseManifestRequirements(obj->getProperty("analysis"),
+                                                         obj->getProperty("fft_size"));
     }
     return m;
 }
 
+std::vector<CustomPluginProperty> PythonPluginBridge::parseProperties(const juce::var& propsVar)
+{
+    std::vector<CustomPluginProperty> props;
+    if (auto* arr = propsVar.getArray())
+    {
+        for (auto& pv : *arr)
+        {
+            if (auto* po = pv.getDynamicObject())
+            {
+                CustomPluginProperty prop;
+                prop.key = po->getProperty("key").toString();
+                prop.label = po->getProperty("label").toString();
+                prop.type = po->getProperty("type").toString();
+                prop.defaultVal = po->getProperty("default");
+                prop.group = po->getProperty("group").toString();
+                prop.minVal = (float)po->getProperty("min");
+                prop.maxVal = (float)po->getProperty("max");
+                prop.step = (float)po->getProperty("step");
+                prop.description = po->getProperty("description").toString();
+
+                // Parse ENUM choices: Python sends [["value","Label"], ...]
+                if (auto* choicesArr = po->getProperty("choices").getArray())
+                {
+                    for (auto& cv : *choicesArr)
+                    {
+                        if (auto* pair = cv.getArray())
+                        {
+                            if (pair->size() >= 2)
+                                prop.choices.add({ (*pair)[0], (*pair)[1].toString() });
+                        }
+                    }
+                }
+
+                props.push_back(std::move(prop));
+            }
+        }
+    }
+
+    return props;
+}
+
 PluginRender::RenderCommand PythonPluginBridge::parseRenderCommand(const juce::var& v)
 {
     PluginRender::RenderCommand cmd;
@@ -735,6 +1308,7 @@ PluginRender::RenderCommand PythonPluginBridge::parseRenderCommand(const juce::v
             {"draw_polyline",      PluginRender::CmdType::DrawPolyline},
             {"save_state",         PluginRender::CmdType::SaveState},
             {"restore_state",      PluginRender::CmdType::RestoreState},
+            {"draw_points",        PluginRender::CmdType::DrawPoints},
             {"draw_shader",        PluginRender::CmdType::DrawShader},
             {"draw_custom_shader", PluginRender::CmdType::DrawCustomShader},
         };
@@ -752,6 +1326,24 @@ PluginRender::RenderCommand PythonPluginBridge::parseRenderCommand(const juce::v
             if (prop.name.toString() != "cmd")
                 params->setProperty(prop.name, prop.value);
         }
+
+        // Packed point arrays arrive as base64 — decode once here rather
+        // than on every replay
+        if (cmd.type == PluginRender::CmdType::DrawPoints)
+        {
+            for (auto* key : { "xy", "radii", "colors" })
+            {
+                auto packed = params->getProperty(key);
+                if (!packed.isString())
+                    continue;
+
+                juce::MemoryOutputStream bytes;
+                if (juce::Base64::convertFromBase64(bytes, packed.toString()))
+                    params->setProperty(key, bytes.getMemoryBlock());
+                else
+                    params->removeProperty(key);
+            }
+        }
         cmd.params = juce::var(params.get());
     }
 
@@ -8,26 +8,50 @@
  * the Python plugin runtime running as a child process.
  *
  * Communication uses JSON-line protocol over stdin/stdout pipes:
- *   Host  → Python:  { "type": "render", "instance_id": ..., "audio": {...}, "width": ..., "height": ... }
- *   Python → Host:   { "type": "render_commands", "commands": [...] }
+ *   Host  → Python:  { "type": "render", "id": 42, "instance_id": ..., "audio": {...}, "width": ..., "height": ... }
+ *   Python → Host:   { "type": "render_commands", "id": 42, "commands": [...] }
+ *
+ * Every request carries an "id" that its response echoes.  A reader thread
+ * owns the stdout pipe and hands each response to whoever is waiting for
+ * that id, so several threads can have requests in flight at once; each
+ * request has its own deadline, and a reply that arrives after it is
+ * dropped instead of being taken for the answer to a later request.
+ *
+ * Canvases with several plugin instances send one "render_batch" per frame
+ * instead (see renderBatch()), so IPC cost does not grow with the count.
+ * Likewise the exporter copies live instances with one "clone_instance"
+ * each (see cloneInstance()) rather than a create plus a set_property per
+ * value.
  *
  * INTEGRATION STEPS:
  *   1. Add this header + PythonPluginBridge.cpp to your CMakeLists.txt
  *   2. On startup, call PythonPluginBridge::getInstance().start("path/to/plugins");
  *   3. Query getAvailablePlugins() to populate the TOOLBOX
  *   4. When user adds a custom component, call createInstance(manifestId)
- *   5. Each frame, call renderInstance(id, width, height, audioJson) →
- *      returns a list of draw commands to replay through juce::Graphics
+ *   5. Each frame, build a PluginAudioFrame and call renderBatch() (or
+ *      renderInstance() for a single instance) → returns the draw commands
+ *      to replay through juce::Graphics
  *   6. On shutdown, call stop()
  *
+ * Native plugins (see NativePluginABI.h) found in the same directory are
+ * served in-process by NativePluginHost through this same interface.
+ *
  * Implementation: PythonPluginBridge.cpp using native Win32 pipes
- * (CreateProcess + anonymous pipes for stdin/stdout IPC).
+ * (CreateProcess + an anonymous stdin pipe and an overlapped named stdout
+ * pipe, so the reader thread can wait on data and deadlines together).
  */
 
 #include <JuceHeader.h>
+#include "../Audio/AnalysisGraph.h"
+#include "../Audio/FeatureExtractor.h"
+#include "../Audio/MetricHistory.h"
+#include "NativePluginABI.h"
 #include <vector>
 #include <memory>
 #include <functional>
+#include <atomic>
+#include <map>
+#include <optional>
 
 #if JUCE_WINDOWS
   #ifndef NOMINMAX
@@ -61,9 +85,19 @@ namespace PluginRender
         FillCircle, StrokeCircle,
         DrawPolyline,
         SaveState, RestoreState,
+        DrawPoints,          ///< Batched dots: packed "xy", optional "radii" / "colors"
         // ── GPU shader commands (v3) ──
         DrawShader,          ///< Execute a GLSL shader pass
         DrawCustomShader,    ///< Execute user-provided GLSL source
+        // ── Native plugins ──
+        BlitImage,           ///< Draw an in-memory image ("image" holds an ImageHolder)
+    };
+
+    /// Carries a juce::Image inside a command's var params without
+    /// encoding it (used for native plugin pixel surfaces).
+    struct ImageHolder : public juce::ReferenceCountedObject
+    {
+        juce::Image image;
     };
 
     /// A single render command with parameters stored as a juce::var (JSON-like).
@@ -88,6 +122,8 @@ struct CustomPluginManifest
     int          defaultWidth  = 300;
     int          defaultHeight = 200;
     juce::StringArray tags;
+    bool         embedded = false;  ///< Opted in to the in-process interpreter
+    Analysis::Requirements analysis { Analysis::All, 0 }; ///< Analyzers the plugin reads
 };
 
 //==============================================================================
@@ -106,12 +142,57 @@ struct CustomPluginProperty
     juce::String description;
 };
 
+//==============================================================================
+/// One instance in a frame-batched render (see PythonPluginBridge::renderBatch).
+struct PluginRenderRequest
+{
+    juce::String instanceId;
+    int          width  = 0;
+    int          height = 0;
+    juce::Colour bgColour;      ///< sent as the instance's bg_color
+    juce::Colour fgColour;      ///< sent as the instance's fg_color
+};
+
+//==============================================================================
+/// The audio analysis every plugin in a batch renders against, built once
+/// per frame.  Native plugins read @c snapshot as is; the Python runtimes
+/// receive @c data, the same values as an AudioData tree.
+struct PluginAudioFrame
+{
+    PluginAudioFrame() = default;
+
+    MxmAudioSnapshot   snapshot {};     ///< spectrum / waveform point into the vectors below
+    std::vector<float> spectrum;        ///< linear magnitudes
+    std::vector<float> waveform;        ///< mono samples
+    juce::var          data;
+
+    /// Point the snapshot at @c spectrum / @c waveform and rebuild @c data
+    /// from them.  Call after filling the fields; extra AudioData keys
+    /// (features) can be added to @c data afterwards.
+    void finalise();
+
+    JUCE_DECLARE_NON_COPYABLE(PluginAudioFrame)
+};
+
+//==============================================================================
+/// Outcome of one instance's render.
+struct PluginRenderResult
+{
+    /// False if the runtime did not know the instance (lost after a bridge
+    /// restart...) or never answered.  A plugin that drew nothing this
+    /// frame is rendered with no commands.
+    bool rendered = false;
+    std::vector<PluginRender::RenderCommand> commands;
+};
+
 //==============================================================================
 /**
  * Singleton bridge to the Python plugin subprocess.
  *
- * Thread safety:  All public methods are meant to be called from the
- * message thread.  The bridge internally guards pipe I/O.
+ * Thread safety:  Lifecycle methods (start, stop, scanPlugins) are meant
+ * to be called from the message thread.  Instance, render and property
+ * calls may come from any thread; they only serialise on the pipe write,
+ * not on each other's round trips.
  */
 class PythonPluginBridge
 {
@@ -138,13 +219,17 @@ public:
     /// @return true if the subprocess is running.
     bool isRunning() const;
 
+    /// @return true if plugin instances can be served — either the Python
+    ///         subprocess is running or native modules are loaded.
+    bool isAvailable() const;
+
     //-- Discovery -----------------------------------------------------------
 
     /// Ask the Python side to (re-)scan the plugins directory.
     /// Blocks briefly; call from message thread.
     void scanPlugins();
 
-    /// Get the list of available custom plugin manifests.
+    /// Get the list of available custom plugin manifests (Python + native).
     std::vector<CustomPluginManifest> getAvailablePlugins() const;
 
     //-- Instance management -------------------------------------------------
@@ -152,28 +237,43 @@ public:
     /// Create a new instance of a custom component.
     /// @param manifestId  The Manifest.id (e.g. "com.example.my_meter").
     /// @param instanceId  A UUID string to identify this instance.
-    /// @return Property descriptors for the Property Panel, or empty on error.
-    std::vector<CustomPluginProperty> createInstance(const juce::String& manifestId,
-                                                     const juce::String& instanceId);
+    /// @return Property descriptors for the Property Panel (possibly none),
+    ///         or std::nullopt if the instance could not be created.
+    std::optional<std::vector<CustomPluginProperty>> createInstance(const juce::String& manifestId,
+                                                                    const juce::String& instanceId);
+
+    /// Copy a live instance, internal state included (histories, particle
+    /// systems...), as @p newInstanceId and apply @p values to the copy —
+    /// one round trip.  Returns false if the source cannot be cloned (not
+    /// found, or a native module); create the instance instead.
+    bool cloneInstance(const juce::String& sourceInstanceId,
+                       const juce::String& newInstanceId,
+                       const std::vector<std::pair<juce::String, juce::var>>& values = {});
 
     /// Destroy an instance.
     void destroyInstance(const juce::String& instanceId);
 
     //-- Rendering -----------------------------------------------------------
 
-    /// Request render commands for one frame.
-    /// @param instanceId     The instance UUID.
-    /// @param width          Component width in pixels.
-    /// @param height         Component height in pixels.
-    /// @param audioJson      Serialised AudioData snapshot (see AudioDataSerialiser).
-    /// @param forceJsonAudio If true, tell Python to use the JSON audio data
-    ///                       instead of shared memory (used for offline export).
-    /// @return List of render commands to replay through juce::Graphics.
-    std::vector<PluginRender::RenderCommand> renderInstance(
-        const juce::String& instanceId,
-        int width, int height,
-        const juce::String& audioJson,
-        bool forceJsonAudio = false);
+    /// Request render commands for one instance — renderBatch() with a
+    /// single request.
+    PluginRenderResult renderInstance(const PluginRenderRequest& request,
+                                      const PluginAudioFrame& audio,
+                                      bool forceJsonAudio = false);
+
+    /// Render several instances against one shared audio frame.
+    /// All subprocess instances go out in a single "render_batch" round trip;
+    /// meanwhile native instances render in parallel on a small pool, and
+    /// embedded ones one after another (they share the GIL) on one of its
+    /// threads.
+    /// @param requests       Instances to render, with their sizes and colours.
+    /// @param audio          Shared analysis (colours are per request).
+    /// @param forceJsonAudio If true, tell Python to use @p audio instead of
+    ///                       shared memory (used for offline export).
+    /// @return One result per request, in request order.
+    std::vector<PluginRenderResult> renderBatch(const std::vector<PluginRenderRequest>& requests,
+                                                const PluginAudioFrame& audio,
+                                                bool forceJsonAudio = false);
 
     //-- Properties ----------------------------------------------------------
 
@@ -182,6 +282,10 @@ public:
                      const juce::String& key,
                      const juce::var& value);
 
+    /// Set several property values in one round trip.
+    void setProperties(const juce::String& instanceId,
+                       const std::vector<std::pair<juce::String, juce::var>>& values);
+
     /// Notify the Python side that the component was resized.
     void notifyResize(const juce::String& instanceId, int width, int height);
 
@@ -198,6 +302,17 @@ public:
     /// Hot-reload a single plugin.
     bool reloadPlugin(const juce::String& manifestId);
 
+    //-- Protocol helpers (shared with EmbeddedPythonRuntime) ----------------
+
+    /// Parse a CustomPluginManifest from a JSON var.
+    static CustomPluginManifest parseManifest(const juce::var& v);
+
+    /// Parse the "properties" array of a "created" response.
+    static std::vector<CustomPluginProperty> parseProperties(const juce::var& propsVar);
+
+    /// Parse a render command from a JSON var.
+    static PluginRender::RenderCommand parseRenderCommand(const juce::var& v);
+
     //-- Error callback ------------------------------------------------------
 
     /// Called on bridge errors (subprocess crash, protocol errors, etc.)
@@ -210,25 +325,68 @@ private:
     PythonPluginBridge(const PythonPluginBridge&) = delete;
     PythonPluginBridge& operator=(const PythonPluginBridge&) = delete;
 
+    using ResponseCallback = std::function<void(const juce::var& response)>;
+
     /// Send a JSON message to the Python subprocess and wait for response.
     /// @param timeoutMs  Max wait time in milliseconds (0 = use default).
     juce::var sendMessage(const juce::var& msg, DWORD timeoutMs = 0);
 
-    /// Parse a CustomPluginManifest from a JSON var.
-    static CustomPluginManifest parseManifest(const juce::var& v);
+    /// Send a JSON message without waiting.  @p onResponse (may be null)
+    /// is called on the reader thread with the response, or with a void var
+    /// if the deadline passes or the subprocess goes away first; it must not
+    /// call back into the bridge.
+    void sendMessageAsync(const juce::var& msg, ResponseCallback onResponse, DWORD timeoutMs = 0);
 
-    /// Parse a render command from a JSON var.
-    static PluginRender::RenderCommand parseRenderCommand(const juce::var& v);
+    //-- Request multiplexing ------------------------------------------------
+    class ResponseReader;
+
+    struct PendingRequest
+    {
+        juce::int64         id = 0;
+        juce::WaitableEvent done;
+        juce::var           response;
+        ResponseCallback    callback;
+        juce::uint32        deadlineMs = 0;   ///< Time::getMillisecondCounter() value
+    };
+
+    /// Tag @p msg with a new id, register @p request and write the line.
+    /// Returns false (and unregisters) if the pipe could not be written.
+    bool postRequest(const juce::var& msg, const std::shared_ptr<PendingRequest>& request);
+
+    /// Unregister a request nobody has answered yet.  Returns false if the
+    /// reader thread has already claimed it.
+    bool withdrawRequest(juce::int64 id);
+
+    /// Restart the subprocess if it has died.  Called with pipeLock held.
+    bool ensureRunning();
+
+    // Called on the reader thread
+    void dispatchResponse(const juce::var& response);
+    void failPendingRequests();
+    DWORD expirePendingRequests();     ///< ms until the next deadline, or INFINITE
+
+    void finishRequest(const std::shared_ptr<PendingRequest>& request, const juce::var& response);
+
+    /// Threads for in-process renders (created on first use)
+    juce::ThreadPool& getRenderPool();
 
     //-- Members -------------------------------------------------------------
     std::vector<CustomPluginManifest>         cachedManifests;
-    juce::CriticalSection                     pipeLock;
-    bool                                      running = false;
+    juce::CriticalSection                     pipeLock;    ///< pipe writes and process lifecycle
+    std::atomic<bool>                         running { false };
+
+    juce::CriticalSection                                    pendingLock_;
+    std::map<juce::int64, std::shared_ptr<PendingRequest>>   pending_;
+    std::atomic<juce::int64>                                 nextRequestId_ { 1 };
+    std::unique_ptr<ResponseReader>                          reader_;
+
+    juce::CriticalSection                     renderPoolLock_;
+    std::unique_ptr<juce::ThreadPool>         renderPool_;
 
     //-- Error recovery state ------------------------------------------------
     juce::File  lastPluginsDir_;    ///< Remembered for restart
     juce::String lastPythonExe_;   ///< Remembered for restart
-    int          restartCount_ = 0;
+    std::atomic<int> restartCount_ { 0 };
     bool         insideScan_   = false;  ///< Guard against recursive scan during restart
     static constexpr int kMaxRestarts = 5;
 
@@ -253,6 +411,16 @@ private:
  * This reduces per-frame IPC overhead from ~500µs to ~5µs.
  *
  * Layout matches the Python AudioSharedMemoryReader in shared_memory.py.
+ *
+ * Version 2 appends a feature block after the waveform (FeatureExtractor
+ * results: u32 block size, then centroid, flux, rolloff, flatness, pitch,
+ * pitch confidence, chroma[12], mfcc[13] as float32).  Everything before it
+ * is unchanged, so version-1 readers keep working.
+ *
+ * Version 3 appends a history block after that: the last kHistorySeconds of
+ * MetricHistory, kHistoryPoints min/max/mean buckets per metric (u32 block
+ * size, u32 metric count, u32 bucket capacity, u32 buckets valid, f32 window
+ * seconds, then metric-major {min, max, mean} float32 triples, oldest first).
  */
 class AudioSharedMemory
 {
@@ -261,8 +429,14 @@ public:
     ~AudioSharedMemory() { destroy(); }
 
     static constexpr uint32_t kMagic   = 0x4D584D41; // "MXMA"
-    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kVersion = 3;
     static constexpr int kHeaderSize   = 236;
+    static constexpr int kFeatureFloats = 6 + FeatureExtractor::kChromaBins + FeatureExtractor::kNumMFCC;
+    static constexpr int kFeatureBlockSize = 4 + kFeatureFloats * 4;
+    static constexpr int kHistoryMetrics = static_cast<int>(MetricHistory::Metric::NumMetrics);
+    static constexpr int kHistoryPoints  = 256;
+    static constexpr float kHistorySeconds = 30.0f;
+    static constexpr int kHistoryBlockSize = 20 + kHistoryMetrics * kHistoryPoints * 12;
     static constexpr int kMaxChannels  = 8;
     static constexpr int kChannelStride = 20; // 5 × float32
     static constexpr const char* kShmName = "MaxiMeter_AudioSHM";
@@ -271,7 +445,9 @@ public:
     bool create(int fftSize = 4096, int waveformSize = 1024)
     {
         int spectrumCount = fftSize / 2 + 1;
-        bufferSize = kHeaderSize + spectrumCount * 4 + waveformSize * 4;
+        featureOffset = kHeaderSize + spectrumCount * 4 + waveformSize * 4;
+        historyOffset = featureOffset + kFeatureBlockSize;
+        bufferSize = historyOffset + kHistoryBlockSize;
 
 #if JUCE_WINDOWS
         hMapFile = CreateFileMappingA(
@@ -290,6 +466,13 @@ public:
         writeU32(12, (uint32_t)bufferSize);
         writeU32(24, (uint32_t)fftSize);
         writeU32(28, (uint32_t)waveformSize);
+        writeU32(featureOffset, (uint32_t)kFeatureBlockSize);
+        writeU32(historyOffset,      (uint32_t)kHistoryBlockSize);
+        writeU32(historyOffset + 4,  (uint32_t)kHistoryMetrics);
+        writeU32(historyOffset + 8,  (uint32_t)kHistoryPoints);
+        writeU32(historyOffset + 12, 0);
+        writeF32(historyOffset + 16, kHistorySeconds);
+        historyPoints.reserve(kHistoryPoints);
 
         this->fftSize = fftSize;
         this->waveformSize = waveformSize;
@@ -340,6 +523,45 @@ public:
         memcpy(pBuf + kHeaderSize + spectrumBytes, data, count * sizeof(float));
     }
 
+    /// Write the feature block (version 2).
+    void writeFeatures(const FeatureExtractor::Features& f)
+    {
+        if (!pBuf) return;
+        int off = featureOffset + 4;
+        for (float v : { f.centroidHz, f.flux, f.rolloffHz, f.flatness, f.pitchHz, f.pitchConfidence })
+        {
+            writeF32(off, v);
+            off += 4;
+        }
+        memcpy(pBuf + off, f.chroma.data(), f.chroma.size() * sizeof(float));
+        off += (int)(f.chroma.size() * sizeof(float));
+        memcpy(pBuf + off, f.mfcc.data(), f.mfcc.size() * sizeof(float));
+    }
+
+    /// Write the history block (version 3): the last kHistorySeconds of
+    /// every metric in @p history.
+    void writeHistory(const MetricHistory& history)
+    {
+        if (!pBuf) return;
+        int valid = 0;
+        for (int m = 0; m < kHistoryMetrics; ++m)
+        {
+            const int n = history.query(static_cast<MetricHistory::Metric>(m), kHistorySeconds,
+                                        kHistoryPoints, historyPoints);
+            valid = (m == 0) ? n : juce::jmin(valid, n);
+
+            int off = historyOffset + 20 + m * kHistoryPoints * 12;
+            for (int i = 0; i < n; ++i, off += 12)
+            {
+                const auto& p = historyPoints[static_cast<size_t>(i)];
+                writeF32(off, p.min);
+                writeF32(off + 4, p.max);
+                writeF32(off + 8, p.mean);
+            }
+        }
+        writeU32(historyOffset + 12, (uint32_t)valid);
+    }
+
     /// Write all scalar fields and increment frame counter.
     void writeFrame(float sampleRate, int numChannels, bool isPlaying,
                     float positionSec, float durationSec,
@@ -379,6 +601,9 @@ private:
 
     uint8_t* pBuf = nullptr;
     int bufferSize = 0;
+    int featureOffset = 0;
+    int historyOffset = 0;
+    std::vector<MetricHistory::Point> historyPoints;
     int fftSize = 4096;
     int waveformSize = 1024;
     uint32_t frameCounter = 0;
@@ -395,7 +620,7 @@ private:
  * Helper to serialise the current audio analysis state to a JSON string
  * compatible with the Python AudioData format.
  *
- * Call this once per frame and pass the result to renderInstance().
+ * Superseded by PluginAudioFrame, which renderBatch() takes directly.
  */
 namespace AudioDataSerialiser
 {
@@ -0,0 +1,178 @@
+#include "RenderGraph.h"
+#include "MeterFactory.h"
+#include "../Audio/StemBank.h"
+#include "../UI/ShapeComponent.h"
+#include <algorithm>
+#include <iterator>
+
+//==============================================================================
+RenderGraph::NodeKind RenderGraph::classify(MeterType type)
+{
+    switch (type)
+    {
+        case MeterType::WinampSkin:
+        case MeterType::SkinnedPlayer:  return NodeKind::Transport;
+        case MeterType::WaveformView:
+        case MeterType::VideoLayer:     return NodeKind::Timeline;
+        case MeterType::CustomPlugin:   return NodeKind::Plugin;
+        case MeterType::Equalizer:
+        case MeterType::ImageLayer:
+        case MeterType::TextLabel:      return NodeKind::Static;
+        default:                        return isShape(type) ? NodeKind::Static
+                                                             : NodeKind::Analysis;
+    }
+}
+
+bool RenderGraph::isShape(MeterType type)
+{
+    return type == MeterType::ShapeRectangle
+        || type == MeterType::ShapeEllipse
+        || type == MeterType::ShapeTriangle
+        || type == MeterType::ShapeLine
+        || type == MeterType::ShapeStar
+        || type == MeterType::ShapeSVG;
+}
+
+//==============================================================================
+void RenderGraph::build(const std::vector<CanvasItem*>& items, StemBank* stems)
+{
+    sources.clear();
+    nodes.clear();
+    sources.push_back({});      // the mix
+
+    for (auto* item : items)
+    {
+        if (item == nullptr || !item->visible)
+            continue;
+
+        ItemNode node;
+        node.item = item;
+        node.kind = classify(item->meterType);
+
+        const auto stemId = MeterFactory::resolveAudioSource(*item, stems);
+        if (stemId.isNotEmpty())
+        {
+            auto it = std::find_if(sources.begin(), sources.end(),
+                                   [&](const SourceNode& s) { return s.stemId == stemId; });
+            if (it == sources.end())
+            {
+                sources.push_back({ stemId, stems->getAnalyzers(stemId), {} });
+                it = std::prev(sources.end());
+            }
+            node.source = static_cast<int>(std::distance(sources.begin(), it));
+        }
+
+        sources[static_cast<size_t>(node.source)].items.push_back(static_cast<int>(nodes.size()));
+        nodes.push_back(node);
+    }
+}
+
+Analysis::Requirements RenderGraph::bindSources(StemBank* stems) const
+{
+    auto itemsOf = [this](const SourceNode& source)
+    {
+        std::vector<const CanvasItem*> items;
+        for (int index : source.items)
+            items.push_back(nodes[static_cast<size_t>(index)].item);
+        return items;
+    };
+
+    if (stems != nullptr)
+    {
+        for (const auto& id : stems->getStemIds())
+        {
+            auto it = std::find_if(sources.begin(), sources.end(),
+                                   [&](const SourceNode& s) { return s.stemId == id; });
+            const bool used = it != sources.end();
+            stems->setUsage(id, used, used ? MeterFactory::collectAnalysisRequirements(itemsOf(*it))
+                                           : Analysis::Requirements {});
+        }
+    }
+
+    return MeterFactory::collectAnalysisRequirements(itemsOf(sources.front()));
+}
+
+//==============================================================================
+void RenderGraph::feed(MeterFactory& factory, const FrameContext& ctx, bool includePlugins) const
+{
+    for (const auto& node : nodes)
+    {
+        auto& item = *node.item;
+        // Culled items catch up from the analysers on their next feed,
+        // except those that build up their own history
+        if (!item.component || !(item.isRenderedLive() || meterKeepsOwnHistory(item.meterType)))
+            continue;
+        if (node.kind == NodeKind::Plugin && !includePlugins)
+            continue;
+
+        factory.feedMeter(item, sources[static_cast<size_t>(node.source)].analyzers, ctx);
+    }
+}
+
+//==============================================================================
+void RenderGraph::strokeShapeOverlay(juce::Graphics& g, const CanvasItem& item,
+                                     juce::Rectangle<float> screenRect, float scale,
+                                     juce::Rectangle<float> clipArea, bool includeCentre)
+{
+    if (!isShape(item.meterType) || item.strokeWidth <= 0.0f)
+        return;
+
+    const auto align = static_cast<StrokeAlignment>(item.strokeAlignment);
+    if (align == StrokeAlignment::Inside)
+        return;
+    if (align == StrokeAlignment::Center && !includeCentre)
+        return;
+
+    auto* sc = dynamic_cast<ShapeComponent*>(item.component.get());
+    if (sc == nullptr)
+        return;
+
+    // Cached path from ShapeComponent (local coords) -> target coords
+    auto localBounds = sc->getLocalBounds().toFloat();
+    if (localBounds.getWidth() <= 0.0f || localBounds.getHeight() <= 0.0f)
+        return;
+
+    const float sx = screenRect.getWidth()  / localBounds.getWidth();
+    const float sy = screenRect.getHeight() / localBounds.getHeight();
+
+    juce::Path shapePath = sc->getCachedPath();
+    shapePath.applyTransform(juce::AffineTransform::scale(sx, sy)
+                                 .translated(screenRect.getX(), screenRect.getY()));
+
+    if (item.rotation != 0)
+    {
+        auto centre = screenRect.getCentre();
+        const float rad = static_cast<float>(item.rotation) * juce::MathConstants<float>::pi / 180.0f;
+        shapePath.applyTransform(juce::AffineTransform::rotation(rad, centre.x, centre.y));
+    }
+
+    const float alpha   = juce::jlimit(0.0f, 1.0f, item.opacity);
+    const float strokeW = item.strokeWidth * scale;
+
+    juce::PathStrokeType::EndCapStyle cap = juce::PathStrokeType::butt;
+    switch (static_cast<LineCap>(item.lineCap))
+    {
+        case LineCap::Butt:   cap = juce::PathStrokeType::butt;    break;
+        case LineCap::Round:  cap = juce::PathStrokeType::rounded; break;
+        case LineCap::Square: cap = juce::PathStrokeType::square;  break;
+    }
+
+    g.setColour(item.strokeColour.withMultipliedAlpha(alpha));
+
+    if (align == StrokeAlignment::Center)
+    {
+        g.strokePath(shapePath, juce::PathStrokeType(strokeW, juce::PathStrokeType::mitered, cap));
+    }
+    else // Outside
+    {
+        // Clip to outside the shape using even-odd rule, draw 2x width
+        juce::Path outsideClip;
+        outsideClip.addRectangle(clipArea);
+        outsideClip.addPath(shapePath);
+        outsideClip.setUsingNonZeroWinding(false);
+
+        juce::Graphics::ScopedSaveState ss(g);
+        g.reduceClipRegion(outsideClip);
+        g.strokePath(shapePath, juce::PathStrokeType(strokeW * 2.0f, juce::PathStrokeType::mitered, cap));
+    }
+}
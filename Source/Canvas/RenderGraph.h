@@ -0,0 +1,112 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "CanvasItem.h"
+#include "../Audio/AnalysisGraph.h"
+#include <vector>
+
+class MeterFactory;
+class StemBank;
+struct AnalyzerSet;
+
+//==============================================================================
+/// RenderGraph — one canvas frame as data:
+///
+///     analysis sources (mix, stems) -> item nodes -> compositor
+///
+/// Built from a list of CanvasItems by the live canvas (CanvasEditor) and the
+/// exporter (OfflineRenderer) alike, then executed two ways:
+///
+///   - live scheduler:       CanvasEditor feeds the on-screen nodes every
+///                           timer tick and the component tree paints them;
+///   - offline frame-stepper: OfflineRenderer feeds every node once per video
+///                           frame with a stepped clock and composites them
+///                           into an image.
+///
+/// Source binding, per-node feeding, culling and the shape stroke pass live
+/// here, so both paths get them from the same code.
+class RenderGraph
+{
+public:
+    /// What drives a node each frame.
+    enum class NodeKind
+    {
+        Analysis,   ///< reads its source's analyzers (meters)
+        Transport,  ///< follows the transport (skinned player, Winamp skin)
+        Timeline,   ///< self-timed live; positioned from the clock when stepped
+        Plugin,     ///< renders through the plugin bridge
+        Static      ///< shapes, text, images, EQ — nothing to feed
+    };
+
+    struct SourceNode
+    {
+        juce::String        stemId;                 ///< empty = main mix
+        AnalyzerSet*        analyzers = nullptr;    ///< nullptr = main mix
+        std::vector<int>    items;                  ///< indices into getItems()
+    };
+
+    struct ItemNode
+    {
+        CanvasItem*  item   = nullptr;
+        NodeKind     kind   = NodeKind::Static;
+        int          source = 0;                    ///< index into getSources()
+    };
+
+    /// Transport state and mix samples for one executed frame.
+    struct FrameContext
+    {
+        enum class PlayState { Stopped, Playing, Paused };
+
+        PlayState     playState = PlayState::Stopped;
+        double        position  = 0.0;      ///< seconds
+        double        length    = 0.0;      ///< seconds
+        juce::String  title;
+
+        /// True when the executor steps time itself (export).  Timeline
+        /// nodes are then positioned from `position`, their own timers being
+        /// off.
+        bool          stepped = false;
+
+        /// Latest mono mix samples; nullptr = read them from the AudioEngine.
+        const float*  mixMono      = nullptr;
+        int           mixMonoCount = 0;
+    };
+
+    //-- Building ------------------------------------------------------------
+
+    /// Rebuild the nodes from @p items (hidden items are left out).  Items
+    /// bound to a stem loaded in @p stems get that stem as their source.
+    void build(const std::vector<CanvasItem*>& items, StemBank* stems);
+
+    /// Install each stem's usage in @p stems (stems no item reads are not
+    /// analysed at all) and return what the mix source's items read.
+    Analysis::Requirements bindSources(StemBank* stems) const;
+
+    const std::vector<SourceNode>& getSources() const { return sources; }
+    const std::vector<ItemNode>&   getItems()   const { return nodes; }
+
+    //-- Execution -----------------------------------------------------------
+
+    /// Feed every node that is rendered live (culled and thumbnail items are
+    /// skipped unless meterKeepsOwnHistory()).  Plugin nodes are only fed when @p includePlugins is set —
+    /// the exporter batches them through its own offline instances.
+    void feed(MeterFactory& factory, const FrameContext& ctx, bool includePlugins) const;
+
+    //-- Compositor ----------------------------------------------------------
+
+    /// Stroke the part of a shape's outline its component cannot draw inside
+    /// its own bounds: Outside strokes always, Center strokes too when
+    /// @p includeCentre (offscreen components are clipped at their edges).
+    /// @p screenRect is the item's bounds in the target, @p scale the canvas-
+    /// to-target scale and @p clipArea the whole target.
+    static void strokeShapeOverlay(juce::Graphics& g, const CanvasItem& item,
+                                   juce::Rectangle<float> screenRect, float scale,
+                                   juce::Rectangle<float> clipArea, bool includeCentre);
+
+    static NodeKind classify(MeterType type);
+    static bool isShape(MeterType type);
+
+private:
+    std::vector<SourceNode> sources;    ///< [0] is always the mix
+    std::vector<ItemNode>   nodes;
+};
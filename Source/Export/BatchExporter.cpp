@@ -13,14 +13,22 @@ BatchExporter::~BatchExporter()
 
 //==============================================================================
 void BatchExporter::addJob(const Export::Settings& settings)
+{
+    addJob(settings, Export::RenderScene::capture(canvasModel_));
+}
+
+void BatchExporter::addJob(const Export::Settings& settings,
+                           std::shared_ptr<const Export::RenderScene> scene)
 {
     Job job;
     job.settings = settings;
+    job.scene    = std::move(scene);
     jobs_.push_back(std::move(job));
 }
 
 void BatchExporter::clearJobs()
 {
+    stopEstimating();
     if (isRunning()) cancelAll();
     jobs_.clear();
     currentJobIndex_ = -1;
@@ -31,6 +39,7 @@ void BatchExporter::startAll()
 {
     if (isRunning()) return;
 
+    stopEstimating();
     cancelRequested_ = false;
     currentJobIndex_ = -1;
 
@@ -47,6 +56,7 @@ void BatchExporter::startAll()
 
 void BatchExporter::cancelAll()
 {
+    stopEstimating();
     cancelRequested_ = true;
 
     if (currentRenderer_)
@@ -68,19 +78,35 @@ void BatchExporter::cancelAll()
 }
 
 //==============================================================================
-void BatchExporter::startNextJob()
+int BatchExporter::pickNextJob() const
 {
-    ++currentJobIndex_;
-
-    // Find next pending job
-    while (currentJobIndex_ < static_cast<int>(jobs_.size()))
+    // Shortest estimated job first, so quick renders are not stuck behind a
+    // long one; jobs without an estimate keep their queue order after them
+    int best = -1;
+    for (int i = 0; i < static_cast<int>(jobs_.size()); ++i)
     {
-        if (jobs_[static_cast<size_t>(currentJobIndex_)].state == Job::State::Pending)
-            break;
-        ++currentJobIndex_;
+        const auto& j = jobs_[static_cast<size_t>(i)];
+        if (j.state != Job::State::Pending)
+            continue;
+
+        if (best < 0)
+        {
+            best = i;
+            continue;
+        }
+
+        const auto& b = jobs_[static_cast<size_t>(best)];
+        if (j.estimate.valid && (!b.estimate.valid || j.estimate.seconds < b.estimate.seconds))
+            best = i;
     }
+    return best;
+}
 
-    if (currentJobIndex_ >= static_cast<int>(jobs_.size()) || cancelRequested_)
+void BatchExporter::startNextJob()
+{
+    currentJobIndex_ = pickNextJob();
+
+    if (currentJobIndex_ < 0 || cancelRequested_)
     {
         // All done
         currentRenderer_.reset();
@@ -91,12 +117,68 @@ void BatchExporter::startNextJob()
     auto& job = jobs_[static_cast<size_t>(currentJobIndex_)];
     job.state = Job::State::Running;
 
-    currentRenderer_ = std::make_unique<OfflineRenderer>(
-        job.settings, canvasModel_, audioEngine_);
+    currentRenderer_ = RenderFarm::createJob(job.settings, job.scene, audioEngine_);
     currentRenderer_->addListener(this);
     currentRenderer_->startThread();
 }
 
+//==============================================================================
+void BatchExporter::estimateAll()
+{
+    if (isRunning() || isEstimating())
+        return;
+
+    estimatingIndex_ = -1;
+    estimateNextJob();
+}
+
+void BatchExporter::estimateNextJob()
+{
+    // Next job that is still to render and has no estimate
+    do
+        ++estimatingIndex_;
+    while (estimatingIndex_ < static_cast<int>(jobs_.size())
+           && (jobs_[static_cast<size_t>(estimatingIndex_)].state != Job::State::Pending
+               || jobs_[static_cast<size_t>(estimatingIndex_)].estimate.valid));
+
+    if (estimatingIndex_ >= static_cast<int>(jobs_.size()))
+    {
+        stopEstimating();
+        return;
+    }
+
+    const auto& job = jobs_[static_cast<size_t>(estimatingIndex_)];
+    estimator_ = std::make_unique<ExportEstimator>(job.settings, job.scene, audioEngine_);
+    estimator_->onFinished = [this](const Export::CostEstimate& estimate)
+    {
+        jobs_[static_cast<size_t>(estimatingIndex_)].estimate = estimate;
+        listeners_.call(&Listener::batchJobEstimated, estimatingIndex_, estimate);
+        estimateNextJob();
+    };
+    estimator_->start();
+}
+
+void BatchExporter::stopEstimating()
+{
+    estimator_.reset();
+    estimatingIndex_ = -1;
+}
+
+double BatchExporter::getEstimatedSecondsRemaining() const
+{
+    double seconds = 0.0;
+    for (const auto& j : jobs_)
+    {
+        if (!j.estimate.valid)
+            continue;
+        if (j.state == Job::State::Pending)
+            seconds += j.estimate.seconds;
+        else if (j.state == Job::State::Running)
+            seconds += j.estimate.seconds * (1.0 - j.progress);
+    }
+    return seconds;
+}
+
 //==============================================================================
 void BatchExporter::renderingProgress(float progress, int /*curFrame*/,
                                        int /*totalFrames*/, double /*eta*/)
@@ -2,30 +2,38 @@
 
 #include <JuceHeader.h>
 #include "ExportSettings.h"
-#include "OfflineRenderer.h"
+#include "RenderFarm.h"
+#include "ExportEstimator.h"
 #include "../Canvas/CanvasModel.h"
 #include "../Audio/AudioEngine.h"
 
 //==============================================================================
 /// Manages a queue of video export jobs.  Runs them sequentially, notifying
-/// listeners on progress and completion of each job.
+/// listeners on progress and completion of each job.  Each job renders the
+/// scene as it was when the job was added, so the project can keep changing
+/// while the queue runs.
+///
+/// Jobs with a pre-flight estimate (estimateAll) run shortest first; the
+/// rest follow in queue order.
 ///
 /// Usage:
 ///   BatchExporter batch(canvasModel, audioEngine);
 ///   batch.addJob(settings1);
 ///   batch.addJob(settings2);
 ///   batch.startAll();
-class BatchExporter : public OfflineRenderer::Listener
+class BatchExporter : public Export::RenderJob::Listener
 {
 public:
     //-- Export job descriptor  ------------------------------------------------
     struct Job
     {
         Export::Settings settings;
+        std::shared_ptr<const Export::RenderScene> scene;
         enum class State { Pending, Running, Done, Failed, Cancelled };
         State  state = State::Pending;
         float  progress = 0.0f;
         juce::String resultMessage;
+        Export::CostEstimate estimate;      ///< valid once estimateAll() reached it
     };
 
     //-- Listener  -------------------------------------------------------------
@@ -36,14 +44,19 @@ public:
         virtual void batchJobFinished(int jobIndex, bool success,
                                       const juce::String& msg) {}
         virtual void batchAllFinished() {}
+        virtual void batchJobEstimated(int jobIndex, const Export::CostEstimate& estimate) {}
     };
 
     BatchExporter(CanvasModel& model, AudioEngine& engine);
     ~BatchExporter();
 
-    /// Add a job to the queue.
+    /// Add a job that renders the canvas as it is now.
     void addJob(const Export::Settings& settings);
 
+    /// Add a job that renders a previously captured @p scene.
+    void addJob(const Export::Settings& settings,
+                std::shared_ptr<const Export::RenderScene> scene);
+
     /// Remove all pending jobs.
     void clearJobs();
 
@@ -59,10 +72,18 @@ public:
 
     bool isRunning() const { return currentRenderer_ != nullptr; }
 
+    /// Pre-flight every job that has no estimate yet, one after another.
+    /// Does nothing while the queue is rendering.
+    void estimateAll();
+    bool isEstimating() const { return estimator_ != nullptr; }
+
+    /// Predicted seconds for the unfinished jobs that have an estimate.
+    double getEstimatedSecondsRemaining() const;
+
     void addListener(Listener* l)    { listeners_.add(l); }
     void removeListener(Listener* l) { listeners_.remove(l); }
 
-    //-- OfflineRenderer::Listener  --------------------------------------------
+    //-- RenderJob::Listener  --------------------------------------------------
     void renderingProgress(float progress, int curFrame, int totalFrames,
                            double eta) override;
     void renderingFinished(bool success, const juce::String& msg) override;
@@ -73,12 +94,18 @@ private:
 
     std::vector<Job>  jobs_;
     int               currentJobIndex_ = -1;
-    std::unique_ptr<OfflineRenderer> currentRenderer_;
+    std::unique_ptr<Export::RenderJob> currentRenderer_;
     bool              cancelRequested_ = false;
 
+    std::unique_ptr<ExportEstimator> estimator_;
+    int               estimatingIndex_ = -1;
+
     juce::ListenerList<Listener> listeners_;
 
     void startNextJob();
+    int  pickNextJob() const;
+    void estimateNextJob();
+    void stopEstimating();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BatchExporter)
 };
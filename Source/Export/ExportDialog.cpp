@@ -1,5 +1,6 @@
 #include "ExportDialog.h"
 #include "FFmpegProcess.h"
+#include "RenderFarm.h"
 #include "../UI/ThemeManager.h"
 
 //==============================================================================
@@ -124,6 +125,32 @@ ExportDialog::ExportDialog(const Export::Settings& initial,
         outputPathEdit_.setText(defaultOut.getFullPathName());
     }
 
+    addAndMakeVisible(farmWorkersLabel_);
+    farmWorkersLabel_.setText("Render Workers:", juce::dontSendNotification);
+    farmWorkersLabel_.setJustificationType(juce::Justification::centredRight);
+
+    addAndMakeVisible(farmWorkersSlider_);
+    farmWorkersSlider_.setRange(0, 16, 1);
+    farmWorkersSlider_.setValue(settings_.farmLocalWorkers);
+    farmWorkersSlider_.setTextBoxStyle(juce::Slider::TextBoxRight, false, 50, 24);
+    farmWorkersSlider_.setTooltip("Split the export across this many background processes. "
+                                  "0 renders in this window.");
+
+    addAndMakeVisible(farmRemoteToggle_);
+    farmRemoteToggle_.setToggleState(settings_.farmAcceptRemote, juce::dontSendNotification);
+    farmRemoteToggle_.setTooltip("Let workers on other machines join (MaxiMeter "
+                                 + juce::String(RenderFarm::kWorkerSwitch) + " <this-host>:"
+                                 + juce::String(settings_.farmPort) + " <token>). "
+                                 "Media must be reachable at the same paths.");
+    farmRemoteToggle_.onClick = [this] { farmTokenEdit_.setVisible(farmRemoteToggle_.getToggleState()); };
+
+    addChildComponent(farmTokenEdit_);
+    farmTokenEdit_.setReadOnly(true);
+    farmTokenEdit_.setText(settings_.farmToken.isNotEmpty() ? settings_.farmToken : RenderFarm::makeToken(),
+                           juce::dontSendNotification);
+    farmTokenEdit_.setTooltip("Token remote workers must pass after the address; new for every export.");
+    farmTokenEdit_.setVisible(settings_.farmAcceptRemote);
+
     addAndMakeVisible(browseButton_);
     browseButton_.onClick = [this]()
     {
@@ -234,12 +261,22 @@ ExportDialog::ExportDialog(const Export::Settings& initial,
     addAndMakeVisible(beatZoomToggle_);
     addPPSlider(beatZoomSlider_, beatZoomLabel_, "Amount:", 0.01, 0.3, 0.01, 0.05);
 
+    // --- Pre-flight estimate ---
+    addChildComponent(estimateButton_);
+    estimateButton_.setTooltip("Render a few sample frames with these settings to predict "
+                               "the export time and file size.");
+    estimateButton_.onClick = [this] { runEstimate(); };
+
+    addAndMakeVisible(estimateLabel_);
+    estimateLabel_.setJustificationType(juce::Justification::topLeft);
+    estimateLabel_.setFont(juce::Font(12.0f));
+
     // ── Move all controls (except buttons) into a scrollable viewport ──
     juce::Array<juce::Component*> toReparent;
     for (int i = 0; i < getNumChildComponents(); ++i)
     {
         auto* c = getChildComponent(i);
-        if (c != &exportButton_ && c != &cancelButton_)
+        if (c != &exportButton_ && c != &cancelButton_ && c != &estimateButton_)
             toReparent.add(c);
     }
 
@@ -279,6 +316,8 @@ void ExportDialog::resized()
     int btnY = getHeight() - bh - 12;
     exportButton_.setBounds(getWidth() - bw * 2 - 20, btnY, bw, bh);
     cancelButton_.setBounds(getWidth() - bw - 10,      btnY, bw, bh);
+    estimateButton_.setBounds(10, btnY, bw, bh);
+    estimateButton_.setVisible(createEstimator != nullptr);
 
     viewport_.setBounds(0, 0, getWidth(), btnY - 8);
     layoutContent();
@@ -328,9 +367,19 @@ void ExportDialog::layoutContent()
     browseButton_.setBounds(cx + rw - 84, y, 84, rh);
     y += rh + gap;
 
+    row(farmWorkersLabel_, farmWorkersSlider_);
+    farmRemoteToggle_.setBounds(cx, y, 180, rh);
+    farmTokenEdit_.setBounds(cx + 184, y, rw - 184, rh);
+    y += rh + gap;
+
     ffmpegStatusLabel_.setBounds(lx, y + 4, w - 20, 20);
     y += 28;
 
+    // Time, size and up to a handful of hot spots
+    const int estimateH = estimateLabel_.getText().isEmpty() ? 0 : 100;
+    estimateLabel_.setBounds(lx, y, w - 20, estimateH);
+    y += estimateH;
+
     y += 4;
     effectsHeader_.setBounds(lx, y, 200, 20);
     y += 24;
@@ -372,6 +421,29 @@ void ExportDialog::layoutContent()
     content_.setSize(w, y);
 }
 
+//==============================================================================
+void ExportDialog::runEstimate()
+{
+    if (createEstimator == nullptr)
+        return;
+
+    estimator_ = createEstimator(getSettings());
+    if (estimator_ == nullptr)
+        return;
+
+    estimateButton_.setEnabled(false);
+    estimateLabel_.setText("Rendering sample frames...", juce::dontSendNotification);
+    layoutContent();
+
+    estimator_->onFinished = [this](const Export::CostEstimate& estimate)
+    {
+        estimateLabel_.setText(estimate.describe(), juce::dontSendNotification);
+        estimateButton_.setEnabled(true);
+        layoutContent();
+    };
+    estimator_->start();
+}
+
 //==============================================================================
 Export::Settings ExportDialog::getSettings() const
 {
@@ -415,6 +487,11 @@ Export::Settings ExportDialog::getSettings() const
     s.audioFile  = audioFile_;
     s.outputFile = juce::File(outputPathEdit_.getText());
 
+    // Render farm
+    s.farmLocalWorkers = static_cast<int>(farmWorkersSlider_.getValue());
+    s.farmAcceptRemote = farmRemoteToggle_.getToggleState();
+    s.farmToken        = farmTokenEdit_.getText();
+
     // Post-processing
     s.postProcess.chromaticAberration = caToggle_.getToggleState();
     s.postProcess.caIntensity         = static_cast<float>(caSlider_.getValue());
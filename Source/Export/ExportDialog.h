@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "ExportSettings.h"
+#include "ExportEstimator.h"
 
 //==============================================================================
 /// Modal dialog for configuring video export settings.
@@ -22,6 +23,10 @@ public:
     /// Collect current UI state into an Export::Settings struct.
     Export::Settings getSettings() const;
 
+    /// Builds the pre-flight for the current settings.  The Estimate button
+    /// is only shown when this is set.
+    std::function<std::unique_ptr<ExportEstimator>(const Export::Settings&)> createEstimator;
+
     /// Recommended dialog size.
     static constexpr int kWidth  = 500;
     static constexpr int kHeight = 680;
@@ -57,6 +62,12 @@ private:
     juce::TextButton browseButton_  { "Browse..." };
     juce::Label      outputLabel_;
 
+    // Render farm
+    juce::Slider       farmWorkersSlider_;    ///< local worker processes, 0 = render in-process
+    juce::Label        farmWorkersLabel_;
+    juce::ToggleButton farmRemoteToggle_ { "Accept remote workers" };
+    juce::TextEditor   farmTokenEdit_;        ///< this export's worker token, to copy to other machines
+
     // ── Post-processing ──
     juce::ToggleButton caToggle_        { "Chromatic Aberration" };
     juce::Slider       caSlider_;
@@ -84,6 +95,11 @@ private:
     // FFmpeg status
     juce::Label      ffmpegStatusLabel_;
 
+    // Pre-flight estimate
+    juce::TextButton estimateButton_ { "Estimate" };
+    juce::Label      estimateLabel_;
+    std::unique_ptr<ExportEstimator> estimator_;
+
     // Scrollable content
     juce::Viewport   viewport_;
     juce::Component  content_;
@@ -97,6 +113,7 @@ private:
     void updateCustomSizeVisibility();
     void updateFileExtension();
     void checkFFmpeg();
+    void runEstimate();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ExportDialog)
 };
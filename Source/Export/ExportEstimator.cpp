@@ -0,0 +1,242 @@
+#include "ExportEstimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+namespace
+{
+    /// Rough FLAC bitrate for stereo 44.1/48 kHz material
+    constexpr int kFlacKbps = 900;
+
+    /// A stage above this share of the frame time is worth pointing out
+    constexpr double kHotStageShare = 0.30;
+
+    /// An item above this share of the render stage is worth pointing out
+    constexpr double kHotItemShare  = 0.10;
+
+    juce::String percent(double share)
+    {
+        return juce::String(juce::roundToInt(share * 100.0)) + "%";
+    }
+
+    bool usesTargetBitrate(Export::VideoCodec c)
+    {
+        return c == Export::VideoCodec::H264_MP4 || c == Export::VideoCodec::H265_MP4
+            || c == Export::VideoCodec::VP9_WebM;
+    }
+
+    /// Settings that make @p stage expensive, most likely culprit first.
+    juce::StringArray settingsBehind(const Export::Settings& s, int stage)
+    {
+        juce::StringArray why;
+        switch (stage)
+        {
+            case Export::RenderProfile::Encode:
+                if (s.videoCodec == Export::VideoCodec::H265_MP4)
+                    why.add("H.265 encodes several times slower than H.264");
+                if (s.videoCodec == Export::VideoCodec::VP9_WebM)
+                    why.add("VP9 encodes slowly");
+                if (s.videoCodec == Export::VideoCodec::PNG_Sequence)
+                    why.add("PNG compression runs on the render thread");
+                if (s.qualityPreset == Export::QualityPreset::Best && usesTargetBitrate(s.videoCodec))
+                    why.add("the Best quality preset uses the slow encoder preset");
+                break;
+
+            case Export::RenderProfile::Render:
+                if (s.getWidth() * s.getHeight() > 1920 * 1080)
+                    why.add(juce::String(s.getWidth()) + "x" + juce::String(s.getHeight())
+                            + " is " + juce::String(s.getWidth() * s.getHeight() / (1920.0 * 1080.0), 1)
+                            + "x the pixels of 1080p");
+                break;
+
+            case Export::RenderProfile::PostProcess:
+            {
+                const auto& pp = s.postProcess;
+                if (pp.chromaticAberration) why.add("chromatic aberration");
+                if (pp.vignette)            why.add("vignette");
+                if (pp.screenShake)         why.add("screen shake");
+                if (pp.beatZoom)            why.add("beat-sync zoom");
+                break;
+            }
+
+            case Export::RenderProfile::Audio:
+                if (s.stemFiles.size() > 0)
+                    why.add(juce::String(s.stemFiles.size()) + " stems analysed alongside the mix");
+                break;
+
+            default:
+                break;
+        }
+        return why;
+    }
+}
+
+//==============================================================================
+Export::CostEstimate Export::estimateFromProfile(const Settings& settings, const RenderProfile& profile)
+{
+    CostEstimate e;
+    e.profile = profile;
+    e.frames  = profile.timelineFrames;
+
+    if (profile.drawnFrames <= 0 || profile.analysedFrames <= 0 || profile.timelineFrames <= 0)
+    {
+        e.error = "The pre-flight did not render any frames.";
+        return e;
+    }
+
+    // A real export analyses every frame once and draws it once
+    double perStage[RenderProfile::NumStages];
+    for (int s = 0; s < RenderProfile::NumStages; ++s)
+    {
+        const bool perAnalysed = s == RenderProfile::Audio || s == RenderProfile::Meters
+                              || s == RenderProfile::Plugins;
+        perStage[s] = profile.stageSeconds[s] / (perAnalysed ? profile.analysedFrames : profile.drawnFrames);
+        e.secondsPerFrame += perStage[s];
+    }
+    e.seconds = e.secondsPerFrame * e.frames;
+
+    for (int s = 0; s < RenderProfile::NumStages; ++s)
+        e.stageShare[s] = e.secondsPerFrame > 0.0 ? perStage[s] / e.secondsPerFrame : 0.0;
+
+    if (profile.stageSeconds[RenderProfile::Encode] > 0.0)
+        e.encoderFps = profile.drawnFrames / profile.stageSeconds[RenderProfile::Encode];
+
+    //-- Size ------------------------------------------------------------------
+    const double duration = static_cast<double>(e.frames) / settings.getFPS();
+    e.videoBytes = static_cast<juce::int64>(static_cast<double>(profile.encodedBytes)
+                                            / profile.drawnFrames * e.frames);
+
+    // Rate-controlled encoders stay near their target over a long run even
+    // where a short sample overshoots
+    if (usesTargetBitrate(settings.videoCodec))
+        e.videoBytes = juce::jmin(e.videoBytes,
+                                  static_cast<juce::int64>(settings.bitrateMbps * 1.0e6 / 8.0 * duration));
+
+    if (settings.videoOnly || settings.videoCodec == VideoCodec::PNG_Sequence)
+        e.audioBytes = 0;
+    else if (settings.audioCodec == AudioCodec::Passthrough)
+        e.audioBytes = settings.audioFile.getSize();
+    else
+    {
+        const int kbps = settings.audioCodec == AudioCodec::FLAC ? kFlacKbps : settings.audioBitrateKbps;
+        e.audioBytes = static_cast<juce::int64>(kbps * 1000.0 / 8.0 * duration);
+    }
+
+    //-- Hot spots: items first (what the user can remove), then settings -----
+    const double renderSeconds = profile.stageSeconds[RenderProfile::Render];
+    auto items = profile.items;
+    std::sort(items.begin(), items.end(),
+              [](const auto& a, const auto& b) { return a.seconds > b.seconds; });
+
+    for (const auto& item : items)
+    {
+        const double share = renderSeconds > 0.0 ? item.seconds / renderSeconds : 0.0;
+        if (share < kHotItemShare || e.hotspots.size() >= 3)
+            break;
+        e.hotspots.add(item.name + " — " + percent(share) + " of rendering");
+    }
+
+    std::vector<int> stages;
+    for (int s = 0; s < RenderProfile::NumStages; ++s)
+        if (e.stageShare[s] >= kHotStageShare)
+            stages.push_back(s);
+    std::sort(stages.begin(), stages.end(),
+              [&e](int a, int b) { return e.stageShare[a] > e.stageShare[b]; });
+
+    for (int s : stages)
+    {
+        auto line = RenderProfile::stageName(s) + " — " + percent(e.stageShare[s]) + " of each frame";
+        const auto why = settingsBehind(settings, s);
+        if (!why.isEmpty())
+            line << " (" << why.joinIntoString(", ") << ")";
+        e.hotspots.add(line);
+    }
+
+    e.valid = true;
+    return e;
+}
+
+juce::String Export::CostEstimate::describe() const
+{
+    if (!valid)
+        return "Estimate failed: " + error;
+
+    juce::String text;
+    text << "Estimated time: " << juce::RelativeTime::seconds(seconds).getDescription()
+         << "  (" << juce::String(secondsPerFrame * 1000.0, 1) << " ms/frame, "
+         << juce::String(frames) << " frames)\n";
+    text << "Estimated size: " << juce::File::descriptionOfSizeInBytes(getTotalBytes());
+    if (encoderFps > 0.0)
+        text << ", encoder " << juce::String(encoderFps, 1) << " fps";
+    text << "\n";
+
+    for (const auto& h : hotspots)
+        text << "  - " << h << "\n";
+
+    return text.trimEnd();
+}
+
+//==============================================================================
+ExportEstimator::ExportEstimator(const Export::Settings& settings,
+                                 std::shared_ptr<const Export::RenderScene> scene,
+                                 AudioEngine& audioEngine)
+    : settings_(settings)
+{
+    // One in-process renderer; the audio is not muxed into the sample
+    auto sample = settings;
+    sample.farmLocalWorkers = 0;
+    sample.farmAcceptRemote = false;
+    sample.videoOnly        = true;
+
+    scratch_ = juce::File::createTempFile(sample.videoCodec == Export::VideoCodec::PNG_Sequence
+                                              ? juce::String("_preflight")
+                                              : Export::videoCodecExtension(sample.videoCodec));
+    sample.outputFile = scratch_;
+
+    renderer_ = std::make_unique<OfflineRenderer>(sample, std::move(scene), audioEngine);
+    renderer_->setProfileSampling(kSampleClusters, kFramesPerCluster, kWarmupFrames);
+    renderer_->addListener(this);
+}
+
+ExportEstimator::~ExportEstimator()
+{
+    alive_->store(false);
+    cancel();
+    renderer_->removeListener(this);
+    renderer_.reset();
+    scratch_.deleteRecursively();
+}
+
+void ExportEstimator::start()
+{
+    if (!renderer_->isThreadRunning())
+        renderer_->startThread();
+}
+
+void ExportEstimator::cancel()
+{
+    renderer_->cancel();
+    renderer_->stopThread(10000);
+}
+
+void ExportEstimator::renderingFinished(bool success, const juce::String& message)
+{
+    Export::CostEstimate estimate;
+    if (success)
+        estimate = Export::estimateFromProfile(settings_, renderer_->getProfile());
+    else
+        estimate.error = message;
+
+    scratch_.deleteRecursively();
+
+    // Deferred: the renderer is still calling its listeners
+    juce::MessageManager::callAsync([this, alive = alive_, estimate]
+    {
+        if (alive->load() && onFinished)
+        {
+            auto callback = onFinished;     // the owner may delete this from it
+            callback(estimate);
+        }
+    });
+}
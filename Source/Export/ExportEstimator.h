@@ -0,0 +1,85 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include "ExportSettings.h"
+#include "RenderProfile.h"
+#include "RenderScene.h"
+#include "OfflineRenderer.h"
+#include "../Audio/AudioEngine.h"
+
+namespace Export
+{
+
+//==============================================================================
+/// Prediction for one export, made from a pre-flight RenderProfile.
+struct CostEstimate
+{
+    bool         valid = false;
+    juce::String error;                 ///< why the pre-flight failed
+
+    int          frames          = 0;
+    double       secondsPerFrame = 0.0;
+    double       seconds         = 0.0; ///< whole export, rendered in one process
+    juce::int64  videoBytes      = 0;
+    juce::int64  audioBytes      = 0;
+    double       encoderFps      = 0.0; ///< what the encoder alone keeps up with
+
+    double            stageShare[RenderProfile::NumStages] = {};   ///< of secondsPerFrame
+    juce::StringArray hotspots;         ///< costliest items and settings first
+
+    RenderProfile profile;
+
+    juce::int64 getTotalBytes() const { return videoBytes + audioBytes; }
+
+    /// A few lines for the export dialog.
+    juce::String describe() const;
+};
+
+/// Scale the sampled costs in @p profile up to the whole export.
+CostEstimate estimateFromProfile(const Settings& settings, const RenderProfile& profile);
+
+} // namespace Export
+
+//==============================================================================
+/// Pre-flight for an export: renders a short sample of frames spread over
+/// the track through the real OfflineRenderer path — analysis, meters,
+/// plugins, post-processing and the chosen encoder — into a scratch file
+/// that is thrown away, then predicts total time and output size.
+///
+/// Runs on the renderer's thread; onFinished arrives on the message thread.
+class ExportEstimator : private Export::RenderJob::Listener
+{
+public:
+    static constexpr int kSampleClusters   = 5;    ///< places in the track
+    static constexpr int kFramesPerCluster = 12;   ///< drawn and encoded at each
+    static constexpr int kWarmupFrames     = 6;    ///< analysed before each
+
+    ExportEstimator(const Export::Settings& settings,
+                    std::shared_ptr<const Export::RenderScene> scene,
+                    AudioEngine& audioEngine);
+    ~ExportEstimator() override;
+
+    void start();
+    void cancel();
+
+    bool  isRunning() const   { return renderer_ != nullptr && renderer_->isThreadRunning(); }
+    float getProgress() const { return renderer_ != nullptr ? renderer_->getProgress() : 0.0f; }
+
+    /// Called on the message thread when the pre-flight ends; may delete
+    /// this estimator.
+    std::function<void(const Export::CostEstimate&)> onFinished;
+
+private:
+    void renderingProgress(float, int, int, double) override {}
+    void renderingFinished(bool success, const juce::String& message) override;
+
+    Export::Settings                 settings_;
+    juce::File                       scratch_;    ///< sample output, deleted afterwards
+    std::unique_ptr<OfflineRenderer> renderer_;
+
+    /// Checked by the deferred onFinished call, which may outlive this
+    std::shared_ptr<std::atomic<bool>> alive_ = std::make_shared<std::atomic<bool>>(true);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ExportEstimator)
+};
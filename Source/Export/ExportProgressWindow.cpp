@@ -162,7 +162,7 @@ void ExportProgressWindow::ContentComp::showErrorLog(const juce::String& logText
 //==============================================================================
 // ExportProgressWindow
 //==============================================================================
-ExportProgressWindow::ExportProgressWindow(std::unique_ptr<OfflineRenderer> renderer)
+ExportProgressWindow::ExportProgressWindow(std::unique_ptr<Export::RenderJob> renderer)
     : juce::DocumentWindow("Exporting Video...",
                            ThemeManager::getInstance().getPalette().windowBg,
                            juce::DocumentWindow::closeButton),
@@ -234,7 +234,7 @@ void ExportProgressWindow::timerCallback()
 void ExportProgressWindow::renderingProgress(float progress, int currentFrame,
                                               int totalFrames, double etaSec)
 {
-    // Already on the message thread (OfflineRenderer calls via MessageManager::callAsync)
+    // Already on the message thread (RenderJob calls via MessageManager::callAsync)
     content_.progressValue_ = static_cast<double>(progress);
     content_.frameLabel_.setText(
         "Frame " + juce::String(currentFrame) + " / " + juce::String(totalFrames),
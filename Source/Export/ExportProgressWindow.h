@@ -1,7 +1,7 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "OfflineRenderer.h"
+#include "RenderJob.h"
 #include "../UI/SkinnedTitleBarLookAndFeel.h"
 #include "../UI/ThemeManager.h"
 
@@ -9,11 +9,11 @@
 /// Floating window that shows export progress — progress bar, frame counter,
 /// estimated time remaining, pause/resume and cancel buttons.
 class ExportProgressWindow : public juce::DocumentWindow,
-                             public OfflineRenderer::Listener,
+                             public Export::RenderJob::Listener,
                              public juce::Timer
 {
 public:
-    ExportProgressWindow(std::unique_ptr<OfflineRenderer> renderer);
+    ExportProgressWindow(std::unique_ptr<Export::RenderJob> renderer);
     ~ExportProgressWindow() override;
 
     void closeButtonPressed() override;
@@ -21,7 +21,7 @@ public:
     // Timer — polls for preview frames
     void timerCallback() override;
 
-    // OfflineRenderer::Listener
+    // RenderJob::Listener
     void renderingProgress(float progress, int currentFrame, int totalFrames,
                            double estimatedSecondsRemaining) override;
     void renderingFinished(bool success, const juce::String& message) override;
@@ -57,7 +57,7 @@ private:
         ExportProgressWindow& owner_;
     };
 
-    std::unique_ptr<OfflineRenderer>  renderer_;
+    std::unique_ptr<Export::RenderJob> renderer_;
     ContentComp                       content_;
     bool                              finished_ = false;
     SkinnedTitleBarLookAndFeel        titleBarLnf_;
@@ -176,11 +176,25 @@ struct Settings
 
     // Files
     juce::File  audioFile;               // source audio
+    juce::StringPairArray stemFiles;     // stem id -> file, analysed alongside audioFile
     juce::File  outputFile;              // destination video
 
     // Post-processing effects
     PostProcessSettings postProcess;
 
+    // Timeline segment (render-farm workers).  frameCount < 0 = to the end.
+    int         startFrame   = 0;
+    int         frameCount   = -1;
+    int         warmupFrames = 0;        // analysed before startFrame, not drawn
+    bool        videoOnly    = false;    // no audio stream (muxed after concatenation)
+    int         keyframeInterval = 0;    // fixed closed GOP length in frames, 0 = encoder default
+
+    // Render farm: split the export across worker processes (see RenderFarm.h)
+    int         farmLocalWorkers = 0;    // worker processes started on this machine
+    bool        farmAcceptRemote = false; // listen on every interface, not just loopback
+    int         farmPort     = 47810;
+    juce::String farmToken;              // secret workers must send; made per export when empty
+
     //-- Helpers ---------------------------------------------------------------
     int getWidth() const
     {
@@ -204,6 +218,8 @@ struct Settings
 
     int getFPS() const { return static_cast<int>(frameRate); }
 
+    bool usesRenderFarm() const { return farmLocalWorkers > 0 || farmAcceptRemote; }
+
     /// Wrap a path in double-quotes for command-line safety.
     static juce::String quoted(const juce::String& path)
     {
@@ -225,7 +241,10 @@ struct Settings
         args.add("-i");       args.add("pipe:0");
 
         // Input 1: audio file
-        args.add("-i");       args.add(quoted(audioFile.getFullPathName()));
+        if (!videoOnly)
+        {
+            args.add("-i");   args.add(quoted(audioFile.getFullPathName()));
+        }
 
         // Video encoder
         switch (videoCodec)
@@ -262,8 +281,26 @@ struct Settings
             default: break;
         }
 
+        // Fixed closed GOPs, so independently encoded segments join losslessly
+        if (keyframeInterval > 0)
+        {
+            const auto gop = juce::String(keyframeInterval);
+            args.add("-g");            args.add(gop);
+            args.add("-keyint_min");   args.add(gop);
+            args.add("-sc_threshold"); args.add("0");
+            if (videoCodec == VideoCodec::H265_MP4)
+            {
+                args.add("-x265-params");
+                args.add("keyint=" + gop + ":min-keyint=" + gop + ":scenecut=0:open-gop=0");
+            }
+        }
+
         // Audio encoder
-        if (audioCodec == AudioCodec::Passthrough)
+        if (videoOnly)
+        {
+            args.add("-an");
+        }
+        else if (audioCodec == AudioCodec::Passthrough)
         {
             args.add("-c:a"); args.add("copy");
         }
@@ -282,6 +319,38 @@ struct Settings
         return args;
     }
 
+    /// Join video-only segments listed in @p concatList (FFmpeg concat
+    /// demuxer format) without re-encoding and mux the audio file in.
+    juce::StringArray buildConcatArgs(const juce::File& ffmpegPath, const juce::File& concatList) const
+    {
+        juce::StringArray args;
+        args.add(quoted(ffmpegPath.getFullPathName()));
+        args.add("-y");
+
+        args.add("-f");       args.add("concat");
+        args.add("-safe");    args.add("0");
+        args.add("-i");       args.add(quoted(concatList.getFullPathName()));
+        args.add("-i");       args.add(quoted(audioFile.getFullPathName()));
+
+        args.add("-map");     args.add("0:v:0");
+        args.add("-map");     args.add("1:a:0");
+        args.add("-c:v");     args.add("copy");
+
+        if (audioCodec == AudioCodec::Passthrough)
+        {
+            args.add("-c:a"); args.add("copy");
+        }
+        else
+        {
+            args.add("-c:a"); args.add(ffmpegAudioEncoder(audioCodec));
+            args.add("-b:a"); args.add(juce::String(audioBitrateKbps) + "k");
+        }
+
+        args.add("-shortest");
+        args.add(quoted(outputFile.getFullPathName()));
+        return args;
+    }
+
     /// Build command line for a single PNG frame save (no FFmpeg needed).
     juce::File pngFramePath(int frameIndex) const
     {
@@ -21,19 +21,21 @@
 #include "../UI/VideoLayerComponent.h"
 #include "../UI/WaveformView.h"
 #include "../Canvas/CustomPluginComponent.h"
+#include "../Audio/MappedAudioReader.h"
 
 #include <cmath>
 #include <algorithm>
 
 //==============================================================================
 OfflineRenderer::OfflineRenderer(const Export::Settings& settings,
-                                 CanvasModel& canvasModel,
+                                 std::shared_ptr<const Export::RenderScene> scene,
                                  AudioEngine& audioEngine)
-    : juce::Thread("OfflineRenderer"),
+    : Export::RenderJob("OfflineRenderer"),
       settings_(settings),
-      canvasModel_(canvasModel),
+      scene_(std::move(scene)),
       audioEngine_(audioEngine),
-      offlineFactory_(audioEngine, offlineFft_, offlineLa_, offlineLoud_, offlineStereo_)
+      offlineFactory_(audioEngine, offlineFft_, offlineBands_, offlineLa_, offlineLoud_,
+                      offlineStereo_, offlineHistory_)
 {
 }
 
@@ -44,6 +46,13 @@ OfflineRenderer::~OfflineRenderer()
     cleanupOfflinePlugins();
 }
 
+void OfflineRenderer::setProfileSampling(int clusters, int framesPerCluster, int warmupFrames)
+{
+    sampleClusters_ = juce::jmax(0, clusters);
+    sampleFrames_   = juce::jmax(1, framesPerCluster);
+    sampleWarmup_   = juce::jmax(0, warmupFrames);
+}
+
 //==============================================================================
 void OfflineRenderer::run()
 {
@@ -51,8 +60,7 @@ void OfflineRenderer::run()
     juce::AudioFormatManager formatManager;
     formatManager.registerBasicFormats();
 
-    std::unique_ptr<juce::AudioFormatReader> reader(
-        formatManager.createReaderFor(settings_.audioFile));
+    auto reader = MappedAudio::createReader(formatManager, settings_.audioFile);
 
     if (!reader)
     {
@@ -65,17 +73,39 @@ void OfflineRenderer::run()
     const int numChannels     = static_cast<int>(reader->numChannels);
 
     //-- 2. Initialise offline analysis pipeline  -----------------------------
+    offlineFft_.getFeatureExtractor().setSampleRate(sampleRate);
     offlineFft_.reset();
+    offlineBands_.setSampleRate(sampleRate);
+    offlineBands_.reset();
     offlineLa_.setSampleRate(sampleRate);
     offlineLa_.reset();
     offlineLoud_.setSampleRate(sampleRate);
     offlineLoud_.reset();
     offlineStereo_.setSampleRate(sampleRate);
     offlineStereo_.reset();
+    offlineHistory_.setSampleRate(sampleRate);
 
-    //-- 3. Create offscreen items mirroring canvas  --------------------------
+    //-- 3. Create offscreen items from the scene  ----------------------------
     createOffscreenItems();
 
+    // Stems get their own analyzers; each source only runs what its items read
+    offlineStems_.setStems(settings_.stemFiles);
+    {
+        std::vector<CanvasItem*> items;
+        for (auto& item : offscreenItems_)
+            items.push_back(&item);
+        graph_.build(items, &offlineStems_);
+        offlineNeeds_ = graph_.bindSources(&offlineStems_);
+
+        const int order = offlineNeeds_.fftOrder > 0 ? offlineNeeds_.fftOrder
+                                                     : FFTProcessor::kDefaultFFTOrder;
+        if (order != offlineFft_.getFFTOrder())
+            offlineFft_.setFFTOrder(order);
+        offlineFft_.setFeaturesEnabled(offlineNeeds_.has(Analysis::Features));
+
+        offlineBands_.setBandsPerOctave(offlineNeeds_.bandsPerOctave > 0 ? offlineNeeds_.bandsPerOctave : 3);
+    }
+
     // Set sample rate on any spectrograms
     for (auto& item : offscreenItems_)
     {
@@ -115,6 +145,50 @@ void OfflineRenderer::run()
         return;
     }
 
+    // Segment of the timeline to draw (all of it unless a farm worker)
+    const int firstFrame = juce::jlimit(0, totalFrames, settings_.startFrame);
+    const int endFrame   = settings_.frameCount < 0 ? totalFrames
+                                                    : juce::jmin(totalFrames, firstFrame + settings_.frameCount);
+    const int warmStart  = juce::jmax(0, firstFrame - juce::jmax(0, settings_.warmupFrames));
+    const int segmentFrames = endFrame - firstFrame;
+
+    if (segmentFrames <= 0)
+    {
+        notifyFinished(false, "Segment starts after the end of the audio.");
+        return;
+    }
+
+    // Runs of frames to visit: the whole segment, or a pre-flight's samples
+    struct FrameRun { int warmStart, first, end; };
+    std::vector<FrameRun> runs;
+    const bool profiling = sampleClusters_ > 0;
+
+    if (profiling)
+    {
+        const int len      = juce::jmin(sampleFrames_, segmentFrames);
+        const int clusters = juce::jlimit(1, sampleClusters_, segmentFrames / len);
+        for (int c = 0; c < clusters; ++c)
+        {
+            // Centred in equal slices of the segment
+            const int first = firstFrame + static_cast<int>(static_cast<int64_t>(segmentFrames - len)
+                                                            * (2 * c + 1) / (2 * clusters));
+            runs.push_back({ juce::jmax(0, first - sampleWarmup_), first, first + len });
+        }
+
+        profile_ = {};
+        profile_.timelineFrames = segmentFrames;
+        for (const auto& item : offscreenItems_)
+            profile_.items.push_back({ item.name.isNotEmpty() ? item.name : meterTypeName(item.meterType) });
+    }
+    else
+    {
+        runs.push_back({ warmStart, firstFrame, endFrame });
+    }
+
+    int framesToDraw = 0;
+    for (const auto& r : runs)
+        framesToDraw += r.end - r.first;
+
     //-- 5. Start FFmpeg (or prepare PNG output dir)  -------------------------
     const bool isPngSequence = (settings_.videoCodec == Export::VideoCodec::PNG_Sequence);
 
@@ -147,10 +221,25 @@ void OfflineRenderer::run()
     juce::AudioBuffer<float> audioBuf(std::max(numChannels, 2), samplesPerFrame + 512);
 
     auto startTime = juce::Time::getMillisecondCounterHiRes();
+    int  done = 0;
+
+    // Pre-flight stage timer: charges the time since the last lap to a stage
+    auto lapStart = juce::Time::getHighResolutionTicks();
+    auto lap = [&](Export::RenderProfile::Stage stage)
+    {
+        if (!profiling)
+            return;
+        const auto now = juce::Time::getHighResolutionTicks();
+        profile_.stageSeconds[stage] += juce::Time::highResolutionTicksToSeconds(now - lapStart);
+        lapStart = now;
+    };
 
     //-- 7. Main render loop  -------------------------------------------------
-    for (int frame = 0; frame < totalFrames; ++frame)
+    for (const auto& span : runs)
+    for (int frame = span.warmStart; frame < span.end; ++frame)
     {
+        const bool warmingUp = frame < span.first;
+
         // Check for cancellation / exit
         if (threadShouldExit() || cancelled_.load())
         {
@@ -186,7 +275,14 @@ void OfflineRenderer::run()
             samplesToRead = 0;
 
         //-- 7b. Read & analyse audio  ----------------------------------------
+        lapStart = juce::Time::getHighResolutionTicks();
         currentFrame_ = frame;
+        imagePool_.beginFrame();
+        offlineFactory_.beginFrame();
+
+        // Stems run on the worker pool while this thread analyses the mix
+        offlineStems_.advanceTo(static_cast<double>(frameSampleEnd) / sampleRate);
+
         if (samplesToRead > 0)
         {
             audioBuf.setSize(std::max(numChannels, 2), samplesToRead, false, false, true);
@@ -200,14 +296,26 @@ void OfflineRenderer::run()
         // Process FFT bins on this thread (normally done on GUI thread)
         while (offlineFft_.processNextBlock()) {}
 
+        offlineStems_.waitForAnalysis();
+        lap(Export::RenderProfile::Audio);
+
         //-- 7c. Feed all offscreen meters  -----------------------------------
         feedOffscreenMeters();
+        lap(Export::RenderProfile::Meters);
 
         //-- 7c'. Feed custom plugin instances via bridge  --------------------
         feedOfflinePlugins();
+        lap(Export::RenderProfile::Plugins);
+        if (profiling)
+            ++profile_.analysedFrames;
+
+        // Warm-up frames only bring the analyzers and meters up to speed
+        if (warmingUp)
+            continue;
 
         //-- 7d. Render frame to Image  ---------------------------------------
         auto frameImage = renderFrame(videoW, videoH);
+        lap(Export::RenderProfile::Render);
 
         //-- 7d'. Post-processing effects  ------------------------------------
         if (postProcessor_)
@@ -218,6 +326,7 @@ void OfflineRenderer::run()
             postProcessor_->setCurrentRMS((rmsL + rmsR) * 0.5f);
             postProcessor_->processFrame(frameImage);
         }
+        lap(Export::RenderProfile::PostProcess);
 
         //-- 7e. Send to FFmpeg or save PNG  ----------------------------------
         if (isPngSequence)
@@ -228,6 +337,8 @@ void OfflineRenderer::run()
             {
                 juce::PNGImageFormat png;
                 png.writeImageToStream(frameImage, fos);
+                if (profiling)
+                    profile_.encodedBytes += fos.getPosition();
             }
         }
         else
@@ -243,16 +354,24 @@ void OfflineRenderer::run()
                 return;
             }
         }
+        lap(Export::RenderProfile::Encode);
+        if (profiling)
+            ++profile_.drawnFrames;
+
+        lastFramePoolMisses_.store(imagePool_.getFrameAllocations()
+                                       + offlineFactory_.getFrameAllocations(),
+                                   std::memory_order_relaxed);
 
         //-- 7f. Update progress  ---------------------------------------------
-        float prog = static_cast<float>(frame + 1) / totalFrames;
+        ++done;
+        float prog = static_cast<float>(done) / framesToDraw;
         progress_.store(prog);
 
         double elapsed = (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
-        double eta = (elapsed / (frame + 1)) * (totalFrames - frame - 1);
+        double eta = (elapsed / done) * (framesToDraw - done);
 
         // Notify every 5 frames (avoid excessive listener calls)
-        if ((frame % 5 == 0) || frame == totalFrames - 1)
+        if ((frame % 5 == 0) || done == framesToDraw)
         {
             if (!isPngSequence)
                 ffmpeg_.drainStderr();   // prevent stderr pipe deadlock
@@ -263,13 +382,11 @@ void OfflineRenderer::run()
                 const float aspect = static_cast<float>(frameImage.getHeight())
                                    / static_cast<float>(frameImage.getWidth());
                 const int prevH = static_cast<int>(prevW * aspect);
-                auto preview = frameImage.rescaled(prevW, prevH,
-                    juce::Graphics::lowResamplingQuality);
-                const juce::SpinLock::ScopedLockType sl(previewLock_);
-                previewImage_ = std::move(preview);
+                setLatestPreview(frameImage.rescaled(prevW, prevH,
+                    juce::Graphics::lowResamplingQuality));
             }
 
-            notifyProgress(prog, frame + 1, totalFrames, eta);
+            notifyProgress(prog, done, framesToDraw, eta);
         }
     }
 
@@ -279,7 +396,12 @@ void OfflineRenderer::run()
     //-- 9. Finish  -----------------------------------------------------------
     if (!isPngSequence)
     {
+        lapStart = juce::Time::getHighResolutionTicks();
         int exitCode = ffmpeg_.finish();
+        lap(Export::RenderProfile::Encode);     // encoder catching up with its queue
+        if (profiling)
+            profile_.encodedBytes = settings_.outputFile.getSize();
+
         if (exitCode != 0)
         {
             notifyFinished(false,
@@ -289,7 +411,7 @@ void OfflineRenderer::run()
         }
     }
 
-    notifyFinished(true, "Export complete! " + juce::String(totalFrames) + " frames rendered.");
+    notifyFinished(true, "Export complete! " + juce::String(framesToDraw) + " frames rendered.");
 }
 
 //==============================================================================
@@ -298,96 +420,43 @@ void OfflineRenderer::createOffscreenItems()
     offscreenItems_.clear();
     offlinePlugins_.clear();
 
-    for (int i = 0; i < canvasModel_.getNumItems(); ++i)
+    for (const auto& src : scene_->items)
     {
-        const auto* src = canvasModel_.getItem(i);
-        if (!src->visible) continue;
+        const auto type = src.props.meterType;
 
         CanvasItem copy;
-        copy.meterType     = src->meterType;
-        copy.x             = src->x;
-        copy.y             = src->y;
-        copy.width         = src->width;
-        copy.height        = src->height;
-        copy.rotation      = src->rotation;
-        copy.visible       = true;
-        copy.name          = src->name;
-        copy.opacity       = src->opacity;
-        copy.mediaFilePath = src->mediaFilePath;
-        copy.vuChannel     = src->vuChannel;
-
-        // Per-item background
-        copy.itemBackground = src->itemBackground;
-
-        // Meter colour overrides
-        copy.meterBgColour = src->meterBgColour;
-        copy.meterFgColour = src->meterFgColour;
-        copy.blendMode     = src->blendMode;
-
-        // Custom plugin IDs
-        copy.customPluginId    = src->customPluginId;
-        copy.customInstanceId  = src->customInstanceId;
-
-        // Shape properties
-        copy.fillColour1       = src->fillColour1;
-        copy.fillColour2       = src->fillColour2;
-        copy.gradientDirection = src->gradientDirection;
-        copy.cornerRadius      = src->cornerRadius;
-        copy.strokeColour      = src->strokeColour;
-        copy.strokeWidth       = src->strokeWidth;
-        copy.strokeAlignment   = src->strokeAlignment;
-        copy.lineCap           = src->lineCap;
-        copy.starPoints        = src->starPoints;
-        copy.triangleRoundness = src->triangleRoundness;
-
-        // Frosted glass
-        copy.frostedGlass  = src->frostedGlass;
-        copy.blurRadius    = src->blurRadius;
-        copy.frostTint     = src->frostTint;
-        copy.frostOpacity  = src->frostOpacity;
-
-        // Text properties
-        copy.textContent   = src->textContent;
-        copy.fontFamily    = src->fontFamily;
-        copy.fontSize      = src->fontSize;
-        copy.fontBold      = src->fontBold;
-        copy.fontItalic    = src->fontItalic;
-        copy.textColour    = src->textColour;
-        copy.textAlignment = src->textAlignment;
+        Export::RenderScene::copyItemProperties(src.props, copy);
 
         // For CustomPlugin items, create an offline bridge instance
         // instead of relying on the component's GL pipeline.
-        if (src->meterType == MeterType::CustomPlugin
-            && src->customPluginId.isNotEmpty())
+        if (type == MeterType::CustomPlugin
+            && src.props.customPluginId.isNotEmpty())
         {
             auto& bridge = PythonPluginBridge::getInstance();
-            if (bridge.isRunning())
+            if (bridge.isAvailable())
             {
                 auto offlineId = "offline_" + juce::Uuid().toString();
-                bridge.createInstance(src->customPluginId, offlineId);
 
-                // Transfer property values from the live instance
-                if (src->component)
+                // Copy the live instance (state and all) with the captured
+                // property values in one round trip; a fresh instance if it
+                // is gone, native, or lives in another process
+                if (!bridge.cloneInstance(src.props.customInstanceId, offlineId, src.pluginProperties))
                 {
-                    auto* liveCpc = dynamic_cast<CustomPluginComponent*>(src->component.get());
-                    if (liveCpc)
-                    {
-                        for (auto& prop : liveCpc->getPluginProperties())
-                            bridge.setProperty(offlineId, prop.key, prop.defaultVal);
-                    }
+                    bridge.createInstance(src.props.customPluginId, offlineId);
+                    bridge.setProperties(offlineId, src.pluginProperties);
                 }
 
                 OfflinePlugin info;
                 info.itemIndex         = static_cast<int>(offscreenItems_.size());
                 info.offlineInstanceId = offlineId;
-                info.manifestId        = src->customPluginId;
+                info.manifestId        = src.props.customPluginId;
                 offlinePlugins_.push_back(std::move(info));
 
                 copy.customInstanceId = offlineId;
             }
 
             // Create the component and initialise its GL pipeline
-            copy.component = offlineFactory_.createMeter(src->meterType);
+            copy.component = offlineFactory_.createMeter(type);
 
             // Initialise GL resources so shaders can render offline
             if (auto* cpc = dynamic_cast<CustomPluginComponent*>(copy.component.get()))
@@ -400,12 +469,12 @@ void OfflineRenderer::createOffscreenItems()
         }
         else
         {
-            copy.component = offlineFactory_.createMeter(src->meterType);
+            copy.component = offlineFactory_.createMeter(type);
         }
 
-        // Transfer component-specific settings from the live component
-        if (copy.component && src->component)
-            transferComponentSettings(src, &copy);
+        // Component-specific settings captured with the scene
+        if (copy.component)
+            Export::RenderScene::configureMeter(src, *copy.component);
 
         // Load media files for image/video layers
         if (copy.mediaFilePath.isNotEmpty())
@@ -413,12 +482,12 @@ void OfflineRenderer::createOffscreenItems()
             juce::File mediaFile(copy.mediaFilePath);
             if (mediaFile.existsAsFile())
             {
-                if (copy.meterType == MeterType::ImageLayer)
+                if (type == MeterType::ImageLayer)
                 {
                     if (auto* imgComp = dynamic_cast<ImageLayerComponent*>(copy.component.get()))
                         imgComp->loadFromFile(mediaFile);
                 }
-                else if (copy.meterType == MeterType::VideoLayer)
+                else if (type == MeterType::VideoLayer)
                 {
                     if (auto* vidComp = dynamic_cast<VideoLayerComponent*>(copy.component.get()))
                     {
@@ -431,7 +500,7 @@ void OfflineRenderer::createOffscreenItems()
         }
 
         // WaveformView: load thumbnail and enable offline position mode
-        if (copy.meterType == MeterType::WaveformView && copy.component)
+        if (type == MeterType::WaveformView && copy.component)
         {
             auto* wv = dynamic_cast<WaveformView*>(copy.component.get());
             if (wv)
@@ -447,242 +516,6 @@ void OfflineRenderer::createOffscreenItems()
     }
 }
 
-//==============================================================================
-void OfflineRenderer::transferComponentSettings(const CanvasItem* src, CanvasItem* dst)
-{
-    auto* srcComp = src->component.get();
-    auto* dstComp = dst->component.get();
-    if (!srcComp || !dstComp) return;
-
-    switch (src->meterType)
-    {
-        case MeterType::MultiBandAnalyzer:
-        {
-            auto* s = dynamic_cast<MultiBandAnalyzer*>(srcComp);
-            auto* d = dynamic_cast<MultiBandAnalyzer*>(dstComp);
-            if (s && d)
-            {
-                d->setDecayRate(s->getDecayRate());
-                d->setDynamicRange(s->getMinDb(), s->getMaxDb());
-                d->setNumBands(s->getNumBands());
-                d->setScaleMode(s->getScaleMode());
-            }
-            break;
-        }
-        case MeterType::Spectrogram:
-        {
-            auto* s = dynamic_cast<Spectrogram*>(srcComp);
-            auto* d = dynamic_cast<Spectrogram*>(dstComp);
-            if (s && d)
-            {
-                d->setColourMap(s->getColourMap());
-                d->setScrollDirection(s->getScrollDirection());
-                d->setDynamicRange(s->getMinDb(), s->getMaxDb());
-            }
-            break;
-        }
-        case MeterType::Goniometer:
-        {
-            auto* s = dynamic_cast<Goniometer*>(srcComp);
-            auto* d = dynamic_cast<Goniometer*>(dstComp);
-            if (s && d)
-            {
-                d->setDotSize(s->getDotSize());
-                d->setTrailOpacity(s->getTrailOpacity());
-                d->setShowGrid(s->getShowGrid());
-            }
-            break;
-        }
-        case MeterType::LissajousScope:
-        {
-            auto* s = dynamic_cast<LissajousScope*>(srcComp);
-            auto* d = dynamic_cast<LissajousScope*>(dstComp);
-            if (s && d)
-            {
-                d->setMode(s->getMode());
-                d->setTrailLength(s->getTrailLength());
-                d->setShowGrid(s->getShowGrid());
-            }
-            break;
-        }
-        case MeterType::LoudnessMeter:
-        {
-            auto* s = dynamic_cast<LoudnessMeter*>(srcComp);
-            auto* d = dynamic_cast<LoudnessMeter*>(dstComp);
-            if (s && d)
-            {
-                d->setTargetLUFS(s->getTargetLUFS());
-                d->setShowHistory(s->getShowHistory());
-            }
-            break;
-        }
-        case MeterType::LevelHistogram:
-        {
-            auto* s = dynamic_cast<LevelHistogram*>(srcComp);
-            auto* d = dynamic_cast<LevelHistogram*>(dstComp);
-            if (s && d)
-            {
-                d->setDisplayRange(s->getMinDb(), s->getMaxDb());
-                d->setBinResolution(s->getBinResolution());
-                d->setCumulative(s->getCumulative());
-                d->setShowStereo(s->getShowStereo());
-            }
-            break;
-        }
-        case MeterType::CorrelationMeter:
-        {
-            auto* s = dynamic_cast<CorrelationMeter*>(srcComp);
-            auto* d = dynamic_cast<CorrelationMeter*>(dstComp);
-            if (s && d)
-            {
-                d->setIntegrationTimeMs(s->getIntegrationTimeMs());
-                d->setShowNumeric(s->getShowNumeric());
-            }
-            break;
-        }
-        case MeterType::PeakMeter:
-        {
-            auto* s = dynamic_cast<PeakMeter*>(srcComp);
-            auto* d = dynamic_cast<PeakMeter*>(dstComp);
-            if (s && d)
-            {
-                d->setPeakMode(s->getPeakMode());
-                d->setPeakHoldTimeMs(s->getPeakHoldTimeMs());
-                d->setDecayRateDbPerSec(s->getDecayRateDbPerSec());
-                d->setShowClipWarning(s->getShowClipWarning());
-            }
-            break;
-        }
-        case MeterType::SkinnedVUMeter:
-        {
-            auto* s = dynamic_cast<SkinnedVUMeter*>(srcComp);
-            auto* d = dynamic_cast<SkinnedVUMeter*>(dstComp);
-            if (s && d)
-            {
-                d->setBallistic(s->getBallistic());
-                d->setDecayTimeMs(s->getDecayTimeMs());
-                d->setChannelLabel(dst->vuChannel == 1 ? "R" : "L");
-            }
-            break;
-        }
-        case MeterType::SkinnedSpectrum:
-        {
-            auto* s = dynamic_cast<SkinnedSpectrumAnalyzer*>(srcComp);
-            auto* d = dynamic_cast<SkinnedSpectrumAnalyzer*>(dstComp);
-            if (s && d)
-            {
-                d->setDecayRate(s->getDecayRate());
-                d->setNumBands(s->getNumBands());
-            }
-            break;
-        }
-        case MeterType::SkinnedOscilloscope:
-        {
-            auto* s = dynamic_cast<SkinnedOscilloscope*>(srcComp);
-            auto* d = dynamic_cast<SkinnedOscilloscope*>(dstComp);
-            if (s && d)
-            {
-                d->setLineThickness(s->getLineThickness());
-                d->setDrawStyle(s->getDrawStyle());
-            }
-            break;
-        }
-        case MeterType::WinampSkin:
-        {
-            auto* s = dynamic_cast<WinampSkinRenderer*>(srcComp);
-            auto* d = dynamic_cast<WinampSkinRenderer*>(dstComp);
-            if (s && d && s->hasSkin())
-                d->setSkinModel(&s->getSkinModel());
-            break;
-        }
-        case MeterType::SkinnedPlayer:
-        {
-            auto* s = dynamic_cast<SkinnedPlayerPanel*>(srcComp);
-            auto* d = dynamic_cast<SkinnedPlayerPanel*>(dstComp);
-            if (s && d && s->hasSkin())
-            {
-                // Transfer skin model pointer from live to offline component
-                // The SkinModel outlives the export since it lives in the main WinampSkinRenderer
-                d->setSkinModel(s->getSkinModel());
-                d->setScale(s->getScale());
-            }
-            break;
-        }
-        case MeterType::Equalizer:
-        {
-            auto* s = dynamic_cast<EqualizerPanel*>(srcComp);
-            auto* d = dynamic_cast<EqualizerPanel*>(dstComp);
-            if (s && d)
-            {
-                if (s->hasSkin())
-                    d->setSkinModel(s->getSkinModel());
-                d->setScale(s->getScale());
-                d->setEqOn(s->isEqOn());
-                d->setAutoOn(s->isAutoOn());
-                d->setPreamp(s->getPreamp());
-                for (int b = 0; b < EqualizerPanel::kNumBands; ++b)
-                    d->setBandGain(b, s->getBandGain(b));
-            }
-            break;
-        }
-        case MeterType::ShapeRectangle:
-        case MeterType::ShapeEllipse:
-        case MeterType::ShapeTriangle:
-        case MeterType::ShapeLine:
-        case MeterType::ShapeStar:
-        case MeterType::ShapeSVG:
-        {
-            auto* d = dynamic_cast<ShapeComponent*>(dstComp);
-            if (d)
-            {
-                d->setFillColour1(dst->fillColour1);
-                d->setFillColour2(dst->fillColour2);
-                d->setGradientDirection(dst->gradientDirection);
-                d->setCornerRadius(dst->cornerRadius);
-                d->setStrokeColour(dst->strokeColour);
-                d->setStrokeWidth(dst->strokeWidth);
-                d->setStrokeAlignment(static_cast<StrokeAlignment>(dst->strokeAlignment));
-                d->setLineCap(static_cast<LineCap>(dst->lineCap));
-                d->setStarPoints(dst->starPoints);
-                d->setTriangleRoundness(dst->triangleRoundness);
-                if (dst->svgPathData.isNotEmpty())
-                    d->setSvgPathData(dst->svgPathData);
-
-                d->setItemBackground(dst->itemBackground);
-                d->setFrostedGlass(dst->frostedGlass);
-                d->setBlurRadius(dst->blurRadius);
-                d->setFrostTint(dst->frostTint);
-                d->setFrostOpacity(dst->frostOpacity);
-            }
-            break;
-        }
-        case MeterType::TextLabel:
-        {
-            auto* d = dynamic_cast<TextLabelComponent*>(dstComp);
-            if (d)
-            {
-                d->setTextContent(dst->textContent);
-                d->setFontFamily(dst->fontFamily);
-                d->setFontSize(dst->fontSize);
-                d->setBold(dst->fontBold);
-                d->setItalic(dst->fontItalic);
-                d->setTextColour(dst->textColour);
-                d->setTextAlignment(dst->textAlignment);
-                d->setFillColour1(dst->fillColour1);
-                d->setFillColour2(dst->fillColour2);
-                d->setGradientDirection(dst->gradientDirection);
-                d->setCornerRadius(dst->cornerRadius);
-                d->setStrokeColour(dst->strokeColour);
-                d->setStrokeWidth(dst->strokeWidth);
-                d->setItemBackground(dst->itemBackground);
-            }
-            break;
-        }
-        default:
-            break;
-    }
-}
-
 //==============================================================================
 void OfflineRenderer::processAudioBlock(juce::AudioBuffer<float>& buffer,
                                          int numSamples, double /*sampleRate*/)
@@ -692,149 +525,64 @@ void OfflineRenderer::processAudioBlock(juce::AudioBuffer<float>& buffer,
                              ? buffer.getReadPointer(1)
                              : left;
 
+    const bool spectrum = offlineNeeds_.has(Analysis::Spectrum);
+
     // Mix to mono for FFT and store waveform for custom plugins
     offlineWaveformBuf_.resize(numSamples);
     for (int i = 0; i < numSamples; ++i)
     {
         float mono = (left[i] + right[i]) * 0.5f;
-        offlineFft_.pushSamples(&mono, 1);
+        if (spectrum)
+            offlineFft_.pushSamples(&mono, 1);
         offlineWaveformBuf_[i] = mono;
     }
 
+    // Fractional-octave filter bank
+    if (offlineNeeds_.has(Analysis::Bands))
+        offlineBands_.processSamples(left, right, numSamples);
+
     // Level analyzer
-    offlineLa_.processSamples(left, right, numSamples);
+    if (offlineNeeds_.has(Analysis::Levels))
+        offlineLa_.processSamples(left, right, numSamples);
 
     // Loudness analyzer
-    offlineLoud_.processSamples(left, right, numSamples);
+    if (offlineNeeds_.has(Analysis::Loudness))
+        offlineLoud_.processSamples(left, right, numSamples);
 
     // Stereo field analyzer
-    offlineStereo_.processSamples(left, right, numSamples);
+    if (offlineNeeds_.has(Analysis::Stereo))
+        offlineStereo_.processSamples(left, right, numSamples);
+
+    // Fixed-rate metric history
+    if (offlineNeeds_.has(Analysis::History))
+        offlineHistory_.processSamples(left, right, numSamples,
+                                       offlineLoud_.getMomentaryLUFS(),
+                                       offlineLoud_.getShortTermLUFS(),
+                                       offlineStereo_.getCorrelation());
 }
 
 //==============================================================================
 void OfflineRenderer::feedOffscreenMeters()
 {
-    for (auto& item : offscreenItems_)
-    {
-        // Skip CustomPlugin items — they are fed via feedOfflinePlugins()
-        if (item.meterType == MeterType::CustomPlugin)
-            continue;
-
-        // SkinnedOscilloscope: feed offline waveform directly
-        if (item.meterType == MeterType::SkinnedOscilloscope && item.component)
-        {
-            if (!offlineWaveformBuf_.empty())
-                static_cast<SkinnedOscilloscope*>(item.component.get())
-                    ->pushSamples(offlineWaveformBuf_.data(),
-                                  static_cast<int>(offlineWaveformBuf_.size()));
-
-            // Still apply MeterBase colours via factory path below
-            // but skip the audioEngine-dependent feedMeter
-            if (auto* mb = dynamic_cast<MeterBase*>(item.component.get()))
-            {
-                mb->setMeterBgColour(item.meterBgColour);
-                mb->setMeterFgColour(item.meterFgColour);
-                mb->setBlendMode(item.blendMode);
-                mb->setMeterFontSize(item.fontSize);
-                mb->setMeterFontFamily(item.fontFamily);
-            }
-            continue;
-        }
-
-        // VideoLayer: sync frame to export timeline
-        if (item.meterType == MeterType::VideoLayer && item.component)
-        {
-            auto* vid = dynamic_cast<VideoLayerComponent*>(item.component.get());
-            if (vid && vid->getFrameCount() > 0)
-            {
-                double posSeconds = static_cast<double>(currentFrame_) / fps_;
-                float videoFps = vid->getAverageFps();
-                if (videoFps <= 0.0f) videoFps = 30.0f;
-                int videoFrame = static_cast<int>(posSeconds * videoFps) % vid->getFrameCount();
-                vid->setCurrentFrame(videoFrame);
-            }
-            continue;
-        }
-
-        // WaveformView: update offline cursor position
-        if (item.meterType == MeterType::WaveformView && item.component)
-        {
-            auto* wv = dynamic_cast<WaveformView*>(item.component.get());
-            if (wv)
-            {
-                double posSeconds = static_cast<double>(currentFrame_) / fps_;
-                wv->setOfflinePosition(posSeconds);
-            }
-            if (auto* mb = dynamic_cast<MeterBase*>(item.component.get()))
-            {
-                mb->setMeterBgColour(item.meterBgColour);
-                mb->setMeterFgColour(item.meterFgColour);
-                mb->setBlendMode(item.blendMode);
-            }
-            continue;
-        }
-
-        // WinampSkin: feed offline transport state + spectrum
-        if (item.meterType == MeterType::WinampSkin && item.component)
-        {
-            auto* r = static_cast<WinampSkinRenderer*>(item.component.get());
-            if (r->hasSkin())
-            {
-                r->setPlayState(WinampSkinRenderer::PlayState::Playing);
-                double pos = static_cast<double>(currentFrame_) / fps_;
-                r->setTime(static_cast<int>(pos) / 60, static_cast<int>(pos) % 60);
-                r->setTitleText(fileName_);
-            }
-            continue;
-        }
-
-        // SkinnedPlayer: feed offline transport state + spectrum
-        if (item.meterType == MeterType::SkinnedPlayer && item.component)
-        {
-            auto* p = static_cast<SkinnedPlayerPanel*>(item.component.get());
-            if (p->hasSkin())
-            {
-                p->setPlayState(SkinnedPlayerPanel::PlayState::Playing);
-                double pos = static_cast<double>(currentFrame_) / fps_;
-                if (fileDuration_ > 0)
-                    p->setPosition(pos / fileDuration_);
-                p->setTime(static_cast<int>(pos) / 60, static_cast<int>(pos) % 60);
-                p->setTitleText(fileName_);
-
-                // Feed offline spectrum
-                const float* specData = offlineFft_.getSpectrumData();
-                int specSize = offlineFft_.getSpectrumSize();
-                if (specSize > 0 && specData)
-                {
-                    float bands20[20] = {};
-                    int binsPer = specSize / 20;
-                    if (binsPer < 1) binsPer = 1;
-                    for (int b = 0; b < 20; ++b)
-                    {
-                        float sum = 0.0f;
-                        for (int j = 0; j < binsPer; ++j)
-                        {
-                            int idx = b * binsPer + j;
-                            if (idx < specSize) sum += specData[idx];
-                        }
-                        float avg = sum / static_cast<float>(binsPer);
-                        bands20[b] = (avg > 1e-10f) ? 20.0f * std::log10(avg) : -60.0f;
-                    }
-                    p->setSpectrumData(bands20, 20);
-                }
-            }
-            continue;
-        }
-
-        offlineFactory_.feedMeter(item);
-    }
+    // Same nodes as the live canvas, on a stepped clock.  CustomPlugin nodes
+    // are left out — they are fed via feedOfflinePlugins().
+    RenderGraph::FrameContext ctx;
+    ctx.playState    = RenderGraph::FrameContext::PlayState::Playing;
+    ctx.position     = static_cast<double>(currentFrame_) / fps_;
+    ctx.length       = fileDuration_;
+    ctx.title        = fileName_;
+    ctx.stepped      = true;
+    ctx.mixMono      = offlineWaveformBuf_.data();
+    ctx.mixMonoCount = static_cast<int>(offlineWaveformBuf_.size());
+
+    graph_.feed(offlineFactory_, ctx, false);
 }
 
 //==============================================================================
 void OfflineRenderer::feedOfflinePlugins()
 {
     auto& bridge = PythonPluginBridge::getInstance();
-    if (!bridge.isRunning()) return;
+    if (!bridge.isAvailable()) return;
 
     // Capture spectrum for GL audio texture upload
     const float* specData = offlineFft_.getSpectrumData();
@@ -844,6 +592,10 @@ void OfflineRenderer::feedOfflinePlugins()
     else
         offlineSpectrumBuf_.clear();
 
+    // One shared audio snapshot and one bridge call for every plugin
+    std::vector<PluginRenderRequest> requests;
+    std::vector<OfflinePlugin*> targets;
+
     for (auto& plugin : offlinePlugins_)
     {
         if (plugin.offlineInstanceId.isEmpty()) continue;
@@ -853,111 +605,61 @@ void OfflineRenderer::feedOfflinePlugins()
         int w = std::max(1, static_cast<int>(item.width  * renderScale_));
         int h = std::max(1, static_cast<int>(item.height * renderScale_));
 
-        auto audioJson = buildOfflineAudioJson(item);
-
-        try
-        {
-            plugin.lastCommands = bridge.renderInstance(
-                plugin.offlineInstanceId, w, h, audioJson,
-                true /* forceJsonAudio — bypass SHM for offline export */);
-        }
-        catch (...)
-        {
-            plugin.lastCommands.clear();
-        }
+        requests.push_back({ plugin.offlineInstanceId, w, h,
+                             item.meterBgColour, item.meterFgColour });
+        targets.push_back(&plugin);
     }
-}
 
-//==============================================================================
-juce::String OfflineRenderer::buildOfflineAudioJson(const CanvasItem& item)
-{
-    juce::DynamicObject::Ptr audioObj = new juce::DynamicObject();
-
-    // Channels
-    juce::Array<juce::var> channelsArr;
-    {
-        juce::DynamicObject::Ptr leftCh = new juce::DynamicObject();
-        leftCh->setProperty("rms",         offlineLa_.getRMSLeft());
-        leftCh->setProperty("peak",        offlineLa_.getPeakLeft());
-        leftCh->setProperty("true_peak",   offlineLa_.getPeakLeft());
-        leftCh->setProperty("rms_linear",  offlineLa_.getRMSLeft());
-        leftCh->setProperty("peak_linear", offlineLa_.getPeakLeft());
-        channelsArr.add(juce::var(leftCh.get()));
-
-        juce::DynamicObject::Ptr rightCh = new juce::DynamicObject();
-        rightCh->setProperty("rms",         offlineLa_.getRMSRight());
-        rightCh->setProperty("peak",        offlineLa_.getPeakRight());
-        rightCh->setProperty("true_peak",   offlineLa_.getPeakRight());
-        rightCh->setProperty("rms_linear",  offlineLa_.getRMSRight());
-        rightCh->setProperty("peak_linear", offlineLa_.getPeakRight());
-        channelsArr.add(juce::var(rightCh.get()));
-    }
-    audioObj->setProperty("channels", channelsArr);
-    audioObj->setProperty("num_channels", 2);
+    if (requests.empty()) return;
 
-    // Loudness
-    audioObj->setProperty("lufs_momentary",  offlineLoud_.getMomentaryLUFS());
-    audioObj->setProperty("lufs_short_term", offlineLoud_.getShortTermLUFS());
-    audioObj->setProperty("lufs_integrated", offlineLoud_.getIntegratedLUFS());
-    audioObj->setProperty("loudness_range",  offlineLoud_.getLRA());
+    PluginAudioFrame audio;
+    buildOfflineAudioFrame(audio);
 
-    // Stereo
-    audioObj->setProperty("correlation", offlineStereo_.getCorrelation());
-
-    // Transport / metadata (so plugins see is_playing=true and correct position)
-    audioObj->setProperty("sample_rate",       sampleRate_);
-    audioObj->setProperty("is_playing",        true);
-    audioObj->setProperty("position_seconds",  static_cast<double>(currentFrame_) / fps_);
-    audioObj->setProperty("duration_seconds",  fileDuration_);
-
-    // Spectrum
-    const float* specData = offlineFft_.getSpectrumData();
-    int specSize = offlineFft_.getSpectrumSize();
-    if (specSize > 0 && specData)
+    std::vector<PluginRenderResult> results;
+    try
     {
-        juce::Array<juce::var> specArr;
-        juce::Array<juce::var> specLinArr;
-        int numBins = juce::jmin(specSize, 512);
-        for (int b = 0; b < numBins; ++b)
-        {
-            specArr.add(specData[b]);
-            specLinArr.add(juce::jlimit(0.0f, 1.0f, specData[b]));
-        }
-        audioObj->setProperty("spectrum", specArr);
-        audioObj->setProperty("spectrum_linear", specLinArr);
-        audioObj->setProperty("fft_size", specSize * 2);
+        results = bridge.renderBatch(requests, audio,
+                                     true /* forceJsonAudio — bypass SHM for offline export */);
     }
-
-    // Waveform (from latest offline processed block)
-    if (!offlineWaveformBuf_.empty())
+    catch (...)
     {
-        juce::Array<juce::var> waveArr;
-        for (auto s : offlineWaveformBuf_)
-            waveArr.add(s);
-        audioObj->setProperty("waveform", waveArr);
+        results.clear();
     }
+    results.resize(targets.size());
 
-    // Meter colours
-    {
-        auto bgC = item.meterBgColour;
-        auto fgC = item.meterFgColour;
-
-        juce::DynamicObject::Ptr bgObj = new juce::DynamicObject();
-        bgObj->setProperty("r", bgC.getFloatRed());
-        bgObj->setProperty("g", bgC.getFloatGreen());
-        bgObj->setProperty("b", bgC.getFloatBlue());
-        bgObj->setProperty("a", bgC.getFloatAlpha());
-        audioObj->setProperty("bg_color", juce::var(bgObj.get()));
-
-        juce::DynamicObject::Ptr fgObj = new juce::DynamicObject();
-        fgObj->setProperty("r", fgC.getFloatRed());
-        fgObj->setProperty("g", fgC.getFloatGreen());
-        fgObj->setProperty("b", fgC.getFloatBlue());
-        fgObj->setProperty("a", fgC.getFloatAlpha());
-        audioObj->setProperty("fg_color", juce::var(fgObj.get()));
-    }
+    for (size_t i = 0; i < targets.size(); ++i)
+        targets[i]->lastCommands = std::move(results[i].commands);
+}
 
-    return juce::JSON::toString(juce::var(audioObj.get()), true);
+//==============================================================================
+void OfflineRenderer::buildOfflineAudioFrame(PluginAudioFrame& frame)
+{
+    // Transport / metadata so plugins see is_playing=true and the right position
+    auto& snap = frame.snapshot;
+    snap.sampleRate  = static_cast<float>(sampleRate_);
+    snap.numChannels = 2;
+    snap.isPlaying   = 1;
+    snap.position    = static_cast<float>(static_cast<double>(currentFrame_) / fps_);
+    snap.duration    = static_cast<float>(fileDuration_);
+    snap.channels[0] = { offlineLa_.getRMSLeft(),  offlineLa_.getPeakLeft(),  offlineLa_.getPeakLeft() };
+    snap.channels[1] = { offlineLa_.getRMSRight(), offlineLa_.getPeakRight(), offlineLa_.getPeakRight() };
+
+    snap.lufsMomentary  = offlineLoud_.getMomentaryLUFS();
+    snap.lufsShortTerm  = offlineLoud_.getShortTermLUFS();
+    snap.lufsIntegrated = offlineLoud_.getIntegratedLUFS();
+    snap.loudnessRange  = offlineLoud_.getLRA();
+    snap.correlation    = offlineStereo_.getCorrelation();
+
+    // Spectrum (captured by feedOfflinePlugins) and the latest processed block
+    snap.fftSize   = static_cast<int32_t>(offlineSpectrumBuf_.size() * 2);
+    frame.spectrum = offlineSpectrumBuf_;
+    frame.waveform = offlineWaveformBuf_;
+
+    frame.finalise();
+
+    // Per-frame features (centroid, chroma, MFCC, pitch, ...)
+    if (offlineFft_.areFeaturesEnabled())
+        offlineFft_.getFeatureExtractor().getFeatures().writeTo(*frame.data.getDynamicObject());
 }
 
 //==============================================================================
@@ -975,7 +677,7 @@ void OfflineRenderer::cleanupOfflinePlugins()
 
     // Destroy bridge instances
     auto& bridge = PythonPluginBridge::getInstance();
-    if (bridge.isRunning())
+    if (bridge.isAvailable())
     {
         for (auto& plugin : offlinePlugins_)
         {
@@ -994,12 +696,12 @@ juce::Image OfflineRenderer::renderFrame(int videoW, int videoH)
 {
     // Use software-backed images for offline rendering (not Direct2D)
     // to avoid D2D single-context restrictions on background threads.
-    juce::Image image(juce::Image::RGB, videoW, videoH, true,
-                      juce::SoftwareImageType());
+    // Buffers come from the pool and are recycled on the next frame.
+    auto image = imagePool_.acquire(juce::Image::RGB, videoW, videoH);
     juce::Graphics g(image);
 
     // Paint canvas background
-    canvasModel_.background.paint(g, juce::Rectangle<float>(0, 0,
+    scene_->background.paint(g, juce::Rectangle<float>(0, 0,
         static_cast<float>(videoW), static_cast<float>(videoH)));
 
     // Compute content bounding box
@@ -1027,11 +729,14 @@ juce::Image OfflineRenderer::renderFrame(int videoW, int videoH)
     float offsetY = (videoH  - content.getHeight() * scale) * 0.5f;
 
     // Render each offscreen meter
+    const bool timeItems = sampleClusters_ > 0;
     for (int idx = 0; idx < (int)offscreenItems_.size(); ++idx)
     {
         auto& item = offscreenItems_[idx];
         if (!item.component) continue;
 
+        const auto itemStart = timeItems ? juce::Time::getHighResolutionTicks() : 0;
+
         float ix = (item.x - content.getX()) * scale + offsetX;
         float iy = (item.y - content.getY()) * scale + offsetY;
         float iw = item.width  * scale;
@@ -1039,12 +744,7 @@ juce::Image OfflineRenderer::renderFrame(int videoW, int videoH)
 
         // Compute stroke margin for shape types with outside / center alignment
         float margin = 0.0f;
-        bool isShape = (item.meterType == MeterType::ShapeRectangle
-                     || item.meterType == MeterType::ShapeEllipse
-                     || item.meterType == MeterType::ShapeTriangle
-                     || item.meterType == MeterType::ShapeLine
-                     || item.meterType == MeterType::ShapeStar
-                     || item.meterType == MeterType::ShapeSVG);
+        const bool isShape = RenderGraph::isShape(item.meterType);
 
         int pw = std::max(1, static_cast<int>(iw));
         int ph = std::max(1, static_cast<int>(ih));
@@ -1068,8 +768,7 @@ juce::Image OfflineRenderer::renderFrame(int videoW, int videoH)
         item.component->setSize(pw, ph);
 
         // Render the component to a sub-image (software-backed)
-        juce::Image meterImg(juce::Image::ARGB, pw, ph, true,
-                             juce::SoftwareImageType());
+        auto meterImg = imagePool_.acquire(juce::Image::ARGB, pw, ph);
         {
             juce::Graphics mg(meterImg);
 
@@ -1108,6 +807,7 @@ juce::Image OfflineRenderer::renderFrame(int videoW, int videoH)
                 // already-composited main image so paint() can blur it without
                 // needing a parent component.
                 ShapeComponent* frostSc = nullptr;
+                juce::Image backdrop;
                 if (isShape && item.frostedGlass && item.blurRadius > 0.0f)
                 {
                     frostSc = dynamic_cast<ShapeComponent*>(item.component.get());
@@ -1119,8 +819,8 @@ juce::Image OfflineRenderer::renderFrame(int videoW, int videoH)
                         int cropH = std::min(ph, videoH - cropY);
                         if (cropW > 0 && cropH > 0)
                         {
-                            auto backdrop = image.getClippedImage(
-                                { cropX, cropY, cropW, cropH }).createCopy();
+                            backdrop = imagePool_.acquire(image.getFormat(), cropW, cropH, false);
+                            ImageBufferPool::copyPixels(image, { cropX, cropY, cropW, cropH }, backdrop);
                             frostSc->setExternalBackdrop(backdrop);
                         }
                     }
@@ -1131,6 +831,8 @@ juce::Image OfflineRenderer::renderFrame(int videoW, int videoH)
                 // Clear external backdrop after paint
                 if (frostSc)
                     frostSc->clearExternalBackdrop();
+                if (backdrop.isValid())
+                    imagePool_.release(backdrop);
 
                 // Also paint children if any
                 for (int c = 0; c < item.component->getNumChildComponents(); ++c)
@@ -1170,70 +872,15 @@ juce::Image OfflineRenderer::renderFrame(int videoW, int videoH)
             g.setOpacity(1.0f);
         }
 
-        // ── Draw Center / Outside strokes directly on the main image ──
-        if (isShape && item.strokeWidth > 0.0f)
-        {
-            auto strokeAlign = static_cast<StrokeAlignment>(item.strokeAlignment);
-            if (strokeAlign != StrokeAlignment::Inside)
-            {
-                auto* sc = dynamic_cast<ShapeComponent*>(item.component.get());
-                if (sc)
-                {
-                    // Use cached path from ShapeComponent, transformed to screen coords
-                    juce::Rectangle<float> shapeRect(ix, iy, iw, ih);
-                    auto localBounds = sc->getLocalBounds().toFloat();
-                    if (localBounds.getWidth() > 0.0f && localBounds.getHeight() > 0.0f)
-                    {
-                        float sx = shapeRect.getWidth()  / localBounds.getWidth();
-                        float sy = shapeRect.getHeight() / localBounds.getHeight();
-
-                        juce::Path shapePath = sc->getCachedPath();
-                        shapePath.applyTransform(
-                            juce::AffineTransform::scale(sx, sy)
-                                .translated(shapeRect.getX(), shapeRect.getY()));
+        imagePool_.release(meterImg);
 
-                        // Apply rotation to the stroke path
-                        if (item.rotation != 0)
-                        {
-                            auto centre = shapeRect.getCentre();
-                            float rad = item.rotation * juce::MathConstants<float>::pi / 180.0f;
-                            shapePath.applyTransform(
-                                juce::AffineTransform::rotation(rad, centre.x, centre.y));
-                        }
-
-                        float screenStrokeW = item.strokeWidth * scale;
-
-                        juce::PathStrokeType::EndCapStyle cap = juce::PathStrokeType::butt;
-                        switch (static_cast<LineCap>(item.lineCap))
-                        {
-                            case LineCap::Butt:   cap = juce::PathStrokeType::butt;    break;
-                            case LineCap::Round:  cap = juce::PathStrokeType::rounded; break;
-                            case LineCap::Square: cap = juce::PathStrokeType::square;  break;
-                        }
-
-                        g.setColour(item.strokeColour.withMultipliedAlpha(alpha));
+        // ── Draw Center / Outside strokes directly on the main image ──
+        RenderGraph::strokeShapeOverlay(g, item, { ix, iy, iw, ih }, scale,
+                                        { 0.0f, 0.0f, (float) videoW, (float) videoH }, true);
 
-                        if (strokeAlign == StrokeAlignment::Center)
-                        {
-                            g.strokePath(shapePath, juce::PathStrokeType(screenStrokeW,
-                                                                          juce::PathStrokeType::mitered, cap));
-                        }
-                        else // Outside
-                        {
-                            juce::Path outsideClip;
-                            outsideClip.addRectangle(0.0f, 0.0f, (float)videoW, (float)videoH);
-                            outsideClip.addPath(shapePath);
-                            outsideClip.setUsingNonZeroWinding(false);
-
-                            juce::Graphics::ScopedSaveState ss(g);
-                            g.reduceClipRegion(outsideClip);
-                            g.strokePath(shapePath, juce::PathStrokeType(screenStrokeW * 2.0f,
-                                                                          juce::PathStrokeType::mitered, cap));
-                        }
-                    }
-                }
-            }
-        }
+        if (timeItems)
+            profile_.items[static_cast<size_t>(idx)].seconds += juce::Time::highResolutionTicksToSeconds(
+                juce::Time::getHighResolutionTicks() - itemStart);
     }
 
     return image;
@@ -1279,26 +926,3 @@ void OfflineRenderer::imageToRGB24(const juce::Image& img, std::vector<uint8_t>&
         }
     }
 }
-
-//==============================================================================
-void OfflineRenderer::notifyProgress(float prog, int curFrame, int totalFrames, double etaSec)
-{
-    auto aliveFlag = alive_;
-    auto* self = this;
-    juce::MessageManager::callAsync([aliveFlag, self, prog, curFrame, totalFrames, etaSec]()
-    {
-        if (aliveFlag->load())
-            self->listeners_.call(&Listener::renderingProgress, prog, curFrame, totalFrames, etaSec);
-    });
-}
-
-void OfflineRenderer::notifyFinished(bool success, const juce::String& msg)
-{
-    auto aliveFlag = alive_;
-    auto* self = this;
-    juce::MessageManager::callAsync([aliveFlag, self, success, msg]()
-    {
-        if (aliveFlag->load())
-            self->listeners_.call(&Listener::renderingFinished, success, msg);
-    });
-}
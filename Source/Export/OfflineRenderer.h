@@ -5,75 +5,83 @@
 #include "ExportSettings.h"
 #include "FFmpegProcess.h"
 #include "PostProcessor.h"
+#include "RenderJob.h"
+#include "RenderProfile.h"
+#include "RenderScene.h"
 #include "../Canvas/CanvasModel.h"
 #include "../Canvas/CanvasItem.h"
 #include "../Canvas/MeterFactory.h"
+#include "../Canvas/RenderGraph.h"
 #include "../Canvas/PythonPluginBridge.h"
 #include "../Canvas/PluginRenderReplayer.h"
 #include "../Audio/AudioEngine.h"
 #include "../Audio/FFTProcessor.h"
+#include "../Audio/OctaveBandAnalyzer.h"
 #include "../Audio/LevelAnalyzer.h"
 #include "../Audio/LoudnessAnalyzer.h"
 #include "../Audio/StereoFieldAnalyzer.h"
+#include "../Audio/StemBank.h"
+#include "../Utils/ImageBufferPool.h"
 
 //==============================================================================
 /// Offline renderer — runs on a background thread, reads audio block-by-block,
 /// feeds meters, renders each video frame to an Image, and pipes RGB24 data
 /// to FFmpeg (or saves PNG sequence).
-class OfflineRenderer : public juce::Thread
+///
+/// Everything it draws comes from an Export::RenderScene captured when the
+/// export was queued, so the live canvas carries on while it runs.
+///
+/// Settings::startFrame / frameCount limit it to one segment of the timeline
+/// (render-farm workers); the warm-up frames before the segment are analysed
+/// and fed to the meters but not drawn.
+///
+/// setProfileSampling() turns a run into a pre-flight: only a few short runs
+/// of frames spread over the timeline are drawn and encoded, and the time of
+/// every stage and item is recorded (see ExportEstimator).
+class OfflineRenderer : public Export::RenderJob
 {
 public:
-    //--  Listener for progress / completion  ----------------------------------
-    struct Listener
-    {
-        virtual ~Listener() = default;
-        virtual void renderingProgress(float progress, int currentFrame, int totalFrames,
-                                       double estimatedSecondsRemaining) = 0;
-        virtual void renderingFinished(bool success, const juce::String& message) = 0;
-    };
-
     OfflineRenderer(const Export::Settings& settings,
-                    CanvasModel& canvasModel,
+                    std::shared_ptr<const Export::RenderScene> scene,
                     AudioEngine& audioEngine);
     ~OfflineRenderer() override;
 
     //-- Thread entry point  ---------------------------------------------------
     void run() override;
 
-    //-- Control  --------------------------------------------------------------
-    void pause()    { paused_.store(true); }
-    void resume()   { paused_.store(false); }
-    void cancel()   { cancelled_.store(true); }
+    /// Image pool misses plus scratch arena overflows during the last
+    /// finished frame; zero once the pools have warmed up.  Only counts the
+    /// recycled buffers — the progress preview, plugin audio JSON, replayed
+    /// plugin commands and JUCE's own graphics state still allocate.
+    int getLastFramePoolMisses() const { return lastFramePoolMisses_.load(std::memory_order_relaxed); }
 
-    float getProgress() const   { return progress_.load(); }
-    bool  isPaused()    const   { return paused_.load(); }
-    bool  isCancelled() const   { return cancelled_.load(); }
+    /// Draw only @p clusters runs of @p framesPerCluster frames spread evenly
+    /// over the timeline, each after @p warmupFrames analysed ones, and time
+    /// every stage.  Call before startThread().
+    void setProfileSampling(int clusters, int framesPerCluster, int warmupFrames);
 
-    void addListener(Listener* l)    { listeners_.add(l); }
-    void removeListener(Listener* l) { listeners_.remove(l); }
-
-    //-- Preview frame (thread-safe)  ------------------------------------------
-    /// Returns a downscaled preview of the latest rendered frame, or null Image.
-    juce::Image getLatestPreview() const
-    {
-        const juce::SpinLock::ScopedLockType sl(previewLock_);
-        return previewImage_;
-    }
+    /// Costs measured by a sampled run.  Read once the thread has finished.
+    const Export::RenderProfile& getProfile() const { return profile_; }
 
 private:
     Export::Settings    settings_;
-    CanvasModel&        canvasModel_;
+    std::shared_ptr<const Export::RenderScene> scene_;   ///< immutable; shared with the queue
     AudioEngine&        audioEngine_;
 
     // Own offline analysis pipeline (independent from real-time)
     FFTProcessor          offlineFft_;
+    OctaveBandAnalyzer    offlineBands_;
     LevelAnalyzer         offlineLa_;
     LoudnessAnalyzer      offlineLoud_;
     StereoFieldAnalyzer   offlineStereo_;
+    MetricHistory         offlineHistory_;
+    Analysis::Requirements offlineNeeds_ { Analysis::All, 0 };  ///< analyzers the mix items read
+    StemBank              offlineStems_;   ///< stems, analysed in parallel with the mix
     MeterFactory          offlineFactory_;
 
-    // Offscreen items — mirror the canvas layout
+    // Offscreen items — built from the scene
     std::vector<CanvasItem> offscreenItems_;
+    RenderGraph             graph_;         ///< nodes over offscreenItems_, stepped per frame
 
     // FFmpeg process
     FFmpegProcess         ffmpeg_;
@@ -81,31 +89,16 @@ private:
     // Post-processing effects
     std::unique_ptr<Export::PostProcessor> postProcessor_;
 
-    // Status
-    std::atomic<float>    progress_   { 0.0f };
-    std::atomic<bool>     paused_     { false };
-    std::atomic<bool>     cancelled_  { false };
-
-    /// Shared flag checked by callAsync lambdas to avoid use-after-free
-    std::shared_ptr<std::atomic<bool>> alive_ =
-        std::make_shared<std::atomic<bool>>(true);
-
-    juce::ListenerList<Listener> listeners_;
-
     //-- Internal helpers  -----------------------------------------------------
     void createOffscreenItems();
-    void transferComponentSettings(const CanvasItem* src, CanvasItem* dst);
     void processAudioBlock(juce::AudioBuffer<float>& buffer, int numSamples, double sampleRate);
     void feedOffscreenMeters();
     void feedOfflinePlugins();
-    juce::String buildOfflineAudioJson(const CanvasItem& item);
+    void buildOfflineAudioFrame(PluginAudioFrame& frame);
     void cleanupOfflinePlugins();
     juce::Image renderFrame(int videoWidth, int videoHeight);
     void imageToRGB24(const juce::Image& img, std::vector<uint8_t>& outBuffer);
 
-    void notifyProgress(float prog, int curFrame, int totalFrames, double etaSec);
-    void notifyFinished(bool success, const juce::String& msg);
-
     //-- Offline custom plugin state  ------------------------------------------
     struct OfflinePlugin
     {
@@ -126,9 +119,15 @@ private:
     double                     sampleRate_    = 44100.0;
     juce::String               fileName_;
 
-    //-- Preview frame  --------------------------------------------------------
-    mutable juce::SpinLock     previewLock_;
-    juce::Image                previewImage_;
+    //-- Recycled frame buffers  -----------------------------------------------
+    ImageBufferPool            imagePool_;           ///< Frame, meter and backdrop images
+    std::atomic<int>           lastFramePoolMisses_ { 0 };
+
+    //-- Pre-flight sampling  --------------------------------------------------
+    int                        sampleClusters_ = 0;  ///< 0 = render the whole segment
+    int                        sampleFrames_   = 0;
+    int                        sampleWarmup_   = 0;
+    Export::RenderProfile      profile_;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderer)
 };
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <algorithm>
 #include <random>
+#include "../Utils/ImageBufferPool.h"
 
 namespace Export
 {
@@ -76,6 +77,23 @@ private:
     float currentRMS_ = 0.0f;
     float zoomLevel_  = 0.0f;   ///< current beat-zoom level (decays per frame)
     std::mt19937 rng_;
+    juce::Image  scratch_;      ///< reusable snapshot buffer (avoids per-frame createCopy)
+
+    /// Copy the current frame into scratch_, reallocating only if the
+    /// frame size or format changed.
+    const juce::Image& snapshot(const juce::Image& image)
+    {
+        if (scratch_.isNull()
+            || scratch_.getFormat() != image.getFormat()
+            || scratch_.getBounds() != image.getBounds())
+        {
+            scratch_ = juce::Image(image.getFormat(), image.getWidth(), image.getHeight(),
+                                   false, juce::SoftwareImageType());
+        }
+
+        ImageBufferPool::copyPixels(image, image.getBounds(), scratch_);
+        return scratch_;
+    }
 
     //==========================================================================
     void applyChromaticAberration(juce::Image& image)
@@ -88,7 +106,7 @@ private:
         if (settings_.shakeBeatSync)
             offset *= (0.3f + currentRMS_ * 0.7f);
 
-        auto src = image.createCopy();  // snapshot
+        auto& src = snapshot(image);
         juce::Image::BitmapData srcData(src, juce::Image::BitmapData::readOnly);
         juce::Image::BitmapData dstData(image, juce::Image::BitmapData::readWrite);
 
@@ -173,7 +191,7 @@ private:
 
         if (dx == 0 && dy == 0) return;
 
-        auto src = image.createCopy();
+        auto& src = snapshot(image);
         juce::Graphics g(image);
         g.fillAll(juce::Colours::black);
         g.drawImageAt(src, dx, dy);
@@ -189,23 +207,15 @@ private:
         if (zoomLevel_ < 0.001f) return;
 
         float scale = 1.0f + zoomLevel_;
-        int w = image.getWidth();
-        int h = image.getHeight();
-        int newW = static_cast<int>(w * scale);
-        int newH = static_cast<int>(h * scale);
-
-        // Upscale into a temp image
-        auto zoomed = image.rescaled(newW, newH, juce::Graphics::highResamplingQuality);
-
-        // Crop center region back to original size
-        int cropX = (newW - w) / 2;
-        int cropY = (newH - h) / 2;
-
-        auto cropped = zoomed.getClippedImage(juce::Rectangle<int>(cropX, cropY, w, h));
+        const float cx = image.getWidth()  * 0.5f;
+        const float cy = image.getHeight() * 0.5f;
 
-        // Copy back
+        // Scale the snapshot about the frame centre straight back into the
+        // frame — same result as upscale + centre crop, without temp images.
+        auto& src = snapshot(image);
         juce::Graphics g(image);
-        g.drawImageAt(cropped, 0, 0);
+        g.setImageResamplingQuality(juce::Graphics::highResamplingQuality);
+        g.drawImageTransformed(src, juce::AffineTransform::scale(scale, scale, cx, cy));
     }
 };
 
@@ -0,0 +1,807 @@
+#include "RenderFarm.h"
+#include "FFmpegProcess.h"
+#include "../Utils/AsyncLogger.h"
+
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+// Protocol helpers
+//==============================================================================
+namespace RenderFarm
+{
+
+std::vector<Segment> planSegments(int totalFrames, int gopFrames, int targetFrames, int warmupFrames)
+{
+    std::vector<Segment> plan;
+    if (totalFrames <= 0)
+        return plan;
+
+    gopFrames = juce::jmax(1, gopFrames);
+    const int gops   = juce::jmax(1, (targetFrames + gopFrames - 1) / gopFrames);
+    const int length = gops * gopFrames;
+
+    for (int start = 0; start < totalFrames; start += length)
+    {
+        Segment s;
+        s.index        = static_cast<int>(plan.size());
+        s.startFrame   = start;
+        s.frameCount   = juce::jmin(length, totalFrames - start);
+        s.warmupFrames = juce::jmin(start, warmupFrames);
+        plan.push_back(s);
+    }
+    return plan;
+}
+
+juce::MemoryBlock makeMessage(const juce::var& header, const void* payload, size_t payloadBytes)
+{
+    const auto json = juce::JSON::toString(header, true).toStdString();
+
+    juce::MemoryBlock mb(json.size() + 1 + payloadBytes, true);
+    mb.copyFrom(json.data(), 0, json.size());
+    if (payload != nullptr && payloadBytes > 0)
+        mb.copyFrom(payload, static_cast<int>(json.size() + 1), payloadBytes);
+    return mb;
+}
+
+bool readMessage(const juce::MemoryBlock& message, juce::var& header,
+                 const char*& payload, size_t& payloadBytes)
+{
+    const auto* data = static_cast<const char*>(message.getData());
+    const auto* end  = data + message.getSize();
+    const auto* zero = std::find(data, end, '\0');
+    if (zero == end)
+        return false;
+
+    header = juce::JSON::parse(juce::String::fromUTF8(data, static_cast<int>(zero - data)));
+    payload      = zero + 1;
+    payloadBytes = static_cast<size_t>(end - payload);
+    return header.isObject();
+}
+
+juce::String makeToken()
+{
+    return juce::Uuid().toDashedString().removeCharacters("-")
+         + juce::Uuid().toDashedString().removeCharacters("-");
+}
+
+juce::var settingsToVar(const Export::Settings& s)
+{
+    auto* o = new juce::DynamicObject();
+    o->setProperty("resolution",       static_cast<int>(s.resolution));
+    o->setProperty("customWidth",      s.customWidth);
+    o->setProperty("customHeight",     s.customHeight);
+    o->setProperty("frameRate",        static_cast<int>(s.frameRate));
+    o->setProperty("videoCodec",       static_cast<int>(s.videoCodec));
+    o->setProperty("qualityPreset",    static_cast<int>(s.qualityPreset));
+    o->setProperty("bitrateMbps",      s.bitrateMbps);
+    o->setProperty("audioCodec",       static_cast<int>(s.audioCodec));
+    o->setProperty("audioBitrateKbps", s.audioBitrateKbps);
+    o->setProperty("audioFile",        s.audioFile.getFullPathName());
+
+    auto* stems = new juce::DynamicObject();
+    for (const auto& key : s.stemFiles.getAllKeys())
+        stems->setProperty(key, s.stemFiles[key]);
+    o->setProperty("stemFiles", juce::var(stems));
+
+    const auto& pp = s.postProcess;
+    auto* post = new juce::DynamicObject();
+    post->setProperty("chromaticAberration", pp.chromaticAberration);
+    post->setProperty("caIntensity",         pp.caIntensity);
+    post->setProperty("vignette",            pp.vignette);
+    post->setProperty("vignetteIntensity",   pp.vignetteIntensity);
+    post->setProperty("vignetteRadius",      pp.vignetteRadius);
+    post->setProperty("screenShake",         pp.screenShake);
+    post->setProperty("shakeIntensity",      pp.shakeIntensity);
+    post->setProperty("shakeBeatSync",       pp.shakeBeatSync);
+    post->setProperty("beatZoom",            pp.beatZoom);
+    post->setProperty("beatZoomAmount",      pp.beatZoomAmount);
+    post->setProperty("beatZoomDecay",       pp.beatZoomDecay);
+    o->setProperty("postProcess", juce::var(post));
+
+    o->setProperty("startFrame",       s.startFrame);
+    o->setProperty("frameCount",       s.frameCount);
+    o->setProperty("warmupFrames",     s.warmupFrames);
+    o->setProperty("videoOnly",        s.videoOnly);
+    o->setProperty("keyframeInterval", s.keyframeInterval);
+    return juce::var(o);
+}
+
+Export::Settings settingsFromVar(const juce::var& v)
+{
+    Export::Settings s;
+    s.resolution       = static_cast<Export::Resolution>(static_cast<int>(v["resolution"]));
+    s.customWidth      = v["customWidth"];
+    s.customHeight     = v["customHeight"];
+    s.frameRate        = static_cast<Export::FrameRate>(static_cast<int>(v["frameRate"]));
+    s.videoCodec       = static_cast<Export::VideoCodec>(static_cast<int>(v["videoCodec"]));
+    s.qualityPreset    = static_cast<Export::QualityPreset>(static_cast<int>(v["qualityPreset"]));
+    s.bitrateMbps      = v["bitrateMbps"];
+    s.audioCodec       = static_cast<Export::AudioCodec>(static_cast<int>(v["audioCodec"]));
+    s.audioBitrateKbps = v["audioBitrateKbps"];
+    s.audioFile        = juce::File(v["audioFile"].toString());
+
+    if (auto* stems = v["stemFiles"].getDynamicObject())
+        for (const auto& nv : stems->getProperties())
+            s.stemFiles.set(nv.name.toString(), nv.value.toString());
+
+    const auto& post = v["postProcess"];
+    auto& pp = s.postProcess;
+    pp.chromaticAberration = post["chromaticAberration"];
+    pp.caIntensity         = post["caIntensity"];
+    pp.vignette            = post["vignette"];
+    pp.vignetteIntensity   = post["vignetteIntensity"];
+    pp.vignetteRadius      = post["vignetteRadius"];
+    pp.screenShake         = post["screenShake"];
+    pp.shakeIntensity      = post["shakeIntensity"];
+    pp.shakeBeatSync       = post["shakeBeatSync"];
+    pp.beatZoom            = post["beatZoom"];
+    pp.beatZoomAmount      = post["beatZoomAmount"];
+    pp.beatZoomDecay       = post["beatZoomDecay"];
+
+    s.startFrame       = v["startFrame"];
+    s.frameCount       = v["frameCount"];
+    s.warmupFrames     = v["warmupFrames"];
+    s.videoOnly        = v["videoOnly"];
+    s.keyframeInterval = v["keyframeInterval"];
+    return s;
+}
+
+} // namespace RenderFarm
+
+namespace
+{
+    juce::var makeHeader(const char* type, int segment = -1)
+    {
+        auto* o = new juce::DynamicObject();
+        o->setProperty("type", type);
+        if (segment >= 0)
+            o->setProperty("segment", segment);
+        return juce::var(o);
+    }
+
+    juce::String segmentExtension(const Export::Settings& s)
+    {
+        return s.videoCodec == Export::VideoCodec::PNG_Sequence ? juce::String(".zip")
+                                                                 : Export::videoCodecExtension(s.videoCodec);
+    }
+}
+
+//==============================================================================
+// Coordinator side
+//==============================================================================
+class RenderFarmCoordinator::Connection : public juce::InterprocessConnection
+{
+public:
+    explicit Connection(RenderFarmCoordinator& o)
+        : juce::InterprocessConnection(false, RenderFarm::kMagic), owner(o) {}
+
+    ~Connection() override { disconnect(); }
+
+    void connectionMade() override
+    {
+        const juce::ScopedLock sl(owner.lock_);
+        lastHeardMs = juce::Time::currentTimeMillis();
+    }
+
+    void connectionLost() override
+    {
+        const juce::ScopedLock sl(owner.lock_);
+        lost = true;
+    }
+
+    void messageReceived(const juce::MemoryBlock& message) override
+    {
+        juce::var header;
+        const char* payload = nullptr;
+        size_t payloadBytes = 0;
+        if (!RenderFarm::readMessage(message, header, payload, payloadBytes))
+            return;
+
+        const juce::ScopedLock sl(owner.lock_);
+        lastHeardMs = juce::Time::currentTimeMillis();
+        owner.handleMessage(*this, header, payload, payloadBytes);
+    }
+
+    RenderFarmCoordinator& owner;
+
+    // Guarded by owner.lock_
+    bool         ready   = false;   ///< said hello with our protocol version
+    bool         lost    = false;
+    int          segment = -1;      ///< segment being rendered, -1 = idle
+    juce::int64  lastHeardMs = juce::Time::currentTimeMillis();
+    juce::String name;
+
+    std::unique_ptr<juce::FileOutputStream> incoming;   ///< result being received
+    juce::File   incomingFile;
+    juce::int64  expectedBytes = 0;
+};
+
+class RenderFarmCoordinator::Server : public juce::InterprocessConnectionServer
+{
+public:
+    explicit Server(RenderFarmCoordinator& o) : owner(o) {}
+    ~Server() override { stop(); }
+
+    juce::InterprocessConnection* createConnectionObject() override
+    {
+        const juce::ScopedLock sl(owner.lock_);
+        return owner.connections_.add(new Connection(owner));
+    }
+
+    RenderFarmCoordinator& owner;
+};
+
+//==============================================================================
+RenderFarmCoordinator::RenderFarmCoordinator(const Export::Settings& settings,
+                                             std::shared_ptr<const Export::RenderScene> scene)
+    : Export::RenderJob("RenderFarmCoordinator"),
+      settings_(settings),
+      scene_(std::move(scene))
+{
+    sceneVar_ = scene_->toVar();
+    token_    = settings_.farmToken.isNotEmpty() ? settings_.farmToken : RenderFarm::makeToken();
+}
+
+RenderFarmCoordinator::~RenderFarmCoordinator()
+{
+    alive_->store(false);
+    stopThread(10000);
+}
+
+//==============================================================================
+void RenderFarmCoordinator::run()
+{
+    //-- 1. Timeline length (same rounding as OfflineRenderer) ----------------
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(settings_.audioFile));
+        if (!reader)
+        {
+            notifyFinished(false, "Cannot open audio file: " + settings_.audioFile.getFullPathName());
+            return;
+        }
+        const double duration = static_cast<double>(reader->lengthInSamples) / reader->sampleRate;
+        totalFrames_ = static_cast<int>(std::ceil(duration * settings_.getFPS()));
+    }
+
+    if (totalFrames_ <= 0)
+    {
+        notifyFinished(false, "Audio file is too short.");
+        return;
+    }
+
+    //-- 2. Segments: whole GOPs, a few per worker so retries stay cheap -------
+    const int fps = settings_.getFPS();
+    const int gop = RenderFarm::kGopSeconds * fps;
+    const int workersHint = juce::jmax(4, settings_.farmLocalWorkers);
+    const int target = juce::jmax(RenderFarm::kMinSegmentSeconds * fps, totalFrames_ / (workersHint * 4));
+
+    for (const auto& seg : RenderFarm::planSegments(totalFrames_, gop, target, RenderFarm::kWarmupSeconds * fps))
+        segments_.push_back({ seg });
+
+    workDir_ = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                   .getChildFile("MaxiMeter_farm_" + juce::String::toHexString(juce::Random::getSystemRandom().nextInt64()));
+    if (!workDir_.createDirectory())
+    {
+        notifyFinished(false, "Cannot create " + workDir_.getFullPathName());
+        return;
+    }
+
+    //-- 3. Listen and start the local workers ---------------------------------
+    server_ = std::make_unique<Server>(*this);
+    const auto bindAddress = settings_.farmAcceptRemote ? juce::String() : juce::String("127.0.0.1");
+    if (!server_->beginWaitingForSocket(settings_.farmPort, bindAddress))
+    {
+        server_.reset();
+        workDir_.deleteRecursively();
+        notifyFinished(false, "Render farm: cannot listen on port " + juce::String(settings_.farmPort) + ".");
+        return;
+    }
+
+    const int started = launchLocalWorkers(settings_.farmPort);
+    if (started < settings_.farmLocalWorkers)
+    {
+        const auto message = "Cannot start " + juce::String(settings_.farmLocalWorkers - started)
+                           + " local render workers: "
+                           + juce::File::getSpecialLocation(juce::File::currentExecutableFile).getFullPathName();
+        MAXIMETER_LOG("ERROR", message);
+
+        // With no workers and no remote ones allowed, nothing can ever run
+        const juce::ScopedLock sl(lock_);
+        if (started == 0 && !settings_.farmAcceptRemote)
+            fatalError_ = message;
+        else
+            failures_.add(message);
+    }
+
+    //-- 4. Hand out segments until all are back -------------------------------
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+    juce::int64 lastNotifyMs = 0;
+    bool finished = false;
+
+    while (!finished)
+    {
+        if (threadShouldExit() || cancelled_.load())
+            break;
+
+        wait(100);
+
+        std::vector<std::pair<Connection*, juce::MemoryBlock>> outgoing;
+        std::vector<std::unique_ptr<Connection>> dropped;
+        float progress = 0.0f;
+        int   framesDone = 0;
+        {
+            const juce::ScopedLock sl(lock_);
+            const auto now = juce::Time::currentTimeMillis();
+
+            // Lost or silent workers give their segment back; connections
+            // that never introduced themselves are dropped
+            for (int i = connections_.size(); --i >= 0;)
+            {
+                auto* c = connections_.getUnchecked(i);
+                const bool stalled = c->segment >= 0 && now - c->lastHeardMs > RenderFarm::kStallTimeoutMs;
+                const bool silent  = !c->ready && now - c->lastHeardMs > RenderFarm::kHelloTimeoutMs;
+                if (!c->lost && !stalled && !silent)
+                    continue;
+
+                if (c->segment >= 0)
+                    segmentFailed(*c, stalled ? "worker stopped responding" : "worker disconnected");
+                dropped.emplace_back(connections_.removeAndReturn(i));
+            }
+
+            // Idle workers get the next pending segment
+            if (!paused_.load() && fatalError_.isEmpty())
+            {
+                for (auto* c : connections_)
+                {
+                    if (!c->ready || c->segment >= 0)
+                        continue;
+
+                    auto next = std::find_if(segments_.begin(), segments_.end(),
+                                             [](const SegmentState& s) { return s.state == State::Pending; });
+                    if (next == segments_.end())
+                        break;
+
+                    auto segSettings = settings_;
+                    segSettings.startFrame       = next->segment.startFrame;
+                    segSettings.frameCount       = next->segment.frameCount;
+                    segSettings.warmupFrames     = next->segment.warmupFrames;
+                    segSettings.videoOnly        = true;
+                    segSettings.keyframeInterval = gop;
+
+                    auto job = makeHeader("job", next->segment.index);
+                    job.getDynamicObject()->setProperty("settings", RenderFarm::settingsToVar(segSettings));
+                    job.getDynamicObject()->setProperty("scene", sceneVar_);
+
+                    next->state    = State::Running;
+                    next->progress = 0.0f;
+                    ++next->attempts;
+                    c->segment     = next->segment.index;
+                    c->lastHeardMs = now;
+                    outgoing.emplace_back(c, RenderFarm::makeMessage(job));
+                }
+            }
+
+            bool allDone = true;
+            for (const auto& s : segments_)
+            {
+                const float p = s.state == State::Done ? 1.0f : s.state == State::Running ? s.progress : 0.0f;
+                framesDone += static_cast<int>(p * static_cast<float>(s.segment.frameCount));
+                allDone = allDone && s.state == State::Done;
+            }
+            progress = static_cast<float>(framesDone) / static_cast<float>(totalFrames_);
+            finished = allDone || fatalError_.isNotEmpty();
+
+            // Nobody left to do the work
+            if (!finished && connections_.isEmpty() && !settings_.farmAcceptRemote
+                && std::none_of(localWorkers_.begin(), localWorkers_.end(),
+                                [](juce::ChildProcess* p) { return p->isRunning(); }))
+            {
+                fatalError_ = "All render workers exited.";
+                finished = true;
+            }
+        }
+
+        dropped.clear();    // disconnects outside the lock (their threads may be waiting on it)
+
+        for (auto& [c, message] : outgoing)
+            if (!c->sendMessage(message))
+                c->disconnect();
+
+        progress_.store(progress);
+        const auto nowMs = juce::Time::currentTimeMillis();
+        if (nowMs - lastNotifyMs >= 500 || finished)
+        {
+            lastNotifyMs = nowMs;
+            const double elapsed = (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+            const double eta = framesDone > 0 ? elapsed / framesDone * (totalFrames_ - framesDone) : 0.0;
+            notifyProgress(progress, framesDone, totalFrames_, eta);
+        }
+    }
+
+    //-- 5. Send everyone home -------------------------------------------------
+    server_->stop();
+    {
+        juce::OwnedArray<Connection> remaining;
+        {
+            const juce::ScopedLock sl(lock_);
+            remaining.swapWith(connections_);
+        }
+        for (auto* c : remaining)
+            c->sendMessage(RenderFarm::makeMessage(makeHeader("bye")));
+    }
+    for (auto* p : localWorkers_)
+        if (!p->waitForProcessToFinish(5000))
+            p->kill();
+    localWorkers_.clear();
+    server_.reset();
+
+    juce::String error;
+    bool ok = false;
+    if (cancelled_.load() || threadShouldExit())
+        error = "Export cancelled.";
+    else if (fatalError_.isNotEmpty())
+        error = fatalError_ + "\n\n" + failures_.joinIntoString("\n");
+    else
+        ok = assemble(error);
+
+    workDir_.deleteRecursively();
+
+    if (ok)
+        notifyFinished(true, "Export complete! " + juce::String(totalFrames_) + " frames rendered in "
+                                 + juce::String(segments_.size()) + " segments.");
+    else
+        notifyFinished(false, error);
+}
+
+//==============================================================================
+void RenderFarmCoordinator::handleMessage(Connection& c, const juce::var& header,
+                                          const char* payload, size_t payloadBytes)
+{
+    const auto type = header["type"].toString();
+
+    if (type == "hello")
+    {
+        c.name = header["worker"].toString();
+        if (header["token"].toString() != token_)
+        {
+            failures_.add("Connection from " + c.getConnectedHostName() + " without the export token; dropped.");
+            c.lost = true;
+            return;
+        }
+
+        c.ready = static_cast<int>(header["version"]) == RenderFarm::kProtocolVersion;
+        if (!c.ready)
+            failures_.add("Worker " + c.name + " speaks another protocol version; ignored.");
+        return;
+    }
+
+    if (!c.ready)
+        return;     // nothing but hello until the worker has introduced itself
+
+    const int index = header["segment"];
+    if (c.segment < 0 || index != c.segment)
+        return;     // stale message for a segment already handed elsewhere
+    auto& seg = segments_[static_cast<size_t>(index)];
+
+    if (type == "progress")
+    {
+        seg.progress = juce::jlimit(0.0f, 1.0f, static_cast<float>(header["progress"]));
+    }
+    else if (type == "result")
+    {
+        if (!static_cast<bool>(header["ok"]))
+        {
+            segmentFailed(c, header["message"].toString());
+            return;
+        }
+
+        c.incomingFile  = workDir_.getChildFile("segment_" + juce::String(index).paddedLeft('0', 5)
+                                                + segmentExtension(settings_));
+        c.incomingFile.deleteFile();
+        c.incoming      = std::make_unique<juce::FileOutputStream>(c.incomingFile);
+        c.expectedBytes = static_cast<juce::int64>(header["bytes"]);
+        if (!c.incoming->openedOk())
+            fatalError_ = "Cannot write " + c.incomingFile.getFullPathName();
+    }
+    else if (type == "chunk")
+    {
+        if (c.incoming != nullptr && !c.incoming->write(payload, payloadBytes))
+            fatalError_ = "Cannot write " + c.incomingFile.getFullPathName();
+    }
+    else if (type == "done")
+    {
+        if (c.incoming == nullptr)
+            return;
+
+        c.incoming->flush();
+        const auto received = c.incoming->getPosition();
+        c.incoming.reset();
+
+        if (received != c.expectedBytes)
+        {
+            segmentFailed(c, "truncated result (" + juce::String(received) + " of "
+                                 + juce::String(c.expectedBytes) + " bytes)");
+            return;
+        }
+
+        seg.state    = State::Done;
+        seg.progress = 1.0f;
+        seg.result   = c.incomingFile;
+        c.segment    = -1;
+    }
+}
+
+void RenderFarmCoordinator::segmentFailed(Connection& c, const juce::String& reason)
+{
+    auto& seg = segments_[static_cast<size_t>(c.segment)];
+    failures_.add("Segment " + juce::String(seg.segment.index) + " on "
+                  + (c.name.isNotEmpty() ? c.name : juce::String("worker")) + ": " + reason);
+
+    if (c.incoming != nullptr)
+    {
+        c.incoming.reset();
+        c.incomingFile.deleteFile();
+    }
+
+    seg.state    = State::Pending;
+    seg.progress = 0.0f;
+    c.segment    = -1;
+
+    if (seg.attempts >= RenderFarm::kMaxAttempts)
+        fatalError_ = "Segment " + juce::String(seg.segment.index) + " failed "
+                      + juce::String(seg.attempts) + " times.";
+}
+
+//==============================================================================
+int RenderFarmCoordinator::launchLocalWorkers(int port)
+{
+    const auto exe = juce::File::getSpecialLocation(juce::File::currentExecutableFile);
+    int started = 0;
+
+    for (int i = 0; i < settings_.farmLocalWorkers; ++i)
+    {
+        auto proc = std::make_unique<juce::ChildProcess>();
+        if (proc->start(juce::StringArray { exe.getFullPathName(), RenderFarm::kWorkerSwitch,
+                                            "127.0.0.1:" + juce::String(port), token_ }, 0))
+        {
+            localWorkers_.add(proc.release());
+            ++started;
+        }
+    }
+    return started;
+}
+
+bool RenderFarmCoordinator::assemble(juce::String& error)
+{
+    // PNG sequences: every segment is a zip of its frames
+    if (settings_.videoCodec == Export::VideoCodec::PNG_Sequence)
+    {
+        settings_.outputFile.createDirectory();
+        for (const auto& s : segments_)
+        {
+            juce::ZipFile zip(s.result);
+            if (zip.getNumEntries() == 0 || zip.uncompressTo(settings_.outputFile).failed())
+            {
+                error = "Cannot unpack segment " + juce::String(s.segment.index) + ".";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Video: stream-copy the segments back to back and mux the audio once
+    auto ffmpeg = FFmpegProcess::locateFFmpeg();
+    if (!ffmpeg.existsAsFile())
+    {
+        error = "FFmpeg not found; the segments cannot be joined.";
+        return false;
+    }
+
+    juce::String list;
+    for (const auto& s : segments_)
+        list << "file '" << s.result.getFullPathName().replace("'", "'\\''") << "'\n";
+
+    auto listFile = workDir_.getChildFile("segments.txt");
+    if (!listFile.replaceWithText(list))
+    {
+        error = "Cannot write " + listFile.getFullPathName();
+        return false;
+    }
+
+    juce::ChildProcess proc;
+    if (!proc.start(settings_.buildConcatArgs(ffmpeg, listFile).joinIntoString(" "),
+                    juce::ChildProcess::wantStdOut | juce::ChildProcess::wantStdErr))
+    {
+        error = "Failed to start FFmpeg.";
+        return false;
+    }
+
+    const auto output = proc.readAllProcessOutput();
+    const auto exitCode = proc.getExitCode();
+    if (exitCode != 0)
+    {
+        error = "FFmpeg exited with code " + juce::String(exitCode) + " while joining segments. "
+              + output.getLastCharacters(2000);
+        return false;
+    }
+    return true;
+}
+
+//==============================================================================
+std::unique_ptr<Export::RenderJob> RenderFarm::createJob(const Export::Settings& settings,
+                                                         std::shared_ptr<const Export::RenderScene> scene,
+                                                         AudioEngine& audioEngine)
+{
+    if (settings.usesRenderFarm())
+        return std::make_unique<RenderFarmCoordinator>(settings, std::move(scene));
+    return std::make_unique<OfflineRenderer>(settings, std::move(scene), audioEngine);
+}
+
+//==============================================================================
+// Worker side
+//==============================================================================
+RenderFarmWorker::RenderFarmWorker()
+    : juce::InterprocessConnection(true, RenderFarm::kMagic)
+{
+    workDir_ = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                   .getChildFile("MaxiMeter_worker_" + juce::String(juce::Random::getSystemRandom().nextInt64()));
+    workDir_.createDirectory();
+}
+
+RenderFarmWorker::~RenderFarmWorker()
+{
+    stopRenderer();
+    disconnect();
+    workDir_.deleteRecursively();
+}
+
+bool RenderFarmWorker::connect(const juce::String& hostAndPort, const juce::String& token)
+{
+    const auto host = hostAndPort.upToLastOccurrenceOf(":", false, false);
+    const int  port = hostAndPort.fromLastOccurrenceOf(":", false, false).getIntValue();
+    if (host.isEmpty() || port <= 0 || token.isEmpty())
+        return false;
+
+    token_ = token;
+    return connectToSocket(host, port, 5000);
+}
+
+void RenderFarmWorker::connectionMade()
+{
+    auto hello = makeHeader("hello");
+    hello.getDynamicObject()->setProperty("version", RenderFarm::kProtocolVersion);
+    hello.getDynamicObject()->setProperty("token", token_);
+    hello.getDynamicObject()->setProperty("worker", juce::SystemStats::getComputerName()
+                                                    + "/" + juce::String(juce::Random::getSystemRandom().nextInt(100000)));
+    send(hello);
+}
+
+void RenderFarmWorker::connectionLost()
+{
+    stopRenderer();
+    if (onFinished)
+        onFinished();
+}
+
+void RenderFarmWorker::messageReceived(const juce::MemoryBlock& message)
+{
+    juce::var header;
+    const char* payload = nullptr;
+    size_t payloadBytes = 0;
+    if (!RenderFarm::readMessage(message, header, payload, payloadBytes))
+        return;
+
+    const auto type = header["type"].toString();
+    if (type == "job")
+    {
+        startSegment(header);
+    }
+    else if (type == "bye")
+    {
+        stopRenderer();
+        if (onFinished)
+            onFinished();
+    }
+}
+
+//==============================================================================
+void RenderFarmWorker::startSegment(const juce::var& job)
+{
+    stopRenderer();
+
+    segment_ = job["segment"];
+    auto settings = RenderFarm::settingsFromVar(job["settings"]);
+
+    const auto name = "segment_" + juce::String(segment_).paddedLeft('0', 5);
+    output_ = settings.videoCodec == Export::VideoCodec::PNG_Sequence
+                  ? workDir_.getChildFile(name)
+                  : workDir_.getChildFile(name + Export::videoCodecExtension(settings.videoCodec));
+    output_.deleteRecursively();
+    settings.outputFile = output_;
+
+    renderer_ = std::make_unique<OfflineRenderer>(settings, Export::RenderScene::fromVar(job["scene"]),
+                                                  audioEngine_);
+    renderer_->addListener(this);
+    renderer_->startThread();
+}
+
+void RenderFarmWorker::stopRenderer()
+{
+    if (renderer_ == nullptr)
+        return;
+
+    renderer_->removeListener(this);
+    renderer_->cancel();
+    renderer_->stopThread(10000);
+    renderer_.reset();
+}
+
+void RenderFarmWorker::send(const juce::var& header, const void* payload, size_t payloadBytes)
+{
+    sendMessage(RenderFarm::makeMessage(header, payload, payloadBytes));
+}
+
+void RenderFarmWorker::renderingProgress(float progress, int, int, double)
+{
+    // The coordinator only needs enough to spot a stalled worker and to sum up
+    const auto now = juce::Time::currentTimeMillis();
+    if (now - lastProgressMs_ < 500)
+        return;
+    lastProgressMs_ = now;
+
+    auto msg = makeHeader("progress", segment_);
+    msg.getDynamicObject()->setProperty("progress", progress);
+    send(msg);
+}
+
+void RenderFarmWorker::renderingFinished(bool success, const juce::String& message)
+{
+    // The renderer's thread has ended; it is released with the next job
+    // (not here, while it is still calling its listeners)
+    const int segment = segment_;
+
+    auto result = makeHeader("result", segment);
+    auto* r = result.getDynamicObject();
+
+    // PNG frames travel as one stored (uncompressed) zip
+    juce::File file = output_;
+    if (success && output_.isDirectory())
+    {
+        file = output_.withFileExtension(".zip");
+        juce::ZipFile::Builder builder;
+        for (const auto& f : output_.findChildFiles(juce::File::findFiles, false, "*.png"))
+            builder.addFile(f, 0);
+
+        juce::FileOutputStream zipOut(file);
+        success = zipOut.openedOk() && builder.writeToStream(zipOut, nullptr);
+    }
+
+    juce::FileInputStream in(file);
+    if (!success || !in.openedOk())
+    {
+        r->setProperty("ok", false);
+        r->setProperty("message", success ? "cannot read " + file.getFullPathName() : message);
+        send(result);
+        return;
+    }
+
+    r->setProperty("ok", true);
+    r->setProperty("bytes", in.getTotalLength());
+    send(result);
+
+    juce::HeapBlock<char> buffer(RenderFarm::kChunkBytes);
+    for (;;)
+    {
+        const int n = in.read(buffer.getData(), static_cast<int>(RenderFarm::kChunkBytes));
+        if (n <= 0)
+            break;
+        send(makeHeader("chunk", segment), buffer.getData(), static_cast<size_t>(n));
+    }
+    send(makeHeader("done", segment));
+
+    file.deleteFile();
+    output_.deleteRecursively();
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+#include "ExportSettings.h"
+#include "RenderJob.h"
+#include "RenderScene.h"
+#include "OfflineRenderer.h"
+#include "../Audio/AudioEngine.h"
+
+//==============================================================================
+/// Render farm — one export split across several processes or machines.
+///
+/// The coordinator (inside the app that queued the export) cuts the timeline
+/// into segments whose length is a whole number of GOPs, and hands them to
+/// workers: the same executable started headless with
+///
+///     MaxiMeter --render-worker <host>:<port> <token>
+///
+/// The token is a secret made per export (Export::Settings::farmToken);
+/// connections whose hello does not carry it are dropped.
+///
+/// Each worker renders its segment with an OfflineRenderer (video only,
+/// fixed closed GOPs, analysers warmed up over the seconds before the
+/// segment) and streams the encoded file back.  Failed, lost or stalled
+/// segments are handed out again, up to kMaxAttempts times.  The segments
+/// are then joined with FFmpeg's concat demuxer (stream copy, no re-encode)
+/// and the audio is muxed in once over the whole timeline; PNG sequences are
+/// simply unpacked into the output folder.
+///
+/// Protocol: juce::InterprocessConnection frames over TCP.  Each message is a
+/// JSON header, a zero byte and an optional binary payload:
+///
+///     worker → coordinator   hello {version, token}
+///     coordinator → worker   job {segment, settings, scene}
+///     worker → coordinator   progress {segment, progress}
+///     worker → coordinator   result {segment, ok, bytes | message}
+///     worker → coordinator   chunk {segment} + payload   (repeated)
+///     worker → coordinator   done {segment}
+///     coordinator → worker   bye
+///
+/// Media referenced by the scene must be reachable at the same paths on
+/// every worker (shared storage, or localhost workers).
+namespace RenderFarm
+{
+    constexpr int          kProtocolVersion = 1;
+    constexpr juce::uint32 kMagic           = 0x4d584d46;   ///< "MXMF"
+    constexpr const char*  kWorkerSwitch    = "--render-worker";
+
+    constexpr int    kMaxAttempts      = 3;         ///< per segment
+    constexpr int    kStallTimeoutMs   = 120000;    ///< a busy worker silent this long is dropped
+    constexpr int    kHelloTimeoutMs   = 10000;     ///< a connection must say hello within this
+    constexpr int    kGopSeconds       = 2;
+    constexpr int    kWarmupSeconds    = 10;
+    constexpr int    kMinSegmentSeconds = 30;
+    constexpr size_t kChunkBytes       = 4u << 20;
+
+    struct Segment
+    {
+        int index        = 0;
+        int startFrame   = 0;
+        int frameCount   = 0;
+        int warmupFrames = 0;   ///< analysed before startFrame (less at the very start)
+    };
+
+    /// Split [0, totalFrames) into segments of a whole number of @p gopFrames,
+    /// about @p targetFrames long (only the last one may be shorter).
+    std::vector<Segment> planSegments(int totalFrames, int gopFrames, int targetFrames, int warmupFrames);
+
+    /// Frame a message (JSON header, zero byte, payload).
+    juce::MemoryBlock makeMessage(const juce::var& header, const void* payload = nullptr, size_t payloadBytes = 0);
+
+    /// Split a message made by makeMessage().  Returns false if malformed.
+    bool readMessage(const juce::MemoryBlock& message, juce::var& header,
+                     const char*& payload, size_t& payloadBytes);
+
+    /// A fresh per-export secret for Export::Settings::farmToken.
+    juce::String makeToken();
+
+    juce::var        settingsToVar(const Export::Settings& s);
+    Export::Settings settingsFromVar(const juce::var& v);
+}
+
+//==============================================================================
+/// Hands the segments of one export to worker processes and joins the
+/// results.  Used in place of an OfflineRenderer when
+/// Export::Settings::usesRenderFarm() is true.
+class RenderFarmCoordinator : public Export::RenderJob
+{
+public:
+    RenderFarmCoordinator(const Export::Settings& settings,
+                          std::shared_ptr<const Export::RenderScene> scene);
+    ~RenderFarmCoordinator() override;
+
+    void run() override;
+
+private:
+    class Connection;
+    class Server;
+
+    enum class State { Pending, Running, Done };
+
+    struct SegmentState
+    {
+        RenderFarm::Segment segment;
+        State  state    = State::Pending;
+        int    attempts = 0;
+        float  progress = 0.0f;
+        juce::File result;
+    };
+
+    // Called with lock_ held
+    void segmentFailed(Connection& c, const juce::String& reason);
+    void handleMessage(Connection& c, const juce::var& header, const char* payload, size_t payloadBytes);
+
+    int  launchLocalWorkers(int port);   ///< number of workers started
+    bool assemble(juce::String& error);
+
+    Export::Settings settings_;
+    std::shared_ptr<const Export::RenderScene> scene_;
+    juce::var        sceneVar_;
+    juce::File       workDir_;
+    juce::String     token_;         ///< workers must present this in hello
+    int              totalFrames_ = 0;
+
+    juce::CriticalSection          lock_;
+    std::vector<SegmentState>      segments_;
+    juce::OwnedArray<Connection>   connections_;
+    juce::StringArray              failures_;      ///< one line per failed attempt
+    juce::String                   fatalError_;
+
+    std::unique_ptr<Server>             server_;
+    juce::OwnedArray<juce::ChildProcess> localWorkers_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderFarmCoordinator)
+};
+
+//==============================================================================
+/// Headless worker: connects to a coordinator, renders the segments it is
+/// given and sends them back.  Lives on the message thread of a process
+/// started with RenderFarm::kWorkerSwitch.
+class RenderFarmWorker : private juce::InterprocessConnection,
+                         private Export::RenderJob::Listener
+{
+public:
+    RenderFarmWorker();
+    ~RenderFarmWorker() override;
+
+    /// Connect to "host:port" and introduce ourselves with @p token.
+    /// Returns false if nobody is listening.
+    bool connect(const juce::String& hostAndPort, const juce::String& token);
+
+    /// Called when the coordinator says goodbye or goes away.
+    std::function<void()> onFinished;
+
+private:
+    void connectionMade() override;
+    void connectionLost() override;
+    void messageReceived(const juce::MemoryBlock& message) override;
+
+    void renderingProgress(float progress, int currentFrame, int totalFrames, double eta) override;
+    void renderingFinished(bool success, const juce::String& message) override;
+
+    void startSegment(const juce::var& job);
+    void stopRenderer();
+    void send(const juce::var& header, const void* payload = nullptr, size_t payloadBytes = 0);
+
+    AudioEngine                      audioEngine_ { false };   ///< MeterFactory needs one; never plays
+    std::unique_ptr<OfflineRenderer> renderer_;
+    juce::String                     token_;
+    int                              segment_ = -1;
+    juce::File                       output_;
+    juce::File                       workDir_;       ///< segment outputs, removed on exit
+    juce::int64                      lastProgressMs_ = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderFarmWorker)
+};
+
+namespace RenderFarm
+{
+    /// The job an export queue should run for @p settings: a
+    /// RenderFarmCoordinator when the farm is enabled, else an OfflineRenderer.
+    std::unique_ptr<Export::RenderJob> createJob(const Export::Settings& settings,
+                                                 std::shared_ptr<const Export::RenderScene> scene,
+                                                 AudioEngine& audioEngine);
+}
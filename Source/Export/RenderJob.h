@@ -0,0 +1,97 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+
+namespace Export
+{
+
+//==============================================================================
+/// RenderJob — an export running on its own thread: a local OfflineRenderer
+/// or a RenderFarmCoordinator driving worker processes.  The progress window
+/// and the batch queue only talk to this interface.
+///
+/// Listener callbacks arrive on the message thread.
+class RenderJob : public juce::Thread
+{
+public:
+    //--  Listener for progress / completion  ----------------------------------
+    struct Listener
+    {
+        virtual ~Listener() = default;
+        virtual void renderingProgress(float progress, int currentFrame, int totalFrames,
+                                       double estimatedSecondsRemaining) = 0;
+        virtual void renderingFinished(bool success, const juce::String& message) = 0;
+    };
+
+    explicit RenderJob(const juce::String& threadName) : juce::Thread(threadName) {}
+    ~RenderJob() override { alive_->store(false); }
+
+    //-- Control  --------------------------------------------------------------
+    void pause()    { paused_.store(true); }
+    void resume()   { paused_.store(false); }
+    void cancel()   { cancelled_.store(true); }
+
+    float getProgress() const   { return progress_.load(); }
+    bool  isPaused()    const   { return paused_.load(); }
+    bool  isCancelled() const   { return cancelled_.load(); }
+
+    void addListener(Listener* l)    { listeners_.add(l); }
+    void removeListener(Listener* l) { listeners_.remove(l); }
+
+    //-- Preview frame (thread-safe)  ------------------------------------------
+    /// Returns a downscaled preview of the latest rendered frame, or null Image.
+    juce::Image getLatestPreview() const
+    {
+        const juce::SpinLock::ScopedLockType sl(previewLock_);
+        return previewImage_;
+    }
+
+protected:
+    void setLatestPreview(juce::Image preview)
+    {
+        const juce::SpinLock::ScopedLockType sl(previewLock_);
+        previewImage_ = std::move(preview);
+    }
+
+    void notifyProgress(float prog, int curFrame, int totalFrames, double etaSec)
+    {
+        auto aliveFlag = alive_;
+        auto* self = this;
+        juce::MessageManager::callAsync([aliveFlag, self, prog, curFrame, totalFrames, etaSec]()
+        {
+            if (aliveFlag->load())
+                self->listeners_.call(&Listener::renderingProgress, prog, curFrame, totalFrames, etaSec);
+        });
+    }
+
+    void notifyFinished(bool success, const juce::String& msg)
+    {
+        auto aliveFlag = alive_;
+        auto* self = this;
+        juce::MessageManager::callAsync([aliveFlag, self, success, msg]()
+        {
+            if (aliveFlag->load())
+                self->listeners_.call(&Listener::renderingFinished, success, msg);
+        });
+    }
+
+    std::atomic<float>    progress_   { 0.0f };
+    std::atomic<bool>     paused_     { false };
+    std::atomic<bool>     cancelled_  { false };
+
+    /// Shared flag checked by callAsync lambdas to avoid use-after-free
+    std::shared_ptr<std::atomic<bool>> alive_ =
+        std::make_shared<std::atomic<bool>>(true);
+
+private:
+    juce::ListenerList<Listener> listeners_;
+
+    mutable juce::SpinLock     previewLock_;
+    juce::Image                previewImage_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderJob)
+};
+
+} // namespace Export
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+namespace Export
+{
+
+//==============================================================================
+/// Where an OfflineRenderer spent its time, filled in when it runs a
+/// pre-flight sample (OfflineRenderer::setProfileSampling).
+struct RenderProfile
+{
+    enum Stage
+    {
+        Audio,          ///< reading + analysing the mix and stems
+        Meters,         ///< pushing analysis into the meters
+        Plugins,        ///< Python plugin bridge round trips
+        Render,         ///< painting and compositing the items
+        PostProcess,
+        Encode,         ///< RGB conversion + FFmpeg pipe / PNG write, incl. flush
+        NumStages
+    };
+
+    static juce::String stageName(int stage)
+    {
+        switch (stage)
+        {
+            case Audio:       return "Audio analysis";
+            case Meters:      return "Meter updates";
+            case Plugins:     return "Python plugins";
+            case Render:      return "Rendering";
+            case PostProcess: return "Post-processing";
+            case Encode:      return "Encoding";
+            default:          return "Unknown";
+        }
+    }
+
+    struct ItemCost
+    {
+        juce::String name;
+        double       seconds = 0.0;   ///< paint + composite, summed over the drawn frames
+    };
+
+    double                stageSeconds[NumStages] = {};
+    std::vector<ItemCost> items;
+
+    int         timelineFrames = 0;   ///< frames in the full export
+    int         analysedFrames = 0;   ///< frames whose audio was analysed (drawn + warm-up)
+    int         drawnFrames    = 0;
+    juce::int64 encodedBytes   = 0;   ///< output written for the drawn frames
+};
+
+} // namespace Export
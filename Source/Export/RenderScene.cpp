@@ -0,0 +1,693 @@
+#include "RenderScene.h"
+
+#include "../UI/MultiBandAnalyzer.h"
+#include "../UI/Spectrogram.h"
+#include "../UI/Goniometer.h"
+#include "../UI/LissajousScope.h"
+#include "../UI/LoudnessMeter.h"
+#include "../UI/LevelHistogram.h"
+#include "../UI/CorrelationMeter.h"
+#include "../UI/PeakMeter.h"
+#include "../UI/SkinnedSpectrumAnalyzer.h"
+#include "../UI/SkinnedVUMeter.h"
+#include "../UI/SkinnedOscilloscope.h"
+#include "../UI/WinampSkinRenderer.h"
+#include "../UI/SkinnedPlayerPanel.h"
+#include "../UI/EqualizerPanel.h"
+#include "../UI/ShapeComponent.h"
+#include "../UI/TextLabelComponent.h"
+#include "../Canvas/CustomPluginComponent.h"
+#include "../Utils/MediaRegistry.h"
+
+#include <map>
+
+namespace Export
+{
+
+namespace
+{
+    /// Skin models are shared by every item that showed the same skin.
+    using SkinCache = std::map<const Skin::SkinModel*, std::shared_ptr<const Skin::SkinModel>>;
+
+    std::shared_ptr<const Skin::SkinModel> snapshotSkin(const Skin::SkinModel* live, SkinCache& cache)
+    {
+        if (live == nullptr || !live->isLoaded())
+            return nullptr;
+
+        auto& slot = cache[live];
+        if (slot == nullptr)
+            slot = std::make_shared<const Skin::SkinModel>(*live);
+        return slot;
+    }
+
+    //==========================================================================
+    juce::var colourToVar(juce::Colour c)             { return static_cast<juce::int64>(c.getARGB()); }
+    juce::Colour colourFromVar(const juce::var& v)    { return juce::Colour(static_cast<juce::uint32>(static_cast<juce::int64>(v))); }
+
+    juce::var itemPropsToVar(const CanvasItem& p)
+    {
+        auto* o = new juce::DynamicObject();
+        o->setProperty("id",            p.id.toString());
+        o->setProperty("meterType",     static_cast<int>(p.meterType));
+        o->setProperty("x",             p.x);
+        o->setProperty("y",             p.y);
+        o->setProperty("width",         p.width);
+        o->setProperty("height",        p.height);
+        o->setProperty("rotation",      p.rotation);
+        o->setProperty("zOrder",        p.zOrder);
+        o->setProperty("locked",        p.locked);
+        o->setProperty("visible",       p.visible);
+        o->setProperty("name",          p.name);
+        o->setProperty("groupId",       p.groupId.isNull() ? juce::String() : p.groupId.toString());
+        o->setProperty("aspectLock",    p.aspectLock);
+        o->setProperty("opacity",       p.opacity);
+        o->setProperty("mediaFilePath", p.mediaFilePath);
+        o->setProperty("vuChannel",     p.vuChannel);
+        o->setProperty("audioSource",   p.audioSource);
+
+        o->setProperty("customPluginId",   p.customPluginId);
+        o->setProperty("customInstanceId", p.customInstanceId);
+
+        o->setProperty("itemBackground", colourToVar(p.itemBackground));
+        o->setProperty("meterBgColour",  colourToVar(p.meterBgColour));
+        o->setProperty("meterFgColour",  colourToVar(p.meterFgColour));
+        o->setProperty("blendMode",      static_cast<int>(p.blendMode));
+
+        o->setProperty("fillColour1",       colourToVar(p.fillColour1));
+        o->setProperty("fillColour2",       colourToVar(p.fillColour2));
+        o->setProperty("gradientDirection", p.gradientDirection);
+        o->setProperty("cornerRadius",      p.cornerRadius);
+        o->setProperty("strokeColour",      colourToVar(p.strokeColour));
+        o->setProperty("strokeWidth",       p.strokeWidth);
+        o->setProperty("strokeAlignment",   p.strokeAlignment);
+        o->setProperty("lineCap",           p.lineCap);
+        o->setProperty("starPoints",        p.starPoints);
+        o->setProperty("triangleRoundness", p.triangleRoundness);
+        o->setProperty("svgPathData",       p.svgPathData);
+        o->setProperty("svgFilePath",       p.svgFilePath);
+
+        o->setProperty("targetLUFS",          p.targetLUFS);
+        o->setProperty("loudnessShowHistory", p.loudnessShowHistory);
+
+        o->setProperty("frostedGlass", p.frostedGlass);
+        o->setProperty("blurRadius",   p.blurRadius);
+        o->setProperty("frostTint",    colourToVar(p.frostTint));
+        o->setProperty("frostOpacity", p.frostOpacity);
+
+        o->setProperty("textContent",   p.textContent);
+        o->setProperty("fontFamily",    p.fontFamily);
+        o->setProperty("fontSize",      p.fontSize);
+        o->setProperty("fontBold",      p.fontBold);
+        o->setProperty("fontItalic",    p.fontItalic);
+        o->setProperty("textColour",    colourToVar(p.textColour));
+        o->setProperty("textAlignment", p.textAlignment);
+        return juce::var(o);
+    }
+
+    void itemPropsFromVar(const juce::var& v, CanvasItem& p)
+    {
+        p.id            = juce::Uuid(v["id"].toString());
+        p.meterType     = static_cast<MeterType>(static_cast<int>(v["meterType"]));
+        p.x             = v["x"];
+        p.y             = v["y"];
+        p.width         = v["width"];
+        p.height        = v["height"];
+        p.rotation      = v["rotation"];
+        p.zOrder        = v["zOrder"];
+        p.locked        = v["locked"];
+        p.visible       = v["visible"];
+        p.name          = v["name"].toString();
+        p.groupId       = v["groupId"].toString().isEmpty() ? juce::Uuid::null() : juce::Uuid(v["groupId"].toString());
+        p.aspectLock    = v["aspectLock"];
+        p.opacity       = v["opacity"];
+        p.mediaFilePath = v["mediaFilePath"].toString();
+        p.vuChannel     = v["vuChannel"];
+        p.audioSource   = v["audioSource"].toString();
+
+        p.customPluginId   = v["customPluginId"].toString();
+        p.customInstanceId = v["customInstanceId"].toString();
+
+        p.itemBackground = colourFromVar(v["itemBackground"]);
+        p.meterBgColour  = colourFromVar(v["meterBgColour"]);
+        p.meterFgColour  = colourFromVar(v["meterFgColour"]);
+        p.blendMode      = static_cast<BlendMode>(static_cast<int>(v["blendMode"]));
+
+        p.fillColour1       = colourFromVar(v["fillColour1"]);
+        p.fillColour2       = colourFromVar(v["fillColour2"]);
+        p.gradientDirection = v["gradientDirection"];
+        p.cornerRadius      = v["cornerRadius"];
+        p.strokeColour      = colourFromVar(v["strokeColour"]);
+        p.strokeWidth       = v["strokeWidth"];
+        p.strokeAlignment   = v["strokeAlignment"];
+        p.lineCap           = v["lineCap"];
+        p.starPoints        = v["starPoints"];
+        p.triangleRoundness = v["triangleRoundness"];
+        p.svgPathData       = v["svgPathData"].toString();
+        p.svgFilePath       = v["svgFilePath"].toString();
+
+        p.targetLUFS          = v["targetLUFS"];
+        p.loudnessShowHistory = v["loudnessShowHistory"];
+
+        p.frostedGlass = v["frostedGlass"];
+        p.blurRadius   = v["blurRadius"];
+        p.frostTint    = colourFromVar(v["frostTint"]);
+        p.frostOpacity = v["frostOpacity"];
+
+        p.textContent   = v["textContent"].toString();
+        p.fontFamily    = v["fontFamily"].toString();
+        p.fontSize      = v["fontSize"];
+        p.fontBold      = v["fontBold"];
+        p.fontItalic    = v["fontItalic"];
+        p.textColour    = colourFromVar(v["textColour"]);
+        p.textAlignment = v["textAlignment"];
+    }
+
+    //==========================================================================
+    /// Read the settings that only the live component holds.
+    void captureMeter(const CanvasItem& src, RenderScene::Item& dst, SkinCache& skins)
+    {
+        auto* comp = src.component.get();
+        if (comp == nullptr)
+            return;
+
+        auto& v = dst.meterSettings;
+
+        switch (src.meterType)
+        {
+            case MeterType::MultiBandAnalyzer:
+                if (auto* s = dynamic_cast<MultiBandAnalyzer*>(comp))
+                {
+                    v.set("decayRate", s->getDecayRate());
+                    v.set("minDb",     s->getMinDb());
+                    v.set("maxDb",     s->getMaxDb());
+                    v.set("numBands",  s->getNumBands());
+                    v.set("scaleMode", static_cast<int>(s->getScaleMode()));
+                    v.set("dataSource", static_cast<int>(s->getDataSource()));
+                }
+                break;
+
+            case MeterType::Spectrogram:
+                if (auto* s = dynamic_cast<Spectrogram*>(comp))
+                {
+                    v.set("colourMap", static_cast<int>(s->getColourMap()));
+                    v.set("scrollDir", static_cast<int>(s->getScrollDirection()));
+                    v.set("minDb",     s->getMinDb());
+                    v.set("maxDb",     s->getMaxDb());
+                }
+                break;
+
+            case MeterType::Goniometer:
+                if (auto* s = dynamic_cast<Goniometer*>(comp))
+                {
+                    v.set("dotSize",      s->getDotSize());
+                    v.set("trailOpacity", s->getTrailOpacity());
+                    v.set("showGrid",     s->getShowGrid());
+                }
+                break;
+
+            case MeterType::LissajousScope:
+                if (auto* s = dynamic_cast<LissajousScope*>(comp))
+                {
+                    v.set("mode",        static_cast<int>(s->getMode()));
+                    v.set("trailLength", s->getTrailLength());
+                    v.set("showGrid",    s->getShowGrid());
+                }
+                break;
+
+            case MeterType::LoudnessMeter:
+                if (auto* s = dynamic_cast<LoudnessMeter*>(comp))
+                {
+                    v.set("targetLUFS",  s->getTargetLUFS());
+                    v.set("showHistory", s->getShowHistory());
+                }
+                break;
+
+            case MeterType::LevelHistogram:
+                if (auto* s = dynamic_cast<LevelHistogram*>(comp))
+                {
+                    v.set("minDb",         s->getMinDb());
+                    v.set("maxDb",         s->getMaxDb());
+                    v.set("binResolution", s->getBinResolution());
+                    v.set("cumulative",    s->getCumulative());
+                    v.set("showStereo",    s->getShowStereo());
+                }
+                break;
+
+            case MeterType::CorrelationMeter:
+                if (auto* s = dynamic_cast<CorrelationMeter*>(comp))
+                {
+                    v.set("integrationMs", s->getIntegrationTimeMs());
+                    v.set("showNumeric",   s->getShowNumeric());
+                }
+                break;
+
+            case MeterType::PeakMeter:
+                if (auto* s = dynamic_cast<PeakMeter*>(comp))
+                {
+                    v.set("peakMode",     static_cast<int>(s->getPeakMode()));
+                    v.set("peakHoldMs",   s->getPeakHoldTimeMs());
+                    v.set("decayRate",    s->getDecayRateDbPerSec());
+                    v.set("showClip",     s->getShowClipWarning());
+                }
+                break;
+
+            case MeterType::SkinnedVUMeter:
+                if (auto* s = dynamic_cast<SkinnedVUMeter*>(comp))
+                {
+                    v.set("ballistic", static_cast<int>(s->getBallistic()));
+                    v.set("decayMs",   s->getDecayTimeMs());
+                }
+                break;
+
+            case MeterType::SkinnedSpectrum:
+                if (auto* s = dynamic_cast<SkinnedSpectrumAnalyzer*>(comp))
+                {
+                    v.set("decayRate", s->getDecayRate());
+                    v.set("numBands",  s->getNumBands());
+                }
+                break;
+
+            case MeterType::SkinnedOscilloscope:
+                if (auto* s = dynamic_cast<SkinnedOscilloscope*>(comp))
+                {
+                    v.set("lineThickness", s->getLineThickness());
+                    v.set("drawStyle",     s->getDrawStyle());
+                }
+                break;
+
+            case MeterType::WinampSkin:
+                if (auto* s = dynamic_cast<WinampSkinRenderer*>(comp); s && s->hasSkin())
+                    dst.skin = snapshotSkin(&s->getSkinModel(), skins);
+                break;
+
+            case MeterType::SkinnedPlayer:
+                if (auto* s = dynamic_cast<SkinnedPlayerPanel*>(comp); s && s->hasSkin())
+                {
+                    dst.skin = snapshotSkin(s->getSkinModel(), skins);
+                    v.set("scale", s->getScale());
+                }
+                break;
+
+            case MeterType::Equalizer:
+                if (auto* s = dynamic_cast<EqualizerPanel*>(comp))
+                {
+                    if (s->hasSkin())
+                        dst.skin = snapshotSkin(s->getSkinModel(), skins);
+                    v.set("scale",  s->getScale());
+                    v.set("eqOn",   s->isEqOn());
+                    v.set("autoOn", s->isAutoOn());
+                    v.set("preamp", s->getPreamp());
+
+                    juce::Array<juce::var> gains;
+                    for (int b = 0; b < EqualizerPanel::kNumBands; ++b)
+                        gains.add(s->getBandGain(b));
+                    v.set("bandGains", gains);
+                }
+                break;
+
+            case MeterType::CustomPlugin:
+                if (auto* s = dynamic_cast<CustomPluginComponent*>(comp))
+                    for (auto& prop : s->getPluginProperties())
+                        dst.pluginProperties.emplace_back(prop.key, prop.defaultVal);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+//==============================================================================
+std::shared_ptr<const RenderScene> RenderScene::capture(const CanvasModel& model)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    auto scene = std::make_shared<RenderScene>();
+    scene->background = model.background;
+
+    SkinCache skins;
+    for (int i = 0; i < model.getNumItems(); ++i)
+    {
+        const auto* src = model.getItem(i);
+        if (!src->visible) continue;
+
+        Item item;
+        copyItemProperties(*src, item.props);
+        captureMeter(*src, item, skins);
+        scene->items.push_back(std::move(item));
+    }
+
+    return scene;
+}
+
+//==============================================================================
+void RenderScene::copyItemProperties(const CanvasItem& src, CanvasItem& dst)
+{
+    dst.id            = src.id;
+    dst.meterType     = src.meterType;
+    dst.x             = src.x;
+    dst.y             = src.y;
+    dst.width         = src.width;
+    dst.height        = src.height;
+    dst.rotation      = src.rotation;
+    dst.zOrder        = src.zOrder;
+    dst.locked        = src.locked;
+    dst.visible       = src.visible;
+    dst.name          = src.name;
+    dst.groupId       = src.groupId;
+    dst.aspectLock    = src.aspectLock;
+    dst.opacity       = src.opacity;
+    dst.mediaFilePath = src.mediaFilePath;
+    dst.vuChannel     = src.vuChannel;
+    dst.audioSource   = src.audioSource;
+
+    // Custom plugin IDs
+    dst.customPluginId    = src.customPluginId;
+    dst.customInstanceId  = src.customInstanceId;
+
+    // Per-item background and meter colour overrides
+    dst.itemBackground = src.itemBackground;
+    dst.meterBgColour  = src.meterBgColour;
+    dst.meterFgColour  = src.meterFgColour;
+    dst.blendMode      = src.blendMode;
+
+    // Shape properties
+    dst.fillColour1       = src.fillColour1;
+    dst.fillColour2       = src.fillColour2;
+    dst.gradientDirection = src.gradientDirection;
+    dst.cornerRadius      = src.cornerRadius;
+    dst.strokeColour      = src.strokeColour;
+    dst.strokeWidth       = src.strokeWidth;
+    dst.strokeAlignment   = src.strokeAlignment;
+    dst.lineCap           = src.lineCap;
+    dst.starPoints        = src.starPoints;
+    dst.triangleRoundness = src.triangleRoundness;
+    dst.svgPathData       = src.svgPathData;
+    dst.svgFilePath       = src.svgFilePath;
+
+    // Loudness meter
+    dst.targetLUFS          = src.targetLUFS;
+    dst.loudnessShowHistory = src.loudnessShowHistory;
+
+    // Frosted glass
+    dst.frostedGlass = src.frostedGlass;
+    dst.blurRadius   = src.blurRadius;
+    dst.frostTint    = src.frostTint;
+    dst.frostOpacity = src.frostOpacity;
+
+    // Text properties
+    dst.textContent   = src.textContent;
+    dst.fontFamily    = src.fontFamily;
+    dst.fontSize      = src.fontSize;
+    dst.fontBold      = src.fontBold;
+    dst.fontItalic    = src.fontItalic;
+    dst.textColour    = src.textColour;
+    dst.textAlignment = src.textAlignment;
+}
+
+//==============================================================================
+juce::var RenderScene::toVar() const
+{
+    juce::Array<juce::var> itemVars;
+    for (const auto& item : items)
+    {
+        auto* o = new juce::DynamicObject();
+        o->setProperty("props", itemPropsToVar(item.props));
+
+        auto* settings = new juce::DynamicObject();
+        for (const auto& nv : item.meterSettings)
+            settings->setProperty(nv.name, nv.value);
+        o->setProperty("meterSettings", juce::var(settings));
+
+        if (item.skin != nullptr)
+            o->setProperty("skinFile", item.skin->skinFile.getFullPathName());
+
+        auto* plugin = new juce::DynamicObject();
+        juce::Array<juce::var> order;
+        for (const auto& [key, value] : item.pluginProperties)
+        {
+            plugin->setProperty(key, value);
+            order.add(key);
+        }
+        o->setProperty("pluginProperties", juce::var(plugin));
+        o->setProperty("pluginPropertyOrder", order);
+
+        itemVars.add(juce::var(o));
+    }
+
+    auto* bg = new juce::DynamicObject();
+    bg->setProperty("mode",      static_cast<int>(background.mode));
+    bg->setProperty("colour1",   colourToVar(background.colour1));
+    bg->setProperty("colour2",   colourToVar(background.colour2));
+    bg->setProperty("angle",     background.angle);
+    bg->setProperty("imageFile", background.imageFile.getFullPathName());
+    bg->setProperty("fitMode",   static_cast<int>(background.fitMode));
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("items", itemVars);
+    root->setProperty("background", juce::var(bg));
+    return juce::var(root);
+}
+
+std::shared_ptr<const RenderScene> RenderScene::fromVar(const juce::var& v)
+{
+    auto scene = std::make_shared<RenderScene>();
+
+    if (auto* itemVars = v["items"].getArray())
+    {
+        for (const auto& iv : *itemVars)
+        {
+            Item item;
+            itemPropsFromVar(iv["props"], item.props);
+
+            if (auto* settings = iv["meterSettings"].getDynamicObject())
+                item.meterSettings = settings->getProperties();
+
+            // Items showing the same skin share one parsed model
+            const auto skinPath = iv["skinFile"].toString();
+            if (skinPath.isNotEmpty() && juce::File::isAbsolutePath(skinPath)
+                && juce::File(skinPath).existsAsFile())
+                item.skin = MediaRegistry::getInstance().getSkin(juce::File(skinPath));
+
+            if (auto* order = iv["pluginPropertyOrder"].getArray())
+                for (const auto& key : *order)
+                    item.pluginProperties.emplace_back(key.toString(),
+                                                       iv["pluginProperties"][juce::Identifier(key.toString())]);
+
+            scene->items.push_back(std::move(item));
+        }
+    }
+
+    const auto& bg = v["background"];
+    scene->background.mode    = static_cast<BackgroundMode>(static_cast<int>(bg["mode"]));
+    scene->background.colour1 = colourFromVar(bg["colour1"]);
+    scene->background.colour2 = colourFromVar(bg["colour2"]);
+    scene->background.angle   = bg["angle"];
+    scene->background.fitMode = static_cast<CanvasBackground::FitMode>(static_cast<int>(bg["fitMode"]));
+
+    const auto imagePath = bg["imageFile"].toString();
+    if (imagePath.isNotEmpty() && juce::File::isAbsolutePath(imagePath))
+    {
+        scene->background.imageFile   = juce::File(imagePath);
+        scene->background.cachedImage = juce::ImageFileFormat::loadFrom(scene->background.imageFile);
+    }
+
+    return scene;
+}
+
+//==============================================================================
+void RenderScene::configureMeter(const Item& item, juce::Component& component)
+{
+    const auto& p = item.props;
+    const auto& v = item.meterSettings;
+    auto* comp = &component;
+
+    switch (p.meterType)
+    {
+        case MeterType::MultiBandAnalyzer:
+            if (auto* d = dynamic_cast<MultiBandAnalyzer*>(comp); d && !v.isEmpty())
+            {
+                d->setDecayRate(v["decayRate"]);
+                d->setDynamicRange(v["minDb"], v["maxDb"]);
+                d->setNumBands(v["numBands"]);
+                d->setScaleMode(static_cast<MultiBandAnalyzer::ScaleMode>(static_cast<int>(v["scaleMode"])));
+                d->setDataSource(static_cast<MultiBandAnalyzer::DataSource>(static_cast<int>(v["dataSource"])));
+            }
+            break;
+
+        case MeterType::Spectrogram:
+            if (auto* d = dynamic_cast<Spectrogram*>(comp); d && !v.isEmpty())
+            {
+                d->setColourMap(static_cast<Spectrogram::ColourMap>(static_cast<int>(v["colourMap"])));
+                d->setScrollDirection(static_cast<Spectrogram::ScrollDirection>(static_cast<int>(v["scrollDir"])));
+                d->setDynamicRange(v["minDb"], v["maxDb"]);
+            }
+            break;
+
+        case MeterType::Goniometer:
+            if (auto* d = dynamic_cast<Goniometer*>(comp); d && !v.isEmpty())
+            {
+                d->setDotSize(v["dotSize"]);
+                d->setTrailOpacity(v["trailOpacity"]);
+                d->setShowGrid(v["showGrid"]);
+            }
+            break;
+
+        case MeterType::LissajousScope:
+            if (auto* d = dynamic_cast<LissajousScope*>(comp); d && !v.isEmpty())
+            {
+                d->setMode(static_cast<LissajousScope::Mode>(static_cast<int>(v["mode"])));
+                d->setTrailLength(v["trailLength"]);
+                d->setShowGrid(v["showGrid"]);
+            }
+            break;
+
+        case MeterType::LoudnessMeter:
+            if (auto* d = dynamic_cast<LoudnessMeter*>(comp); d && !v.isEmpty())
+            {
+                d->setTargetLUFS(v["targetLUFS"]);
+                d->setShowHistory(v["showHistory"]);
+            }
+            break;
+
+        case MeterType::LevelHistogram:
+            if (auto* d = dynamic_cast<LevelHistogram*>(comp); d && !v.isEmpty())
+            {
+                d->setDisplayRange(v["minDb"], v["maxDb"]);
+                d->setBinResolution(v["binResolution"]);
+                d->setCumulative(v["cumulative"]);
+                d->setShowStereo(v["showStereo"]);
+            }
+            break;
+
+        case MeterType::CorrelationMeter:
+            if (auto* d = dynamic_cast<CorrelationMeter*>(comp); d && !v.isEmpty())
+            {
+                d->setIntegrationTimeMs(v["integrationMs"]);
+                d->setShowNumeric(v["showNumeric"]);
+            }
+            break;
+
+        case MeterType::PeakMeter:
+            if (auto* d = dynamic_cast<PeakMeter*>(comp); d && !v.isEmpty())
+            {
+                d->setPeakMode(static_cast<PeakMeter::PeakMode>(static_cast<int>(v["peakMode"])));
+                d->setPeakHoldTimeMs(v["peakHoldMs"]);
+                d->setDecayRateDbPerSec(v["decayRate"]);
+                d->setShowClipWarning(v["showClip"]);
+            }
+            break;
+
+        case MeterType::SkinnedVUMeter:
+            if (auto* d = dynamic_cast<SkinnedVUMeter*>(comp))
+            {
+                if (!v.isEmpty())
+                {
+                    d->setBallistic(static_cast<SkinnedVUMeter::Ballistic>(static_cast<int>(v["ballistic"])));
+                    d->setDecayTimeMs(v["decayMs"]);
+                }
+                d->setChannelLabel(p.vuChannel == 1 ? "R" : "L");
+            }
+            break;
+
+        case MeterType::SkinnedSpectrum:
+            if (auto* d = dynamic_cast<SkinnedSpectrumAnalyzer*>(comp); d && !v.isEmpty())
+            {
+                d->setDecayRate(v["decayRate"]);
+                d->setNumBands(v["numBands"]);
+            }
+            break;
+
+        case MeterType::SkinnedOscilloscope:
+            if (auto* d = dynamic_cast<SkinnedOscilloscope*>(comp); d && !v.isEmpty())
+            {
+                d->setLineThickness(v["lineThickness"]);
+                d->setDrawStyle(v["drawStyle"]);
+            }
+            break;
+
+        case MeterType::WinampSkin:
+            if (auto* d = dynamic_cast<WinampSkinRenderer*>(comp); d && item.skin)
+                d->setSkinModel(item.skin.get());
+            break;
+
+        case MeterType::SkinnedPlayer:
+            // The panel keeps a pointer; the scene owns the model for the
+            // whole export
+            if (auto* d = dynamic_cast<SkinnedPlayerPanel*>(comp); d && item.skin)
+            {
+                d->setSkinModel(item.skin.get());
+                d->setScale(v["scale"]);
+            }
+            break;
+
+        case MeterType::Equalizer:
+            if (auto* d = dynamic_cast<EqualizerPanel*>(comp); d && !v.isEmpty())
+            {
+                if (item.skin)
+                    d->setSkinModel(item.skin.get());
+                d->setScale(v["scale"]);
+                d->setEqOn(v["eqOn"]);
+                d->setAutoOn(v["autoOn"]);
+                d->setPreamp(v["preamp"]);
+                if (auto* gains = v["bandGains"].getArray())
+                    for (int b = 0; b < juce::jmin(EqualizerPanel::kNumBands, gains->size()); ++b)
+                        d->setBandGain(b, (*gains)[b]);
+            }
+            break;
+
+        case MeterType::ShapeRectangle:
+        case MeterType::ShapeEllipse:
+        case MeterType::ShapeTriangle:
+        case MeterType::ShapeLine:
+        case MeterType::ShapeStar:
+        case MeterType::ShapeSVG:
+            if (auto* d = dynamic_cast<ShapeComponent*>(comp))
+            {
+                d->setFillColour1(p.fillColour1);
+                d->setFillColour2(p.fillColour2);
+                d->setGradientDirection(p.gradientDirection);
+                d->setCornerRadius(p.cornerRadius);
+                d->setStrokeColour(p.strokeColour);
+                d->setStrokeWidth(p.strokeWidth);
+                d->setStrokeAlignment(static_cast<StrokeAlignment>(p.strokeAlignment));
+                d->setLineCap(static_cast<LineCap>(p.lineCap));
+                d->setStarPoints(p.starPoints);
+                d->setTriangleRoundness(p.triangleRoundness);
+                if (p.svgPathData.isNotEmpty())
+                    d->setSvgPathData(p.svgPathData);
+
+                d->setItemBackground(p.itemBackground);
+                d->setFrostedGlass(p.frostedGlass);
+                d->setBlurRadius(p.blurRadius);
+                d->setFrostTint(p.frostTint);
+                d->setFrostOpacity(p.frostOpacity);
+            }
+            break;
+
+        case MeterType::TextLabel:
+            if (auto* d = dynamic_cast<TextLabelComponent*>(comp))
+            {
+                d->setTextContent(p.textContent);
+                d->setFontFamily(p.fontFamily);
+                d->setFontSize(p.fontSize);
+                d->setBold(p.fontBold);
+                d->setItalic(p.fontItalic);
+                d->setTextColour(p.textColour);
+                d->setTextAlignment(p.textAlignment);
+                d->setFillColour1(p.fillColour1);
+                d->setFillColour2(p.fillColour2);
+                d->setGradientDirection(p.gradientDirection);
+                d->setCornerRadius(p.cornerRadius);
+                d->setStrokeColour(p.strokeColour);
+                d->setStrokeWidth(p.strokeWidth);
+                d->setItemBackground(p.itemBackground);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+} // namespace Export
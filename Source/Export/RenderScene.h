@@ -0,0 +1,55 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+#include "../Canvas/CanvasModel.h"
+#include "../Canvas/CanvasItem.h"
+#include "../Skin/SkinModel.h"
+
+namespace Export
+{
+
+//==============================================================================
+/// RenderScene — immutable snapshot of everything an export draws.
+///
+/// Captured once on the message thread when an export is queued: item
+/// properties, the settings the live meter components hold, skin models,
+/// plugin property values and the background.  The OfflineRenderer builds
+/// its own components from the snapshot and never touches the CanvasModel
+/// or the live components, so the canvas keeps playing and can be edited
+/// while exports run, and several exports can be queued from different
+/// states of the project.
+struct RenderScene
+{
+    struct Item
+    {
+        CanvasItem                              props;          ///< model properties; component is null
+        juce::NamedValueSet                     meterSettings;  ///< settings held by the live meter component
+        std::shared_ptr<const Skin::SkinModel>  skin;           ///< skinned items (player, EQ, Winamp skin)
+        std::vector<std::pair<juce::String, juce::var>> pluginProperties;  ///< CustomPlugin values
+    };
+
+    std::vector<Item>   items;          ///< visible items in z-order
+    CanvasBackground    background;
+
+    /// Snapshot @p model.  Message thread only.
+    static std::shared_ptr<const RenderScene> capture(const CanvasModel& model);
+
+    /// Copy every persistent property of @p src (not the component or the
+    /// runtime culling state) into @p dst.
+    static void copyItemProperties(const CanvasItem& src, CanvasItem& dst);
+
+    /// Configure a freshly created meter @p component from @p item.
+    static void configureMeter(const Item& item, juce::Component& component);
+
+    /// Serialise for a render-farm worker.  Files (media, background, skins)
+    /// are referenced by absolute path, so they must be reachable at the same
+    /// path on the worker; skins are parsed again from their .wsz files.
+    juce::var toVar() const;
+
+    /// Rebuild a scene written by toVar().  Any thread.
+    static std::shared_ptr<const RenderScene> fromVar(const juce::var& v);
+};
+
+} // namespace Export
@@ -1,6 +1,8 @@
 #include <JuceHeader.h>
 #include "UI/MainWindow.h"
+#include "Export/RenderFarm.h"
 #include "UI/SkeuomorphicLookAndFeel.h"
+#include "Utils/AsyncLogger.h"
 #include <fstream>
 #include <csignal>
 #include <windows.h>
@@ -19,6 +21,8 @@ extern "C" { __declspec(dllexport) unsigned long AmdPowerXpressRequestHighPerfor
 namespace CrashGuard {
     inline void logCrash(const char* reason)
     {
+        AsyncLogger::getInstance().flush(false);   // pending diagnostics first
+
         auto p = juce::File::getSpecialLocation(
                      juce::File::currentApplicationFile)
                      .getParentDirectory()
@@ -82,7 +86,12 @@ public:
 
     const juce::String getApplicationName() override    { return "MaxiMeter"; }
     const juce::String getApplicationVersion() override { return "0.1.0"; }
-    bool moreThanOneInstanceAllowed() override           { return false; }
+
+    // Render-farm workers are extra copies of this executable
+    bool moreThanOneInstanceAllowed() override
+    {
+        return getCommandLineParameterArray().contains(RenderFarm::kWorkerSwitch);
+    }
 
     //==========================================================================
     void initialise(const juce::String& commandLine) override
@@ -91,6 +100,24 @@ public:
 
         CrashGuard::install();
 
+        // Headless render worker: no window, quits when the coordinator is done
+        const auto args = getCommandLineParameterArray();
+        const int workerArg = args.indexOf(RenderFarm::kWorkerSwitch);
+        if (workerArg >= 0)
+        {
+            renderWorker = std::make_unique<RenderFarmWorker>();
+            renderWorker->onFinished = [] { juce::MessageManager::callAsync([] { quit(); }); };
+            if (!renderWorker->connect(args[workerArg + 1], args[workerArg + 2]))
+                quit();
+            return;
+        }
+
+        // Mirror diagnostics to a file next to the executable (opt-in)
+        if (args.contains(kLogFileSwitch))
+            AsyncLogger::getInstance().setFileSink(
+                juce::File::getSpecialLocation(juce::File::currentApplicationFile)
+                    .getParentDirectory().getChildFile("MaxiMeter_debug.log"));
+
         // Apply skeuomorphic look-and-feel
         juce::LookAndFeel::setDefaultLookAndFeel(&lookAndFeel);
 
@@ -101,9 +128,11 @@ public:
 
     void shutdown() override
     {
+        renderWorker.reset();
         mainWindow.reset();
         ThemeManager::getInstance().removeListener(this);
         juce::LookAndFeel::setDefaultLookAndFeel(nullptr);
+        AsyncLogger::getInstance().shutdown();
     }
 
     //==========================================================================
@@ -120,7 +149,11 @@ public:
     void anotherInstanceStarted(const juce::String& /*commandLine*/) override {}
 
 private:
+    /// Write the diagnostic log to MaxiMeter_debug.log (run_debug.bat passes it)
+    static constexpr const char* kLogFileSwitch = "--log-file";
+
     std::unique_ptr<MainWindow> mainWindow;
+    std::unique_ptr<RenderFarmWorker> renderWorker;
     SkeuomorphicLookAndFeel lookAndFeel;
 };
 
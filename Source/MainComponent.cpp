@@ -1,13 +1,16 @@
 #include "MainComponent.h"
+#include "Audio/AudioTelemetry.h"
 #include "Utils/CrashHandler.h"
+#include "Utils/AsyncLogger.h"
 #include "UI/SettingsWindow.h"
 #include "UI/SplashOverlay.h"
 #include "Canvas/CanvasCommands.h"
 #include "Project/AppSettings.h"
 #include "Export/ExportDialog.h"
 #include "Export/ExportProgressWindow.h"
-#include "Export/OfflineRenderer.h"
+#include "Export/RenderFarm.h"
 #include "Project/ProjectSerializer.h"
+#include "Project/ProjectBundle.h"
 #include "Project/PresetTemplates.h"
 #include "UI/ImageLayerComponent.h"
 #include "UI/VideoLayerComponent.h"
@@ -23,7 +26,8 @@ MainComponent::MainComponent()
     : transportBar(audioEngine),
       waveformView(audioEngine),
       statusBar(audioEngine, levelAnalyzer),
-      canvasEditor(audioEngine, fftProcessor, levelAnalyzer, loudnessAnalyzer, stereoAnalyzer)
+      canvasEditor(audioEngine, fftProcessor, octaveBands, levelAnalyzer, loudnessAnalyzer,
+                   stereoAnalyzer, metricHistory, analysisGraph, stemBank)
 {
     // Register as theme listener
     ThemeManager::getInstance().addListener(this);
@@ -31,6 +35,10 @@ MainComponent::MainComponent()
     // Initialise Crash Handler with emergency save callback
     CrashHandler::init([this]() { emergencySave(); });
 
+    // The status bar's level readout needs the level analyzer whatever the
+    // canvas shows; everything else follows the canvas contents.
+    analysisGraph.setBaseRequirements({ Analysis::Levels, 0 });
+
     // Wire up the audio analysis callback (runs on audio thread — must be lock-free!)
     audioEngine.setAudioBlockCallback(
         [this](const juce::AudioSourceChannelInfo& info)
@@ -46,21 +54,69 @@ MainComponent::MainComponent()
                                          ? buffer->getReadPointer(1, startSample)
                                          : left;
 
+                using Stage = AudioTelemetry::Stage;
+                using Analysis::Need;
+
+                // Analyzers the canvas switched back on start from a clean
+                // state.  The FFT, filter bank and history take the request
+                // at this block; the rest are reset by timerCallback().
+                if (const auto activated = analysisGraph.takeActivated())
+                {
+                    if (activated & Analysis::Spectrum) fftProcessor.requestReset();
+                    if (activated & Analysis::Bands)    octaveBands.reset();
+                    if (activated & Analysis::History)  metricHistory.reset();
+                    pendingResets.fetch_or(activated, std::memory_order_relaxed);
+                }
+                fftProcessor.beginBlock();
+
                 // Mix to mono for FFT
-                for (int i = 0; i < numSamples; ++i)
+                if (analysisGraph.isActive(Need::Spectrum))
+                {
+                    const AudioTelemetry::ScopedStage t(Stage::Fft);
+                    for (int i = 0; i < numSamples; ++i)
+                    {
+                        float mono = (left[i] + right[i]) * 0.5f;
+                        fftProcessor.pushSamples(&mono, 1);
+                    }
+                }
+
+                // Fractional-octave filter bank (per-sample, SIMD lanes)
+                if (analysisGraph.isActive(Need::Bands))
                 {
-                    float mono = (left[i] + right[i]) * 0.5f;
-                    fftProcessor.pushSamples(&mono, 1);
+                    const AudioTelemetry::ScopedStage t(Stage::Bands);
+                    octaveBands.processSamples(left, right, numSamples);
                 }
 
                 // Feed level analyzer
-                levelAnalyzer.processSamples(left, right, numSamples);
+                if (analysisGraph.isActive(Need::Levels))
+                {
+                    const AudioTelemetry::ScopedStage t(Stage::Level);
+                    levelAnalyzer.processSamples(left, right, numSamples);
+                }
 
                 // Feed loudness analyzer (K-weighting + gated integration)
-                loudnessAnalyzer.processSamples(left, right, numSamples);
+                if (analysisGraph.isActive(Need::Loudness))
+                {
+                    const AudioTelemetry::ScopedStage t(Stage::Loudness);
+                    loudnessAnalyzer.processSamples(left, right, numSamples);
+                }
 
                 // Feed stereo field analyzer (correlation + goniometer)
-                stereoAnalyzer.processSamples(left, right, numSamples);
+                if (analysisGraph.isActive(Need::Stereo))
+                {
+                    const AudioTelemetry::ScopedStage t(Stage::Stereo);
+                    stereoAnalyzer.processSamples(left, right, numSamples);
+                }
+
+                // Record fixed-rate history for graphs (after the analyzers above)
+                if (analysisGraph.isActive(Need::History))
+                {
+                    const AudioTelemetry::ScopedStage t(Stage::History);
+                    metricHistory.processSamples(left, right, numSamples,
+                                                 loudnessAnalyzer.getMomentaryLUFS(),
+                                                 loudnessAnalyzer.getShortTermLUFS(),
+                                                 stereoAnalyzer.getCorrelation());
+                }
             }
         });
 
@@ -214,6 +270,11 @@ MainComponent::~MainComponent()
     openGLContext_.detach();
     stopTimer();
     ThemeManager::getInstance().removeListener(this);
+
+    // Let queued project saves finish writing
+    if (savePool != nullptr)
+        while (savePool->getNumJobs() > 0)
+            juce::Thread::sleep(10);
 }
 
 //==============================================================================
@@ -264,9 +325,30 @@ void MainComponent::timerCallback()
         }
     }
 
+    // Resets the audio thread asked for when analyzers came back on
+    if (const auto resets = pendingResets.exchange(0, std::memory_order_relaxed))
+    {
+        if (resets & Analysis::Levels)   levelAnalyzer.reset();
+        if (resets & Analysis::Loudness) loudnessAnalyzer.reset();
+        if (resets & Analysis::Stereo)   stereoAnalyzer.reset();
+    }
+
+    // Follow the FFT size the visible items ask for (applied by the audio
+    // thread at the start of a block)...
+    fftProcessor.requestFFTOrder(analysisGraph.getFFTOrder());
+
+    // ...and the filter-bank resolution (likewise)
+    octaveBands.setBandsPerOctave(analysisGraph.getBandsPerOctave());
+
+    // Plugin features ride on the mix FFT frames
+    fftProcessor.setFeaturesEnabled(analysisGraph.isActive(Analysis::Features));
+
     // Process any pending FFT data on the GUI thread
     while (fftProcessor.processNextBlock()) {}
 
+    // Bring the stems up to where the mix analysis is (worker pool, no wait)
+    stemBank.advanceTo(audioEngine.getAnalysisClock());
+
     // Feed all meters through the canvas editor
     canvasEditor.timerTick();
 
@@ -300,7 +382,10 @@ void MainComponent::timerCallback()
         if (autoSaveElapsedMs >= autoSaveIntervalMs)
         {
             autoSaveElapsedMs = 0;
-            saveProject();
+
+            // Still writing the previous one: try again next interval
+            if (savePool == nullptr || savePool->getNumJobs() == 0)
+                saveProject();
         }
     }
 }
@@ -314,19 +399,36 @@ void MainComponent::loadAudioFile(const juce::File& file)
 
         levelAnalyzer.setSampleRate(sr);
         levelAnalyzer.reset();
-        fftProcessor.reset();
+        fftProcessor.getFeatureExtractor().setSampleRate(sr);
+        fftProcessor.requestReset();
+        octaveBands.setSampleRate(sr);
+        octaveBands.reset();
         waveformView.loadThumbnail(file);
 
         loudnessAnalyzer.setSampleRate(sr);
         loudnessAnalyzer.reset();
         stereoAnalyzer.setSampleRate(sr);
         stereoAnalyzer.reset();
+        metricHistory.setSampleRate(sr);
 
         // Reset meters through canvas editor
         canvasEditor.onFileLoaded(sr);
     }
 }
 
+void MainComponent::addStems(const juce::Array<juce::File>& files)
+{
+    for (const auto& f : files)
+        stemBank.addStem(f);
+    canvasEditor.onStemsChanged();
+}
+
+void MainComponent::clearStems()
+{
+    stemBank.clear();
+    canvasEditor.onStemsChanged();
+}
+
 void MainComponent::loadSkin(const juce::File& skinFile)
 {
     if (winampRenderer.loadSkin(skinFile))
@@ -461,23 +563,30 @@ void MainComponent::showExportDialog()
     defaults.frameRate = (fpsId == 5) ? Export::FrameRate::FPS_60 : Export::FrameRate::FPS_30;
 
     auto* dialog = new ExportDialog(defaults, audioFile);
+    dialog->createEstimator = [this](const Export::Settings& settings)
+    {
+        auto sampleSettings = settings;
+        sampleSettings.stemFiles = stemBank.getStemFiles();
+        return std::make_unique<ExportEstimator>(
+            sampleSettings,
+            Export::RenderScene::capture(canvasEditor.getModel()),
+            audioEngine);
+    };
     dialog->onExport = [this](const Export::Settings& settings)
     {
-        // Freeze the canvas viewport during export
-        canvasEditor.setExportOverlay(true);
-
-        // Create an offline renderer and launch the progress window
-        auto renderer = std::make_unique<OfflineRenderer>(
-            settings,
-            canvasEditor.getModel(),
+        // The export analyses the same stems as the live view
+        auto exportSettings = settings;
+        exportSettings.stemFiles = stemBank.getStemFiles();
+
+        // The renderer works from a snapshot, so the canvas keeps running
+        // and can be edited (or exported again) while this one renders
+        auto renderer = RenderFarm::createJob(
+            exportSettings,
+            Export::RenderScene::capture(canvasEditor.getModel()),
             audioEngine);
 
         // The ExportProgressWindow takes ownership and self-deletes on close
-        auto* progressWin = new ExportProgressWindow(std::move(renderer));
-        progressWin->onClose = [this]()
-        {
-            canvasEditor.setExportOverlay(false);
-        };
+        new ExportProgressWindow(std::move(renderer));
     };
 
     juce::DialogWindow::LaunchOptions options;
@@ -502,16 +611,23 @@ void MainComponent::themeChanged(AppTheme /*newTheme*/)
     // Propagate theme to all sub-panels that cache widget colors
     canvasEditor.applyThemeToAllPanels();
 
-    // Recursively repaint the entire component tree
     sendLookAndFeelChange();
-    
-    std::function<void(juce::Component*)> repaintAll = [&](juce::Component* comp)
+
+    // One repaint of the root covers every plain child.  Only components
+    // with a cached image (buffered / OpenGL) keep stale pixels and need
+    // invalidating individually.
+    repaint();
+
+    std::function<void(juce::Component*)> invalidateCached = [&](juce::Component* comp)
     {
-        comp->repaint();
-        for (int i = 0; i < comp->getNumChildComponents(); ++i)
-            repaintAll(comp->getChildComponent(i));
+        for (auto* child : comp->getChildren())
+        {
+            if (child->getCachedComponentImage() != nullptr)
+                child->repaint();
+            invalidateCached(child);
+        }
     };
-    repaintAll(this);
+    invalidateCached(this);
 }
 
 //==============================================================================
@@ -547,7 +663,7 @@ void MainComponent::newProject()
 void MainComponent::openProject()
 {
     auto chooser = std::make_shared<juce::FileChooser>(
-        "Open Project", juce::File(), "*.mmproj");
+        "Open Project", juce::File(), "*.mmproj;*.mmpz");
 
     chooser->launchAsync(juce::FileBrowserComponent::openMode
                        | juce::FileBrowserComponent::canSelectFiles,
@@ -581,10 +697,7 @@ void MainComponent::saveProject()
         if (skinLoaded && winampRenderer.hasSkin())
             skinFile = {}; // No easy way to get skin file back — save empty
 
-        ProjectSerializer::saveToFile(currentProjectFile,
-                                      canvasEditor.getModel(),
-                                      skinFile,
-                                      audioEngine.getLoadedFile());
+        writeProjectFile(currentProjectFile, skinFile);
         AppSettings::getInstance().set(AppSettings::kLastProjectPath,
                                        currentProjectFile.getFullPathName());
     }
@@ -594,10 +707,42 @@ void MainComponent::saveProject()
     }
 }
 
+juce::ThreadPool& MainComponent::getSavePool()
+{
+    if (savePool == nullptr)
+        savePool = std::make_unique<juce::ThreadPool>(1);
+    return *savePool;
+}
+
+void MainComponent::writeProjectFile(const juce::File& file, const juce::File& skinFile)
+{
+    if (ProjectBundle::isBundle(file))
+    {
+        // Packing hashes and previews assets; only the JSON is built here
+        auto json = ProjectSerializer::serialise(canvasEditor.getModel(),
+                                                 skinFile,
+                                                 audioEngine.getLoadedFile(),
+                                                 stemBank.getStemFiles());
+        getSavePool().addJob([file, json]
+        {
+            if (!ProjectBundle::saveJson(file, json))
+                MAXIMETER_LOG("ERROR", "Project save failed: " + file.getFullPathName());
+        });
+    }
+    else
+    {
+        ProjectSerializer::saveToFile(file,
+                                      canvasEditor.getModel(),
+                                      skinFile,
+                                      audioEngine.getLoadedFile(),
+                                      stemBank.getStemFiles());
+    }
+}
+
 void MainComponent::saveProjectAs()
 {
     auto chooser = std::make_shared<juce::FileChooser>(
-        "Save Project As", juce::File(), "*.mmproj");
+        "Save Project As", juce::File(), "*.mmproj;*.mmpz");
 
     chooser->launchAsync(juce::FileBrowserComponent::saveMode
                        | juce::FileBrowserComponent::canSelectFiles,
@@ -606,15 +751,11 @@ void MainComponent::saveProjectAs()
             auto file = fc.getResult();
             if (file == juce::File()) return;
 
-            // Ensure extension
-            if (!file.hasFileExtension(".mmproj"))
+            // Ensure extension (.mmpz saves a self-contained bundle)
+            if (!file.hasFileExtension(".mmproj") && !ProjectBundle::isBundle(file))
                 file = file.withFileExtension(".mmproj");
 
-            juce::File skinFile;
-            ProjectSerializer::saveToFile(file,
-                                          canvasEditor.getModel(),
-                                          skinFile,
-                                          audioEngine.getLoadedFile());
+            writeProjectFile(file, {});
             currentProjectFile = file;
             AppSettings::getInstance().set(AppSettings::kLastProjectPath,
                                            file.getFullPathName());
@@ -855,6 +996,7 @@ void MainComponent::loadProjectResult(const juce::File& file,
             item->opacity  = desc.opacity;
             item->mediaFilePath = desc.mediaFilePath;
             item->vuChannel = desc.vuChannel;
+            item->audioSource = desc.audioSource;
             item->itemBackground = desc.itemBackground;
 
             // Meter colour overrides
@@ -961,7 +1103,13 @@ void MainComponent::loadProjectResult(const juce::File& file,
                     if (desc.type == MeterType::ImageLayer)
                     {
                         if (auto* comp = dynamic_cast<ImageLayerComponent*>(item->component.get()))
-                            comp->loadFromFile(mediaFile);
+                        {
+                            auto preview = result.previews.find(desc.mediaFilePath);
+                            if (preview != result.previews.end())
+                                comp->loadFromFileDeferred(mediaFile, preview->second);
+                            else
+                                comp->loadFromFile(mediaFile);
+                        }
                     }
                     else if (desc.type == MeterType::VideoLayer)
                     {
@@ -994,11 +1142,10 @@ void MainComponent::loadProjectResult(const juce::File& file,
                                         : juce::Uuid().toString();
                     item->customInstanceId = instanceId;
 
-                    if (bridge.isRunning())
+                    if (bridge.isAvailable())
                     {
-                        auto props = bridge.createInstance(desc.customPluginId, instanceId);
-                        if (!props.empty())
-                            cpc->setPluginProperties(props);
+                        if (auto props = bridge.createInstance(desc.customPluginId, instanceId))
+                            cpc->setPluginProperties(*props);
 
                         // Restore saved property values
                         for (auto& [key, val] : desc.customPluginPropertyValues)
@@ -1050,9 +1197,19 @@ void MainComponent::loadProjectResult(const juce::File& file,
     {
         juce::File audioFile(result.audioFilePath);
         if (audioFile.existsAsFile())
+        {
+            auto summary = result.waveformSummaries.find(result.audioFilePath);
+            if (summary != result.waveformSummaries.end())
+                waveformView.primeThumbnail(audioFile, summary->second);
             loadAudioFile(audioFile);
+        }
     }
 
+    // Stems belong to the project; items keep their binding even if a stem
+    // file has gone missing (they read the mix until it is added back)
+    stemBank.setStems(result.stemFiles);
+    canvasEditor.onStemsChanged();
+
     // Frame view to show all loaded elements.
     // Deferred so the canvas view has its final bounds before we compute zoom/pan.
     juce::MessageManager::callAsync([this]() {
@@ -1084,7 +1241,8 @@ void MainComponent::emergencySave()
     ProjectSerializer::saveToFile(recoveryFile, 
                                   canvasEditor.getModel(), 
                                   juce::File(), 
-                                  audioEngine.getLoadedFile());
+                                  audioEngine.getLoadedFile(),
+                                  stemBank.getStemFiles());
                                   
     CrashHandler::log("Canvas Model saved to: " + recoveryFile.getFullPathName().toStdString());
 }
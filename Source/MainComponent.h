@@ -6,6 +6,10 @@
 #include "Audio/LevelAnalyzer.h"
 #include "Audio/LoudnessAnalyzer.h"
 #include "Audio/StereoFieldAnalyzer.h"
+#include "Audio/MetricHistory.h"
+#include "Audio/OctaveBandAnalyzer.h"
+#include "Audio/AnalysisGraph.h"
+#include "Audio/StemBank.h"
 #include "UI/TransportBar.h"
 #include "UI/WaveformView.h"
 #include "UI/StatusBar.h"
@@ -44,6 +48,10 @@ public:
     /// Load a Winamp skin (.wsz or folder)
     void loadSkin(const juce::File& skinFile);
 
+    /// Add stems that canvas meters can be bound to instead of the mix
+    void addStems(const juce::Array<juce::File>& files);
+    void clearStems();
+
     /// Access the audio engine
     AudioEngine& getAudioEngine() { return audioEngine; }
 
@@ -84,9 +92,14 @@ private:
     // Audio pipeline
     AudioEngine           audioEngine;
     FFTProcessor          fftProcessor;
+    OctaveBandAnalyzer    octaveBands;
     LevelAnalyzer         levelAnalyzer;
     LoudnessAnalyzer      loudnessAnalyzer;
     StereoFieldAnalyzer   stereoAnalyzer;
+    MetricHistory         metricHistory;
+    AnalysisGraph         analysisGraph;    ///< which of the above the canvas reads
+    StemBank              stemBank;         ///< stems metered alongside the mix
+    std::atomic<uint32_t> pendingResets { 0 }; ///< Analysis bits the audio thread wants reset
 
     // Skin state
     bool                  skinLoaded = false;
@@ -116,6 +129,13 @@ private:
     int autoSaveIntervalMs = 0;
     int autoSaveElapsedMs  = 0;
 
+    /// Writes .mmpz bundles off the message thread, one at a time
+    std::unique_ptr<juce::ThreadPool> savePool;   ///< created on first use
+    juce::ThreadPool& getSavePool();
+
+    /// Save the project to @p file; bundles are packed on the save pool
+    void writeProjectFile(const juce::File& file, const juce::File& skinFile);
+
     void setupLayout();
     void showExportDialog();
 
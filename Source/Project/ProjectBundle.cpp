@@ -0,0 +1,426 @@
+#include "ProjectBundle.h"
+#include "../Audio/MappedAudioReader.h"
+#include "../Utils/AsyncLogger.h"
+
+namespace
+{
+    const juce::String kProjectEntry  { "project.json" };
+    const juce::String kAssetScheme   { "asset:" };
+    const juce::String kAssetDir      { "assets/" };
+    const juce::String kPreviewDir    { "thumbs/" };
+    const juce::String kAnalysisDir   { "analysis/" };
+
+    /// "<64 hex digits><ext>" — anything else could name a path outside the cache.
+    bool isValidAssetName(const juce::String& name)
+    {
+        const auto hash = name.upToFirstOccurrenceOf(".", false, false);
+        return hash.length() == 64
+            && hash.containsOnly("0123456789abcdef")
+            && !name.containsAnyOf("/\\:")
+            && !name.contains("..");
+    }
+
+    /// Formats that are already compressed gain nothing from deflate.
+    bool isCompressedFormat(const juce::File& f)
+    {
+        return f.hasFileExtension("png;jpg;jpeg;gif;webp;mp3;ogg;flac;m4a;aac;opus;"
+                                  "mp4;mov;m4v;webm;mkv;avi;wsz;zip");
+    }
+
+    //==========================================================================
+    /// What a bundle stores for one source file: its hash and previews.
+    struct AssetRecord
+    {
+        juce::Time          modified;
+        juce::int64         size = -1;
+        juce::String        hash;
+        juce::MemoryBlock   preview;    ///< PNG, empty if not an image
+        juce::MemoryBlock   summary;    ///< AudioThumbnail data, empty if not audio
+    };
+
+    /// Records of every file packed this session, keyed by path.  Saving
+    /// again (autosave) only hashes and decodes files whose modification
+    /// time or size changed since.
+    class AssetIndex
+    {
+    public:
+        static AssetIndex& get()
+        {
+            static AssetIndex index;
+            return index;
+        }
+
+        AssetRecord lookup(const juce::File& file, juce::AudioFormatManager& formats)
+        {
+            const auto modified = file.getLastModificationTime();
+            const auto size     = file.getSize();
+            const auto path     = file.getFullPathName();
+            {
+                const juce::ScopedLock sl(lock);
+                if (auto known = records.find(path); known != records.end()
+                     && known->second.modified == modified && known->second.size == size)
+                    return known->second;
+            }
+
+            AssetRecord record;
+            record.modified = modified;
+            record.size     = size;
+            record.hash     = juce::SHA256(file).toHexString();
+            record.preview  = makePreview(file);
+            record.summary  = makeWaveformSummary(file, formats);
+
+            const juce::ScopedLock sl(lock);
+            records[path] = record;
+            return record;
+        }
+
+    private:
+        static juce::MemoryBlock makePreview(const juce::File& file)
+        {
+            if (juce::ImageFileFormat::findImageFormatForFileExtension(file) == nullptr)
+                return {};
+
+            auto image = juce::ImageFileFormat::loadFrom(file);
+            if (!image.isValid())
+                return {};
+
+            const int longest = juce::jmax(image.getWidth(), image.getHeight());
+            if (longest > ProjectBundle::kPreviewSize)
+            {
+                const double scale = ProjectBundle::kPreviewSize / static_cast<double>(longest);
+                image = image.rescaled(juce::jmax(1, juce::roundToInt(image.getWidth()  * scale)),
+                                       juce::jmax(1, juce::roundToInt(image.getHeight() * scale)),
+                                       juce::Graphics::mediumResamplingQuality);
+            }
+
+            juce::MemoryOutputStream png;
+            juce::PNGImageFormat format;
+            if (!format.writeImageToStream(image, png))
+                return {};
+            return png.getMemoryBlock();
+        }
+
+        static juce::MemoryBlock makeWaveformSummary(const juce::File& file,
+                                                     juce::AudioFormatManager& formats)
+        {
+            if (formats.findFormatForFileExtension(file.getFileExtension()) == nullptr)
+                return {};
+
+            auto reader = MappedAudio::createReader(formats, file);
+            if (reader == nullptr || reader->lengthInSamples <= 0)
+                return {};
+
+            const int numChannels = static_cast<int>(juce::jmin(2u, reader->numChannels));
+            juce::AudioThumbnailCache cache { 1 };
+            juce::AudioThumbnail thumbnail { ProjectBundle::kWaveformSamplesPerThumb, formats, cache };
+            thumbnail.reset(numChannels, reader->sampleRate, reader->lengthInSamples);
+
+            constexpr int blockSize = 65536;
+            juce::AudioBuffer<float> block(numChannels, blockSize);
+            for (juce::int64 pos = 0; pos < reader->lengthInSamples; pos += blockSize)
+            {
+                const int n = static_cast<int>(juce::jmin<juce::int64>(blockSize, reader->lengthInSamples - pos));
+                reader->read(&block, 0, n, pos, true, numChannels > 1);
+                thumbnail.addBlock(pos, block, 0, n);
+            }
+
+            juce::MemoryOutputStream summary;
+            thumbnail.saveTo(summary);
+            return summary.getMemoryBlock();
+        }
+
+        juce::CriticalSection                   lock;
+        std::map<juce::String, AssetRecord>     records;
+    };
+
+    //==========================================================================
+    /// Collects the files a project references, one zip entry per distinct
+    /// content, and hands back the reference to store in the JSON.
+    class Packer
+    {
+    public:
+        Packer() { formatManager.registerBasicFormats(); }
+
+        /// Reference for @p path, adding the file on first sight.  Paths that
+        /// do not exist are kept as they are.
+        juce::String add(const juce::String& path)
+        {
+            if (path.isEmpty())
+                return path;
+
+            const juce::File file(path);
+            if (!file.existsAsFile())
+                return path;
+
+            if (auto known = refsByPath.find(path); known != refsByPath.end())
+                return known->second;
+
+            const auto record = AssetIndex::get().lookup(file, formatManager);
+            const auto& hash  = record.hash;
+            const auto name = hash + file.getFileExtension().toLowerCase();
+            const auto ref  = kAssetScheme + name;
+            refsByPath[path] = ref;
+
+            if (storedHashes.contains(hash))
+                return ref;
+            storedHashes.add(hash);
+
+            builder.addFile(file, isCompressedFormat(file) ? 0 : 6, kAssetDir + name);
+            if (!record.preview.isEmpty())
+                addData(kPreviewDir + hash + ".png", record.preview, 0);
+            if (!record.summary.isEmpty())
+                addData(kAnalysisDir + hash + ".wfm", record.summary, 6);
+            return ref;
+        }
+
+        void addText(const juce::String& entryName, const juce::String& text)
+        {
+            juce::MemoryBlock data(text.toRawUTF8(), text.getNumBytesAsUTF8());
+            addData(entryName, data, 6);
+        }
+
+        bool writeTo(const juce::File& target)
+        {
+            juce::TemporaryFile temp(target);
+            {
+                auto out = temp.getFile().createOutputStream();
+                if (out == nullptr || !builder.writeToStream(*out, nullptr))
+                    return false;
+            }
+            return temp.overwriteTargetFileWithTemporary();
+        }
+
+    private:
+        void addData(const juce::String& entryName, const juce::MemoryBlock& data, int level)
+        {
+            builder.addEntry(new juce::MemoryInputStream(data, true), level,
+                             entryName, juce::Time::getCurrentTime());
+        }
+
+        juce::ZipFile::Builder                  builder;
+        juce::AudioFormatManager                formatManager;
+        std::map<juce::String, juce::String>    refsByPath;
+        juce::StringArray                       storedHashes;
+    };
+
+    //==========================================================================
+    /// Resolves asset references against an open bundle, extracting each
+    /// asset into the cache the first time it is needed.
+    class Unpacker
+    {
+    public:
+        Unpacker(juce::ZipFile& z, ProjectSerializer::LoadResult& r)
+            : zip(z), result(r), cacheDir(ProjectBundle::getAssetCacheDirectory())
+        {
+            cacheDir.createDirectory();
+        }
+
+        /// Replace @p value (an asset reference) with the extracted path.
+        void resolve(juce::String& value)
+        {
+            if (!value.startsWith(kAssetScheme))
+                return;
+
+            const auto name = value.fromFirstOccurrenceOf(kAssetScheme, false, false);
+            if (!isValidAssetName(name))
+            {
+                MAXIMETER_LOG("ERROR", "Bundle asset reference rejected: " + name);
+                value.clear();
+                return;
+            }
+
+            if (auto done = pathsByName.find(name); done != pathsByName.end())
+            {
+                value = done->second;
+                return;
+            }
+
+            const auto path = extract(name);
+            pathsByName[name] = path;
+            value = path;
+
+            if (path.isNotEmpty())
+            {
+                const auto hash = name.upToFirstOccurrenceOf(".", false, false);
+                readPreview(hash, path);
+                readWaveformSummary(hash, path);
+            }
+        }
+
+    private:
+        juce::String extract(const juce::String& name)
+        {
+            const auto* entry = zip.getEntry(kAssetDir + name);
+            if (entry == nullptr)
+            {
+                MAXIMETER_LOG("ERROR", "Bundle asset missing: " + name);
+                return {};
+            }
+
+            // Content-addressed: a cached file with the right size and hash is
+            // this asset (anything else is stale or damaged and is rewritten)
+            auto target = cacheDir.getChildFile(name);
+            if (target.existsAsFile() && target.getSize() == entry->uncompressedSize
+                 && juce::SHA256(target).toHexString() == name.upToFirstOccurrenceOf(".", false, false))
+                return target.getFullPathName();
+
+            std::unique_ptr<juce::InputStream> in(zip.createStreamForEntry(*entry));
+            if (in == nullptr)
+                return {};
+
+            juce::TemporaryFile temp(target);
+            {
+                auto out = temp.getFile().createOutputStream();
+                if (out == nullptr)
+                    return {};
+                out->writeFromInputStream(*in, -1);
+            }
+            if (!temp.overwriteTargetFileWithTemporary())
+                return {};
+
+            return target.getFullPathName();
+        }
+
+        void readPreview(const juce::String& hash, const juce::String& path)
+        {
+            if (auto in = openEntry(kPreviewDir + hash + ".png"))
+            {
+                juce::PNGImageFormat format;
+                auto image = format.decodeImage(*in);
+                if (image.isValid())
+                    result.previews[path] = image;
+            }
+        }
+
+        void readWaveformSummary(const juce::String& hash, const juce::String& path)
+        {
+            if (auto in = openEntry(kAnalysisDir + hash + ".wfm"))
+            {
+                juce::MemoryBlock data;
+                in->readIntoMemoryBlock(data);
+                result.waveformSummaries[path] = std::move(data);
+            }
+        }
+
+        std::unique_ptr<juce::InputStream> openEntry(const juce::String& entryName)
+        {
+            if (const auto* entry = zip.getEntry(entryName))
+                return std::unique_ptr<juce::InputStream>(zip.createStreamForEntry(*entry));
+            return nullptr;
+        }
+
+        juce::ZipFile&                          zip;
+        ProjectSerializer::LoadResult&          result;
+        juce::File                              cacheDir;
+        std::map<juce::String, juce::String>    pathsByName;
+    };
+
+    void packProperty(juce::var& objectVar, const juce::Identifier& key, Packer& packer)
+    {
+        if (auto* obj = objectVar.getDynamicObject())
+            if (obj->hasProperty(key))
+                obj->setProperty(key, packer.add(obj->getProperty(key).toString()));
+    }
+}
+
+//==============================================================================
+juce::File ProjectBundle::getAssetCacheDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+               .getChildFile("MaxiMeter").getChildFile("AssetCache");
+}
+
+//==============================================================================
+bool ProjectBundle::save(const juce::File& file,
+                         const CanvasModel& model,
+                         const juce::File& skinFile,
+                         const juce::File& audioFile,
+                         const juce::StringPairArray& stemFiles)
+{
+    return saveJson(file, ProjectSerializer::serialise(model, skinFile, audioFile, stemFiles));
+}
+
+bool ProjectBundle::saveJson(const juce::File& file, const juce::String& projectJson)
+{
+    auto root = juce::JSON::parse(projectJson);
+    if (!root.isObject())
+        return false;
+
+    Packer packer;
+
+    // Every file path the serialiser writes becomes an asset reference
+    if (auto* items = root["items"].getArray())
+        for (auto& item : *items)
+        {
+            packProperty(item, "mediaFilePath", packer);
+            packProperty(item, "svgFilePath",   packer);
+        }
+
+    auto background = root["background"];
+    packProperty(background, "imagePath", packer);
+    packProperty(root, "skinFile",  packer);
+    packProperty(root, "audioFile", packer);
+
+    if (auto* stems = root["stems"].getArray())
+        for (auto& stem : *stems)
+            packProperty(stem, "file", packer);
+
+    packer.addText(kProjectEntry, juce::JSON::toString(root, true));
+
+    if (!packer.writeTo(file))
+    {
+        MAXIMETER_LOG("ERROR", "Cannot write bundle: " + file.getFullPathName());
+        return false;
+    }
+    return true;
+}
+
+//==============================================================================
+ProjectSerializer::LoadResult ProjectBundle::load(const juce::File& file)
+{
+    ProjectSerializer::LoadResult result;
+
+    // The zip directory and every stored asset are read straight from the
+    // mapping; only deflated entries are copied through a decompressor.
+    juce::MemoryMappedFile mapped(file, juce::MemoryMappedFile::readOnly);
+    if (mapped.getData() == nullptr)
+    {
+        result.errorMessage = "Cannot open bundle: " + file.getFullPathName();
+        return result;
+    }
+
+    juce::MemoryInputStream stream(mapped.getData(), mapped.getSize(), false);
+    juce::ZipFile zip(stream);
+
+    const auto* projectEntry = zip.getEntry(kProjectEntry);
+    std::unique_ptr<juce::InputStream> projectStream(
+        projectEntry != nullptr ? zip.createStreamForEntry(*projectEntry) : nullptr);
+    if (projectStream == nullptr)
+    {
+        result.errorMessage = "Bundle has no " + kProjectEntry + ".";
+        return result;
+    }
+
+    result = ProjectSerializer::parse(projectStream->readEntireStreamAsString());
+    if (!result.success)
+        return result;
+
+    Unpacker unpacker(zip, result);
+    for (auto& item : result.items)
+    {
+        unpacker.resolve(item.mediaFilePath);
+        unpacker.resolve(item.svgFilePath);
+    }
+    unpacker.resolve(result.bgImagePath);
+    unpacker.resolve(result.skinFilePath);
+    unpacker.resolve(result.audioFilePath);
+
+    for (int i = 0; i < result.stemFiles.size(); ++i)
+    {
+        auto path = result.stemFiles.getAllValues()[i];
+        unpacker.resolve(path);
+        result.stemFiles.set(result.stemFiles.getAllKeys()[i], path);
+    }
+
+    return result;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "ProjectSerializer.h"
+
+//==============================================================================
+/// ProjectBundle — self-contained project file (.mmpz).
+///
+/// A bundle is a zip holding the project JSON plus every file it references
+/// (images, videos, SVGs, skin, audio, stems).  Assets are stored once under
+/// their SHA-256, so an image used by ten items takes up space once, and the
+/// JSON refers to them as "asset:<hash><ext>" instead of absolute paths.
+/// Alongside each asset the bundle keeps what the first paint needs:
+///
+///   project.json          — ProjectSerializer output with asset references
+///   assets/<hash><ext>    — original bytes (media already compressed is stored)
+///   thumbs/<hash>.png     — downscaled preview of every image asset
+///   analysis/<hash>.wfm   — juce::AudioThumbnail data of every audio asset
+///
+/// Loading memory-maps the bundle and copies assets into a content-addressed
+/// cache directory (skipped when the cache already holds them intact), since the
+/// image, video and audio loaders all work on files.  Previews and waveform
+/// summaries come back in the LoadResult so the canvas can show them while
+/// full-resolution images decode in the background.
+class ProjectBundle
+{
+public:
+    static constexpr const char* kExtension = ".mmpz";
+
+    static bool isBundle(const juce::File& file) { return file.hasFileExtension(kExtension); }
+
+    /// Write the project and every file it references to @p file.
+    /// Returns true on success.
+    static bool save(const juce::File& file,
+                     const CanvasModel& model,
+                     const juce::File& skinFile = {},
+                     const juce::File& audioFile = {},
+                     const juce::StringPairArray& stemFiles = {});
+
+    /// Pack already serialised project JSON (ProjectSerializer::serialise)
+    /// into @p file.  Touches no model state, so it may run on a worker
+    /// thread.  Hashes and previews are reused for files that have not
+    /// changed since they were last packed.
+    static bool saveJson(const juce::File& file, const juce::String& projectJson);
+
+    /// Read a bundle.  Asset references in the result are replaced by the
+    /// paths of the extracted files.
+    static ProjectSerializer::LoadResult load(const juce::File& file);
+
+    /// Where extracted assets live (shared by all bundles).
+    static juce::File getAssetCacheDirectory();
+
+    /// Longest edge of the stored image previews, in pixels.
+    static constexpr int kPreviewSize = 256;
+
+    /// Must match the AudioThumbnail resolution used by WaveformView.
+    static constexpr int kWaveformSamplesPerThumb = 512;
+};
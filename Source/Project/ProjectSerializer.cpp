@@ -1,4 +1,5 @@
 #include "ProjectSerializer.h"
+#include "ProjectBundle.h"
 #include "../Canvas/CustomPluginComponent.h"
 
 //==============================================================================
@@ -103,6 +104,8 @@ juce::var ProjectSerializer::itemToVar(const CanvasItem& item)
     obj->setProperty("aspectLock", item.aspectLock);
     obj->setProperty("opacity",    item.opacity);
     obj->setProperty("vuChannel",  item.vuChannel);
+    if (item.audioSource.isNotEmpty())
+        obj->setProperty("audioSource", item.audioSource);
     obj->setProperty("itemBackground", item.itemBackground.toString());
 
     // Grouping
@@ -218,7 +221,8 @@ juce::var ProjectSerializer::gridToVar(const GridSettings& grid)
 
 juce::String ProjectSerializer::serialise(const CanvasModel& model,
                                           const juce::File& skinFile,
-                                          const juce::File& audioFile)
+                                          const juce::File& audioFile,
+                                          const juce::StringPairArray& stemFiles)
 {
     auto* root = new juce::DynamicObject();
     root->setProperty("formatVersion", kFormatVersion);
@@ -247,15 +251,33 @@ juce::String ProjectSerializer::serialise(const CanvasModel& model,
     if (audioFile.existsAsFile())
         root->setProperty("audioFile", audioFile.getFullPathName());
 
+    // Stems analysed alongside the mix
+    if (stemFiles.size() > 0)
+    {
+        juce::Array<juce::var> stemArray;
+        for (int i = 0; i < stemFiles.size(); ++i)
+        {
+            auto* stemObj = new juce::DynamicObject();
+            stemObj->setProperty("id",   stemFiles.getAllKeys()[i]);
+            stemObj->setProperty("file", stemFiles.getAllValues()[i]);
+            stemArray.add(juce::var(stemObj));
+        }
+        root->setProperty("stems", stemArray);
+    }
+
     return juce::JSON::toString(juce::var(root), true);
 }
 
 bool ProjectSerializer::saveToFile(const juce::File& file,
                                    const CanvasModel& model,
                                    const juce::File& skinFile,
-                                   const juce::File& audioFile)
+                                   const juce::File& audioFile,
+                                   const juce::StringPairArray& stemFiles)
 {
-    auto json = serialise(model, skinFile, audioFile);
+    if (ProjectBundle::isBundle(file))
+        return ProjectBundle::save(file, model, skinFile, audioFile, stemFiles);
+
+    auto json = serialise(model, skinFile, audioFile, stemFiles);
     return file.replaceWithText(json);
 }
 
@@ -268,6 +290,9 @@ ProjectSerializer::LoadResult ProjectSerializer::loadFromFile(const juce::File&
     if (!file.existsAsFile())
         return { false, "File not found: " + file.getFullPathName() };
 
+    if (ProjectBundle::isBundle(file))
+        return ProjectBundle::load(file);
+
     auto json = file.loadFileAsString();
     return parse(json);
 }
@@ -324,6 +349,8 @@ ProjectSerializer::LoadResult ProjectSerializer::parse(const juce::String& json)
                     desc.mediaFilePath = obj->getProperty("mediaFilePath").toString();
                 if (obj->hasProperty("vuChannel"))
                     desc.vuChannel = static_cast<int>((int)obj->getProperty("vuChannel"));
+                if (obj->hasProperty("audioSource"))
+                    desc.audioSource = obj->getProperty("audioSource").toString();
                 if (obj->hasProperty("itemBackground"))
                     desc.itemBackground = juce::Colour::fromString(obj->getProperty("itemBackground").toString());
 
@@ -451,6 +478,14 @@ ProjectSerializer::LoadResult ProjectSerializer::parse(const juce::String& json)
     result.skinFilePath  = root->getProperty("skinFile").toString();
     result.audioFilePath = root->getProperty("audioFile").toString();
 
+    if (auto* stemArray = root->getProperty("stems").getArray())
+    {
+        for (const auto& sv : *stemArray)
+            if (auto* stemObj = sv.getDynamicObject())
+                result.stemFiles.set(stemObj->getProperty("id").toString(),
+                                     stemObj->getProperty("file").toString());
+    }
+
     result.success = true;
     return result;
 }
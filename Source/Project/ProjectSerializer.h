@@ -20,13 +20,16 @@ public:
     /// Serialise the full project to a JSON string.
     static juce::String serialise(const CanvasModel& model,
                                   const juce::File& skinFile = {},
-                                  const juce::File& audioFile = {});
+                                  const juce::File& audioFile = {},
+                                  const juce::StringPairArray& stemFiles = {});
 
-    /// Serialise and write to file.  Returns true on success.
+    /// Serialise and write to file; .mmpz files are written as a bundle
+    /// (see ProjectBundle).  Returns true on success.
     static bool saveToFile(const juce::File& file,
                            const CanvasModel& model,
                            const juce::File& skinFile = {},
-                           const juce::File& audioFile = {});
+                           const juce::File& audioFile = {},
+                           const juce::StringPairArray& stemFiles = {});
 
     //-- Deserialisation -----------------------------------------------------
 
@@ -50,6 +53,7 @@ public:
             float          opacity = 1.0f;
             juce::String   mediaFilePath;
             int            vuChannel = 0;
+            juce::String   audioSource;     ///< stem id, empty = mix
             juce::Colour   itemBackground { 0x00000000 };
 
             // Meter colour overrides
@@ -119,9 +123,14 @@ public:
         // External references
         juce::String            skinFilePath;
         juce::String            audioFilePath;
+        juce::StringPairArray   stemFiles { false };   ///< stem id -> file path
+
+        // Bundles only (see ProjectBundle): keyed by extracted file path
+        std::map<juce::String, juce::Image>        previews;            ///< downscaled images
+        std::map<juce::String, juce::MemoryBlock>  waveformSummaries;   ///< AudioThumbnail data
     };
 
-    /// Load from file.
+    /// Load from file (.mmproj, or a .mmpz bundle via ProjectBundle).
     static LoadResult loadFromFile(const juce::File& file);
 
     /// Parse from JSON string.
@@ -5,30 +5,27 @@
  * @brief Debug log window and diagnostic logger for MaxiMeter.
  *
  * Provides:
- *   - DebugLogger:   Singleton ring-buffer that captures diagnostic messages.
- *   - DebugLogWindow: DocumentWindow that displays bridge status, instance
- *                      diagnostics, and a scrollable live log.
+ *   - DebugLogger:   Facade over AsyncLogger (see Utils/AsyncLogger.h), which
+ *                    defines MAXIMETER_LOG.
+ *   - DebugLogWindow: DocumentWindow that displays bridge status, audio-thread
+ *                      telemetry, instance diagnostics, and a scrollable live log.
  */
 
 #include <JuceHeader.h>
 #include "../Canvas/PythonPluginBridge.h"
+#include "../Audio/AudioTelemetry.h"
+#include "../Audio/FFTBenchmark.h"
 #include "SkinnedTitleBarLookAndFeel.h"
 #include "ThemeManager.h"
-#include <deque>
-#include <mutex>
+#include "../Utils/AsyncLogger.h"
 
 //==============================================================================
-/// Thread-safe ring-buffer logger.  Call DebugLogger::log() from anywhere;
-/// the DebugLogWindow will poll for new entries via a timer.
+/// Facade over AsyncLogger kept for existing callers.  log() is wait-free;
+/// entries appear once the drain thread has processed them (~10 ms).
 class DebugLogger
 {
 public:
-    struct Entry
-    {
-        juce::String timestamp;
-        juce::String category;   // "BRIDGE", "SHADER", "RENDER", "INSTANCE", …
-        juce::String message;
-    };
+    using Entry = AsyncLogger::Entry;
 
     static DebugLogger& getInstance()
     {
@@ -36,49 +33,23 @@ public:
         return inst;
     }
 
-    /// Append a log entry (thread-safe).
+    /// Append a log entry with a runtime category (thread-safe).
+    /// Prefer MAXIMETER_LOG, which resolves the category at compile time.
     void log(const juce::String& category, const juce::String& message)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
-        Entry e;
-        e.timestamp = juce::Time::getCurrentTime().toString(false, true, true, true);
-        e.category  = category;
-        e.message   = message;
-        entries_.push_back(std::move(e));
-        if (entries_.size() > maxEntries_)
-            entries_.pop_front();
+        auto cat = category.toRawUTF8();
+        AsyncLogger::getInstance().log(LogCategories::idOf(cat), cat, message);
     }
 
     /// Snapshot all entries (thread-safe).
-    std::vector<Entry> getEntries() const
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return { entries_.begin(), entries_.end() };
-    }
-
-    void clear()
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        entries_.clear();
-    }
-
-    int size() const
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return (int)entries_.size();
-    }
+    std::vector<Entry> getEntries() const { return AsyncLogger::getInstance().getEntries(); }
+    void clear()                          { AsyncLogger::getInstance().clear(); }
+    int size() const                      { return AsyncLogger::getInstance().size(); }
 
 private:
     DebugLogger() = default;
-    mutable std::mutex mutex_;
-    std::deque<Entry> entries_;
-    static constexpr size_t maxEntries_ = 2000;
 };
 
-//==============================================================================
-/// Convenience macro — use throughout the codebase.
-#define MAXIMETER_LOG(cat, msg)  DebugLogger::getInstance().log(cat, msg)
-
 //==============================================================================
 /// The content component shown inside DebugLogWindow.
 class DebugLogContent : public juce::Component,
@@ -144,6 +115,22 @@ public:
         btnTestConnection.setButtonText("Test Connection");
         btnTestConnection.onClick = [this] { testBridgeConnection(); };
 
+        addAndMakeVisible(btnExportTelemetry);
+        btnExportTelemetry.setButtonText("Export Telemetry");
+        btnExportTelemetry.onClick = [this] { exportTelemetry(); };
+
+        addAndMakeVisible(btnResetTelemetry);
+        btnResetTelemetry.setButtonText("Reset");
+        btnResetTelemetry.onClick = []
+        {
+            AudioTelemetry::getInstance().reset();
+            MAXIMETER_LOG("AUDIO", "Telemetry reset by user");
+        };
+
+        addAndMakeVisible(btnFftBenchmark);
+        btnFftBenchmark.setButtonText("FFT Benchmark");
+        btnFftBenchmark.onClick = [] { FFTBenchmark::runAsync(); };
+
         addAndMakeVisible(autoScrollToggle);
         autoScrollToggle.setButtonText("Auto-scroll");
         autoScrollToggle.setToggleState(true, juce::dontSendNotification);
@@ -160,6 +147,7 @@ public:
         filterCombo.addItem("RENDER", 4);
         filterCombo.addItem("INSTANCE", 5);
         filterCombo.addItem("ERROR", 6);
+        filterCombo.addItem("AUDIO", 7);
         filterCombo.setSelectedId(1);
         filterCombo.onChange = [this] { refreshLog(); };
 
@@ -203,6 +191,12 @@ public:
         btnCopy.setBounds(btnRow.removeFromLeft(120));
         btnRow.removeFromLeft(12);
         autoScrollToggle.setBounds(btnRow.removeFromLeft(100));
+        btnRow.removeFromLeft(12);
+        btnExportTelemetry.setBounds(btnRow.removeFromLeft(120));
+        btnRow.removeFromLeft(4);
+        btnResetTelemetry.setBounds(btnRow.removeFromLeft(60));
+        btnRow.removeFromLeft(4);
+        btnFftBenchmark.setBounds(btnRow.removeFromLeft(110));
 
         area.removeFromTop(6);
 
@@ -215,7 +209,7 @@ public:
         area.removeFromTop(6);
 
         // Status area
-        statusLabel.setBounds(area.removeFromTop(100));
+        statusLabel.setBounds(area.removeFromTop(150));
 
         area.removeFromTop(4);
 
@@ -236,7 +230,22 @@ public:
         for (auto& m : manifests)
             s << "    - " << m.name << "  [" << m.id << "]  src=" << m.sourceFile << juce::newLine;
 
-        s << "  Log entries:     " << DebugLogger::getInstance().size() << juce::newLine;
+        s << "  Log entries:     " << DebugLogger::getInstance().size()
+          << "  (dropped " << juce::String(static_cast<juce::int64>(AsyncLogger::getInstance().getDroppedCount()))
+          << ")" << juce::newLine;
+
+        auto tel = AudioTelemetry::getInstance().getSnapshot();
+        s << "=== Audio Thread ===" << juce::newLine;
+        s << "  " << AudioTelemetry::formatSummary(tel) << juce::newLine;
+        s << " ";
+        for (int i = 0; i < AudioTelemetry::kNumStages; ++i)
+        {
+            const auto idx = static_cast<size_t>(i);
+            s << " " << AudioTelemetry::getStageName(static_cast<AudioTelemetry::Stage>(i))
+              << " " << juce::String(tel.stageAverage[idx] * 100.0f, 1)
+              << "/" << juce::String(tel.stageWorst[idx] * 100.0f, 1) << "%";
+        }
+        s << "   (avg/worst)" << juce::newLine;
 
         statusLabel.setText(s, juce::dontSendNotification);
     }
@@ -253,6 +262,7 @@ public:
             case 4: filterCat = "RENDER";   break;
             case 5: filterCat = "INSTANCE"; break;
             case 6: filterCat = "ERROR";    break;
+            case 7: filterCat = "AUDIO";    break;
             default: break; // show all
         }
 
@@ -314,6 +324,30 @@ private:
         refreshLog();
     }
 
+    void exportTelemetry()
+    {
+        auto csv = AudioTelemetry::toCsv(AudioTelemetry::getInstance().getSnapshot());
+        telemetryChooser_ = std::make_unique<juce::FileChooser>(
+            "Export Audio Telemetry",
+            juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                .getChildFile("maximeter_telemetry.csv"),
+            "*.csv");
+
+        telemetryChooser_->launchAsync(
+            juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles
+                | juce::FileBrowserComponent::warnAboutOverwriting,
+            [csv](const juce::FileChooser& fc)
+            {
+                auto file = fc.getResult();
+                if (file == juce::File{})
+                    return;
+                if (file.replaceWithText(csv))
+                    MAXIMETER_LOG("AUDIO", "Telemetry exported to " + file.getFullPathName());
+                else
+                    MAXIMETER_LOG("ERROR", "Could not write telemetry to " + file.getFullPathName());
+            });
+    }
+
     void applyThemeColours()
     {
         auto& pal = ThemeManager::getInstance().getPalette();
@@ -326,6 +360,8 @@ private:
     juce::Label statusLabel;
     juce::TextEditor logEditor;
     juce::TextButton btnClear, btnCopy, btnRestartBridge, btnRescan, btnTestConnection;
+    juce::TextButton btnExportTelemetry, btnResetTelemetry, btnFftBenchmark;
+    std::unique_ptr<juce::FileChooser> telemetryChooser_;
     juce::ToggleButton autoScrollToggle;
     juce::Label filterLabel;
     juce::ComboBox filterCombo;
@@ -898,6 +898,27 @@ private:
             "```\n"
             "audio.bpm            Detected tempo in BPM\n"
             "audio.beat_phase     Phase within current beat (0..1)\n"
+            "```\n\n"
+            "### Spectral & Pitch Features\n\n"
+            "Computed once per FFT frame for plugins that declare \"features\".\n\n"
+            "```\n"
+            "audio.spectral_centroid   Magnitude-weighted mean frequency (Hz)\n"
+            "audio.spectral_flux       Positive magnitude change since last frame\n"
+            "audio.spectral_rolloff    85% power rolloff frequency (Hz)\n"
+            "audio.spectral_flatness   0 = tonal .. 1 = noise-like\n"
+            "audio.chroma              12 pitch classes C..B (loudest = 1)\n"
+            "audio.mfcc                13 MFCCs (40 mel bands)\n"
+            "audio.pitch_hz            YIN pitch estimate (0 = unvoiced)\n"
+            "audio.pitch_confidence    0..1\n"
+            "```\n\n"
+            "### Metric History\n\n"
+            "The host's history store, for plugins that declare \"history\"\n"
+            "(shared-memory transport only).\n\n"
+            "```\n"
+            "audio.history          {metric: [(min, max, mean), ...]} oldest first\n"
+            "                       peak_left/right, rms_left/right, lufs_momentary,\n"
+            "                       lufs_short_term, correlation\n"
+            "audio.history_window   Seconds covered when full (30)\n"
             "```\n"
             "\n---\n\n"
 
@@ -958,7 +979,14 @@ private:
             "min_size       Minimum resize dimensions\n"
             "max_size       Maximum resize dimensions\n"
             "tags           Tuple of searchable keyword strings\n"
-            "```\n"
+            "analysis       Analyzers read, e.g. (\"spectrum\", \"loudness\")\n"
+            "               spectrum | levels | loudness | stereo | history |\n"
+            "               features\n"
+            "               (default None = all)\n"
+            "fft_size       Preferred FFT size 1024..8192 (0 = default)\n"
+            "```\n\n"
+            "Analyzers that no visible item declares are switched off, so\n"
+            "declaring only what you read makes cheap layouts cheaper.\n"
             "\n---\n\n"
 
             // ------ 11. Color & Gradient ------
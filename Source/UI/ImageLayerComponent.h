@@ -1,10 +1,12 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "../Utils/MediaRegistry.h"
 
 //==============================================================================
 /// Displays a static image (PNG, JPG, BMP, GIF frame) on the canvas.
 /// Supports loading from file, stretch-to-fill with optional aspect ratio.
+/// Files are decoded through MediaRegistry, so copies of a layer share pixels.
 class ImageLayerComponent : public juce::Component
 {
 public:
@@ -14,20 +16,40 @@ public:
     /// Load an image from file. Returns true on success.
     bool loadFromFile(const juce::File& file)
     {
-        auto img = juce::ImageFileFormat::loadFrom(file);
-        if (img.isValid())
+        if (auto asset = MediaRegistry::getInstance().getImage(file))
         {
-            image = img;
             filePath = file.getFullPathName();
-            repaint();
+            setAsset(std::move(asset));
             return true;
         }
         return false;
     }
 
+    /// Show @p preview straight away and decode @p file at full resolution
+    /// on a background thread (projects opened from a bundle).
+    void loadFromFileDeferred(const juce::File& file, const juce::Image& preview)
+    {
+        filePath = file.getFullPathName();
+        if (preview.isValid())
+            setImage(preview);
+
+        juce::Component::SafePointer<ImageLayerComponent> safeThis(this);
+        juce::Thread::launch([safeThis, file]
+        {
+            auto asset = MediaRegistry::getInstance().getImage(file);
+            juce::MessageManager::callAsync([safeThis, asset, path = file.getFullPathName()]
+            {
+                // Dropped if the layer is gone or another file was loaded meanwhile
+                if (safeThis != nullptr && asset != nullptr && safeThis->filePath == path)
+                    safeThis->setAsset(asset);
+            });
+        });
+    }
+
     /// Set image directly.
     void setImage(const juce::Image& img)
     {
+        asset_.reset();
         image = img;
         repaint();
     }
@@ -53,7 +75,15 @@ public:
     }
 
 private:
+    void setAsset(std::shared_ptr<const juce::Image> asset)
+    {
+        image  = *asset;
+        asset_ = std::move(asset);
+        repaint();
+    }
+
     juce::Image image;
+    std::shared_ptr<const juce::Image> asset_;   ///< keeps the shared decode alive
     juce::String filePath;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ImageLayerComponent)
@@ -24,6 +24,34 @@ int LevelHistogram::dbToBin(float db) const
 }
 
 void LevelHistogram::pushLevel(float leftLinear, float rightLinear)
+{
+    accumulate(leftLinear, rightLinear, 18000, 0.999);  // ~5 minutes at 60fps
+    repaint();
+}
+
+void LevelHistogram::update(const MetricHistory& history)
+{
+    const auto written = history.getNumWritten(0);
+    if (resyncCursor || historyCursor > written)       // local or store reset
+    {
+        historyCursor = written;
+        resyncCursor = false;
+        return;
+    }
+
+    historyCursor = std::max(historyCursor, history.getOldestReadable(0));
+    if (historyCursor == written)
+        return;
+
+    for (; historyCursor < written; ++historyCursor)
+        accumulate(history.getValue(MetricHistory::Metric::RmsLeft, historyCursor),
+                   history.getValue(MetricHistory::Metric::RmsRight, historyCursor),
+                   30000, 0.9994);                       // ~5 minutes at 100 Hz
+
+    repaint();
+}
+
+void LevelHistogram::accumulate(float leftLinear, float rightLinear, int decayAfter, double decay)
 {
     float dbL = (leftLinear > 0.0f) ? 20.0f * std::log10(leftLinear) : -100.0f;
     float dbR = (rightLinear > 0.0f) ? 20.0f * std::log10(rightLinear) : -100.0f;
@@ -36,15 +64,13 @@ void LevelHistogram::pushLevel(float leftLinear, float rightLinear)
 
     totalSamples += 1.0;
 
-    if (!cumulative && totalSamples > 18000)  // ~5 minutes at 60fps
+    if (!cumulative && totalSamples > decayAfter)
     {
         // Decay old data
-        for (auto& b : binsL) b *= 0.999;
-        for (auto& b : binsR) b *= 0.999;
-        totalSamples *= 0.999;
+        for (auto& b : binsL) b *= decay;
+        for (auto& b : binsR) b *= decay;
+        totalSamples *= decay;
     }
-
-    repaint();
 }
 
 void LevelHistogram::reset()
@@ -52,6 +78,7 @@ void LevelHistogram::reset()
     for (auto& b : binsL) b = 0.0;
     for (auto& b : binsR) b = 0.0;
     totalSamples = 0;
+    resyncCursor = true;
 }
 
 //==============================================================================
@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "MeterBase.h"
+#include "../Audio/MetricHistory.h"
 #include <vector>
 
 //==============================================================================
@@ -18,6 +19,11 @@ public:
     /// Push a new level sample (linear, 0..1+). Call at regular intervals (e.g., 60fps).
     void pushLevel(float leftLinear, float rightLinear);
 
+    /// Consume every RMS value recorded in @p history since the last call.
+    /// Accumulation then runs at the store's fixed 100 Hz rate regardless of
+    /// how often the GUI timer fires.
+    void update(const MetricHistory& history);
+
     /// Configuration
     void setBinResolution(float dbPerBin)  { binRes = juce::jlimit(0.1f, 3.0f, dbPerBin); rebuildBins(); }
     void setDisplayRange(float minDb, float maxDb) { minRange = minDb; maxRange = maxDb; rebuildBins(); }
@@ -50,7 +56,11 @@ private:
     std::vector<double> binsR;
     double totalSamples = 0;
 
+    uint64_t historyCursor = 0;          // next level-0 index to consume
+    bool     resyncCursor  = true;       // skip existing history after reset
+
     void rebuildBins();
+    void accumulate(float leftLinear, float rightLinear, int decayAfter, double decay);
     int dbToBin(float db) const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelHistogram)
@@ -1,5 +1,6 @@
 #include "LoudnessMeter.h"
 #include <cmath>
+#include <limits>
 
 //==============================================================================
 LoudnessMeter::LoudnessMeter()
@@ -39,11 +40,6 @@ void LoudnessMeter::paint(juce::Graphics& g)
     auto bounds = getLocalBounds();
     g.fillAll(getBgColour(juce::Colour(0xFF0D0D1A)));
 
-    // Push short-term value into scrolling history every paint (~60 fps)
-    shortTermHistory.push_back(shortTerm);
-    while (static_cast<int>(shortTermHistory.size()) > kHistoryMaxLen)
-        shortTermHistory.pop_front();
-
     // Layout
     auto infoArea = bounds.removeFromBottom(70);
     auto histArea = showHistory ? bounds.removeFromBottom(80) : juce::Rectangle<int>();
@@ -172,29 +168,29 @@ void LoudnessMeter::drawHistoryGraph(juce::Graphics& g, juce::Rectangle<int> are
                           static_cast<float>(area.getX()),
                           static_cast<float>(area.getRight()));
 
-    // Data line — always fill full width with collected points
-    int n = static_cast<int>(shortTermHistory.size());
+    // Data line — one bucket per pixel column, newest at the right edge
+    const int width = juce::jmax(1, area.getWidth());
+    const int n = history != nullptr
+        ? history->query(MetricHistory::Metric::ShortTermLUFS, historySeconds, width, historyBuckets)
+        : 0;
     if (n > 1)
     {
-        juce::Path path;
-        bool started = false;
+        const float pxPerBucket = static_cast<float>(area.getWidth()) / static_cast<float>(width);
+        const float x0 = static_cast<float>(area.getRight()) - n * pxPerBucket;
 
+        // Silent buckets break the line (NaN y)
+        historyPoints.resize(static_cast<size_t>(n));
         for (int i = 0; i < n; ++i)
         {
-            float val = shortTermHistory[static_cast<size_t>(i)];
-            if (val < -90.0f) continue;
-
-            float px = area.getX() + area.getWidth() * (static_cast<float>(i) / static_cast<float>(n - 1));
-            float py = dbToY(val);
-
-            if (!started) { path.startNewSubPath(px, py); started = true; }
-            else path.lineTo(px, py);
+            float val = historyBuckets[static_cast<size_t>(i)].mean;
+            float px = x0 + (static_cast<float>(i) + 0.5f) * pxPerBucket;
+            float py = val < -90.0f ? std::numeric_limits<float>::quiet_NaN() : dbToY(val);
+            historyPoints[static_cast<size_t>(i)] = { px, py };
         }
 
         g.saveState();
         g.reduceClipRegion(area);
-        g.setColour(tintFg(juce::Colour(0xFF44BBFF)).withAlpha(0.8f));
-        g.strokePath(path, juce::PathStrokeType(1.5f));
+        historyRaster.draw(g, historyPoints, 1.5f, tintFg(juce::Colour(0xFF44BBFF)).withAlpha(0.8f));
         g.restoreState();
     }
 
@@ -203,7 +199,7 @@ void LoudnessMeter::drawHistoryGraph(juce::Graphics& g, juce::Rectangle<int> are
     g.drawRoundedRectangle(area.toFloat(), 4.0f, 1.0f);
 
     // Current value label
-    float current = shortTermHistory.empty() ? -100.0f : shortTermHistory.back();
+    float current = shortTerm;
     juce::String label = (current > -90.0f)
         ? juce::String(current, 1) + " LUFS" : "--- LUFS";
     g.setFont(meterFont(10.0f));
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include <deque>
+#include <vector>
 #include "MeterBase.h"
+#include "../Audio/MetricHistory.h"
+#include "PolylineRasteriser.h"
 
 //==============================================================================
 /// LoudnessMeter — EBU R128 / ITU-R BS.1770-4 loudness display.
@@ -27,6 +29,11 @@ public:
     /// Configuration
     void setDisplayRange(float minLUFS, float maxLUFS) { minRange = minLUFS; maxRange = maxLUFS; }
     void setShowHistory(bool show)      { showHistory = show; }
+    void setHistorySeconds(double s)    { historySeconds = juce::jmax(1.0, s); }
+
+    /// Short-term history is read from the shared fixed-rate store, so the
+    /// graph's time axis no longer depends on the paint rate.
+    void setHistorySource(const MetricHistory* h) { history = h; }
 
     // Getters for export/serialization
     float getTargetLUFS()  const { return targetLUFS; }
@@ -48,10 +55,12 @@ private:
     float maxRange = 0.0f;
     bool  showHistory = true;
 
-    // Scrolling short-term history (deque, one sample per frame)
-    static constexpr int kHistoryMaxLen = 1800;  // 30 s * 60 fps
-    std::deque<float> shortTermHistory;
-    int historyFrameDiv = 0;              // push every N-th paint
+    // Scrolling short-term history (read from MetricHistory at paint time)
+    const MetricHistory* history = nullptr;
+    double historySeconds = 30.0;
+    std::vector<MetricHistory::Point> historyBuckets;   // reused across paints
+    std::vector<juce::Point<float>>   historyPoints;
+    PolylineRasteriser                historyRaster;
 
     float lufsToNormalized(float lufs) const;
     juce::Colour lufsToColour(float lufs) const;
@@ -79,6 +79,8 @@ juce::PopupMenu MainWindow::getMenuForIndex(int menuIndex, const juce::String& /
         menu.addItem(cmdSaveProjectAs, "Save Project As...\tCtrl+Shift+S");
         menu.addSeparator();
         menu.addItem(cmdOpenAudioFile, "Open Audio File...");
+        menu.addItem(cmdAddStems,      "Add Stems...");
+        menu.addItem(cmdClearStems,    "Remove All Stems");
         menu.addItem(cmdOpenSkinFile,  "Open Skin File (.wsz)...");
         menu.addSeparator();
         menu.addItem(cmdSettings,      "Settings...");
@@ -174,6 +176,29 @@ void MainWindow::menuItemSelected(int menuItemID, int /*topLevelMenuIndex*/)
             break;
         }
 
+        case cmdAddStems:
+        {
+            auto chooser = std::make_shared<juce::FileChooser>(
+                "Add Stems", juce::File{},
+                "*.wav;*.mp3;*.flac;*.ogg;*.aiff;*.aif;*.wma;*.m4a;*.aac");
+
+            chooser->launchAsync(
+                juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles
+                    | juce::FileBrowserComponent::canSelectMultipleItems,
+                [this, chooser](const juce::FileChooser& fc)
+                {
+                    auto files = fc.getResults();
+                    if (!files.isEmpty())
+                        if (auto* m = getMainComponent())
+                            m->addStems(files);
+                });
+            break;
+        }
+
+        case cmdClearStems:
+            mc->clearStems();
+            break;
+
         case cmdOpenSkinFile:
         {
             auto chooser = std::make_shared<juce::FileChooser>(
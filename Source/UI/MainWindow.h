@@ -42,6 +42,8 @@ private:
         cmdSaveProject,
         cmdSaveProjectAs,
         cmdOpenAudioFile,
+        cmdAddStems,
+        cmdClearStems,
         cmdOpenSkinFile,
         cmdSettings,         // New Settings command
         cmdExportVideo,
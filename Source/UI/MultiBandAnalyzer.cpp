@@ -76,7 +76,6 @@ void MultiBandAnalyzer::setSpectrumData(const float* data, int numBins, double s
     computeBandBoundaries(numBins, sampleRate);
 
     float binWidth = static_cast<float>(sampleRate) / (numBins * 2.0f);
-    float dt = 1.0f / 60.0f;
 
     for (int b = 0; b < numBands; ++b)
     {
@@ -99,35 +98,83 @@ void MultiBandAnalyzer::setSpectrumData(const float* data, int numBins, double s
         // data[] is linear magnitude — convert to dB for display
         float mag = (count > 0) ? sum / count : 0.0f;
         float level = (mag > 1.0e-10f) ? 20.0f * std::log10(mag) : minRange;
-        bandLevels[static_cast<size_t>(b)] = level;
-
-        // Smooth
-        float target = level;
-        float& sm = smoothed[static_cast<size_t>(b)];
-        if (target > sm)
-            sm = target;  // instant attack
-        else
-            sm = std::max(target, sm - decayRate * dt);
-
-        // Peak hold
-        float& pk = peaks[static_cast<size_t>(b)];
-        float& pt = peakTimers[static_cast<size_t>(b)];
-        if (sm >= pk)
-        {
-            pk = sm;
-            pt = 2.0f;  // 2 second hold
-        }
-        else
+        updateBand(b, level, level);
+    }
+
+    shownBands = numBands;
+    repaint();
+}
+
+void MultiBandAnalyzer::setBandData(const OctaveBandAnalyzer::Band* bands, int count,
+                                    int bankBandsPerOctave, double sampleRate)
+{
+    // Display bands at this meter's resolution (never finer than the bank's)
+    std::array<OctaveBandAnalyzer::Band, OctaveBandAnalyzer::kMaxBands> shown;
+    const int fraction = std::min(getBandsPerOctave(), bankBandsPerOctave);
+    const int n = std::min(kMaxBands, OctaveBandAnalyzer::computeBands(fraction, sampleRate, shown));
+    if (n <= 0)
+        return;
+
+    // Sum the power of every bank band whose centre lies in a display band
+    std::array<float, kMaxBands> power {}, peak {};
+    for (int i = 0, d = 0; i < count && d < n; ++i)
+    {
+        while (d < n && bands[i].centre >= shown[static_cast<size_t>(d)].upper)
+            ++d;
+        if (d < n && bands[i].centre >= shown[static_cast<size_t>(d)].lower)
         {
-            pt -= dt;
-            if (pt <= 0.0f)
-                pk = std::max(minRange, pk - decayRate * 0.5f * dt);
+            power[static_cast<size_t>(d)] += bands[i].rms * bands[i].rms;
+            peak[static_cast<size_t>(d)]   = std::max(peak[static_cast<size_t>(d)], bands[i].peak);
         }
     }
 
+    bandInfos.resize(static_cast<size_t>(n));
+    for (int b = 0; b < n; ++b)
+    {
+        const auto& band = shown[static_cast<size_t>(b)];
+        bandInfos[static_cast<size_t>(b)] = { band.centre, band.lower, band.upper };
+
+        const float p  = power[static_cast<size_t>(b)];
+        const float pk = peak[static_cast<size_t>(b)];
+        // dB re a full-scale sine (AES17), so a 0 dBFS tone reads 0 dB
+        const float level = (p > 1.0e-20f) ? 10.0f * std::log10(2.0f * p) : minRange;
+        updateBand(b, level, (pk > 1.0e-10f) ? 20.0f * std::log10(pk) : minRange);
+    }
+
+    shownBands = n;
     repaint();
 }
 
+void MultiBandAnalyzer::updateBand(int b, float levelDb, float peakDb)
+{
+    const float dt = 1.0f / 60.0f;
+    bandLevels[static_cast<size_t>(b)] = levelDb;
+
+    // Smooth
+    float target = levelDb;
+    float& sm = smoothed[static_cast<size_t>(b)];
+    if (target > sm)
+        sm = target;  // instant attack
+    else
+        sm = std::max(target, sm - decayRate * dt);
+
+    // Peak hold
+    float& pk = peaks[static_cast<size_t>(b)];
+    float& pt = peakTimers[static_cast<size_t>(b)];
+    const float held = std::max(sm, peakDb);
+    if (held >= pk)
+    {
+        pk = held;
+        pt = 2.0f;  // 2 second hold
+    }
+    else
+    {
+        pt -= dt;
+        if (pt <= 0.0f)
+            pk = std::max(minRange, pk - decayRate * 0.5f * dt);
+    }
+}
+
 //==============================================================================
 juce::Colour MultiBandAnalyzer::getBarColour(float normalized, int /*band*/) const
 {
@@ -169,9 +216,9 @@ void MultiBandAnalyzer::paint(juce::Graphics& g)
         drawGrid(g, area);
 
     // Draw bars
-    float barW = static_cast<float>(area.getWidth()) / numBands;
+    float barW = static_cast<float>(area.getWidth()) / shownBands;
 
-    for (int b = 0; b < numBands; ++b)
+    for (int b = 0; b < shownBands; ++b)
     {
         float x = area.getX() + b * barW;
         float norm = dbToNormalized(smoothed[static_cast<size_t>(b)]);
@@ -238,8 +285,8 @@ void MultiBandAnalyzer::paint(juce::Graphics& g)
         g.setColour(juce::Colours::grey.withAlpha(0.6f));
 
         // Show labels for a subset of bands
-        int step = std::max(1, numBands / 10);
-        for (int b = 0; b < numBands; b += step)
+        int step = std::max(1, shownBands / 10);
+        for (int b = 0; b < shownBands; b += step)
         {
             float x = static_cast<float>(area.getX()) + b * barW + barW * 0.5f;
             float freq = bandInfos[static_cast<size_t>(b)].centerFreq;
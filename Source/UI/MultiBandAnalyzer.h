@@ -3,6 +3,7 @@
 #include <JuceHeader.h>
 #include "MeterBase.h"
 #include "../Skin/SkinModel.h"
+#include "../Audio/OctaveBandAnalyzer.h"
 #include <array>
 #include <vector>
 
@@ -10,12 +11,17 @@
 /// MultiBandAnalyzer — multi-band frequency analyzer with configurable band count
 /// and scale modes (Log/Linear/Octave).
 /// Supports 8/16/20/31/64 bands, peak hold, dB grid, frequency labels.
+///
+/// Bands come either from FFT bins (setSpectrumData) or from the IEC 61260
+/// filter bank (setBandData), which shows the standard 1/1, 1/3 or 1/6
+/// octave bands with per-sample time resolution.
 class MultiBandAnalyzer : public juce::Component,
                          public MeterBase
 {
 public:
     enum class ScaleMode { Logarithmic, Linear, Octave };
     enum class BarStyle  { Filled, LED, Outline };
+    enum class DataSource { FFT, FilterBank };
 
     MultiBandAnalyzer();
     ~MultiBandAnalyzer() override = default;
@@ -23,6 +29,11 @@ public:
     /// Set spectrum data (dB values, -60..0 range)
     void setSpectrumData(const float* data, int numBins, double sampleRate);
 
+    /// Set filter-bank levels.  @p bankBandsPerOctave may be finer than this
+    /// meter shows; band powers are then summed into the display bands.
+    void setBandData(const OctaveBandAnalyzer::Band* bands, int count,
+                     int bankBandsPerOctave, double sampleRate);
+
     /// Configuration
     void setNumBands(int bands)          { numBands = juce::jlimit(8, 64, bands); }
     int  getNumBands() const             { return numBands; }
@@ -34,12 +45,18 @@ public:
     void setDecayRate(float dbPerSec)    { decayRate = juce::jlimit(5.0f, 60.0f, dbPerSec); }
     void setDynamicRange(float minDb, float maxDb) { minRange = minDb; maxRange = maxDb; }
     void setSkin(const Skin::SkinModel* skin) { currentSkin = skin; repaint(); }
+    void setDataSource(DataSource source) { dataSource = source; }
 
     // Getters for export/serialization
     float     getDecayRate() const { return decayRate; }
     float     getMinDb()     const { return minRange; }
     float     getMaxDb()     const { return maxRange; }
     ScaleMode getScaleMode() const { return scaleMode; }
+    DataSource getDataSource() const { return dataSource; }
+
+    /// Filter-bank resolution for the band count: up to 12 bands shows
+    /// octaves, up to 31 third octaves, more sixth octaves.
+    int getBandsPerOctave() const { return numBands <= 12 ? 1 : (numBands <= 31 ? 3 : 6); }
 
     void paint(juce::Graphics& g) override;
 
@@ -47,7 +64,9 @@ private:
     const Skin::SkinModel* currentSkin = nullptr;
 
     int numBands = 31;
+    int shownBands = 31;    ///< bars drawn: numBands, or the filter bank's count
     ScaleMode scaleMode  = ScaleMode::Logarithmic;
+    DataSource dataSource = DataSource::FFT;
     BarStyle  barStyle   = BarStyle::Filled;
     bool peakHoldEnabled = true;
     bool showGrid        = true;
@@ -66,6 +85,7 @@ private:
     std::vector<BandInfo> bandInfos;
 
     void computeBandBoundaries(int numBins, double sampleRate);
+    void updateBand(int band, float levelDb, float peakDb);
     float dbToNormalized(float db) const;
     juce::Colour getBarColour(float normalized, int band) const;
     void drawGrid(juce::Graphics& g, juce::Rectangle<int> area);
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define MAXIMETER_RASTER_SSE2 1
+ #include <immintrin.h>
+#else
+ #define MAXIMETER_RASTER_SSE2 0
+#endif
+
+#if !MAXIMETER_RASTER_SSE2 && (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64))
+ #define MAXIMETER_RASTER_NEON 1
+ #include <arm_neon.h>
+#else
+ #define MAXIMETER_RASTER_NEON 0
+#endif
+
+//==============================================================================
+/// PixelBlend — coverage-weighted source-over into ARGB pixels (0xAARRGGBB in
+/// native order, BGRA in memory), shared by the software rasterisers.
+namespace PixelBlend
+{
+    /// Premultiplied source colour, channels in 0..255.
+    struct Source
+    {
+        float a, r, g, b;
+        float alphaNorm;    ///< a / 255
+
+        static Source fromColour(juce::Colour colour)
+        {
+            const auto argb = colour.getPixelARGB();    // premultiplied
+            return { static_cast<float>(argb.getAlpha()), static_cast<float>(argb.getRed()),
+                     static_cast<float>(argb.getGreen()), static_cast<float>(argb.getBlue()),
+                     argb.getAlpha() / 255.0f };
+        }
+    };
+
+    /// Source-over one pixel at coverage @p cov.
+    inline void blendPixel(uint32_t& px, const Source& s, float cov)
+    {
+        const float inv = 1.0f - s.alphaNorm * cov;
+        auto channel = [&](int shift, float src)
+        {
+            const float d = static_cast<float>((px >> shift) & 0xFFu);
+            return static_cast<uint32_t>(juce::jmin(255.0f, src * cov + d * inv) + 0.5f) << shift;
+        };
+        px = channel(24, s.a) | channel(16, s.r) | channel(8, s.g) | channel(0, s.b);
+    }
+
+   #if MAXIMETER_RASTER_SSE2
+    /// Four adjacent pixels, coverage per lane.  Skips the store when all
+    /// four coverages are zero.
+    inline void blend4(uint32_t* px, const Source& s, __m128 cov)
+    {
+        if (_mm_movemask_ps(_mm_cmpgt_ps(cov, _mm_setzero_ps())) == 0)
+            return;
+
+        const __m128i d    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(px));
+        const __m128i mask = _mm_set1_epi32(0xFF);
+        const __m128  inv  = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(s.alphaNorm), cov));
+        const __m128  lim  = _mm_set1_ps(255.0f);
+
+        auto channel = [&](int shift, float src)
+        {
+            const __m128 dst = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(d, shift), mask));
+            const __m128 out = _mm_min_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(src), cov), _mm_mul_ps(dst, inv)), lim);
+            return _mm_slli_epi32(_mm_cvtps_epi32(out), shift);
+        };
+        const __m128i result = _mm_or_si128(_mm_or_si128(channel(24, s.a), channel(16, s.r)),
+                                            _mm_or_si128(channel(8, s.g),   channel(0, s.b)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(px), result);
+    }
+   #elif MAXIMETER_RASTER_NEON
+    inline void blend4(uint32_t* px, const Source& s, float32x4_t cov)
+    {
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        const uint32x4_t  any  = vcgtq_f32(cov, zero);
+        if ((vgetq_lane_u32(any, 0) | vgetq_lane_u32(any, 1) | vgetq_lane_u32(any, 2) | vgetq_lane_u32(any, 3)) == 0)
+            return;
+
+        const uint32x4_t  d    = vld1q_u32(px);
+        const uint32x4_t  mask = vdupq_n_u32(0xFF);
+        const float32x4_t inv  = vsubq_f32(vdupq_n_f32(1.0f), vmulq_n_f32(cov, s.alphaNorm));
+        const float32x4_t lim  = vdupq_n_f32(255.0f);
+        const float32x4_t half = vdupq_n_f32(0.5f);
+
+        auto channel = [&](int shift, float src)
+        {
+            const uint32x4_t  bits = vandq_u32(vshlq_u32(d, vdupq_n_s32(-shift)), mask);
+            const float32x4_t out  = vminq_f32(vmlaq_f32(vmulq_n_f32(cov, src), vcvtq_f32_u32(bits), inv), lim);
+            return vshlq_u32(vcvtq_u32_f32(vaddq_f32(out, half)), vdupq_n_s32(shift));
+        };
+        vst1q_u32(px, vorrq_u32(vorrq_u32(channel(24, s.a), channel(16, s.r)),
+                                vorrq_u32(channel(8, s.g),   channel(0, s.b))));
+    }
+   #endif
+}
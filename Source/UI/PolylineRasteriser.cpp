@@ -0,0 +1,274 @@
+#include "PolylineRasteriser.h"
+#include "PixelBlend.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    using PixelBlend::Source;
+    using PixelBlend::blendPixel;
+
+    inline float rowCoverage(float row, float top, float bottom)
+    {
+        return juce::jlimit(0.0f, 1.0f, juce::jmin(row + 1.0f, bottom) - juce::jmax(row, top));
+    }
+
+   #if MAXIMETER_RASTER_SSE2
+    /// Four adjacent pixels of one row.
+    inline void blend4(uint32_t* px, const Source& s, __m128 row,
+                       __m128 top, __m128 bottom, __m128 alpha)
+    {
+        const __m128 one = _mm_set1_ps(1.0f);
+        __m128 cov = _mm_sub_ps(_mm_min_ps(_mm_add_ps(row, one), bottom), _mm_max_ps(row, top));
+        cov = _mm_mul_ps(_mm_min_ps(_mm_max_ps(cov, _mm_setzero_ps()), one), alpha);
+        PixelBlend::blend4(px, s, cov);
+    }
+   #elif MAXIMETER_RASTER_NEON
+    inline void blend4(uint32_t* px, const Source& s, float32x4_t row,
+                       float32x4_t top, float32x4_t bottom, float32x4_t alpha)
+    {
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        float32x4_t cov = vsubq_f32(vminq_f32(vaddq_f32(row, one), bottom), vmaxq_f32(row, top));
+        cov = vmulq_f32(vminq_f32(vmaxq_f32(cov, vdupq_n_f32(0.0f)), one), alpha);
+        PixelBlend::blend4(px, s, cov);
+    }
+   #endif
+}
+
+//==============================================================================
+bool PolylineRasteriser::isMonotonicX(const juce::Point<float>* points, int numPoints)
+{
+    for (int i = 1; i < numPoints; ++i)
+        if (points[i].x < points[i - 1].x)
+            return false;
+    return true;
+}
+
+//==============================================================================
+void PolylineRasteriser::computeSpans(const juce::Point<float>* points, int numPoints,
+                                      int width, float thickness)
+{
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    const auto w = static_cast<size_t>(width);
+    rawTop.assign(w, inf);
+    rawBottom.assign(w, -inf);
+    columnCover.assign(w, 0.0f);
+
+    auto extend = [&](int c, float y0, float y1, float cover)
+    {
+        auto& t = rawTop[static_cast<size_t>(c)];
+        auto& b = rawBottom[static_cast<size_t>(c)];
+        t = juce::jmin(t, y0, y1);
+        b = juce::jmax(b, y0, y1);
+        columnCover[static_cast<size_t>(c)] += cover;
+    };
+
+    // Min/max of the line over each column it crosses
+    for (int i = 0; i + 1 < numPoints; ++i)
+    {
+        const auto a = points[i], b = points[i + 1];
+        if (std::isnan(a.y) || std::isnan(b.y))
+            continue;
+
+        if (b.x <= a.x)
+        {
+            const int c = static_cast<int>(std::floor(a.x));
+            if (c >= 0 && c < width)
+                extend(c, a.y, b.y, 0.0f);
+            continue;
+        }
+
+        const int c0 = juce::jmax(0, static_cast<int>(std::floor(a.x)));
+        const int c1 = juce::jmin(width - 1, static_cast<int>(std::ceil(b.x)) - 1);
+        const float slope = (b.y - a.y) / (b.x - a.x);
+
+        for (int c = c0; c <= c1; ++c)
+        {
+            const float xl = juce::jmax(a.x, static_cast<float>(c));
+            const float xr = juce::jmin(b.x, static_cast<float>(c + 1));
+            extend(c, a.y + (xl - a.x) * slope, a.y + (xr - a.x) * slope, xr - xl);
+        }
+    }
+
+    // Thick strokes also reach the neighbouring columns (steep runs)
+    const int reach = thickness > 1.0f ? juce::roundToInt((thickness - 1.0f) * 0.5f) : 0;
+    spanTop.assign(w, 0.0f);
+    spanBottom.assign(w, 0.0f);
+    columnAlpha.assign(w, 0.0f);
+
+    const float halfT = thickness * 0.5f;
+    for (int c = 0; c < width; ++c)
+    {
+        const auto ci = static_cast<size_t>(c);
+        float top = rawTop[ci], bottom = rawBottom[ci];
+        float cover = columnCover[ci];
+
+        for (int n = juce::jmax(0, c - reach); n <= juce::jmin(width - 1, c + reach); ++n)
+        {
+            top    = juce::jmin(top, rawTop[static_cast<size_t>(n)]);
+            bottom = juce::jmax(bottom, rawBottom[static_cast<size_t>(n)]);
+            cover  = juce::jmax(cover, columnCover[static_cast<size_t>(n)]);
+        }
+        if (top > bottom)
+            continue;
+
+        // Scale so the column holds a true stroke's ink: t·√(1 + rise²)
+        const float rise = rawTop[ci] <= rawBottom[ci] ? rawBottom[ci] - rawTop[ci] : 0.0f;
+        const float span = (bottom - top) + thickness;
+        const float ink  = thickness * std::sqrt(1.0f + rise * rise);
+
+        spanTop[ci]     = top - halfT;
+        spanBottom[ci]  = bottom + halfT;
+        columnAlpha[ci] = juce::jmin(1.0f, ink / span) * juce::jlimit(0.0f, 1.0f, cover > 0.0f ? cover : 1.0f);
+    }
+}
+
+//==============================================================================
+bool PolylineRasteriser::rasterise(juce::Image::BitmapData& dest, const juce::Point<float>* points,
+                                   int numPoints, float thickness, juce::Colour colour)
+{
+    if (numPoints < 2 || !isMonotonicX(points, numPoints))
+        return false;
+    if (dest.pixelFormat != juce::Image::ARGB || dest.width <= 0 || dest.height <= 0)
+        return true;
+
+    const int width = dest.width, height = dest.height;
+    thickness = juce::jmax(0.5f, thickness);
+    computeSpans(points, numPoints, width, thickness);
+
+    const auto src = Source::fromColour(colour);
+    if (src.a <= 0.0f)
+        return true;
+
+    auto rowPtr = [&](int row, int column)
+    {
+        return reinterpret_cast<uint32_t*>(dest.getLinePointer(row)) + column;
+    };
+
+    // Row range a group of columns needs
+    auto rowsOf = [&](int c0, int c1, int& first, int& last)
+    {
+        float top = std::numeric_limits<float>::infinity(), bottom = -top;
+        for (int c = c0; c < c1; ++c)
+        {
+            if (columnAlpha[static_cast<size_t>(c)] <= 0.0f)
+                continue;
+            top    = juce::jmin(top, spanTop[static_cast<size_t>(c)]);
+            bottom = juce::jmax(bottom, spanBottom[static_cast<size_t>(c)]);
+        }
+        first = juce::jmax(0, static_cast<int>(std::floor(top)));
+        last  = juce::jmin(height - 1, static_cast<int>(std::ceil(bottom)) - 1);
+        return top <= bottom;
+    };
+
+    int c = 0;
+   #if MAXIMETER_RASTER_SSE2 || MAXIMETER_RASTER_NEON
+    for (; c + 4 <= width; c += 4)
+    {
+        int first = 0, last = -1;
+        if (!rowsOf(c, c + 4, first, last))
+            continue;
+
+       #if MAXIMETER_RASTER_SSE2
+        const __m128 top    = _mm_loadu_ps(spanTop.data() + c);
+        const __m128 bottom = _mm_loadu_ps(spanBottom.data() + c);
+        const __m128 alpha  = _mm_loadu_ps(columnAlpha.data() + c);
+        for (int r = first; r <= last; ++r)
+            blend4(rowPtr(r, c), src, _mm_set1_ps(static_cast<float>(r)), top, bottom, alpha);
+       #else
+        const float32x4_t top    = vld1q_f32(spanTop.data() + c);
+        const float32x4_t bottom = vld1q_f32(spanBottom.data() + c);
+        const float32x4_t alpha  = vld1q_f32(columnAlpha.data() + c);
+        for (int r = first; r <= last; ++r)
+            blend4(rowPtr(r, c), src, vdupq_n_f32(static_cast<float>(r)), top, bottom, alpha);
+       #endif
+    }
+   #endif
+
+    // Scalar columns (tail, or the whole width without SIMD)
+    for (; c < width; ++c)
+    {
+        int first = 0, last = -1;
+        if (!rowsOf(c, c + 1, first, last))
+            continue;
+
+        const auto ci = static_cast<size_t>(c);
+        for (int r = first; r <= last; ++r)
+        {
+            const float cov = rowCoverage(static_cast<float>(r), spanTop[ci], spanBottom[ci]) * columnAlpha[ci];
+            if (cov > 0.0f)
+                blendPixel(*rowPtr(r, c), src, cov);
+        }
+    }
+    return true;
+}
+
+//==============================================================================
+void PolylineRasteriser::draw(juce::Graphics& g, const juce::Point<float>* points, int numPoints,
+                              float thickness, juce::Colour colour)
+{
+    if (points == nullptr || numPoints < 2 || colour.isTransparent())
+        return;
+
+    if (!isMonotonicX(points, numPoints))
+    {
+        juce::Path path;
+        bool started = false;
+        for (int i = 0; i < numPoints; ++i)
+        {
+            if (std::isnan(points[i].y)) { started = false; continue; }
+            if (!started) { path.startNewSubPath(points[i]); started = true; }
+            else path.lineTo(points[i]);
+        }
+        g.setColour(colour);
+        g.strokePath(path, juce::PathStrokeType(thickness));
+        return;
+    }
+
+    // Bounds of the stroke, limited to what the context can show
+    float minY = std::numeric_limits<float>::infinity(), maxY = -minY;
+    for (int i = 0; i < numPoints; ++i)
+    {
+        if (std::isnan(points[i].y)) continue;
+        minY = juce::jmin(minY, points[i].y);
+        maxY = juce::jmax(maxY, points[i].y);
+    }
+    if (minY > maxY)
+        return;
+
+    const float pad = thickness * 0.5f + 1.0f;
+    const auto area = juce::Rectangle<float>::leftTopRightBottom(points[0].x - pad, minY - pad,
+                                                                 points[numPoints - 1].x + pad, maxY + pad)
+                          .getSmallestIntegerContainer()
+                          .getIntersection(g.getClipBounds());
+    if (area.isEmpty())
+        return;
+
+    // Rasterise at device resolution so zoomed canvases and exports stay sharp
+    const float scale = juce::jmax(1.0f, g.getInternalContext().getPhysicalPixelScaleFactor());
+    const int w = juce::roundToInt(std::ceil(static_cast<float>(area.getWidth())  * scale));
+    const int h = juce::roundToInt(std::ceil(static_cast<float>(area.getHeight()) * scale));
+
+    if (scratch.isNull() || scratch.getWidth() < w || scratch.getHeight() < h)
+        scratch = juce::Image(juce::Image::ARGB,
+                              juce::jmax(w, scratch.isNull() ? 0 : scratch.getWidth()),
+                              juce::jmax(h, scratch.isNull() ? 0 : scratch.getHeight()),
+                              true, juce::SoftwareImageType());
+    else
+        scratch.clear({ 0, 0, w, h });
+
+    scaled.resize(static_cast<size_t>(numPoints));
+    const auto origin = area.getPosition().toFloat();
+    for (int i = 0; i < numPoints; ++i)
+        scaled[static_cast<size_t>(i)] = (points[i] - origin) * scale;
+
+    {
+        juce::Image::BitmapData bmp(scratch, 0, 0, w, h, juce::Image::BitmapData::readWrite);
+        rasterise(bmp, scaled.data(), numPoints, thickness * scale, colour);
+    }
+
+    g.drawImageTransformed(scratch.getClippedImage({ 0, 0, w, h }),
+                           juce::AffineTransform::scale(1.0f / scale).translated(origin));
+}
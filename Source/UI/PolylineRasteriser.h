@@ -0,0 +1,58 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+//==============================================================================
+/// PolylineRasteriser — anti-aliased strokes for dense traces whose x never
+/// decreases (oscilloscopes, history graphs, plugin polylines).
+///
+/// Instead of building a juce::Path and running it through the general edge
+/// table, the trace is reduced to one vertical span per pixel column (the
+/// min/max of the line over that column, widened by the thickness) and the
+/// spans are filled four columns at a time, SSE2 / NEON coverage and
+/// source-over blending straight into the ARGB pixels (BGRA in memory).
+/// Column coverage is scaled so each column carries the ink of a true stroke
+/// of that width, so diagonals are not bolder than flat runs.
+///
+/// Points with a NaN y break the trace.  Input whose x goes backwards is
+/// handed to juce::Graphics::strokePath instead.
+///
+/// Keeps its scratch buffers between calls; give each component (or render
+/// thread) its own instance.
+class PolylineRasteriser
+{
+public:
+    PolylineRasteriser() = default;
+
+    /// Stroke @p points (component coordinates) through @p g.  The trace is
+    /// rasterised at the context's physical pixel scale into a scratch image
+    /// and drawn with one blit.
+    void draw(juce::Graphics& g, const juce::Point<float>* points, int numPoints,
+              float thickness, juce::Colour colour);
+
+    void draw(juce::Graphics& g, const std::vector<juce::Point<float>>& points,
+              float thickness, juce::Colour colour)
+    {
+        draw(g, points.data(), static_cast<int>(points.size()), thickness, colour);
+    }
+
+    /// Blend the trace straight into @p dest (ARGB).  @p points are in
+    /// @p dest pixels.  Returns false (and draws nothing) when x decreases.
+    bool rasterise(juce::Image::BitmapData& dest, const juce::Point<float>* points, int numPoints,
+                   float thickness, juce::Colour colour);
+
+    /// True when no point's x is smaller than the one before it.
+    static bool isMonotonicX(const juce::Point<float>* points, int numPoints);
+
+private:
+    void computeSpans(const juce::Point<float>* points, int numPoints, int width, float thickness);
+
+    // Per-column spans (rows, fractional) and coverage
+    std::vector<float> rawTop, rawBottom, spanTop, spanBottom, columnAlpha, columnCover;
+
+    juce::Image                     scratch;
+    std::vector<juce::Point<float>> scaled;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PolylineRasteriser)
+};
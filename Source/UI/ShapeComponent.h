@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "StackBlur.h"
+#include "../Utils/MediaRegistry.h"
 
 //==============================================================================
 /// Identifies which geometric shape to draw.
@@ -62,14 +63,15 @@ public:
     {
         svgPathData_ = data;
         svgDrawable_.reset();
+        svgPrototype_.reset();
         svgParsedPath_ = juce::Path();
         if (data.isNotEmpty())
         {
-            // Try parsing as an SVG document first
-            if (auto xml = juce::XmlDocument::parse(data))
-            {
-                svgDrawable_ = juce::Drawable::createFromSVG(*xml);
-            }
+            // Try parsing as an SVG document first (parsed once per document,
+            // however many shapes show it)
+            svgPrototype_ = MediaRegistry::getInstance().getSvg(data);
+            if (svgPrototype_)
+                svgDrawable_ = svgPrototype_->createCopy();
             // If that didn't work, try just as path data
             if (!svgDrawable_)
             {
@@ -274,6 +276,7 @@ private:
     juce::Colour bgColour     { 0x00000000 };
     juce::String svgPathData_;                         ///< raw SVG/path data
     std::unique_ptr<juce::Drawable> svgDrawable_;      ///< parsed SVG drawable
+    std::shared_ptr<const juce::Drawable> svgPrototype_; ///< shared parse it was copied from
     juce::Path   svgParsedPath_;                       ///< fallback parsed path
 
     // Frosted glass
@@ -75,28 +75,16 @@ void SkinnedOscilloscope::drawLineWaveform(juce::Graphics& g, juce::Rectangle<fl
         color = currentSkin->visColors.colors[18];  // viscolor index 18 = oscilloscope line
     color = tintFg(color);
 
-    juce::Path path;
-    bool started = false;
-
+    tracePoints.resize(static_cast<size_t>(displaySamples));
     for (int i = 0; i < displaySamples; ++i)
     {
         float x = bounds.getX() + i * stepX;
         float y = midY - displayBuffer[static_cast<size_t>(i)] * ampH;
         y = juce::jlimit(bounds.getY(), bounds.getBottom(), y);
-
-        if (!started)
-        {
-            path.startNewSubPath(x, y);
-            started = true;
-        }
-        else
-        {
-            path.lineTo(x, y);
-        }
+        tracePoints[static_cast<size_t>(i)] = { x, y };
     }
 
-    g.setColour(color);
-    g.strokePath(path, juce::PathStrokeType(lineWidth));
+    traceRaster.draw(g, tracePoints, lineWidth, color);
 }
 
 void SkinnedOscilloscope::drawDotWaveform(juce::Graphics& g, juce::Rectangle<float> bounds)
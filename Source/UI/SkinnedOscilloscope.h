@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "MeterBase.h"
+#include "PolylineRasteriser.h"
 #include "../Skin/SkinModel.h"
 
 //==============================================================================
@@ -46,6 +47,9 @@ private:
     juce::Colour bgColour   { 0xFF000000 };
     int drawStyle = 0;
 
+    PolylineRasteriser               traceRaster;
+    std::vector<juce::Point<float>>  tracePoints;
+
     void drawLineWaveform(juce::Graphics& g, juce::Rectangle<float> bounds);
     void drawDotWaveform(juce::Graphics& g, juce::Rectangle<float> bounds);
     void drawFilledWaveform(juce::Graphics& g, juce::Rectangle<float> bounds);
@@ -0,0 +1,190 @@
+#include "SpriteSplatter.h"
+#include "PixelBlend.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+//==============================================================================
+const SpriteSplatter::Mask& SpriteSplatter::getMask(int radiusStep, int phaseX, int phaseY)
+{
+    if (static_cast<size_t>(radiusStep) >= masks.size())
+        masks.resize(static_cast<size_t>(radiusStep) + 1);
+
+    auto& slot = masks[static_cast<size_t>(radiusStep)][static_cast<size_t>(phaseY * kPhases + phaseX)];
+    if (slot != nullptr)
+        return *slot;
+
+    slot = std::make_unique<Mask>();
+    auto& m = *slot;
+
+    const float r  = static_cast<float>(radiusStep) / kStepsPerPixel;
+    const float fx = (static_cast<float>(phaseX) + 0.5f) / kPhases;   // centre within its pixel
+    const float fy = (static_cast<float>(phaseY) + 0.5f) / kPhases;
+
+    m.half   = static_cast<int>(std::ceil(r)) + 1;
+    m.side   = m.half * 2 + 1;
+    m.stride = (m.side + 3) & ~3;
+    m.coverage.assign(static_cast<size_t>(m.stride * m.side), 0.0f);
+
+    // Distance-to-edge coverage, then scaled so the mask carries the disc's
+    // area (sub-pixel dots would otherwise be far too heavy)
+    float sum = 0.0f;
+    for (int row = 0; row < m.side; ++row)
+    {
+        const float dy = static_cast<float>(row - m.half) + 0.5f - fy;
+        for (int col = 0; col < m.side; ++col)
+        {
+            const float dx  = static_cast<float>(col - m.half) + 0.5f - fx;
+            const float cov = juce::jlimit(0.0f, 1.0f, r + 0.5f - std::sqrt(dx * dx + dy * dy));
+            m.coverage[static_cast<size_t>(row * m.stride + col)] = cov;
+            sum += cov;
+        }
+    }
+
+    if (sum > 0.0f)
+    {
+        const float k = juce::MathConstants<float>::pi * r * r / sum;
+        for (auto& c : m.coverage)
+            c = juce::jmin(1.0f, c * k);
+    }
+    return m;
+}
+
+//==============================================================================
+void SpriteSplatter::splat(juce::Image::BitmapData& dest, const float* xy, const float* radii,
+                           const juce::uint32* colours, int count, float radius, juce::Colour colour,
+                           float scale, juce::Point<float> origin)
+{
+    if (xy == nullptr || count <= 0 || dest.pixelFormat != juce::Image::ARGB
+        || dest.width <= 0 || dest.height <= 0)
+        return;
+
+    const int maxStep = static_cast<int>(kMaxRadius) * kStepsPerPixel;
+    auto uniform = PixelBlend::Source::fromColour(colour);
+
+    for (int i = 0; i < count; ++i)
+    {
+        const float x = (xy[i * 2]     - origin.x) * scale;
+        const float y = (xy[i * 2 + 1] - origin.y) * scale;
+        const float r = (radii != nullptr ? radii[i] : radius) * scale;
+        if (std::isnan(x) || std::isnan(y) || !(r > 0.0f) || r > kMaxRadius)
+            continue;
+        if (x + r < -1.0f || y + r < -1.0f || x - r > dest.width + 1.0f || y - r > dest.height + 1.0f)
+            continue;
+
+        const auto src = colours != nullptr ? PixelBlend::Source::fromColour(juce::Colour(colours[i]))
+                                            : uniform;
+        if (src.a <= 0.0f)
+            continue;
+
+        const float fx = std::floor(x), fy = std::floor(y);
+        const int step = juce::jlimit(1, maxStep, juce::roundToInt(r * kStepsPerPixel));
+        const auto& m  = getMask(step,
+                                 juce::jlimit(0, kPhases - 1, static_cast<int>((x - fx) * kPhases)),
+                                 juce::jlimit(0, kPhases - 1, static_cast<int>((y - fy) * kPhases)));
+
+        // Mask rows / columns that land inside dest
+        const int left = static_cast<int>(fx) - m.half, top = static_cast<int>(fy) - m.half;
+        const int col0 = juce::jmax(0, -left), col1 = juce::jmin(m.side, dest.width  - left);
+        const int row0 = juce::jmax(0, -top),  row1 = juce::jmin(m.side, dest.height - top);
+        if (col0 >= col1 || row0 >= row1)
+            continue;
+
+        const int span = col1 - col0;
+        for (int row = row0; row < row1; ++row)
+        {
+            const float* cov = m.coverage.data() + row * m.stride + col0;
+            auto* px = reinterpret_cast<uint32_t*>(dest.getLinePointer(top + row)) + (left + col0);
+
+            int n = 0;
+           #if MAXIMETER_RASTER_SSE2
+            for (; n + 4 <= span; n += 4)
+                PixelBlend::blend4(px + n, src, _mm_loadu_ps(cov + n));
+           #elif MAXIMETER_RASTER_NEON
+            for (; n + 4 <= span; n += 4)
+                PixelBlend::blend4(px + n, src, vld1q_f32(cov + n));
+           #endif
+            for (; n < span; ++n)
+                if (cov[n] > 0.0f)
+                    PixelBlend::blendPixel(px[n], src, cov[n]);
+        }
+    }
+}
+
+//==============================================================================
+void SpriteSplatter::draw(juce::Graphics& g, const float* xy, const float* radii,
+                          const juce::uint32* colours, int count, float radius, juce::Colour colour)
+{
+    if (xy == nullptr || count <= 0)
+        return;
+
+    // Rasterise at device resolution so zoomed canvases and exports stay sharp
+    const float scale = juce::jmax(1.0f, g.getInternalContext().getPhysicalPixelScaleFactor());
+
+    // Bounds of the batch, limited to what the context can show.  Dots too
+    // big for a mask (same test as splat(), in device pixels) are left out.
+    float minX = std::numeric_limits<float>::infinity(), minY = minX;
+    float maxX = -minX, maxY = -minX;
+    bool hasLarge = false;
+    for (int i = 0; i < count; ++i)
+    {
+        const float x = xy[i * 2], y = xy[i * 2 + 1];
+        const float r = radii != nullptr ? radii[i] : radius;
+        if (std::isnan(x) || std::isnan(y) || !(r > 0.0f))
+            continue;
+        if (r * scale > kMaxRadius)
+        {
+            hasLarge = true;
+            continue;
+        }
+        minX = juce::jmin(minX, x - r);  maxX = juce::jmax(maxX, x + r);
+        minY = juce::jmin(minY, y - r);  maxY = juce::jmax(maxY, y + r);
+    }
+
+    if (minX <= maxX)
+        blitBatch(g, juce::Rectangle<float>::leftTopRightBottom(minX - 1.0f, minY - 1.0f,
+                                                                maxX + 1.0f, maxY + 1.0f),
+                  scale, xy, radii, colours, count, radius, colour);
+
+    if (!hasLarge)
+        return;
+
+    for (int i = 0; i < count; ++i)
+    {
+        const float x = xy[i * 2], y = xy[i * 2 + 1];
+        const float r = radii != nullptr ? radii[i] : radius;
+        if (std::isnan(x) || std::isnan(y) || !(r * scale > kMaxRadius))
+            continue;
+        g.setColour(colours != nullptr ? juce::Colour(colours[i]) : colour);
+        g.fillEllipse(x - r, y - r, r * 2.0f, r * 2.0f);
+    }
+}
+
+void SpriteSplatter::blitBatch(juce::Graphics& g, juce::Rectangle<float> bounds, float scale,
+                               const float* xy, const float* radii, const juce::uint32* colours,
+                               int count, float radius, juce::Colour colour)
+{
+    const auto area = bounds.getSmallestIntegerContainer().getIntersection(g.getClipBounds());
+    if (area.isEmpty())
+        return;
+
+    const int w = juce::roundToInt(std::ceil(static_cast<float>(area.getWidth())  * scale));
+    const int h = juce::roundToInt(std::ceil(static_cast<float>(area.getHeight()) * scale));
+
+    if (scratch.isNull() || scratch.getWidth() < w || scratch.getHeight() < h)
+        scratch = juce::Image(juce::Image::ARGB,
+                              juce::jmax(w, scratch.isNull() ? 0 : scratch.getWidth()),
+                              juce::jmax(h, scratch.isNull() ? 0 : scratch.getHeight()),
+                              true, juce::SoftwareImageType());
+    else
+        scratch.clear({ 0, 0, w, h });
+
+    const auto origin = area.getPosition().toFloat();
+    {
+        juce::Image::BitmapData bmp(scratch, 0, 0, w, h, juce::Image::BitmapData::readWrite);
+        splat(bmp, xy, radii, colours, count, radius, colour, scale, origin);
+    }
+
+    g.drawImageTransformed(scratch.getClippedImage({ 0, 0, w, h }),
+                           juce::AffineTransform::scale(1.0f / scale).translated(origin));
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/// SpriteSplatter — draws large batches of filled anti-aliased dots
+/// (particles, scatter plots) without building a path per dot.
+///
+/// Disc coverage masks are rasterised once per quantised radius (¼ px steps)
+/// and sub-pixel phase (¼ px on each axis) and cached.  Each dot then costs a
+/// mask lookup and a SIMD source-over of its rows into an ARGB scratch image;
+/// the whole batch reaches the juce::Graphics target as one blit.
+///
+/// Masks go up to kMaxRadius device pixels; larger dots are skipped by
+/// splat() and drawn with Graphics::fillEllipse by draw(), after the batch.
+/// Keeps its masks and scratch image between calls; give each component (or
+/// render thread) its own instance.
+class SpriteSplatter
+{
+public:
+    static constexpr float kMaxRadius = 64.0f;
+
+    SpriteSplatter() = default;
+
+    /// Draw @p count dots through @p g.  @p xy holds interleaved x, y pairs in
+    /// component coordinates; @p radii and @p colours (0xAARRGGBB) are
+    /// per-dot and may be null, in which case @p radius / @p colour apply to
+    /// every dot.  Dots with a NaN coordinate are skipped.
+    void draw(juce::Graphics& g, const float* xy, const float* radii, const juce::uint32* colours,
+              int count, float radius, juce::Colour colour);
+
+    /// Blend the dots straight into @p dest (ARGB).  Positions and radii are
+    /// mapped to @p dest pixels as (p − @p origin) × @p scale.
+    void splat(juce::Image::BitmapData& dest, const float* xy, const float* radii,
+               const juce::uint32* colours, int count, float radius, juce::Colour colour,
+               float scale = 1.0f, juce::Point<float> origin = {});
+
+private:
+    static constexpr int kStepsPerPixel = 4;
+    static constexpr int kPhases        = 4;
+
+    /// Coverage of one disc, rows padded to a multiple of four.
+    struct Mask
+    {
+        int half = 0;                   ///< mask spans [-half, half] pixels around the centre pixel
+        int side = 0, stride = 0;
+        std::vector<float> coverage;
+    };
+
+    const Mask& getMask(int radiusStep, int phaseX, int phaseY);
+
+    /// splat() the dots into the scratch image over @p bounds (component
+    /// coordinates) and draw it through @p g.
+    void blitBatch(juce::Graphics& g, juce::Rectangle<float> bounds, float scale,
+                   const float* xy, const float* radii, const juce::uint32* colours,
+                   int count, float radius, juce::Colour colour);
+
+    std::vector<std::array<std::unique_ptr<Mask>, kPhases * kPhases>> masks;
+    juce::Image scratch;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpriteSplatter)
+};
@@ -1,5 +1,6 @@
 #include "StatusBar.h"
 #include "ThemeManager.h"
+#include "DebugLogWindow.h"
 
 //==============================================================================
 StatusBar::StatusBar(AudioEngine& eng, LevelAnalyzer& lvl)
@@ -54,6 +55,20 @@ void StatusBar::paint(juce::Graphics& g)
         g.setColour(juce::Colours::limegreen);
 
     g.drawText(levelStr, area.removeFromRight(250), juce::Justification::centredRight);
+
+    // Middle: audio-thread load (fills the remaining space)
+    if (telemetry.callbacks > 0)
+    {
+        if (telemetry.overruns > 0 || telemetry.smoothedLoad > 0.8f)
+            g.setColour(juce::Colours::red);
+        else if (telemetry.smoothedLoad > 0.5f)
+            g.setColour(juce::Colours::yellow);
+        else
+            g.setColour(pal.dimText);
+
+        g.drawText(AudioTelemetry::formatSummary(telemetry), area,
+                   juce::Justification::centredRight, true);
+    }
 }
 
 void StatusBar::resized()
@@ -64,9 +79,46 @@ void StatusBar::resized()
 //==============================================================================
 void StatusBar::timerCallback()
 {
+    pollTelemetry();
     repaint();
 }
 
+void StatusBar::pollTelemetry()
+{
+    auto& tel = AudioTelemetry::getInstance();
+    tel.setDeviceXRunCount(engine.getXRunCount());
+    telemetry = tel.getSnapshot();
+
+    // A reset (device restart) lowers the counters — resync silently
+    if (telemetry.overruns < loggedOverruns) loggedOverruns = telemetry.overruns;
+    if (telemetry.deviceXRuns < loggedXRuns) loggedXRuns = juce::jmax(0, telemetry.deviceXRuns);
+
+    if (telemetry.overruns > loggedOverruns)
+    {
+        juce::String msg;
+        msg << "Callback overran its " << juce::String(telemetry.bufferMs, 1) << " ms period ("
+            << juce::roundToInt(telemetry.lastLoad * 100.0f) << "%), slowest stage: "
+            << AudioTelemetry::getStageName(static_cast<AudioTelemetry::Stage>(telemetry.lastBlamed))
+            << "  [total " << static_cast<int>(telemetry.overruns) << "]";
+        MAXIMETER_LOG("AUDIO", msg);
+        loggedOverruns = telemetry.overruns;
+    }
+
+    if (telemetry.deviceXRuns > loggedXRuns)
+    {
+        MAXIMETER_LOG("AUDIO", "Device reported " + juce::String(telemetry.deviceXRuns - loggedXRuns)
+                                   + " xrun(s)  [total " + juce::String(telemetry.deviceXRuns) + "]");
+        loggedXRuns = telemetry.deviceXRuns;
+    }
+
+    // Periodic summary while playing (every ~30 s at 15 Hz)
+    if (engine.isPlaying() && ++ticksSinceLog >= 450)
+    {
+        MAXIMETER_LOG("AUDIO", AudioTelemetry::formatSummary(telemetry));
+        ticksSinceLog = 0;
+    }
+}
+
 void StatusBar::fileLoaded(const juce::String& fileName, double lengthSeconds)
 {
     int mins = static_cast<int>(lengthSeconds) / 60;
@@ -3,10 +3,11 @@
 #include <JuceHeader.h>
 #include "../Audio/AudioEngine.h"
 #include "../Audio/LevelAnalyzer.h"
+#include "../Audio/AudioTelemetry.h"
 
 //==============================================================================
 /// StatusBar — bottom bar showing file info, current levels, sample rate,
-/// and playback state.
+/// playback state and audio-thread load.
 class StatusBar : public juce::Component,
                   public juce::Timer,
                   public AudioEngine::Listener
@@ -30,5 +31,13 @@ private:
     juce::String fileInfo;
     juce::String playbackState { "Stopped" };
 
+    // Audio-thread telemetry (polled on the timer)
+    AudioTelemetry::Snapshot telemetry;
+    uint32_t loggedOverruns = 0;
+    int      loggedXRuns    = 0;
+    int      ticksSinceLog  = 0;
+
+    void pollTelemetry();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StatusBar)
 };
@@ -2,12 +2,12 @@
 
 #include <JuceHeader.h>
 #include "../Export/FFmpegProcess.h"
+#include "../Utils/AsyncLogger.h"
+#include "../Utils/MediaRegistry.h"
 #include <thread>
 #include <atomic>
 #include <memory>
 #include <vector>
-#include <fstream>
-#include <mutex>
 
 #ifdef _WIN32
  #ifndef NOMINMAX
@@ -17,26 +17,21 @@
 #endif
 
 //==============================================================================
-// Crash-trace logger — writes to MaxiMeter_crash.log next to the exe
+// Crash-trace logger — routed through AsyncLogger ("VIDEO", verbose).  The
+// trace is compiled out unless MAXIMETER_LOG_LEVEL=2, and only reaches
+// MaxiMeter_debug.log when the app runs with --log-file.
 //==============================================================================
 namespace VLC_Log {
-    inline std::mutex& mut() { static std::mutex m; return m; }
     inline void log(const char* msg)
     {
-        std::lock_guard<std::mutex> lk(mut());
-        auto p = juce::File::getSpecialLocation(
-                     juce::File::currentApplicationFile)
-                     .getParentDirectory()
-                     .getChildFile("MaxiMeter_crash.log");
-        std::ofstream f(p.getFullPathName().toStdString(), std::ios::app);
-        f << juce::Time::getCurrentTime().toString(true, true, true, true).toStdString()
-          << "  " << msg << "\n";
-        f.flush();
+        MAXIMETER_LOG("VIDEO", msg);
     }
 }
 
 //==============================================================================
 /// Displays an animated GIF or video on the canvas.
+/// Frames are extracted through MediaRegistry, so every layer (and export
+/// copy) showing the same file shares one set of decoded frames.
 class VideoLayerComponent : public juce::Component,
                             public juce::Timer
 {
@@ -100,11 +95,11 @@ public:
 
         // Static image
         VLC_Log::log("loadFromFile: static image, loading inline");
-        auto img = juce::ImageFileFormat::loadFrom(file);
         isLoading_ = false;
-        if (img.isValid())
+        if (auto img = MediaRegistry::getInstance().getImage(file))
         {
-            frames_.push_back(img);
+            frames_.push_back(*img);
+            media_ = std::move(img);
             repaint();
             return true;
         }
@@ -121,17 +116,18 @@ public:
 
         if (isAnimatedFormat(ext))
         {
-            auto ffPath = FFmpegProcess::locateFFmpeg();
-            if (ffPath.existsAsFile())
-            {
-                std::atomic<bool> noCancel { false };
-                extractFrames(ffPath, file, frames_, averageFps_, &noCancel);
-                if (!frames_.empty()) return true;
-            }
+            std::atomic<bool> noCancel { false };
+            setFrames(MediaRegistry::getInstance().getVideoFrames(file,
+                          [this, &file, &noCancel] { return decodeFrames(file, &noCancel, false); }));
+            return hasContent();
         }
 
-        auto img = juce::ImageFileFormat::loadFrom(file);
-        if (img.isValid()) { frames_.push_back(img); return true; }
+        if (auto img = MediaRegistry::getInstance().getImage(file))
+        {
+            frames_.push_back(*img);
+            media_ = std::move(img);
+            return true;
+        }
         return false;
     }
 
@@ -198,7 +194,8 @@ public:
     }
 
 private:
-    std::vector<juce::Image> frames_;
+    std::vector<juce::Image> frames_;       ///< shares its pixels with media_
+    std::shared_ptr<const void> media_;     ///< keeps the shared decode alive
     int          currentFrame_ = 0;
     float        averageFps_   = 30.0f;
     juce::String filePath_;
@@ -224,11 +221,21 @@ private:
     {
         filePath_ = file.getFullPathName();
         frames_.clear();
+        media_.reset();
         currentFrame_ = 0;
         averageFps_   = 30.0f;
         isLoading_    = false;
     }
 
+    /// Show the frames of a shared decode (nothing if it failed).
+    void setFrames(std::shared_ptr<const MediaRegistry::VideoFrames> decoded)
+    {
+        frames_       = decoded != nullptr ? decoded->frames : std::vector<juce::Image>();
+        averageFps_   = decoded != nullptr ? decoded->fps : 30.0f;
+        currentFrame_ = 0;
+        media_        = std::move(decoded);
+    }
+
     void cancelAndJoin()
     {
         VLC_Log::log("cancelAndJoin: ENTER");
@@ -303,23 +310,59 @@ private:
     void backgroundLoadImpl(const juce::File& file, int generation,
                             std::shared_ptr<std::atomic<bool>>& alive)
     {
-        std::vector<juce::Image> loaded;
-        float fps = 30.0f;
+        // Another layer showing this file may already hold (or be extracting)
+        // its frames; then this only waits for them
+        auto decoded = MediaRegistry::getInstance().getVideoFrames(file,
+                           [this, &file] { return decodeFrames(file, &loadCancelled_, true); },
+                           &loadCancelled_);
+
+        if (loadCancelled_.load())
+        {
+            VLC_Log::log("backgroundLoadImpl: cancelled, returning");
+            return;
+        }
+
+        VLC_Log::log("backgroundLoadImpl: delivering to message thread");
+
+        auto* self = this;
+
+        juce::MessageManager::callAsync([self, alive, decoded, generation]()
+        {
+            if (!alive->load()) return;
+            if (self->loadGeneration_.load() != generation) return;
+
+            self->setFrames(decoded);
+            self->isLoading_ = false;
+
+            if (self->averageFps_ > 0)
+                self->startTimerHz(juce::jmax(1, static_cast<int>(self->averageFps_)));
+
+            self->repaint();
+        });
+    }
+
+    /// Extract the frames of @p file with FFmpeg, or a single frame via JUCE
+    /// if that fails.  Returns nullptr if cancelled or nothing decoded.
+    std::shared_ptr<const MediaRegistry::VideoFrames> decodeFrames(const juce::File& file,
+                                                                   std::atomic<bool>* canceller,
+                                                                   bool warnIfNoFFmpeg)
+    {
+        auto decoded = std::make_shared<MediaRegistry::VideoFrames>();
 
         auto ffPath = FFmpegProcess::locateFFmpeg();
-        VLC_Log::log(("backgroundLoadImpl: ffmpeg path = " + ffPath.getFullPathName()).toRawUTF8());
-        VLC_Log::log(("backgroundLoadImpl: ffmpeg exists = " + juce::String(ffPath.existsAsFile() ? "YES" : "NO")).toRawUTF8());
+        VLC_Log::log(("decodeFrames: ffmpeg path = " + ffPath.getFullPathName()).toRawUTF8());
+        VLC_Log::log(("decodeFrames: ffmpeg exists = " + juce::String(ffPath.existsAsFile() ? "YES" : "NO")).toRawUTF8());
 
-        if (ffPath.existsAsFile() && !loadCancelled_.load())
+        if (ffPath.existsAsFile() && !canceller->load())
         {
-            VLC_Log::log("backgroundLoadImpl: calling extractFrames");
-            extractFrames(ffPath, file, loaded, fps, &loadCancelled_);
-            VLC_Log::log(("backgroundLoadImpl: extractFrames returned, frames=" + juce::String((int)loaded.size())).toRawUTF8());
+            VLC_Log::log("decodeFrames: calling extractFrames");
+            extractFrames(ffPath, file, decoded->frames, decoded->fps, canceller);
+            VLC_Log::log(("decodeFrames: extractFrames returned, frames=" + juce::String((int)decoded->frames.size())).toRawUTF8());
         }
-        else if (!ffPath.existsAsFile())
+        else if (!ffPath.existsAsFile() && warnIfNoFFmpeg)
         {
             // FFmpeg is missing — notify the user on the message thread.
-            VLC_Log::log("backgroundLoadImpl: ffmpeg not found, showing error dialog");
+            VLC_Log::log("decodeFrames: ffmpeg not found, showing error dialog");
             juce::MessageManager::callAsync([]()
             {
                 juce::AlertWindow::showAsync(
@@ -334,40 +377,18 @@ private:
         }
 
         // Fallback: single frame via JUCE
-        if (loaded.empty() && !loadCancelled_.load())
+        if (decoded->frames.empty() && !canceller->load())
         {
-            VLC_Log::log("backgroundLoadImpl: fallback to JUCE ImageFileFormat");
+            VLC_Log::log("decodeFrames: fallback to JUCE ImageFileFormat");
             auto img = juce::ImageFileFormat::loadFrom(file);
-            if (img.isValid()) loaded.push_back(img);
-            VLC_Log::log(("backgroundLoadImpl: fallback result valid=" + juce::String(img.isValid() ? "YES" : "NO")).toRawUTF8());
-        }
-
-        if (loadCancelled_.load())
-        {
-            VLC_Log::log("backgroundLoadImpl: cancelled, returning");
-            return;
+            if (img.isValid()) decoded->frames.push_back(img);
+            VLC_Log::log(("decodeFrames: fallback result valid=" + juce::String(img.isValid() ? "YES" : "NO")).toRawUTF8());
         }
 
-        VLC_Log::log("backgroundLoadImpl: delivering to message thread");
-
-        auto* self  = this;
-        auto shared = std::make_shared<std::vector<juce::Image>>(std::move(loaded));
-
-        juce::MessageManager::callAsync([self, alive, shared, fps, generation]()
-        {
-            if (!alive->load()) return;
-            if (self->loadGeneration_.load() != generation) return;
-
-            self->frames_       = std::move(*shared);
-            self->currentFrame_ = 0;
-            self->averageFps_   = fps;
-            self->isLoading_    = false;
-
-            if (fps > 0)
-                self->startTimerHz(juce::jmax(1, static_cast<int>(fps)));
-
-            self->repaint();
-        });
+        // Partial or empty results are not worth sharing
+        if (canceller->load() || decoded->frames.empty())
+            return nullptr;
+        return decoded;
     }
 
     //==========================================================================
@@ -1,5 +1,6 @@
 #include "WaveformView.h"
 #include "ThemeManager.h"
+#include "../Audio/MappedAudioReader.h"
 
 //==============================================================================
 WaveformView::WaveformView(AudioEngine& eng) : engine(eng)
@@ -107,15 +108,23 @@ void WaveformView::seekToMousePosition(const juce::MouseEvent& e)
 //==============================================================================
 void WaveformView::loadThumbnail(const juce::File& file)
 {
-    auto* reader = formatManager.createReaderFor(file);
-    if (reader != nullptr)
+    // The thumbnail scans the whole file on its own thread; hand it the
+    // mapped reader, keyed like a FileInputSource so cached data still matches
+    if (auto reader = MappedAudio::createReader(formatManager, file))
     {
-        auto newSource = std::make_unique<juce::AudioFormatReaderSource>(reader, true);
-        thumbnail.setSource(new juce::FileInputSource(file));
         totalLength = reader->lengthInSamples / reader->sampleRate;
+        thumbnail.setReader(reader.release(), juce::FileInputSource(file).hashCode());
     }
 }
 
+void WaveformView::primeThumbnail(const juce::File& file, const juce::MemoryBlock& summary)
+{
+    juce::AudioThumbnail primed { 512, formatManager, thumbnailCache };
+    juce::MemoryInputStream in(summary, false);
+    if (primed.loadFrom(in))
+        thumbnailCache.storeThumb(primed, juce::FileInputSource(file).hashCode());
+}
+
 void WaveformView::clearThumbnail()
 {
     thumbnail.setSource(nullptr);
@@ -26,6 +26,10 @@ public:
     void loadThumbnail(const juce::File& file);
     void clearThumbnail();
 
+    /// Seed the thumbnail cache with summary data saved for @p file (project
+    /// bundles), so the next load of that file draws without a rescan.
+    void primeThumbnail(const juce::File& file, const juce::MemoryBlock& summary);
+
     /// Set an offline playback position (seconds). When >= 0, this overrides
     /// the live engine position — used during video export.
     void setOfflinePosition(double seconds) { offlinePos_ = seconds; }
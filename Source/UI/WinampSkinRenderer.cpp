@@ -271,9 +271,7 @@ void WinampSkinRenderer::drawOscilloscopeVis(juce::Graphics& g, juce::Rectangle<
         return;
 
     // Draw waveform using viscolor palette (middle colors)
-    g.setColour(colors[18]);  // Use a bright color for the oscilloscope line
-
-    juce::Path path;
+    oscPoints.resize(static_cast<size_t>(oscDataSize));
     float xStep = static_cast<float>(area.getWidth()) / static_cast<float>(oscDataSize - 1);
     float centerY = area.getCentreY();
     float halfH = area.getHeight() * 0.5f;
@@ -283,14 +281,10 @@ void WinampSkinRenderer::drawOscilloscopeVis(juce::Graphics& g, juce::Rectangle<
         float x = area.getX() + i * xStep;
         float y = centerY - oscData[static_cast<size_t>(i)] * halfH;
         y = juce::jlimit(static_cast<float>(area.getY()), static_cast<float>(area.getBottom()), y);
-
-        if (i == 0)
-            path.startNewSubPath(x, y);
-        else
-            path.lineTo(x, y);
+        oscPoints[static_cast<size_t>(i)] = { x, y };
     }
 
-    g.strokePath(path, juce::PathStrokeType(1.0f));
+    oscRaster.draw(g, oscPoints, 1.0f, colors[18]);  // a bright viscolor for the line
 }
 
 //==============================================================================
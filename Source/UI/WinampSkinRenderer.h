@@ -4,6 +4,7 @@
 #include "../Skin/SkinModel.h"
 #include "../Skin/SkinParser.h"
 #include "BitmapFontRenderer.h"
+#include "PolylineRasteriser.h"
 
 //==============================================================================
 /// WinampSkinRenderer — renders the full Winamp main window using skin data.
@@ -81,6 +82,8 @@ private:
     std::array<float, 20> spectrumBands {};  // 20-band Winamp spectrum
     std::array<float, 512> oscData {};
     int oscDataSize = 0;
+    std::vector<juce::Point<float>> oscPoints;
+    PolylineRasteriser              oscRaster;
 
     // Window focus state
     bool isWindowActive = true;
@@ -0,0 +1,361 @@
+#include "AsyncLogger.h"
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <string>
+
+//==============================================================================
+/// Wakes a few times per frame and moves records from the rings to the sinks.
+class AsyncLogger::DrainThread : public juce::Thread
+{
+public:
+    explicit DrainThread(AsyncLogger& o) : juce::Thread("MaxiMeter Log"), owner(o) {}
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            wait(kDrainIntervalMs);
+            owner.drainAll(true);
+        }
+    }
+
+private:
+    static constexpr int kDrainIntervalMs = 10;
+    AsyncLogger& owner;
+};
+
+//==============================================================================
+/// Thread-local owner of a producer ring.  When the thread exits the ring is
+/// marked orphaned; the drain thread frees it once it has been emptied.
+struct AsyncLogger::ThreadHandle
+{
+    Ring* ring = nullptr;
+
+    ~ThreadHandle()
+    {
+        if (ring != nullptr)
+            ring->orphaned.store(true, std::memory_order_release);
+    }
+};
+
+//==============================================================================
+AsyncLogger::AsyncLogger()
+    : startTicks(juce::Time::getHighResolutionTicks()),
+      startMillis(juce::Time::currentTimeMillis())
+{
+    drainThread = std::make_unique<DrainThread>(*this);
+    drainThread->startThread(juce::Thread::Priority::low);
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    shutdown();
+}
+
+void AsyncLogger::shutdown()
+{
+    if (drainThread != nullptr)
+    {
+        drainThread->stopThread(1000);
+        drainThread.reset();
+    }
+    flush();
+}
+
+//==============================================================================
+// Producers
+//==============================================================================
+AsyncLogger::Ring* AsyncLogger::getThreadRing() noexcept
+{
+    static thread_local ThreadHandle handle;
+
+    if (handle.ring == nullptr)
+    {
+        // First log call on this thread — the only locking step.
+        auto ring = std::make_unique<Ring>();
+        handle.ring = ring.get();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        rings.push_back(std::move(ring));
+    }
+
+    return handle.ring;
+}
+
+void AsyncLogger::fillHeader(Record& r, int categoryId, const char* categoryName) noexcept
+{
+    r.ticks      = juce::Time::getHighResolutionTicks();
+    r.format     = nullptr;
+    r.category   = static_cast<uint8_t>(categoryId);
+    r.numArgs    = 0;
+    r.continues  = 0;
+    r.textLength = 0;
+    r.categoryName[0] = 0;
+
+    if (categoryId == LogCategories::kOther && categoryName != nullptr)
+    {
+        const auto n = std::min(std::strlen(categoryName), sizeof(r.categoryName) - 1);
+        std::memcpy(r.categoryName, categoryName, n);
+        r.categoryName[n] = 0;
+    }
+}
+
+void AsyncLogger::log(int categoryId, const char* categoryName, const juce::String& message) noexcept
+{
+    auto utf8 = message.toRawUTF8();
+    logText(categoryId, categoryName, utf8, std::strlen(utf8));
+}
+
+void AsyncLogger::log(int categoryId, const char* categoryName, const char* message) noexcept
+{
+    logText(categoryId, categoryName, message, message != nullptr ? std::strlen(message) : 0);
+}
+
+void AsyncLogger::logText(int categoryId, const char* categoryName,
+                          const char* utf8, size_t length) noexcept
+{
+    auto* ring = getThreadRing();
+
+    // Long messages span consecutive slots, published together
+    const auto needed = static_cast<uint32_t>(std::max<size_t>(1, (length + kTextBytes - 1) / kTextBytes));
+    const auto head = ring->head.load(std::memory_order_relaxed);
+    const auto tail = ring->tail.load(std::memory_order_acquire);
+    if (needed > kRingCapacity - (head - tail))
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    for (uint32_t i = 0; i < needed; ++i)
+    {
+        auto& r = ring->slots[(head + i) & (kRingCapacity - 1)];
+        fillHeader(r, categoryId, categoryName);
+
+        const size_t offset = static_cast<size_t>(i) * kTextBytes;
+        const size_t chunk  = std::min<size_t>(kTextBytes, length - offset);
+        std::memcpy(r.text, utf8 + offset, chunk);
+        r.textLength = static_cast<uint8_t>(chunk);
+        r.continues  = (i + 1 < needed) ? 1 : 0;
+    }
+
+    ring->head.store(head + needed, std::memory_order_release);
+}
+
+void AsyncLogger::logDeferred(int categoryId, const char* categoryName, const char* format,
+                              const double* values, int numValues) noexcept
+{
+    auto* ring = getThreadRing();
+
+    const auto head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) >= kRingCapacity)
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto& r = ring->slots[head & (kRingCapacity - 1)];
+    fillHeader(r, categoryId, categoryName);
+    r.format  = format;
+    r.numArgs = static_cast<uint8_t>(numValues);
+    for (int i = 0; i < numValues; ++i)
+        r.args[i] = values[i];
+
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+//==============================================================================
+// Drain (background thread, or flush())
+//==============================================================================
+juce::String AsyncLogger::formatRecordTime(juce::int64 ticks) const
+{
+    const double seconds = juce::Time::highResolutionTicksToSeconds(ticks - startTicks);
+    return juce::Time(startMillis + static_cast<juce::int64>(seconds * 1000.0))
+               .toString(false, true, true, true);
+}
+
+juce::String AsyncLogger::expandFormat(const char* format, const double* args, int numArgs)
+{
+    std::string out;
+    int next = 0;
+    for (const char* p = format; *p != 0; ++p)
+    {
+        if (p[0] == '{' && p[1] == '}' && next < numArgs)
+        {
+            const double v = args[next++];
+            if (v == std::floor(v) && std::abs(v) < 1.0e15)
+                out += std::to_string(static_cast<long long>(v));
+            else
+                out += juce::String(v, 3).toStdString();
+            ++p;
+        }
+        else
+        {
+            out += *p;
+        }
+    }
+    return juce::String::fromUTF8(out.c_str(), static_cast<int>(out.size()));
+}
+
+void AsyncLogger::drainAll(bool waitForLock)
+{
+    std::unique_lock<std::mutex> drainLock(drainMutex, std::defer_lock);
+    if (waitForLock)
+        drainLock.lock();
+    else if (!drainLock.try_lock())
+        return;
+
+    struct Pending
+    {
+        juce::int64  ticks;
+        int          category;
+        juce::String categoryName;
+        juce::String message;
+    };
+    std::vector<Pending> batch;
+
+    {
+        std::unique_lock<std::mutex> lock(registryMutex, std::defer_lock);
+        if (waitForLock)
+            lock.lock();
+        else if (!lock.try_lock())
+            return;
+
+        for (auto it = rings.begin(); it != rings.end();)
+        {
+            auto& ring = **it;
+            // Read orphaned before head so records written just before the
+            // owning thread exited are never missed.
+            const bool orphaned = ring.orphaned.load(std::memory_order_acquire);
+            const auto head = ring.head.load(std::memory_order_acquire);
+            auto tail = ring.tail.load(std::memory_order_relaxed);
+
+            while (tail != head)
+            {
+                const auto& first = ring.slots[tail & (kRingCapacity - 1)];
+                Pending p;
+                p.ticks    = first.ticks;
+                p.category = first.category;
+                p.categoryName = first.category < LogCategories::kNumKnown
+                               ? juce::String(LogCategories::kTable[first.category].name)
+                               : juce::String(first.categoryName);
+
+                if (first.format != nullptr)
+                {
+                    p.message = expandFormat(first.format, first.args, first.numArgs);
+                    ++tail;
+                }
+                else
+                {
+                    juce::MemoryBlock text;
+                    for (;;)
+                    {
+                        const auto& r = ring.slots[tail & (kRingCapacity - 1)];
+                        text.append(r.text, r.textLength);
+                        ++tail;
+                        if (r.continues == 0 || tail == head)
+                            break;
+                    }
+                    p.message = juce::String::fromUTF8(static_cast<const char*>(text.getData()),
+                                                       static_cast<int>(text.getSize()));
+                }
+
+                batch.push_back(std::move(p));
+            }
+
+            ring.tail.store(tail, std::memory_order_release);
+
+            if (orphaned)
+                it = rings.erase(it);
+            else
+                ++it;
+        }
+    }
+
+    const auto lost = dropped.exchange(0, std::memory_order_relaxed);
+    totalDropped.fetch_add(lost, std::memory_order_relaxed);
+    if (batch.empty() && lost == 0)
+        return;
+
+    std::stable_sort(batch.begin(), batch.end(),
+                     [](const Pending& a, const Pending& b) { return a.ticks < b.ticks; });
+
+    std::vector<Entry> formatted;
+    formatted.reserve(batch.size() + 1);
+    for (auto& p : batch)
+        formatted.push_back({ formatRecordTime(p.ticks), p.categoryName, std::move(p.message) });
+
+    if (lost > 0)
+        formatted.push_back({ formatRecordTime(juce::Time::getHighResolutionTicks()), "ERROR",
+                              juce::String(static_cast<juce::int64>(lost))
+                                  + " log record(s) dropped (producer ring full)" });
+
+    if (fileSink != nullptr)
+    {
+        for (auto& e : formatted)
+            *fileSink << "[" << e.timestamp << "] [" << e.category << "] " << e.message << "\n";
+        fileSink->flush();
+
+        if (fileSink->getPosition() > kMaxFileBytes)
+            openFileSink();
+    }
+
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    for (auto& e : formatted)
+        entries.push_back(std::move(e));
+    while (entries.size() > kMaxEntries)
+        entries.pop_front();
+}
+
+void AsyncLogger::flush(bool waitForLock)
+{
+    drainAll(waitForLock);
+}
+
+void AsyncLogger::setFileSink(const juce::File& file)
+{
+    std::lock_guard<std::mutex> drainLock(drainMutex);
+    fileSinkPath = file;
+    openFileSink();
+}
+
+void AsyncLogger::openFileSink()
+{
+    fileSink.reset();
+
+    if (fileSinkPath == juce::File{})
+        return;
+
+    // Keep one previous file; the new one starts empty
+    if (fileSinkPath.existsAsFile())
+        fileSinkPath.moveFileTo(fileSinkPath.getSiblingFile(fileSinkPath.getFileNameWithoutExtension()
+                                                            + ".old" + fileSinkPath.getFileExtension()));
+
+    auto stream = std::make_unique<juce::FileOutputStream>(fileSinkPath);
+    if (stream->openedOk())
+    {
+        stream->setPosition(0);
+        stream->truncate();
+        fileSink = std::move(stream);
+    }
+}
+
+//==============================================================================
+// UI ring
+//==============================================================================
+std::vector<AsyncLogger::Entry> AsyncLogger::getEntries() const
+{
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    return { entries.begin(), entries.end() };
+}
+
+void AsyncLogger::clear()
+{
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    entries.clear();
+}
+
+int AsyncLogger::size() const
+{
+    std::lock_guard<std::mutex> lock(entriesMutex);
+    return static_cast<int>(entries.size());
+}
@@ -0,0 +1,246 @@
+#pragma once
+
+/**
+ * @file AsyncLogger.h
+ * @brief Wait-free diagnostic logging backend behind MAXIMETER_LOG.
+ *
+ * Every thread that logs gets its own single-producer ring of fixed-size
+ * binary records (category id, high-resolution tick count, text or
+ * deferred numeric arguments).  Writing a record is a bounded copy and one
+ * atomic store — no lock, no clock formatting — and when a ring is full the
+ * record is dropped and counted rather than blocking.  MAXIMETER_LOG still
+ * builds its juce::String message at the call site; only MAXIMETER_LOGV,
+ * whose text is formatted on the drain thread, is allocation-free.
+ *
+ * A background thread drains all rings every few milliseconds, merges
+ * records by timestamp, formats them and appends them to the UI ring read
+ * by DebugLogWindow and, when enabled, to a size-capped log file.
+ *
+ * Categories are known at compile time.  Building with
+ * MAXIMETER_LOG_LEVEL=0 (errors only) or 1 (errors + info) removes calls in
+ * the disabled categories entirely, including evaluation of their message
+ * arguments.
+ */
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifndef MAXIMETER_LOG_LEVEL
+ #define MAXIMETER_LOG_LEVEL 1
+#endif
+
+//==============================================================================
+enum class LogLevel : uint8_t { Error = 0, Info = 1, Verbose = 2 };
+
+namespace LogCategories
+{
+    struct Info
+    {
+        const char* name;
+        LogLevel    level;
+    };
+
+    /// Known categories.  Unknown names map to kOther and are logged at Info.
+    inline constexpr Info kTable[] =
+    {
+        { "ERROR",      LogLevel::Error   },
+        { "BRIDGE-ERR", LogLevel::Error   },
+        { "EMBED-ERR",  LogLevel::Error   },
+        { "BRIDGE",     LogLevel::Info    },
+        { "SHADER",     LogLevel::Info    },
+        { "INSTANCE",   LogLevel::Info    },
+        { "AUDIO",      LogLevel::Info    },
+        { "EMBED",      LogLevel::Info    },
+        { "NATIVE",     LogLevel::Info    },
+        { "RENDER",     LogLevel::Verbose },
+        { "PY-OUT",     LogLevel::Verbose },
+        { "VIDEO",      LogLevel::Verbose },
+    };
+
+    inline constexpr int kNumKnown = static_cast<int>(sizeof(kTable) / sizeof(kTable[0]));
+    inline constexpr int kOther    = kNumKnown;
+
+    constexpr bool namesEqual(const char* a, const char* b)
+    {
+        while (*a != 0 && *a == *b) { ++a; ++b; }
+        return *a == *b;
+    }
+
+    constexpr int idOf(const char* name)
+    {
+        for (int i = 0; i < kNumKnown; ++i)
+            if (namesEqual(kTable[i].name, name))
+                return i;
+        return kOther;
+    }
+
+    constexpr LogLevel levelOf(int id)
+    {
+        return id < kNumKnown ? kTable[id].level : LogLevel::Info;
+    }
+
+    constexpr bool isCompiledIn(int id)
+    {
+        return static_cast<int>(levelOf(id)) <= MAXIMETER_LOG_LEVEL;
+    }
+}
+
+//==============================================================================
+class AsyncLogger
+{
+public:
+    /// Formatted entry as shown in the debug log window.
+    struct Entry
+    {
+        juce::String timestamp;
+        juce::String category;
+        juce::String message;
+    };
+
+    static AsyncLogger& getInstance()
+    {
+        static AsyncLogger inst;
+        return inst;
+    }
+
+    //--- Producers (any thread, wait-free after the thread's first call) ---
+
+    /// Log preformatted text.  @p categoryName is only read for kOther.
+    void log(int categoryId, const char* categoryName, const juce::String& message) noexcept;
+    void log(int categoryId, const char* categoryName, const char* message) noexcept;
+
+    /// Log a static format string with up to kMaxArgs numeric arguments.
+    /// Each "{}" in @p staticFormat is replaced when the record is drained,
+    /// so the caller pays neither string building nor number formatting.
+    /// @p staticFormat must outlive the program (a string literal).
+    template <typename... Args>
+    void logValues(int categoryId, const char* categoryName, const char* staticFormat, Args... args) noexcept
+    {
+        static_assert(sizeof...(Args) <= kMaxArgs, "too many log arguments");
+        const double values[] = { static_cast<double>(args)..., 0.0 };
+        logDeferred(categoryId, categoryName, staticFormat, values, static_cast<int>(sizeof...(Args)));
+    }
+
+    //--- Consumers ---
+
+    /// Snapshot of the UI ring (thread-safe).
+    std::vector<Entry> getEntries() const;
+    void clear();
+    int  size() const;
+
+    /// Records dropped because a producer's ring was full.
+    uint64_t getDroppedCount() const
+    {
+        return totalDropped.load(std::memory_order_relaxed) + dropped.load(std::memory_order_relaxed);
+    }
+
+    /// Also write every entry to @p file (pass File{} to disable).  The
+    /// previous contents are kept once as "<name>.old<ext>", and the file is
+    /// rotated the same way whenever it grows past kMaxFileBytes.
+    void setFileSink(const juce::File& file);
+
+    static constexpr juce::int64 kMaxFileBytes = 8 << 20;
+
+    /// Drain all pending records now on the calling thread — for shutdown
+    /// and crash handlers, never for hot paths.  Crash handlers pass
+    /// @p waitForLock = false so a drain already in progress cannot hang them.
+    void flush(bool waitForLock = true);
+
+    /// Stop the drain thread after a final flush.  Logging after this call
+    /// still reaches the rings but is only written by an explicit flush().
+    void shutdown();
+
+    static constexpr int kMaxArgs = 4;
+
+private:
+    AsyncLogger();
+    ~AsyncLogger();
+
+    //--- Binary record (fixed size, one cache-friendly slot) ---
+    static constexpr int kTextBytes = 176;
+
+    struct Record
+    {
+        juce::int64 ticks;
+        const char* format;                 ///< deferred format, nullptr for text
+        double      args[kMaxArgs];
+        uint8_t     category;
+        uint8_t     numArgs;
+        uint8_t     continues;              ///< text carries on in the next record
+        uint8_t     textLength;
+        char        categoryName[12];       ///< only for LogCategories::kOther
+        char        text[kTextBytes];
+    };
+
+    //--- Single-producer / single-consumer ring, one per logging thread ---
+    static constexpr uint32_t kRingCapacity = 512;   // power of two
+
+    struct Ring
+    {
+        std::array<Record, kRingCapacity> slots;
+        std::atomic<uint32_t> head { 0 };   ///< written by the producer
+        std::atomic<uint32_t> tail { 0 };   ///< written by the consumer
+        std::atomic<bool>     orphaned { false };
+    };
+
+    struct ThreadHandle;
+    Ring* getThreadRing() noexcept;
+
+    void logText(int categoryId, const char* categoryName, const char* utf8, size_t length) noexcept;
+    void logDeferred(int categoryId, const char* categoryName, const char* format,
+                     const double* values, int numValues) noexcept;
+    static void fillHeader(Record& r, int categoryId, const char* categoryName) noexcept;
+
+    void drainAll(bool waitForLock);
+    juce::String formatRecordTime(juce::int64 ticks) const;
+    static juce::String expandFormat(const char* format, const double* args, int numArgs);
+
+    class DrainThread;
+    std::unique_ptr<DrainThread> drainThread;
+
+    std::mutex               registryMutex;   ///< ring registration only
+    std::vector<std::unique_ptr<Ring>> rings;
+
+    std::mutex               drainMutex;      ///< one drainer at a time
+    std::unique_ptr<juce::FileOutputStream> fileSink;
+    juce::File               fileSinkPath;
+    void openFileSink();                      ///< rotates; drainMutex held
+
+    mutable std::mutex       entriesMutex;
+    std::deque<Entry>        entries;
+    static constexpr size_t  kMaxEntries = 2000;
+
+    std::atomic<uint64_t>    dropped { 0 };         ///< since the last drain
+    std::atomic<uint64_t>    totalDropped { 0 };
+
+    // Wall-clock anchor for converting tick counts
+    const juce::int64 startTicks;
+    const juce::int64 startMillis;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AsyncLogger)
+};
+
+//==============================================================================
+/// Log preformatted text.  Calls in categories above MAXIMETER_LOG_LEVEL are
+/// compiled out, including evaluation of @p msg.
+#define MAXIMETER_LOG(cat, msg) \
+    do { \
+        constexpr int mxmLogCategory_ = LogCategories::idOf(cat); \
+        if constexpr (LogCategories::isCompiledIn(mxmLogCategory_)) \
+            AsyncLogger::getInstance().log(mxmLogCategory_, cat, msg); \
+    } while (false)
+
+/// Log a literal format with "{}" placeholders and numeric arguments; the
+/// text is built on the drain thread.
+#define MAXIMETER_LOGV(cat, fmt, ...) \
+    do { \
+        constexpr int mxmLogCategory_ = LogCategories::idOf(cat); \
+        if constexpr (LogCategories::isCompiledIn(mxmLogCategory_)) \
+            AsyncLogger::getInstance().logValues(mxmLogCategory_, cat, fmt, __VA_ARGS__); \
+    } while (false)
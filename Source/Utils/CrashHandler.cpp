@@ -3,6 +3,7 @@
 #include <dbghelp.h>
 #include <fstream>
 #include <JuceHeader.h>
+#include "AsyncLogger.h"
 #include <ctime>
 
 #pragma comment(lib, "dbghelp.lib")
@@ -103,6 +104,7 @@ namespace CrashHandler
 
     LONG WINAPI UnhandledHandler(EXCEPTION_POINTERS* ep)
     {
+        AsyncLogger::getInstance().flush(false);   // pending diagnostics first
         log("!!! CRASH DETECTED !!!");
         char buf[128];
         snprintf(buf, sizeof(buf), "Exception Code: 0x%08X at Address: %p", 
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+//==============================================================================
+/// Bump allocator for scratch data that only lives for a single frame.
+///
+/// Call reset() at the start of every frame; everything handed out by
+/// allocate() is invalidated at that point.  Only trivially-destructible
+/// data (float buffers, band arrays, ...) should be placed in the arena —
+/// destructors are never run.
+///
+/// When a frame asks for more than the reserved capacity the request is
+/// served from an overflow block on the heap and counted.  On the next
+/// reset() the arena grows to the frame's high-water mark, so after the
+/// first few frames the steady state performs no heap allocations.
+class FrameArena
+{
+public:
+    explicit FrameArena(size_t initialBytes = 64 * 1024)
+    {
+        reserve(initialBytes);
+    }
+
+    /// Start a new frame: rewind the arena and grow it if the previous
+    /// frame overflowed.
+    void reset()
+    {
+        if (! overflow_.empty())
+        {
+            reserve(highWater_ + highWater_ / 2);
+            overflow_.clear();
+        }
+
+        used_ = 0;
+        highWater_ = 0;
+        frameAllocations_ = 0;
+    }
+
+    /// Allocate raw bytes with the given alignment.  Never returns nullptr.
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        const size_t aligned = (used_ + alignment - 1) & ~(alignment - 1);
+        highWater_ = std::max(highWater_, aligned + bytes);
+
+        if (aligned + bytes <= capacity_)
+        {
+            used_ = aligned + bytes;
+            return block_.get() + aligned;
+        }
+
+        // Out of room — fall back to the heap for the rest of this frame.
+        ++frameAllocations_;
+        overflow_.emplace_back(new uint8_t[bytes + alignment]);
+        auto addr = reinterpret_cast<uintptr_t>(overflow_.back().get());
+        return reinterpret_cast<void*>((addr + alignment - 1) & ~(uintptr_t)(alignment - 1));
+    }
+
+    /// Allocate an uninitialised array of trivially-destructible T.
+    template <typename T>
+    T* allocateArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "FrameArena never runs destructors");
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /// Number of heap allocations made by the arena during the current frame.
+    int    getFrameAllocations() const { return frameAllocations_; }
+    size_t getBytesUsed()        const { return used_; }
+    size_t getCapacity()         const { return capacity_; }
+
+private:
+    void reserve(size_t bytes)
+    {
+        if (bytes <= capacity_) return;
+        block_.reset(new uint8_t[bytes]);
+        capacity_ = bytes;
+    }
+
+    std::unique_ptr<uint8_t[]>              block_;
+    size_t                                  capacity_  = 0;
+    size_t                                  used_      = 0;
+    size_t                                  highWater_ = 0;
+    std::vector<std::unique_ptr<uint8_t[]>> overflow_;
+    int                                     frameAllocations_ = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FrameArena)
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+//==============================================================================
+/// Size-bucketed pool of software-backed images that are recycled between
+/// frames instead of being re-allocated.
+///
+/// Images are bucketed by exact (format, width, height).  The offline export
+/// renders the same layout every frame, so after the first frame every
+/// acquire() is satisfied from the pool.
+///
+/// Not thread-safe — each render thread owns its own pool.
+class ImageBufferPool
+{
+public:
+    ImageBufferPool() = default;
+
+    /// Mark every pooled image as free and reset the per-frame counter.
+    /// Images handed out during the previous frame must no longer be used.
+    void beginFrame()
+    {
+        for (auto& e : entries_)
+            e.inUse = false;
+        frameAllocations_ = 0;
+    }
+
+    /// Get an image of the requested format and size, cleared to transparent
+    /// black when @p clear is true.
+    juce::Image acquire(juce::Image::PixelFormat format, int width, int height,
+                        bool clear = true)
+    {
+        for (auto& e : entries_)
+        {
+            if (! e.inUse
+                && e.image.getFormat() == format
+                && e.image.getWidth()  == width
+                && e.image.getHeight() == height)
+            {
+                e.inUse = true;
+                if (clear)
+                    e.image.clear(e.image.getBounds());
+                return e.image;
+            }
+        }
+
+        ++frameAllocations_;
+        entries_.push_back({ juce::Image(format, width, height, true,
+                                         juce::SoftwareImageType()), true });
+        return entries_.back().image;
+    }
+
+    /// Return an image to the pool before the end of the frame so it can be
+    /// reused by a later acquire() in the same frame.
+    void release(const juce::Image& image)
+    {
+        for (auto& e : entries_)
+        {
+            if (e.image == image)
+            {
+                e.inUse = false;
+                return;
+            }
+        }
+    }
+
+    /// Drop every pooled image (e.g. when the output size changes).
+    void clear() { entries_.clear(); }
+
+    /// Number of images that had to be allocated during the current frame.
+    int getFrameAllocations() const { return frameAllocations_; }
+    int getNumPooledImages()  const { return static_cast<int>(entries_.size()); }
+
+    /// Copy the pixels of @p src (or a sub-area of it) into @p dst without
+    /// allocating.  Both images must share the same pixel format and @p dst
+    /// must be at least as large as the copied area.
+    static void copyPixels(const juce::Image& src, juce::Rectangle<int> srcArea,
+                           juce::Image& dst)
+    {
+        srcArea = srcArea.getIntersection(src.getBounds());
+        const int w = std::min(srcArea.getWidth(),  dst.getWidth());
+        const int h = std::min(srcArea.getHeight(), dst.getHeight());
+        if (w <= 0 || h <= 0 || src.getFormat() != dst.getFormat()) return;
+
+        juce::Image::BitmapData s(src, srcArea.getX(), srcArea.getY(), w, h,
+                                  juce::Image::BitmapData::readOnly);
+        juce::Image::BitmapData d(dst, 0, 0, w, h,
+                                  juce::Image::BitmapData::writeOnly);
+
+        const size_t rowBytes = static_cast<size_t>(w) * static_cast<size_t>(s.pixelStride);
+        for (int y = 0; y < h; ++y)
+            std::memcpy(d.getLinePointer(y), s.getLinePointer(y), rowBytes);
+    }
+
+private:
+    struct Entry
+    {
+        juce::Image image;
+        bool        inUse = false;
+    };
+
+    std::vector<Entry> entries_;
+    int                frameAllocations_ = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ImageBufferPool)
+};
@@ -0,0 +1,135 @@
+#include "MediaRegistry.h"
+#include "../Skin/SkinParser.h"
+
+#include <chrono>
+
+//==============================================================================
+MediaRegistry& MediaRegistry::getInstance()
+{
+    static MediaRegistry instance;
+    return instance;
+}
+
+juce::String MediaRegistry::fileKey(const char* kind, const juce::File& file)
+{
+    return juce::String(kind) + ":" + file.getFullPathName()
+         + "@" + juce::String(file.getLastModificationTime().toMilliseconds())
+         + ":" + juce::String(file.getSize());
+}
+
+//==============================================================================
+std::shared_ptr<const void> MediaRegistry::acquire(const juce::String& key, const Decoder& decode,
+                                                   const std::atomic<bool>* cancel)
+{
+    std::shared_ptr<Slot> slot;
+    {
+        const std::lock_guard<std::mutex> ml(mapLock_);
+
+        // Forget files nobody shows any more.  A slot only referenced by the
+        // map has no loader that could be writing to it.
+        for (auto it = slots_.begin(); it != slots_.end();)
+        {
+            if (it->second.use_count() == 1 && it->second->asset.expired() && it->first != key)
+                it = slots_.erase(it);
+            else
+                ++it;
+        }
+
+        auto& s = slots_[key];
+        if (s == nullptr)
+            s = std::make_shared<Slot>();
+        slot = s;
+    }
+
+    std::unique_lock<std::mutex> sl(slot->lock);
+    for (;;)
+    {
+        if (auto asset = slot->asset.lock())
+            return asset;
+
+        if (!slot->loading)
+            break;
+
+        // Someone else is decoding it — wait, but stay cancellable
+        if (cancel != nullptr && cancel->load())
+            return nullptr;
+        slot->loaded.wait_for(sl, std::chrono::milliseconds(50));
+    }
+
+    slot->loading = true;
+    sl.unlock();
+
+    std::shared_ptr<const void> asset;
+    try
+    {
+        asset = decode();
+    }
+    catch (...)
+    {
+        sl.lock();
+        slot->loading = false;
+        sl.unlock();
+        slot->loaded.notify_all();
+        throw;
+    }
+
+    // A failed or cancelled decode is not cached; a waiter tries again
+    sl.lock();
+    slot->loading = false;
+    slot->asset   = asset;
+    sl.unlock();
+    slot->loaded.notify_all();
+    return asset;
+}
+
+//==============================================================================
+std::shared_ptr<const juce::Image> MediaRegistry::getImage(const juce::File& file)
+{
+    auto asset = acquire(fileKey("image", file), [file]() -> std::shared_ptr<const void>
+    {
+        auto img = juce::ImageFileFormat::loadFrom(file);
+        if (!img.isValid())
+            return nullptr;
+        return std::make_shared<const juce::Image>(img);
+    });
+    return std::static_pointer_cast<const juce::Image>(asset);
+}
+
+std::shared_ptr<const MediaRegistry::VideoFrames> MediaRegistry::getVideoFrames(const juce::File& file,
+                                                                                const VideoDecoder& decode,
+                                                                                const std::atomic<bool>* cancel)
+{
+    auto asset = acquire(fileKey("video", file),
+                         [&decode]() -> std::shared_ptr<const void> { return decode(); },
+                         cancel);
+    return std::static_pointer_cast<const VideoFrames>(asset);
+}
+
+std::shared_ptr<const Skin::SkinModel> MediaRegistry::getSkin(const juce::File& wszFile)
+{
+    auto asset = acquire(fileKey("skin", wszFile), [wszFile]() -> std::shared_ptr<const void>
+    {
+        SkinParser parser;
+        auto model = std::make_shared<Skin::SkinModel>(parser.loadFromFile(wszFile));
+        if (!model->isLoaded())
+            return nullptr;
+        return model;
+    });
+    return std::static_pointer_cast<const Skin::SkinModel>(asset);
+}
+
+std::shared_ptr<const juce::Drawable> MediaRegistry::getSvg(const juce::String& svgText)
+{
+    // Identical documents (duplicated layers) share a prototype
+    const auto key = "svg:" + juce::String::toHexString(svgText.hashCode64())
+                   + ":" + juce::String(svgText.length());
+
+    auto asset = acquire(key, [&svgText]() -> std::shared_ptr<const void>
+    {
+        auto xml = juce::XmlDocument::parse(svgText);
+        if (xml == nullptr)
+            return nullptr;
+        return std::shared_ptr<const juce::Drawable>(juce::Drawable::createFromSVG(*xml));
+    });
+    return std::static_pointer_cast<const juce::Drawable>(asset);
+}
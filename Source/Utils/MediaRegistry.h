@@ -0,0 +1,83 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Skin/SkinModel.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//==============================================================================
+/// Process-wide cache of decoded media, so that every layer showing the same
+/// file — duplicates, pasted copies and the export's offscreen items — shares
+/// one decoded copy instead of decoding its own.
+///
+/// Files are keyed by path, modification time and size; an edited file gets
+/// a fresh decode.  Assets are immutable and reference-counted: the registry
+/// only keeps weak references, so an asset is freed when the last layer
+/// using it lets go.  A file requested by several threads at once is
+/// decoded once; the others wait for it.
+///
+/// Thread-safe.  Hold on to the returned pointer for as long as the asset is
+/// shown — copies of the juce::Image objects inside share their pixels, but
+/// do not keep the registry entry alive.
+class MediaRegistry
+{
+public:
+    /// Frames extracted from a video or animated GIF.
+    struct VideoFrames
+    {
+        std::vector<juce::Image> frames;
+        float                    fps = 30.0f;
+    };
+
+    using VideoDecoder = std::function<std::shared_ptr<const VideoFrames>()>;
+
+    static MediaRegistry& getInstance();
+
+    /// A still image, or nullptr if @p file cannot be decoded.
+    std::shared_ptr<const juce::Image> getImage(const juce::File& file);
+
+    /// The frames of a video, made by @p decode unless another layer already
+    /// holds them.  @p decode returns nullptr when it fails or is cancelled;
+    /// nothing is cached then.  While another thread is decoding the same
+    /// file this waits for it, giving up with nullptr once @p cancel is set.
+    std::shared_ptr<const VideoFrames> getVideoFrames(const juce::File& file,
+                                                      const VideoDecoder& decode,
+                                                      const std::atomic<bool>* cancel = nullptr);
+
+    /// A parsed .wsz skin, or nullptr if it fails to load.
+    std::shared_ptr<const Skin::SkinModel> getSkin(const juce::File& wszFile);
+
+    /// The parsed Drawable for an SVG document, or nullptr if it is not one.
+    /// Drawables are Components and cannot be painted from two threads at
+    /// once, so paint a createCopy() of it; the XML is only parsed once.
+    std::shared_ptr<const juce::Drawable> getSvg(const juce::String& svgText);
+
+private:
+    MediaRegistry() = default;
+
+    struct Slot
+    {
+        std::mutex                  lock;
+        std::condition_variable     loaded;
+        bool                        loading = false;
+        std::weak_ptr<const void>   asset;
+    };
+
+    using Decoder = std::function<std::shared_ptr<const void>()>;
+
+    /// The live asset for @p key, decoding it if nobody holds it.
+    std::shared_ptr<const void> acquire(const juce::String& key, const Decoder& decode,
+                                        const std::atomic<bool>* cancel = nullptr);
+
+    static juce::String fileKey(const char* kind, const juce::File& file);
+
+    std::mutex                                      mapLock_;
+    std::map<juce::String, std::shared_ptr<Slot>>   slots_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MediaRegistry)
+};
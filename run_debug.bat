@@ -8,5 +8,5 @@ if not exist "%EXE%" (
   exit /b 1
 )
 
-start "MaxiMeter" "%EXE%"
+start "MaxiMeter" "%EXE%" --log-file
 endlocal